@@ -38,6 +38,35 @@ typedef struct {
 	bool door_open;           /* Door is fully opened */
 } CondSel_In;
 
+/** Packed input values of the condition selector, one bit per CondSel_In signal. */
+typedef uint8_t CondSel_Mask;
+
+#define CONDSEL_MASK_BELOW    (1U << 0)  /* call_pending_below */
+#define CONDSEL_MASK_SAME     (1U << 1)  /* call_pending_same */
+#define CONDSEL_MASK_ABOVE    (1U << 2)  /* call_pending_above */
+#define CONDSEL_MASK_CLOSED   (1U << 3)  /* door_closed */
+#define CONDSEL_MASK_OPEN     (1U << 4)  /* door_open */
+#define CONDSEL_MASK_PENDING  (CONDSEL_MASK_BELOW | CONDSEL_MASK_SAME | CONDSEL_MASK_ABOVE)
+#define CONDSEL_MASK_ALL      (0x1FU)    /* every signal bit */
+#define CONDSEL_MASK_COUNT    (32U)      /* number of distinct masks */
+
+/** Input values of 64 condition selectors, bit i of every plane belongs to instance i. */
+typedef struct {
+	uint64_t call_pending_below;
+	uint64_t call_pending_same;
+	uint64_t call_pending_above;
+	uint64_t door_closed;
+	uint64_t door_open;
+} CondSel_Planes;
+
+/** Selector index (3 planes) and inversion of 64 condition selectors, bit i belongs to instance i. */
+typedef struct {
+	uint64_t index0;  /* Bit 0 of the selector index */
+	uint64_t index1;  /* Bit 1 of the selector index */
+	uint64_t index2;  /* Bit 2 of the selector index */
+	uint64_t invert;  /* Result inversion */
+} CondSel_SelPlanes;
+
 /** Calculates the result of the condition selector based on the parameters.
  * @param[in] invert  Return value is inverted.
  * @param[in] index   Index of the value to select (@see documentation for details).
@@ -46,6 +75,41 @@ typedef struct {
  */  
 CONDSEL_API bool CondSel_calc(const bool invert, const uint8_t index, const CondSel_In values);
 
+/** Packs the input values into a CondSel_Mask.
+ * @param[in] values  External input values.
+ * @return Returns with the packed mask.
+ */
+CONDSEL_API CondSel_Mask CondSel_pack(const CondSel_In* values);
+
+/** Branchless variant of CondSel_calc() working on packed inputs.
+ * @param[in] invert  Return value is inverted.
+ * @param[in] index   Index of the value to select (@see documentation for details).
+ * @param[in] mask    Packed external input values.
+ * @return Resturns with the selected value or the negated value of it.
+ */
+CONDSEL_API bool CondSel_calcMask(const bool invert, const uint8_t index, const CondSel_Mask mask);
+
+/** Returns the inputs a selector index reads.
+ * @param[in] index   Index of the value to select (@see documentation for details).
+ * @return Returns with the mask of the inputs (0 for the constant selectors).
+ */
+CONDSEL_API CondSel_Mask CondSel_dependency(const uint8_t index);
+
+/** Evaluates the same selector index for 64 instances at once.
+ * @param[in] invert  Return values are inverted.
+ * @param[in] index   Index of the value to select (@see documentation for details).
+ * @param[in] values  Input planes of the 64 instances.
+ * @return Returns with the result plane, bit i belongs to instance i.
+ */
+CONDSEL_API uint64_t CondSel_calcSliced(const bool invert, const uint8_t index, const CondSel_Planes* values);
+
+/** Evaluates a per-instance selector index and inversion for 64 instances at once.
+ * @param[in] sel     Selector index and inversion planes of the 64 instances.
+ * @param[in] values  Input planes of the 64 instances.
+ * @return Returns with the result plane, bit i belongs to instance i.
+ */
+CONDSEL_API uint64_t CondSel_calcSlicedSel(const CondSel_SelPlanes* sel, const CondSel_Planes* values);
+
 #ifdef __cplusplus
 }
 #endif
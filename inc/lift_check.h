@@ -0,0 +1,155 @@
+/**
+ * @file lift_check.h
+ * @brief Explicit-state model checker of a program controlling the emulated plant.
+ *
+ * The checker explores every state of the product "program counter x plant state"
+ * reachable from an initial state, in breadth-first order. A transition is one
+ * controller step with the plant semantics of LiftPlant_apply(); before every step
+ * the environment may register a new call on any floor without one (or none).
+ *
+ * States are packed into 64 bits (@see LiftCheck_pack), so the floor count is only
+ * limited by LIFT_CHECK_MAX_FLOORS, not by LIFT_MAX_FLOORS. The visited set is a
+ * lock-free open-addressing hash table in caller-provided memory, shared by the
+ * worker threads that expand each BFS level. Every visited state keeps a link to
+ * its parent, so a violation comes with a shortest counterexample trace.
+ *
+ * Checked properties:
+ *  - the car never moves with the door open,
+ *  - no instruction requests moving up and down at once,
+ *  - the car never leaves the floor range,
+ *  - optionally, from every reachable state, the pending calls are all served within
+ *    a bounded number of steps if no new call arrives.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "seqnet.h"
+
+/// Maximum number of floors supported by the packed state
+#define LIFT_CHECK_MAX_FLOORS           (32U)
+
+/**
+ * @brief Verdict of a model checking run.
+ */
+typedef enum LiftCheckVerdict_t {
+    LIFT_CHECK_OK               = 0,  ///< Every reachable state satisfies the properties
+    LIFT_CHECK_MOVE_CONFLICT    = 1,  ///< An instruction requests moving up and down at once
+    LIFT_CHECK_DOOR_OPEN_MOVING = 2,  ///< The car moves with the door open
+    LIFT_CHECK_FLOOR_RANGE      = 3,  ///< The car left the floor range
+    LIFT_CHECK_SERVICE          = 4,  ///< Pending calls are not served within the bound
+    LIFT_CHECK_OUT_OF_MEMORY    = 5   ///< The workspace is too small for the state space
+} LiftCheckVerdict_t;
+
+/**
+ * @brief Unpacked state of the product.
+ */
+typedef struct
+{
+    uint8_t pc;          ///< Program counter
+    uint8_t floor;       ///< Current floor
+    bool is_door_open;   ///< Is the door open?
+    bool is_moving;      ///< Is the lift moving?
+    uint32_t calls;      ///< Pending calls, bit i = floor i
+} LiftCheckState_t;
+
+/**
+ * @brief Parameters of a model checking run.
+ */
+typedef struct
+{
+    uint8_t floors;          ///< Number of floors (1..LIFT_CHECK_MAX_FLOORS)
+    bool arrivals;           ///< Let the environment register new calls
+    uint16_t service_bound;  ///< Steps allowed to serve all pending calls, 0 disables the check
+    uint32_t threads;        ///< Number of worker threads (1..LIFT_THREAD_MAX)
+} LiftCheckConfig_t;
+
+/**
+ * @brief Caller-provided memory of the checker.
+ *
+ * Every array holds @p capacity entries, @p capacity must be a power of two.
+ * The visited set is filled up to 3/4 of the capacity.
+ */
+typedef struct
+{
+    uint64_t* keys;      ///< Visited set: packed state + 1, 0 marks an empty slot
+    uint32_t* parents;   ///< Slot of the parent of every visited state
+    uint32_t* current;   ///< Slots of the BFS level being expanded
+    uint32_t* next;      ///< Slots of the next BFS level
+    uint32_t capacity;   ///< Number of entries of every array
+} LiftCheckWorkspace_t;
+
+/**
+ * @brief Result of a model checking run.
+ */
+typedef struct
+{
+    LiftCheckVerdict_t verdict;  ///< Outcome of the run
+    uint32_t states;             ///< Number of visited states
+    uint32_t depth;              ///< Number of BFS levels explored
+    uint32_t violation;          ///< Slot of the violating state (valid if verdict is a violation)
+} LiftCheckResult_t;
+
+/**
+ * @brief Packs a state into its 64-bit key.
+ * @param[in] state  State to pack.
+ * @return Returns with the packed state.
+ */
+uint64_t LiftCheck_pack(const LiftCheckState_t* state);
+
+/**
+ * @brief Unpacks a 64-bit key.
+ * @param[in]  key    Packed state.
+ * @param[out] state  Unpacked state.
+ */
+void LiftCheck_unpack(uint64_t key, LiftCheckState_t* state);
+
+/**
+ * @brief Explores every state reachable from @p initial and checks the properties.
+ *
+ * The verdict, the state count and the depth do not depend on the number of threads:
+ * levels are explored completely, and among the violations of the first violating
+ * level the smallest verdict, then the smallest packed state is reported. Its trace
+ * is a shortest one, but which of several equally short traces is kept may vary.
+ *
+ * @param[in]  program    Decoded program of the controller (read only, shared by the workers).
+ * @param[in]  config     Parameters of the run.
+ * @param[in]  initial    Initial state.
+ * @param[in]  workspace  Memory of the visited set and the frontiers.
+ * @param[out] result     Outcome of the run.
+ */
+void LiftCheck_run(const SeqNet_Program* program, const LiftCheckConfig_t* config,
+                   const LiftCheckState_t* initial, const LiftCheckWorkspace_t* workspace,
+                   LiftCheckResult_t* result);
+
+/**
+ * @brief Extracts the counterexample trace of a violation.
+ *
+ * The trace starts with the initial state and ends with the violating state. For a
+ * move conflict the last state is the one executing the conflicting instruction,
+ * for a service violation the one whose calls are not served in time.
+ *
+ * @param[in]  workspace  Workspace of the run.
+ * @param[in]  result     Result of the run.
+ * @param[out] trace      Array of at most @p max_length states.
+ * @param[in]  max_length Capacity of @p trace.
+ * @return Returns with the length of the trace (0 if there is no violation or it does not fit).
+ */
+uint32_t LiftCheck_trace(const LiftCheckWorkspace_t* workspace, const LiftCheckResult_t* result,
+                         LiftCheckState_t* trace, uint32_t max_length);
+
+/**
+ * @brief Returns the printable name of a verdict.
+ * @param[in] verdict  Verdict.
+ * @return Constant name string.
+ */
+const char* LiftCheckVerdict_name(LiftCheckVerdict_t verdict);
+
+#ifdef __cplusplus
+}
+#endif
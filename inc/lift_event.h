@@ -0,0 +1,69 @@
+/**
+ * @file lift_event.h
+ * @brief Event-driven simulation of one controller and its plant.
+ *
+ * The tick-driven mode steps the controller once per tick. The event-driven mode
+ * produces the same states, but whenever the controller is parked in a wait loop
+ * (@see SeqNet_ctxPark) and the plant is at rest under the held outputs, it jumps the
+ * clock straight to the next call injection. The cost of a simulation then scales
+ * with the number of events instead of the number of ticks.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "seqnet.h"
+#include "lift_plant.h"
+
+/**
+ * @brief Simulation state.
+ */
+typedef struct
+{
+    LiftInputs_t plant;  ///< Plant state and its condition inputs
+    SeqNet_Ctx ctx;      ///< Controller
+    uint64_t tick;       ///< Simulation clock (number of elapsed ticks)
+    uint64_t steps;      ///< Controller steps actually executed
+    uint64_t skipped;    ///< Ticks skipped while parked
+    uint32_t parks;      ///< Number of clock jumps
+    uint32_t next_call;  ///< Index of the next pending injection
+} LiftEventSim_t;
+
+/**
+ * @brief Initializes a simulation.
+ *
+ * @param[out] sim      Simulation to initialize.
+ * @param[in]  program  Decoded program of the controller.
+ * @param[in]  initial  Initial plant state.
+ * @param[in]  pc       Initial program counter.
+ */
+void LiftEventSim_init(LiftEventSim_t* sim, const SeqNet_Program* program, const LiftState_t* initial, uint8_t pc);
+
+/**
+ * @brief Runs the simulation tick by tick until @p end_tick (reference mode).
+ *
+ * @param[in,out] sim         Simulation to advance.
+ * @param[in]     end_tick    Clock value to stop at.
+ * @param[in]     calls       Call injections sorted by tick.
+ * @param[in]     call_count  Number of injections.
+ */
+void LiftEventSim_runTicks(LiftEventSim_t* sim, uint64_t end_tick, const LiftCallInjection_t* calls, uint32_t call_count);
+
+/**
+ * @brief Runs the simulation until @p end_tick, skipping the ticks spent parked.
+ *
+ * @param[in,out] sim         Simulation to advance.
+ * @param[in]     end_tick    Clock value to stop at.
+ * @param[in]     calls       Call injections sorted by tick.
+ * @param[in]     call_count  Number of injections.
+ */
+void LiftEventSim_run(LiftEventSim_t* sim, uint64_t end_tick, const LiftCallInjection_t* calls, uint32_t call_count);
+
+#ifdef __cplusplus
+}
+#endif
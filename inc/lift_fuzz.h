@@ -0,0 +1,82 @@
+/**
+ * @file lift_fuzz.h
+ * @brief Randomized scenario fuzzer of a program controlling the emulated plant.
+ *
+ * Every scenario is derived from a 64-bit seed: a random initial state, a random
+ * start PC and random call injections during the run. The controller is stepped with
+ * its transition table (@see SeqNetTable_step) and the plant with the input tracker
+ * of the other simulators (@see LiftInputs_apply), while the invariants of the model
+ * checker are checked before every plant update (@see LiftCheckVerdict_t). A failing
+ * scenario is reported by its seed, LiftFuzz_scenario() replays it exactly.
+ *
+ * LiftFuzz_run() spreads the seeds over worker threads in chunks and reports the
+ * lowest failing seed, so the report does not depend on the number of threads.
+ * The fuzzer allocates nothing.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "seqnet_table.h"
+#include "lift_check.h"
+
+/**
+ * @brief Parameters of the fuzzer.
+ */
+typedef struct
+{
+    uint16_t floors;           ///< Floors of the fuzzed building (1..LIFT_MAX_FLOORS), 0 for LIFT_MAX_FLOORS
+    uint32_t steps;            ///< Controller steps per scenario
+    uint32_t service_bound;    ///< Steps a call may stay pending, 0 disables the check
+    uint8_t injection_shift;   ///< A call arrives at a step with probability 2^-shift, 0 disables arrivals
+    const uint8_t* presets;    ///< Start PCs to choose from, NULL for any PC
+    uint32_t preset_count;     ///< Number of start PCs in @p presets
+    uint32_t threads;          ///< Worker threads of LiftFuzz_run() (1..LIFT_THREAD_MAX), 0 runs on the calling thread
+} LiftFuzzConfig_t;
+
+/**
+ * @brief First failing scenario of a fuzzing run.
+ */
+typedef struct
+{
+    LiftCheckVerdict_t verdict;  ///< Violated invariant, LIFT_CHECK_OK if every scenario passed
+    uint64_t seed;               ///< Seed of the failing scenario
+    uint32_t step;               ///< Step after which the invariant was violated
+} LiftFuzzReport_t;
+
+/**
+ * @brief Runs the scenario of one seed.
+ *
+ * @param[in]  table   Transition table of the program.
+ * @param[in]  config  Parameters of the fuzzer.
+ * @param[in]  seed    Seed of the scenario.
+ * @param[out] step    Step of the violation (may be NULL).
+ * @return Returns with the violated invariant, LIFT_CHECK_OK if none.
+ */
+LiftCheckVerdict_t LiftFuzz_scenario(const SeqNetTable_t* table, const LiftFuzzConfig_t* config,
+                                     uint64_t seed, uint32_t* step);
+
+/**
+ * @brief Runs the scenarios of seeds first_seed .. first_seed + count - 1, stopping at the first failure.
+ *
+ * With several threads the seeds beyond a failure may be run too, but the reported
+ * failure is always the one of the lowest failing seed.
+ *
+ * @param[in]  table       Transition table of the program.
+ * @param[in]  config      Parameters of the fuzzer.
+ * @param[in]  first_seed  Seed of the first scenario.
+ * @param[in]  count       Number of scenarios.
+ * @param[out] report      First failing scenario.
+ * @return Returns with the number of scenarios up to and including the failing one, @p count if none failed.
+ */
+uint64_t LiftFuzz_run(const SeqNetTable_t* table, const LiftFuzzConfig_t* config,
+                      uint64_t first_seed, uint64_t count, LiftFuzzReport_t* report);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file lift_group.h
+ * @brief Group control of a bank of cars: hall call dispatching over N controllers.
+ *
+ * The group owns the hall calls of the building. A new hall call is assigned to
+ * exactly one car by a pluggable cost function and registered in that car's call
+ * memory, where its own controller serves it. Every car keeps a small view (floor,
+ * direction, load) that is updated by the step that changes it.
+ *
+ * The cost of every pending hall call with every car is cached. When the view of a
+ * car changes, only the costs of that car are re-evaluated (one call per pending hall
+ * call), the other cars keep their cached costs. A call is handed over to a car that
+ * became cheaper than its owner, unless the owner stands at the floor of the call or
+ * holds a car call there. The owner is rated without the call itself, so a hand-over
+ * alone never makes the call look better elsewhere again.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "seqnet.h"
+#include "lift_plant.h"
+
+/// Maximum number of cars of a group
+#define LIFT_GROUP_MAX_CARS             (16U)
+/// Owner of a floor without a pending hall call
+#define LIFT_GROUP_NO_CAR               (0xFFU)
+
+/**
+ * @brief Dispatch view of a car, updated by the steps changing it.
+ */
+typedef struct
+{
+    uint16_t floor;      ///< Current floor
+    int8_t direction;    ///< Direction of the last move while busy: +1 up, -1 down, 0 idle
+    bool is_door_open;   ///< Door state
+    uint16_t load;       ///< Calls registered in the car's call memory
+} LiftGroupCarView_t;
+
+/**
+ * @brief Cost of serving a hall call with a car, the lowest cost wins (ties: lowest car index).
+ *
+ * The cost may only depend on the view and the floor, @p car may point to a copy of the view.
+ *
+ * @param[in] car      View of the candidate car.
+ * @param[in] floor    Floor of the hall call.
+ * @param[in] context  User data given to LiftGroup_init().
+ * @return Cost of the assignment.
+ */
+typedef uint32_t (*LiftGroupCost_t)(const LiftGroupCarView_t* car, uint16_t floor, const void* context);
+
+/**
+ * @brief Weights of LiftGroupCost_default().
+ */
+typedef struct
+{
+    uint32_t distance;   ///< Cost per floor between the car and the call
+    uint32_t reversal;   ///< Cost of a call behind a busy car
+    uint32_t load;       ///< Cost per call already registered in the car
+} LiftGroupWeights_t;
+
+/**
+ * @brief Group of cars.
+ */
+typedef struct
+{
+    SeqNet_Ctx ctx[LIFT_GROUP_MAX_CARS];            ///< Controllers
+    LiftInputs_t plant[LIFT_GROUP_MAX_CARS];        ///< Plants with their condition inputs
+    LiftGroupCarView_t view[LIFT_GROUP_MAX_CARS];   ///< Dispatch views
+    uint8_t cars;                                   ///< Number of cars
+    LiftCalls_t hall;                               ///< Pending hall calls
+    uint8_t owner[LIFT_MAX_FLOORS];                 ///< Car serving the hall call of a floor, LIFT_GROUP_NO_CAR if none
+    uint16_t pending[LIFT_MAX_FLOORS];              ///< Floors of the pending hall calls, unordered
+    uint16_t slot[LIFT_MAX_FLOORS];                 ///< Index of a pending floor in pending[]
+    uint16_t pending_count;                         ///< Number of pending hall calls
+    uint32_t costs[LIFT_MAX_FLOORS][LIFT_GROUP_MAX_CARS]; ///< Cached cost of a pending hall call with each car
+    LiftCalls_t cabin[LIFT_GROUP_MAX_CARS];         ///< Car calls of each car
+    LiftGroupCost_t cost;                           ///< Cost function
+    const void* cost_context;                       ///< User data of the cost function
+    uint64_t dispatched;                            ///< Hall calls assigned
+    uint64_t served;                                ///< Hall calls served
+    uint64_t reassigned;                            ///< Hall calls handed over to a cheaper car
+    uint64_t evaluations;                           ///< Calls of the cost function
+} LiftGroup_t;
+
+/**
+ * @brief Distance, direction and load weighted cost (context: const LiftGroupWeights_t*).
+ */
+uint32_t LiftGroupCost_default(const LiftGroupCarView_t* car, uint16_t floor, const void* context);
+
+/**
+ * @brief Initializes a group.
+ *
+ * @param[out] group    Group to initialize.
+ * @param[in]  program  Decoded program of every controller.
+ * @param[in]  cars     Number of cars (1..LIFT_GROUP_MAX_CARS).
+ * @param[in]  initial  Initial plant states of the cars, NULL for idle cars on floor 0 with closed doors.
+ * @param[in]  cost     Cost function.
+ * @param[in]  context  User data of the cost function.
+ */
+void LiftGroup_init(LiftGroup_t* group, const SeqNet_Program* program, uint8_t cars, const LiftState_t* initial,
+                    LiftGroupCost_t cost, const void* context);
+
+/**
+ * @brief Returns the car with the lowest cost for a hall call, without assigning it.
+ *
+ * @param[in] group  Group.
+ * @param[in] floor  Floor of the hall call.
+ * @return Index of the selected car.
+ */
+uint8_t LiftGroup_select(const LiftGroup_t* group, uint16_t floor);
+
+/**
+ * @brief Registers a hall call and assigns it to a car (one cost evaluation per car).
+ *
+ * @param[in,out] group  Group.
+ * @param[in]     floor  Floor of the hall call.
+ * @return Index of the car serving the call (the existing owner if the call is already pending).
+ */
+uint8_t LiftGroup_hallCall(LiftGroup_t* group, uint16_t floor);
+
+/**
+ * @brief Registers a car call (a floor button inside a car).
+ *
+ * @param[in,out] group  Group.
+ * @param[in]     car    Index of the car.
+ * @param[in]     floor  Requested floor.
+ */
+void LiftGroup_carCall(LiftGroup_t* group, uint8_t car, uint16_t floor);
+
+/**
+ * @brief Executes one controller step on every car and updates the views and hall calls.
+ *
+ * The costs of the cars whose view changed are re-evaluated and hall calls are reassigned.
+ *
+ * @param[in,out] group  Group to advance.
+ */
+void LiftGroup_step(LiftGroup_t* group);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file lift_motion.h
+ * @brief Continuous-time plant: jerk-limited car motion and door travel of many cars.
+ *
+ * LiftPlant_apply() moves a car one floor per step and switches its door instantly.
+ * This model integrates position, velocity and acceleration with a fixed step instead:
+ * a car accelerates, cruises and brakes along a jerk-limited speed pattern, levels at
+ * the floor and only then reports the arrival. The door travels in door_time and is
+ * held fully open for door_dwell before a close request is honoured.
+ *
+ * Every car owns one slot in caller-provided arrays (structure of arrays), so the
+ * integration of all cars is one SIMD pass (@see SeqNetBatch_t for the same layout of
+ * the controllers). The kernel is selected at runtime: AVX2 (8 cars), SSE4.1 (4 cars)
+ * or a portable scalar loop; all of them produce bit-identical results.
+ *
+ * Move requests are latched: a request at rest (door closed) starts a run towards the
+ * nearest floor with a pending call in that direction (or the next floor), later
+ * requests of the run are ignored and the car stops by itself. While the car is
+ * running it retargets to a nearer call it can still stop at. A car standing at a
+ * floor with a pending call does not start, the call has to be served first.
+ *
+ * The condition inputs are derived from the physics: door_closed and door_open are the
+ * door end positions, call_pending_same is only reported for a levelled car.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "condsel.h"
+#include "lift_plant.h"
+#include "seqnet_batch.h"
+
+/**
+ * @brief Physical parameters of the cars and the fixed integration step.
+ */
+typedef struct
+{
+    float dt;               // Integration step [s]
+    float floor_height;     // Distance of two floors [m]
+    float max_speed;        // Rated speed [m/s]
+    float max_accel;        // Acceleration limit [m/s^2]
+    float max_jerk;         // Jerk limit [m/s^3]
+    float level_tolerance;  // Floor-level detection window [m]
+    float door_time;        // Travel time of the door between its end positions [s]
+    float door_dwell;       // Time the door is held fully open before closing [s]
+    uint16_t floors;        // Floors of the building (2..LIFT_MAX_FLOORS)
+} LiftMotionParams_t;
+
+/**
+ * @brief Caller-owned arrays of a motion model, each of `count` elements.
+ */
+typedef struct
+{
+    float* position;        // Car position above floor 0 [m]
+    float* velocity;        // Car velocity [m/s]
+    float* accel;           // Car acceleration [m/s^2]
+    float* target;          // Stop position of the current run [m]
+    float* door;            // Door opening, 0 = closed .. 1 = open
+    float* door_rate;       // Door travel per second (positive = opening)
+    float* dwell;           // Remaining hold time of the open door [s]
+    int8_t* direction;      // Latched run direction (+1 up, -1 down, 0 levelled)
+    LiftInputs_t* plant;    // Call memory, floor and condition inputs
+    CondSel_Mask* in;       // Packed condition inputs (@see SeqNetBatch_t.in)
+} LiftMotionArrays_t;
+
+/**
+ * @brief Motion model of a bank of cars.
+ */
+typedef struct
+{
+    LiftMotionParams_t params;    // Physical parameters
+    LiftMotionArrays_t car;       // State arrays
+    uint32_t count;               // Number of cars
+    SeqNetBatchKernel_t kernel;   // Resolved integration kernel (never AUTO)
+} LiftMotion_t;
+
+/**
+ * @brief Fills typical mid-rise parameters (1.6 m/s, 1 m/s^2, 1.5 m/s^3, 10 ms step).
+ *
+ * @param[out] params  Parameters to fill.
+ * @param[in]  floors  Floors of the building.
+ */
+void LiftMotionParams_default(LiftMotionParams_t* params, uint16_t floors);
+
+/**
+ * @brief Initializes a motion model over caller-owned arrays and selects the best kernel.
+ *
+ * Every car is placed levelled at floor 0 with a closed door and no calls.
+ *
+ * @param[out] motion  Model to initialize.
+ * @param[in]  params  Physical parameters (copied).
+ * @param[in]  arrays  State arrays (copied pointers).
+ * @param[in]  count   Number of cars.
+ */
+void LiftMotion_init(LiftMotion_t* motion, const LiftMotionParams_t* params,
+                     const LiftMotionArrays_t* arrays, uint32_t count);
+
+/**
+ * @brief Selects the integration kernel of a model.
+ *
+ * Kernels not supported by the running CPU fall back to the next best one.
+ *
+ * @param[in,out] motion     Model to configure.
+ * @param[in]     requested  Requested kernel (AUTO selects the best available).
+ * @return Returns with the kernel actually selected.
+ */
+SeqNetBatchKernel_t LiftMotion_select(LiftMotion_t* motion, SeqNetBatchKernel_t requested);
+
+/**
+ * @brief Places a car levelled at the floor of a plant state.
+ *
+ * The door is fully open or closed as in the state, its calls are loaded.
+ *
+ * @param[in,out] motion  Model of the car.
+ * @param[in]     car     Index of the car.
+ * @param[in]     state   Floor, door and calls (the floor must be below params.floors).
+ */
+void LiftMotion_place(LiftMotion_t* motion, uint32_t car, const LiftState_t* state);
+
+/**
+ * @brief Applies the packed output words of one controller step to every car.
+ *
+ * @param[in,out] motion  Model to command.
+ * @param[in]     out     Array of `count` output words (@see SeqNetBatch_t.out).
+ */
+void LiftMotion_command(LiftMotion_t* motion, const uint16_t* out);
+
+/**
+ * @brief Advances the motion and the door of every car by one integration step.
+ *
+ * @param[in,out] motion  Model to integrate.
+ */
+void LiftMotion_integrate(LiftMotion_t* motion);
+
+/**
+ * @brief Derives floors, arrivals and condition inputs from the integrated state.
+ *
+ * Updates the floor and the inputs of every plant and packs them into `in`.
+ *
+ * @param[in,out] motion  Model to sense.
+ */
+void LiftMotion_sense(LiftMotion_t* motion);
+
+/**
+ * @brief One fixed step of the plant: command, integrate, sense.
+ *
+ * @param[in,out] motion  Model to step.
+ * @param[in]     out     Array of `count` output words of the last controller step.
+ */
+void LiftMotion_step(LiftMotion_t* motion, const uint16_t* out);
+
+#ifdef __cplusplus
+}
+#endif
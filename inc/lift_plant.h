@@ -0,0 +1,322 @@
+/**
+ * @file lift_plant.h
+ * @brief Emulated lift plant: car state, its condition selector view and its response to outputs.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "condsel.h"
+#include "seqnet.h"
+
+/// Maximum number of floors (adjust if needed, e.g. -DLIFT_MAX_FLOORS=256 for towers)
+#ifndef LIFT_MAX_FLOORS
+#define LIFT_MAX_FLOORS                 (6U)
+#endif
+
+#if (LIFT_MAX_FLOORS < 1) || (LIFT_MAX_FLOORS > 65535)
+#error "LIFT_MAX_FLOORS must be in 1..65535"
+#endif
+
+/// Bits of one call bitset word
+#define LIFT_CALL_WORD_BITS             (64U)
+/// Words of a call bitset
+#define LIFT_CALL_WORDS                 ((LIFT_MAX_FLOORS + LIFT_CALL_WORD_BITS - 1U) / LIFT_CALL_WORD_BITS)
+/// Size of the text written by LiftCalls_format(), terminator included
+#define LIFT_CALLS_TEXT_SIZE            (3U * LIFT_MAX_FLOORS + 1U)
+
+/// Call bit of a floor in the first word, for LIFT_CALLS_INIT()
+#define LIFT_CALL(floor)                (1ULL << (floor))
+/// Initializer of a call bitset from the call bits of floors 0..63, e.g. LIFT_CALLS_INIT(LIFT_CALL(1) | LIFT_CALL(3))
+#define LIFT_CALLS_INIT(bits)           { .words = { (uint64_t)(bits) } }
+/// Initializer of an empty call bitset
+#define LIFT_CALLS_NONE                 LIFT_CALLS_INIT(0)
+
+/**
+ * @brief Pending calls of a car, bit i = floor i.
+ *
+ * Bits above LIFT_MAX_FLOORS are always zero.
+ */
+typedef struct
+{
+    uint64_t words[LIFT_CALL_WORDS]; // Call bits, floor i is bit (i % 64) of word (i / 64)
+} LiftCalls_t;
+
+/**
+ * @brief State of the emulated lift car.
+ */
+typedef struct
+{
+    uint16_t floor; // Current floor
+    bool is_door_open; // Is the door open?
+    bool is_moving; // Is the lift moving?
+    LiftCalls_t calls; // Calls from other floors
+} LiftState_t;
+
+/**
+ * @brief Call registered on a floor at a given simulation tick.
+ */
+typedef struct
+{
+    uint32_t tick; // Tick at which the call is registered (before the controller step of that tick)
+    uint16_t floor; // Floor of the call
+} LiftCallInjection_t;
+
+/**
+ * @brief Returns whether a floor has a pending call.
+ */
+static inline bool LiftCalls_get(const LiftCalls_t* calls, uint16_t floor)
+{
+    return ((calls->words[floor / LIFT_CALL_WORD_BITS] >> (floor % LIFT_CALL_WORD_BITS)) & 1U) != 0;
+}
+
+/**
+ * @brief Registers the call of a floor.
+ */
+static inline void LiftCalls_set(LiftCalls_t* calls, uint16_t floor)
+{
+    calls->words[floor / LIFT_CALL_WORD_BITS] |= 1ULL << (floor % LIFT_CALL_WORD_BITS);
+}
+
+/**
+ * @brief Clears the call of a floor.
+ */
+static inline void LiftCalls_clear(LiftCalls_t* calls, uint16_t floor)
+{
+    calls->words[floor / LIFT_CALL_WORD_BITS] &= ~(1ULL << (floor % LIFT_CALL_WORD_BITS));
+}
+
+/**
+ * @brief Sets or clears the call of a floor.
+ */
+static inline void LiftCalls_assign(LiftCalls_t* calls, uint16_t floor, bool pending)
+{
+    if (pending)
+    {
+        LiftCalls_set(calls, floor);
+    }
+    else
+    {
+        LiftCalls_clear(calls, floor);
+    }
+}
+
+/**
+ * @brief Returns the number of pending calls.
+ *
+ * @param[in] calls  Call bitset.
+ * @return Number of floors with a pending call.
+ */
+uint32_t LiftCalls_count(const LiftCalls_t* calls);
+
+/**
+ * @brief Compares two call bitsets.
+ *
+ * @param[in] a  First bitset.
+ * @param[in] b  Second bitset.
+ * @return Returns with true, if the same floors have pending calls.
+ */
+bool LiftCalls_equal(const LiftCalls_t* a, const LiftCalls_t* b);
+
+/**
+ * @brief Compares two lift states field by field.
+ *
+ * @param[in] a  First state.
+ * @param[in] b  Second state.
+ * @return Returns with true, if the floor, the door, the motion and the calls match.
+ */
+bool LiftState_equal(const LiftState_t* a, const LiftState_t* b);
+
+/**
+ * @brief Formats the calls of every floor as "0, 1, 0, ..." (the list of the step logs).
+ *
+ * @param[in]  calls  Call bitset.
+ * @param[out] text   Output buffer of at least LIFT_CALLS_TEXT_SIZE characters.
+ * @return Returns with @p text.
+ */
+const char* LiftCalls_format(const LiftCalls_t* calls, char* text);
+
+/**
+ * @brief Plant state with incrementally maintained condition inputs.
+ *
+ * Owns the call memory of a car and keeps its condition inputs up to date through
+ * O(1) hooks (call set, call reset, floor step, door change), so a step reads the
+ * cached inputs instead of rebuilding them with LiftStateArray_convert().
+ * Only the state must not be written directly; use the hooks or LiftInputs_init().
+ */
+typedef struct
+{
+    LiftState_t state;   // Plant state, including the call memory
+    CondSel_In in;       // Condition inputs of the state
+    uint16_t below;      // Pending calls below the floor
+    uint16_t above;      // Pending calls above the floor
+} LiftInputs_t;
+
+/**
+ * @brief Convert LiftState_t to CondSel_In structure.
+ *
+ * This function takes the current elevator state (floor, door, calls)
+ * and fills a CondSel_In structure used for evaluating logic conditions.
+ * The calls are tested a bitset word at a time, not floor by floor.
+ *
+ * @param[in]  state  Pointer to the current lift state.
+ * @param[out] out    Pointer to the output CondSel_In structure to be filled.
+ */
+void LiftStateArray_convert(const LiftState_t* state, CondSel_In* out);
+
+/**
+ * @brief Applies the outputs of one controller step to the lift state.
+ *
+ * The door follows the requested state instantly, a reset clears the call of the
+ * current floor and a move request moves the car by one floor.
+ *
+ * @param[in,out] state  Lift state to update.
+ * @param[in]     out    Outputs of the executed instruction.
+ */
+void LiftPlant_apply(LiftState_t* state, const SeqNet_Out* out);
+
+/**
+ * @brief Loads a plant state into an input tracker and derives its inputs.
+ *
+ * @param[out] inputs  Tracker to initialize.
+ * @param[in]  state   Plant state to load.
+ */
+void LiftInputs_init(LiftInputs_t* inputs, const LiftState_t* state);
+
+/**
+ * @brief Recounts the calls below and above the floor (O(LIFT_CALL_WORDS)).
+ *
+ * Used by the hooks when the car leaves the floor range.
+ *
+ * @param[in,out] inputs  Tracker to resynchronize.
+ */
+void LiftInputs_sync(LiftInputs_t* inputs);
+
+/**
+ * @brief Registers the call of a floor.
+ */
+static inline void LiftInputs_callSet(LiftInputs_t* inputs, uint16_t floor)
+{
+    if (LiftCalls_get(&inputs->state.calls, floor)) return;
+
+    LiftCalls_set(&inputs->state.calls, floor);
+    if (floor < inputs->state.floor)
+    {
+        inputs->below++;
+        inputs->in.call_pending_below = true;
+    }
+    else if (floor == inputs->state.floor)
+    {
+        inputs->in.call_pending_same = true;
+    }
+    else
+    {
+        inputs->above++;
+        inputs->in.call_pending_above = true;
+    }
+}
+
+/**
+ * @brief Withdraws the call of a floor (e.g. a hall call handed over to another car).
+ */
+static inline void LiftInputs_callClear(LiftInputs_t* inputs, uint16_t floor)
+{
+    if (!LiftCalls_get(&inputs->state.calls, floor)) return;
+
+    LiftCalls_clear(&inputs->state.calls, floor);
+    if (floor < inputs->state.floor)
+    {
+        inputs->below--;
+        inputs->in.call_pending_below = (inputs->below != 0);
+    }
+    else if (floor == inputs->state.floor)
+    {
+        inputs->in.call_pending_same = false;
+    }
+    else
+    {
+        inputs->above--;
+        inputs->in.call_pending_above = (inputs->above != 0);
+    }
+}
+
+/**
+ * @brief Clears the call of the current floor (the plant's response to req_reset).
+ */
+static inline void LiftInputs_callReset(LiftInputs_t* inputs)
+{
+    if (inputs->state.floor < LIFT_MAX_FLOORS)
+    {
+        LiftCalls_clear(&inputs->state.calls, inputs->state.floor);
+    }
+    inputs->in.call_pending_same = false;
+}
+
+/**
+ * @brief Moves the car one floor up.
+ */
+static inline void LiftInputs_floorUp(LiftInputs_t* inputs)
+{
+    const uint16_t floor = ++inputs->state.floor;
+    if ((floor == 0) || (floor >= LIFT_MAX_FLOORS))
+    {
+        LiftInputs_sync(inputs);
+        return;
+    }
+
+    // The call of the floor left is below now, the call of the floor reached is no longer above
+    inputs->below += inputs->in.call_pending_same;
+    const bool same = LiftCalls_get(&inputs->state.calls, floor);
+    inputs->above -= same;
+    inputs->in.call_pending_same = same;
+    inputs->in.call_pending_below = (inputs->below != 0);
+    inputs->in.call_pending_above = (inputs->above != 0);
+}
+
+/**
+ * @brief Moves the car one floor down.
+ */
+static inline void LiftInputs_floorDown(LiftInputs_t* inputs)
+{
+    const uint16_t floor = --inputs->state.floor;
+    if (floor >= LIFT_MAX_FLOORS - 1U)
+    {
+        LiftInputs_sync(inputs);
+        return;
+    }
+
+    // The call of the floor left is above now, the call of the floor reached is no longer below
+    inputs->above += inputs->in.call_pending_same;
+    const bool same = LiftCalls_get(&inputs->state.calls, floor);
+    inputs->below -= same;
+    inputs->in.call_pending_same = same;
+    inputs->in.call_pending_below = (inputs->below != 0);
+    inputs->in.call_pending_above = (inputs->above != 0);
+}
+
+/**
+ * @brief Opens or closes the door.
+ */
+static inline void LiftInputs_door(LiftInputs_t* inputs, bool open)
+{
+    inputs->state.is_door_open = open;
+    inputs->in.door_open = open;
+    inputs->in.door_closed = !open;
+}
+
+/**
+ * @brief Applies the outputs of one controller step through the hooks (@see LiftPlant_apply).
+ *
+ * @param[in,out] inputs  Tracker to update.
+ * @param[in]     out     Outputs of the executed instruction.
+ */
+void LiftInputs_apply(LiftInputs_t* inputs, const SeqNet_Out* out);
+
+#ifdef __cplusplus
+}
+#endif
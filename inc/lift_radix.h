@@ -0,0 +1,90 @@
+/**
+ * @file lift_radix.h
+ * @brief Radix heap: monotone priority queue of 64-bit event times.
+ *
+ * Keys pushed must not be smaller than the last popped key, which holds for the
+ * clock of a discrete-event simulation. Entries are spread over 65 buckets by the
+ * highest bit in which they differ from the last popped key; a pop only scans and
+ * redistributes one bucket, so every entry is moved at most 64 times over its life.
+ * Nodes live in caller-provided memory.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/// Number of buckets: one for the last key, one per differing bit
+#define LIFT_RADIX_BUCKETS              (65U)
+/// End of a node list
+#define LIFT_RADIX_NONE                 (0xFFFFFFFFUL)
+
+/**
+ * @brief Entry of the heap.
+ */
+typedef struct
+{
+    uint64_t key;     ///< Event time
+    uint32_t value;   ///< User data
+    uint32_t next;    ///< Next node of the bucket or of the free list
+} LiftRadixNode_t;
+
+/**
+ * @brief Radix heap.
+ */
+typedef struct
+{
+    LiftRadixNode_t* nodes;                 ///< Node pool of @p capacity nodes
+    uint32_t capacity;                      ///< Number of nodes
+    uint32_t free;                          ///< First free node
+    uint32_t count;                         ///< Number of entries
+    uint64_t last;                          ///< Last popped key (lower bound of every key)
+    uint64_t used;                          ///< Bit i set if bucket i + 1 is not empty
+    uint32_t heads[LIFT_RADIX_BUCKETS];     ///< First node of every bucket
+} LiftRadixHeap_t;
+
+/**
+ * @brief Initializes an empty heap.
+ *
+ * @param[out] heap      Heap to initialize.
+ * @param[in]  nodes     Node pool.
+ * @param[in]  capacity  Number of nodes in the pool.
+ */
+void LiftRadix_init(LiftRadixHeap_t* heap, LiftRadixNode_t* nodes, uint32_t capacity);
+
+/**
+ * @brief Inserts an entry.
+ *
+ * @param[in,out] heap   Heap.
+ * @param[in]     key    Key, not smaller than the last popped key.
+ * @param[in]     value  User data.
+ * @return Returns with false, if the node pool is exhausted.
+ */
+bool LiftRadix_push(LiftRadixHeap_t* heap, uint64_t key, uint32_t value);
+
+/**
+ * @brief Returns the smallest key without removing it.
+ *
+ * @param[in,out] heap  Heap (reorganized, the entries do not change).
+ * @param[out]    key   Smallest key.
+ * @return Returns with false, if the heap is empty.
+ */
+bool LiftRadix_top(LiftRadixHeap_t* heap, uint64_t* key);
+
+/**
+ * @brief Removes an entry with the smallest key (entries with equal keys pop in any order).
+ *
+ * @param[in,out] heap   Heap.
+ * @param[out]    key    Key of the entry.
+ * @param[out]    value  User data of the entry.
+ * @return Returns with false, if the heap is empty.
+ */
+bool LiftRadix_pop(LiftRadixHeap_t* heap, uint64_t* key, uint32_t* value);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file lift_random.h
+ * @brief Small deterministic random generators shared by the simulators, tools and tests.
+ *
+ * The generators are not cryptographic; they only make seeded runs reproducible.
+ * A xorshift state must never be 0, otherwise the stream stays 0.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * @brief Step of a 32-bit xorshift stream.
+ *
+ * @param[in,out] state  Generator state, non-zero.
+ * @return Returns with the new state.
+ */
+static inline uint32_t LiftRandom_next32(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Step of a 64-bit xorshift stream.
+ *
+ * @param[in,out] state  Generator state, non-zero.
+ * @return Returns with the new state.
+ */
+static inline uint64_t LiftRandom_next64(uint64_t* state)
+{
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Seed mixer (splitmix64), turns consecutive seeds into independent streams.
+ *
+ * @param[in] x  Seed.
+ * @return Returns with the mixed seed.
+ */
+static inline uint64_t LiftRandom_mix(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+#ifdef __cplusplus
+}
+#endif
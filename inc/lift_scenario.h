@@ -0,0 +1,211 @@
+/**
+ * @file lift_scenario.h
+ * @brief Scenario files (text and binary) and a streaming runner with bounded memory.
+ *
+ * A scenario is a test case (@see LiftTestCase_t) with optional timed call injections.
+ * The text form holds one scenario per line, '#' starts a comment:
+ *
+ *     # pc steps | floor door motion calls | floor door motion calls | tick:floor ...
+ *     0 10 | 0 closed idle 2 | 2 open idle - | 4:5 6:1
+ *
+ * Door is `open` or `closed`, motion is `idle` or `moving`, calls is a comma separated
+ * floor list or `-`. The first state is the initial one, the second the expected end
+ * state; the injection part is optional. A call is injected before the controller step
+ * of its tick, injections at or beyond the steps never arrive.
+ *
+ * The binary form is a 8-byte header (magic "LSCN", version, call bytes per state)
+ * followed by little-endian records:
+ *
+ *     steps u32, pc u8, flags u8, injections u16, initial floor u16, end floor u16,
+ *     initial calls, end calls (call bytes each), injections (tick u32, floor u16 each)
+ *
+ * Both forms are read and written one scenario at a time, so a file of any size is
+ * processed in the memory of one line or record (plus the batch of the runner).
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "seqnet.h"
+#include "lift_plant.h"
+
+/// Magic number of a binary scenario file ("LSCN")
+#define LIFT_SCENARIO_MAGIC             (0x4E43534CUL)
+/// Version of the binary scenario format
+#define LIFT_SCENARIO_VERSION           (1U)
+/// Size of the binary file header in bytes
+#define LIFT_SCENARIO_HEADER_SIZE       (8U)
+/// Most call injections of a scenario
+#define LIFT_SCENARIO_MAX_INJECTIONS    (64U)
+/// Longest text line, terminator included
+#define LIFT_SCENARIO_LINE_SIZE         (8192U)
+/// Call bytes per state written by this build
+#define LIFT_SCENARIO_CALL_BYTES        ((LIFT_MAX_FLOORS + 7U) / 8U)
+
+/**
+ * @brief Result of the scenario functions.
+ */
+typedef enum LiftScenarioStatus_t {
+    LIFT_SCENARIO_OK           = 0,  ///< Success
+    LIFT_SCENARIO_END          = 1,  ///< No more scenarios
+    LIFT_SCENARIO_IO_ERROR     = 2,  ///< The file cannot be read or written
+    LIFT_SCENARIO_BAD_MAGIC    = 3,  ///< Binary file with a wrong magic number
+    LIFT_SCENARIO_BAD_VERSION  = 4,  ///< Unsupported binary format version
+    LIFT_SCENARIO_TRUNCATED    = 5,  ///< The file ends inside a record
+    LIFT_SCENARIO_SYNTAX       = 6,  ///< Malformed line or record, a line too long or injections out of tick order
+    LIFT_SCENARIO_BAD_FLOOR    = 7,  ///< A floor or a call at or above LIFT_MAX_FLOORS
+    LIFT_SCENARIO_TOO_MANY     = 8   ///< More than LIFT_SCENARIO_MAX_INJECTIONS injections
+} LiftScenarioStatus_t;
+
+/**
+ * @brief Encodings of a scenario file.
+ */
+typedef enum LiftScenarioFormat_t {
+    LIFT_SCENARIO_TEXT   = 0,  ///< One scenario per line
+    LIFT_SCENARIO_BINARY = 1   ///< Compact little-endian records
+} LiftScenarioFormat_t;
+
+/**
+ * @brief Test case with timed call injections.
+ */
+typedef struct
+{
+    LiftState_t initial_state;                                  ///< Initial state of the lift
+    LiftState_t end_state;                                      ///< Expected end state
+    uint32_t steps;                                             ///< Controller steps
+    uint8_t PC_preset;                                          ///< Start PC
+    uint16_t injection_count;                                   ///< Number of injections
+    LiftCallInjection_t injections[LIFT_SCENARIO_MAX_INJECTIONS]; ///< Calls ordered by tick
+} LiftScenario_t;
+
+/**
+ * @brief Outcome of one scenario.
+ */
+typedef struct
+{
+    LiftState_t end_state;  ///< Simulated end state
+    uint8_t end_pc;         ///< Program counter after the last step
+    bool passed;            ///< End state equals the expected one
+} LiftScenarioResult_t;
+
+/**
+ * @brief Sequential reader of a scenario file.
+ */
+typedef struct
+{
+    FILE* in;                               ///< Input file, opened in binary mode
+    LiftScenarioFormat_t format;            ///< Detected format
+    uint16_t call_bytes;                    ///< Call bytes per state (binary)
+    uint32_t line;                          ///< Line of the last text scenario (1-based)
+    uint64_t index;                         ///< Scenarios read so far
+    char text[LIFT_SCENARIO_LINE_SIZE];     ///< Line buffer
+} LiftScenarioReader_t;
+
+/**
+ * @brief Sequential writer of a scenario file.
+ */
+typedef struct
+{
+    FILE* out;                      ///< Output file, opened in binary mode
+    LiftScenarioFormat_t format;    ///< Written format
+    uint64_t count;                 ///< Scenarios written so far
+    bool error;                     ///< A write failed
+} LiftScenarioWriter_t;
+
+/**
+ * @brief Outcome of a streaming run.
+ */
+typedef struct
+{
+    LiftScenarioStatus_t status;    ///< LIFT_SCENARIO_END if the whole file was run, the read error otherwise
+    uint64_t count;                 ///< Scenarios run
+    uint64_t passed;                ///< Scenarios ending in their expected state
+    uint64_t first_failed;          ///< Index of the first failing scenario, UINT64_MAX if none
+    uint32_t line;                  ///< Line of the read error (text)
+} LiftScenarioReport_t;
+
+/**
+ * @brief Starts reading a file, the format is detected from the first byte.
+ *
+ * @param[out] reader  Reader to initialize.
+ * @param[in]  in      Input file.
+ * @return Returns with LIFT_SCENARIO_OK or the reason of the failure.
+ */
+LiftScenarioStatus_t LiftScenarioReader_begin(LiftScenarioReader_t* reader, FILE* in);
+
+/**
+ * @brief Reads the next scenario.
+ *
+ * @param[in,out] reader    Reader of the file.
+ * @param[out]    scenario  Scenario read.
+ * @return Returns with LIFT_SCENARIO_OK, LIFT_SCENARIO_END or the reason of the failure.
+ */
+LiftScenarioStatus_t LiftScenarioReader_next(LiftScenarioReader_t* reader, LiftScenario_t* scenario);
+
+/**
+ * @brief Starts writing a file (the binary header, or a comment line describing the text columns).
+ *
+ * @param[out] writer  Writer to initialize.
+ * @param[in]  out     Output file.
+ * @param[in]  format  Encoding of the file.
+ * @return Returns with LIFT_SCENARIO_OK or LIFT_SCENARIO_IO_ERROR.
+ */
+LiftScenarioStatus_t LiftScenarioWriter_begin(LiftScenarioWriter_t* writer, FILE* out, LiftScenarioFormat_t format);
+
+/**
+ * @brief Appends a scenario.
+ *
+ * @param[in,out] writer    Writer of the file.
+ * @param[in]     scenario  Scenario to write.
+ * @return Returns with LIFT_SCENARIO_OK, LIFT_SCENARIO_TOO_MANY or LIFT_SCENARIO_IO_ERROR.
+ */
+LiftScenarioStatus_t LiftScenarioWriter_add(LiftScenarioWriter_t* writer, const LiftScenario_t* scenario);
+
+/**
+ * @brief Flushes the file (the file stays open).
+ *
+ * @param[in,out] writer  Writer of the file.
+ * @return Returns with LIFT_SCENARIO_OK or LIFT_SCENARIO_IO_ERROR.
+ */
+LiftScenarioStatus_t LiftScenarioWriter_end(LiftScenarioWriter_t* writer);
+
+/**
+ * @brief Runs one scenario on a program.
+ *
+ * @param[in]  scenario  Scenario to run.
+ * @param[in]  program   Decoded program.
+ * @param[out] result    Outcome of the scenario.
+ * @return Returns with result->passed.
+ */
+bool LiftScenario_run(const LiftScenario_t* scenario, const SeqNet_Program* program, LiftScenarioResult_t* result);
+
+/**
+ * @brief Streams a file through the program: reads a batch, runs it on the threads, repeats.
+ *
+ * @param[in,out] reader    Reader of the file.
+ * @param[in]     program   Decoded program.
+ * @param[out]    batch     Caller-provided scenario buffer.
+ * @param[in]     capacity  Scenarios of the buffer.
+ * @param[in]     threads   Number of worker threads (1..LIFT_THREAD_MAX).
+ * @param[out]    report    Outcome of the run.
+ * @return Returns with true, if the whole file was read and every scenario passed.
+ */
+bool LiftScenario_stream(LiftScenarioReader_t* reader, const SeqNet_Program* program, LiftScenario_t* batch,
+                         uint32_t capacity, uint32_t threads, LiftScenarioReport_t* report);
+
+/**
+ * @brief Returns the printable name of a status.
+ * @param[in] status  Status value.
+ * @return Constant name string.
+ */
+const char* LiftScenarioStatus_name(LiftScenarioStatus_t status);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file lift_search.h
+ * @brief Parallel genetic search of microprograms serving the calls in fewer steps.
+ *
+ * A population of program images is evolved with a (mu + lambda) scheme: every
+ * generation breeds children by tournament selection, one-point crossover and
+ * word-level mutations (jump address, condition, inversion, output bit, copied word),
+ * evaluates them in parallel and keeps the best of parents and children.
+ *
+ * A candidate is valid if it passes every scenario of the suite (@see LiftTestCase_t)
+ * and the random traffic of the fuzzer (@see LiftFuzz_run) without violating an
+ * invariant or leaving a call pending beyond the service bound. Evaluation stops at
+ * the first failing scenario. The fitness of a valid candidate is compared by the steps
+ * to service summed over the suite, then by the door cycles, then by the words used.
+ *
+ * Children are bred on the calling thread from the search seed and every evaluation
+ * is a pure function of the child, so the results do not depend on the number of
+ * threads. The search allocates nothing: the pool of candidates and the transition
+ * table of every worker are caller-provided.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "seqnet.h"
+#include "seqnet_table.h"
+#include "lift_fuzz.h"
+#include "test_lift.h"
+
+/// Largest pool of candidates (population + offspring)
+#define LIFT_SEARCH_MAX_POOL            (512U)
+
+/**
+ * @brief Fitness of a candidate, lower is better.
+ */
+typedef struct
+{
+    bool valid;             ///< Passed the suite and the traffic
+    uint32_t steps;         ///< Steps until the end state of every suite scenario is first reached, summed
+    uint32_t door_cycles;   ///< Door openings over the suite
+    uint16_t words;         ///< Distinct PCs executed over the suite
+} LiftSearchFitness_t;
+
+/**
+ * @brief Program image with its fitness.
+ */
+typedef struct
+{
+    SeqNet_Program program;         ///< Decoded program
+    LiftSearchFitness_t fitness;    ///< Fitness, valid after evaluation
+} LiftSearchCandidate_t;
+
+/**
+ * @brief Parameters of a search.
+ */
+typedef struct
+{
+    const LiftTestCase_t* cases;    ///< Scenario suite every candidate has to pass
+    uint32_t case_count;            ///< Number of scenarios
+    LiftFuzzConfig_t traffic;       ///< Random traffic (steps, service bound, arrivals, start PCs)
+    uint32_t traffic_count;         ///< Random scenarios every candidate has to pass
+    uint64_t traffic_seed;          ///< Seed of the first random scenario
+    uint16_t population;            ///< Candidates kept every generation
+    uint16_t offspring;             ///< Children bred every generation (population + offspring <= LIFT_SEARCH_MAX_POOL)
+    uint16_t length;                ///< Words the mutations may touch and jump to (1..SEQNET_PROGMEM_SIZE)
+    uint8_t mutations;              ///< Most mutations of a child (at least 1)
+    uint32_t threads;               ///< Number of worker threads (1..LIFT_THREAD_MAX)
+    uint64_t seed;                  ///< Seed of the breeding
+} LiftSearchConfig_t;
+
+/**
+ * @brief Caller-provided memory of a search.
+ */
+typedef struct
+{
+    LiftSearchCandidate_t* pool;    ///< population + offspring candidates
+    SeqNetTable_t* tables;          ///< One transition table per thread
+} LiftSearchWorkspace_t;
+
+/**
+ * @brief State of a search.
+ */
+typedef struct
+{
+    LiftSearchConfig_t config;                  ///< Parameters (copied)
+    LiftSearchWorkspace_t workspace;            ///< Memory (copied pointers)
+    uint16_t rank[LIFT_SEARCH_MAX_POOL];        ///< Pool slots from best to worst, the population first
+    uint64_t random;                            ///< Breeding generator state
+    uint32_t generation;                        ///< Generations done
+    uint64_t evaluated;                         ///< Candidates evaluated so far
+} LiftSearch_t;
+
+/**
+ * @brief Outcome of one generation.
+ */
+typedef struct
+{
+    uint32_t generation;            ///< Number of the generation (1-based)
+    LiftSearchFitness_t best;       ///< Fitness of the best candidate
+    uint32_t valid;                 ///< Valid candidates in the population
+    uint32_t bred;                  ///< Children bred
+    uint32_t duplicates;            ///< Children equal to a member of the population (not evaluated)
+    uint32_t rejected;              ///< Evaluated children failing the suite or the traffic
+    uint32_t accepted;              ///< Children that entered the population
+} LiftSearchReport_t;
+
+/**
+ * @brief Evaluates one candidate.
+ *
+ * @param[in]  config     Parameters of the search (suite and traffic).
+ * @param[in]  program    Decoded program.
+ * @param[out] table      Scratch transition table.
+ * @param[out] fitness    Fitness of the program.
+ * @return Returns with fitness->valid.
+ */
+bool LiftSearch_evaluate(const LiftSearchConfig_t* config, const SeqNet_Program* program,
+                         SeqNetTable_t* table, LiftSearchFitness_t* fitness);
+
+/**
+ * @brief Compares two fitness values.
+ * @return Returns with a negative value if @p a is better, positive if @p b is better, 0 if equal.
+ */
+int LiftSearchFitness_compare(const LiftSearchFitness_t* a, const LiftSearchFitness_t* b);
+
+/**
+ * @brief Starts a search from a seed program: the population is the seed and its mutants.
+ *
+ * @param[out] search     Search to initialize.
+ * @param[in]  config     Parameters (copied).
+ * @param[in]  workspace  Memory (copied pointers).
+ * @param[in]  seed       Decoded seed program.
+ */
+void LiftSearch_init(LiftSearch_t* search, const LiftSearchConfig_t* config,
+                     const LiftSearchWorkspace_t* workspace, const SeqNet_Program* seed);
+
+/**
+ * @brief Breeds, evaluates and selects one generation.
+ *
+ * @param[in,out] search  Search to advance.
+ * @param[out]    report  Outcome of the generation.
+ */
+void LiftSearch_generation(LiftSearch_t* search, LiftSearchReport_t* report);
+
+/**
+ * @brief Returns the best candidate of the population.
+ * @param[in] search  Search.
+ * @return Pointer into the pool, valid until the next generation.
+ */
+const LiftSearchCandidate_t* LiftSearch_best(const LiftSearch_t* search);
+
+#ifdef __cplusplus
+}
+#endif
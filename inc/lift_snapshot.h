@@ -0,0 +1,92 @@
+/**
+ * @file lift_snapshot.h
+ * @brief Snapshots of a running simulation: controller PC, program identity and plant state.
+ *
+ * A snapshot is a small plain-data blob that can be copied, stored or sent as is.
+ * Restoring it is O(1), so a sweep can simulate a shared prefix once, snapshot it
+ * (e.g. when a new call arrives) and explore any number of futures from there,
+ * instead of replaying the prefix from SeqNet_init() for every branch.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "seqnet.h"
+#include "lift_plant.h"
+
+/// Door open flag of a snapshot
+#define LIFT_SNAPSHOT_DOOR_OPEN         (0x01U)
+/// Moving flag of a snapshot
+#define LIFT_SNAPSHOT_MOVING            (0x02U)
+
+/**
+ * @brief Snapshot of one controller and its plant, 8 bytes plus the call bitset.
+ */
+typedef struct
+{
+    uint32_t program_id;  ///< Identity of the executed program (@see SeqNet_Program)
+    uint16_t floor;       ///< Current floor
+    uint8_t pc;           ///< Program counter
+    uint8_t flags;        ///< LIFT_SNAPSHOT_* flags
+    LiftCalls_t calls;    ///< Pending calls
+} LiftSnapshot_t;
+
+/**
+ * @brief Captures a controller context and its plant.
+ *
+ * @param[out] snapshot  Snapshot to fill.
+ * @param[in]  ctx       Controller context.
+ * @param[in]  state     Plant state.
+ */
+void LiftSnapshot_take(LiftSnapshot_t* snapshot, const SeqNet_Ctx* ctx, const LiftState_t* state);
+
+/**
+ * @brief Restores a controller context and its plant from a snapshot.
+ *
+ * The context keeps its program, which must be the one the snapshot was taken on.
+ *
+ * @param[in]  snapshot  Snapshot to restore.
+ * @param[out] ctx       Controller context executing the snapshot's program.
+ * @param[out] state     Plant state.
+ * @return Returns with false (and changes nothing), if the context executes another program.
+ */
+bool LiftSnapshot_restore(const LiftSnapshot_t* snapshot, SeqNet_Ctx* ctx, LiftState_t* state);
+
+/**
+ * @brief Captures the global controller and a plant.
+ *
+ * @param[out] snapshot  Snapshot to fill.
+ * @param[in]  state     Plant state.
+ */
+void LiftSnapshot_takeGlobal(LiftSnapshot_t* snapshot, const LiftState_t* state);
+
+/**
+ * @brief Restores the global controller and a plant from a snapshot.
+ *
+ * @param[in]  snapshot  Snapshot to restore.
+ * @param[out] state     Plant state.
+ * @return Returns with false (and changes nothing), if the program memory holds another program.
+ */
+bool LiftSnapshot_restoreGlobal(const LiftSnapshot_t* snapshot, LiftState_t* state);
+
+/**
+ * @brief Forks @p count independent copies of a snapshot for batch exploration.
+ *
+ * @param[in]  snapshot  Snapshot to fork.
+ * @param[in]  program   Program the snapshot was taken on.
+ * @param[out] ctxs      Array of @p count contexts to initialize.
+ * @param[out] states    Array of @p count plant states.
+ * @param[in]  count     Number of copies.
+ * @return Returns with the number of copies made (0 if the program does not match).
+ */
+uint32_t LiftSnapshot_fork(const LiftSnapshot_t* snapshot, const SeqNet_Program* program,
+                           SeqNet_Ctx* ctxs, LiftState_t* states, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,75 @@
+/**
+ * @file lift_thread.h
+ * @brief Minimal thread shim over Win32 threads and POSIX threads.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/// Maximum number of worker threads used by the emulator tools
+#define LIFT_THREAD_MAX                 (64U)
+
+/**
+ * @brief Entry function of a thread.
+ * @param[in] arg  Argument passed to LiftThread_start().
+ */
+typedef void (*LiftThread_Fn)(void* arg);
+
+/**
+ * @brief Thread handle.
+ */
+typedef struct
+{
+#if defined(_WIN32)
+    HANDLE handle;      ///< Win32 thread handle
+#else
+    pthread_t handle;   ///< POSIX thread handle
+#endif
+    LiftThread_Fn fn;   ///< Entry function
+    void* arg;          ///< Argument of the entry function
+} LiftThread_t;
+
+/**
+ * @brief Starts a thread.
+ *
+ * @param[out] thread  Thread handle, must stay valid until LiftThread_join().
+ * @param[in]  fn      Entry function.
+ * @param[in]  arg     Argument of the entry function.
+ * @return Returns with true, if the thread was started.
+ */
+bool LiftThread_start(LiftThread_t* thread, LiftThread_Fn fn, void* arg);
+
+/**
+ * @brief Waits for a thread to finish.
+ * @param[in,out] thread  Thread started by LiftThread_start().
+ */
+void LiftThread_join(LiftThread_t* thread);
+
+/**
+ * @brief Runs @p fn on @p count threads (the calling thread is one of them) and waits for all.
+ *
+ * Falls back to running the remaining workers on the calling thread if a thread
+ * cannot be started, so the work is always completed.
+ *
+ * @param[in] fn      Entry function.
+ * @param[in] args    Base of the argument array.
+ * @param[in] stride  Size of one argument in bytes, 0 passes the same argument to every worker.
+ * @param[in] count   Number of workers (at most LIFT_THREAD_MAX).
+ */
+void LiftThread_runAll(LiftThread_Fn fn, void* args, uint32_t stride, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
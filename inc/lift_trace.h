@@ -0,0 +1,167 @@
+/**
+ * @file lift_trace.h
+ * @brief Binary step trace recorder with a fixed-size ring buffer.
+ *
+ * Every controller step is stored as one 8-byte record: the PC before and after the
+ * step, the packed condition inputs, the packed output word and the change of the
+ * plant state (floor step, door and moving toggles, call bits flipped). A keyframe
+ * record holding the absolute plant state starts every run, so the records between
+ * two keyframes can be expanded into full states offline. Records carry the calls of
+ * floors 0..7; in taller buildings every change above them adds a call record.
+ *
+ * Records are collected in caller-provided memory. With a sink file the buffer is
+ * written out in one sequential write whenever it fills up (and on LiftTrace_flush()),
+ * without a sink it keeps the most recent records as a flight recorder.
+ * LiftTrace_decode() turns a trace file back into the step log text of the lift tests.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "condsel.h"
+#include "lift_plant.h"
+
+/// Magic number of a trace file ("LTRC")
+#define LIFT_TRACE_MAGIC                (0x4352544CUL)
+/// Version of the trace file format
+#define LIFT_TRACE_VERSION              (2U)
+/// Floors whose calls fit into a step or keyframe record
+#define LIFT_TRACE_RECORD_FLOORS        (8U)
+
+/**
+ * @brief Record kinds.
+ */
+typedef enum LiftTraceKind_t {
+    LIFT_TRACE_KIND_STEP  = 0,  ///< One controller step
+    LIFT_TRACE_KIND_STATE = 1,  ///< Keyframe: absolute plant state and PC, restarts the step count
+    LIFT_TRACE_KIND_CALL  = 2   ///< Flips the call of a floor above LIFT_TRACE_RECORD_FLOORS (since version 2)
+} LiftTraceKind_t;
+
+/// Floor delta field of a step record
+#define LIFT_TRACE_FLOOR_UP             (0x01U)
+#define LIFT_TRACE_FLOOR_DOWN           (0x02U)
+/// Toggles of a step record
+#define LIFT_TRACE_DOOR_TOGGLE          (0x04U)
+#define LIFT_TRACE_MOVING_TOGGLE        (0x08U)
+/// Absolute flags of a keyframe record
+#define LIFT_TRACE_DOOR_OPEN            (0x04U)
+#define LIFT_TRACE_MOVING               (0x08U)
+
+/**
+ * @brief Trace record, 8 bytes.
+ *
+ * Step record: @p a and @p b are the PC before and after the step, @p calls the call
+ * bits flipped by the step and @p flags the floor delta and toggles.
+ * Keyframe record: @p a is the PC, @p b and @p mask the low and high byte of the floor,
+ * @p calls the call bits and @p flags the absolute door and moving flags.
+ * Call record: @p out_word is the floor whose call flips. Call records follow the step
+ * or keyframe record they belong to.
+ */
+typedef struct
+{
+    uint8_t kind;       ///< LiftTraceKind_t
+    uint8_t a;          ///< PC before the step / PC of the keyframe
+    uint8_t b;          ///< PC after the step / floor of the keyframe (low byte)
+    uint8_t mask;       ///< Packed condition inputs of the step (@see CondSel_Mask) / floor of the keyframe (high byte)
+    uint16_t out_word;  ///< Packed outputs of the step / floor of the call record
+    uint8_t calls;      ///< Flipped call bits / absolute call bits of floors 0..7
+    uint8_t flags;      ///< LIFT_TRACE_* flags
+} LiftTraceRecord_t;
+
+/**
+ * @brief Header of a trace file.
+ */
+typedef struct
+{
+    uint32_t magic;         ///< LIFT_TRACE_MAGIC
+    uint16_t version;       ///< LIFT_TRACE_VERSION
+    uint16_t record_size;   ///< sizeof(LiftTraceRecord_t)
+    uint32_t floors;        ///< Number of call bits per record
+    uint32_t reserved;      ///< Zero
+} LiftTraceHeader_t;
+
+/**
+ * @brief Trace recorder.
+ */
+typedef struct
+{
+    LiftTraceRecord_t* records;  ///< Ring buffer of @p capacity records
+    uint32_t capacity;           ///< Number of records, power of two
+    FILE* sink;                  ///< Output file, NULL keeps the latest records only
+    uint64_t written;            ///< Records recorded so far
+    uint64_t flushed;            ///< Records written to the sink (or overwritten without a sink)
+    uint16_t floor;              ///< Floor after the last record
+    LiftCalls_t calls;           ///< Calls after the last record
+    uint8_t flags;               ///< Door and moving flags after the last record
+    bool error;                  ///< A write to the sink failed
+} LiftTrace_t;
+
+/**
+ * @brief Initializes a recorder and writes the file header to the sink.
+ *
+ * @param[out] trace     Recorder to initialize.
+ * @param[in]  buffer    Ring buffer of @p capacity records.
+ * @param[in]  capacity  Number of records, power of two.
+ * @param[in]  sink      Binary output file, NULL for an in-memory flight recorder.
+ */
+void LiftTrace_init(LiftTrace_t* trace, LiftTraceRecord_t* buffer, uint32_t capacity, FILE* sink);
+
+/**
+ * @brief Records a keyframe: starts a new run from an absolute state.
+ *
+ * @param[in,out] trace  Recorder.
+ * @param[in]     pc     Program counter at the start of the run.
+ * @param[in]     state  Plant state at the start of the run.
+ */
+void LiftTrace_begin(LiftTrace_t* trace, uint8_t pc, const LiftState_t* state);
+
+/**
+ * @brief Records one controller step.
+ *
+ * @param[in,out] trace     Recorder.
+ * @param[in]     pc_pre    Program counter before the step.
+ * @param[in]     pc_post   Program counter after the step.
+ * @param[in]     mask      Packed condition inputs of the step.
+ * @param[in]     out_word  Packed outputs of the step.
+ * @param[in]     state     Plant state after the step.
+ */
+void LiftTrace_step(LiftTrace_t* trace, uint8_t pc_pre, uint8_t pc_post, CondSel_Mask mask,
+                    uint16_t out_word, const LiftState_t* state);
+
+/**
+ * @brief Writes the pending records to the sink.
+ *
+ * @param[in,out] trace  Recorder.
+ * @return Returns with false, if a write failed (now or earlier).
+ */
+bool LiftTrace_flush(LiftTrace_t* trace);
+
+/**
+ * @brief Returns the number of records still held by the buffer (unflushed or latest).
+ *
+ * @param[in] trace  Recorder.
+ * @return Number of records in the buffer.
+ */
+uint32_t LiftTrace_pending(const LiftTrace_t* trace);
+
+/**
+ * @brief Decodes a trace file into the step log text of the lift tests.
+ *
+ * Every keyframe prints an "INT:" line, every step a "Step NN:" line with the plant
+ * state before the step, exactly as LiftTestCase_run() prints it with its debug log.
+ *
+ * @param[in] in   Binary trace file, positioned at its header.
+ * @param[in] out  Text output.
+ * @return Returns with false on a malformed or truncated file.
+ */
+bool LiftTrace_decode(FILE* in, FILE* out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file lift_traffic.h
+ * @brief Discrete-event building traffic simulation of one car.
+ *
+ * Passengers arrive on every origin floor as independent Poisson streams whose next
+ * arrival times are kept in a radix heap. An arrival registers a hall call in the
+ * car's call memory; when the controller resets the call of a floor, the passengers
+ * riding to it alight and the ones waiting there board and register their
+ * destinations. The controller is stepped only while something can change: when it
+ * is parked and the plant is at rest, the clock jumps to the next arrival, so long
+ * quiet periods (nights, weekends) cost nothing.
+ *
+ * One tick is one controller step; @p ticks_per_hour maps ticks to building time.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "seqnet.h"
+#include "lift_plant.h"
+#include "lift_radix.h"
+
+/// Buckets of the waiting time histogram (bucket i: 2^(i-1) <= wait < 2^i ticks, bucket 0: no wait)
+#define LIFT_TRAFFIC_HISTOGRAM          (32U)
+
+/**
+ * @brief Traffic profiles: where passengers come from and go to.
+ */
+typedef enum LiftTrafficProfile_t {
+    LIFT_TRAFFIC_UNIFORM     = 0,  ///< Any floor to any other floor
+    LIFT_TRAFFIC_UP_PEAK     = 1,  ///< From the lobby (floor 0) to the upper floors
+    LIFT_TRAFFIC_DOWN_PEAK   = 2,  ///< From the upper floors to the lobby
+    LIFT_TRAFFIC_INTER_FLOOR = 3   ///< Between the upper floors only
+} LiftTrafficProfile_t;
+
+/**
+ * @brief Parameters of a traffic simulation.
+ */
+typedef struct
+{
+    LiftTrafficProfile_t profile;   ///< Origin and destination distribution
+    uint16_t floors;                ///< Served floors (2..LIFT_MAX_FLOORS; 3.. for inter-floor traffic)
+    double arrivals_per_hour;       ///< Mean arrivals in the whole building per hour
+    uint32_t ticks_per_hour;        ///< Controller steps per hour of building time
+    uint64_t duration;              ///< Simulated ticks
+    uint64_t seed;                  ///< Seed of the arrival streams
+    bool tick_by_tick;              ///< Reference mode: step every tick, never jump the clock
+} LiftTrafficConfig_t;
+
+/**
+ * @brief Passenger record (internal, in the workspace).
+ */
+typedef struct
+{
+    uint64_t arrival;      ///< Arrival tick
+    uint16_t destination;  ///< Destination floor
+    uint32_t next;         ///< Next passenger of the same list
+} LiftTrafficPassenger_t;
+
+/**
+ * @brief Caller-provided memory of a simulation.
+ */
+typedef struct
+{
+    LiftRadixNode_t* events;             ///< Event nodes, at least one per floor
+    uint32_t event_capacity;             ///< Number of event nodes
+    LiftTrafficPassenger_t* passengers;  ///< Passengers waiting or riding at the same time
+    uint32_t passenger_capacity;         ///< Number of passenger records
+    uint32_t* lists;                     ///< 2 * floors list heads: waiting and riding passengers per floor
+} LiftTrafficWorkspace_t;
+
+/**
+ * @brief Service quality of a simulation (times in ticks).
+ */
+typedef struct
+{
+    uint64_t ticks;                               ///< Simulated ticks
+    uint64_t steps;                               ///< Controller steps executed
+    uint64_t arrived;                             ///< Passengers arrived
+    uint64_t dropped;                             ///< Arrivals lost because the passenger records ran out
+    uint64_t boarded;                             ///< Passengers picked up
+    uint64_t delivered;                           ///< Passengers delivered
+    uint64_t wait_sum;                            ///< Sum of the waiting times (arrival to boarding)
+    uint64_t wait_max;                            ///< Longest waiting time
+    uint64_t journey_sum;                         ///< Sum of the journey times (arrival to delivery)
+    uint64_t journey_max;                         ///< Longest journey time
+    uint64_t wait_histogram[LIFT_TRAFFIC_HISTOGRAM];  ///< Waiting times, log2 buckets
+    double mean_wait;                             ///< Mean waiting time
+    double mean_journey;                          ///< Mean journey time
+    double throughput_per_hour;                   ///< Passengers delivered per hour of building time
+} LiftTrafficReport_t;
+
+/**
+ * @brief Simulates the traffic of a building served by one car.
+ *
+ * The car starts idle on floor 0 with its door closed, at PC 0.
+ *
+ * @param[in]  program    Decoded program of the controller.
+ * @param[in]  config     Parameters of the simulation.
+ * @param[in]  workspace  Memory of the event queue and the passengers.
+ * @param[out] report     Service quality.
+ */
+void LiftTraffic_run(const SeqNet_Program* program, const LiftTrafficConfig_t* config,
+                     const LiftTrafficWorkspace_t* workspace, LiftTrafficReport_t* report);
+
+/**
+ * @brief Returns a waiting time below which a share of the passengers waited (from the histogram).
+ *
+ * @param[in] report   Report of a simulation.
+ * @param[in] percent  Share of the passengers (0..100).
+ * @return Upper bound of the histogram bucket reaching @p percent.
+ */
+uint64_t LiftTraffic_waitPercentile(const LiftTrafficReport_t* report, uint32_t percent);
+
+#ifdef __cplusplus
+}
+#endif
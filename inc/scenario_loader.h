@@ -10,6 +10,8 @@
 extern "C" {
 #endif
 
+#include "seqnet.h"
+
 /**
  * @brief Loads the default instruction set into program memory.
  * 
@@ -18,6 +20,13 @@ extern "C" {
  */
 void ScenarioDefaultProgram_load(void);
 
+/**
+ * @brief Returns the assembly source of the default program (@see SeqNetAsm_assemble).
+ *
+ * @return Constant NUL-terminated source text.
+ */
+const char* ScenarioDefaultProgram_source(void);
+
 /**
  * @brief Prints the program memory contents in a structured and readable format.
  * 
@@ -25,6 +34,16 @@ void ScenarioDefaultProgram_load(void);
  */
 void ScenarioProgram_print(void);
 
+/**
+ * @brief Prints the program memory listing annotated with an execution profile.
+ *
+ * Every PC shows its hit count, its share of all steps and its taken / not taken
+ * jump counts, followed by the evaluation count of every condition selector.
+ *
+ * @param[in] profile  Counters collected while running the program (@see SeqNet_ctxProfile).
+ */
+void ScenarioProgramProfile_print(const SeqNet_Profile* profile);
+
 #ifdef __cplusplus
 }
 #endif
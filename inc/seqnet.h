@@ -29,6 +29,13 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "condsel.h"
+
+/** Number of words in a program memory image. */
+#define SEQNET_PROGMEM_SIZE 255
+
+/** Number of PCs a jump can reach: the program memory and the trap row at 255 (@see SEQNET_TRAP_WORD). */
+#define SEQNET_PC_COUNT (SEQNET_PROGMEM_SIZE + 1)
 
 typedef struct {
 	bool cond_inv;        /* Condition value inversion */
@@ -40,6 +47,55 @@ typedef struct {
 	uint8_t jump_addr;    /* Address to jump if condition result is active */
 } SeqNet_Out;
 
+/** Output groups watched by SeqNet_runUntil(), as bits of the instruction word. */
+#define SEQNET_WATCH_MOVE   (0x0300U)  /* bits 8..9: move up / move down */
+#define SEQNET_WATCH_DOOR   (0x0400U)  /* bit 10: target door state */
+#define SEQNET_WATCH_RESET  (0x0800U)  /* bit 11: call reset */
+#define SEQNET_WATCH_ALL    (SEQNET_WATCH_MOVE | SEQNET_WATCH_DOOR | SEQNET_WATCH_RESET)
+
+/** Program memory image together with its predecoded instruction table. */
+typedef struct {
+	uint16_t words[SEQNET_PROGMEM_SIZE];     /* Encoded 16-bit instructions */
+	SeqNet_Out decoded[SEQNET_PC_COUNT];     /* Predecoded instructions and the trap row, valid after SeqNetProgram_decode() */
+	uint32_t id;                             /* Identity of the image (hash of the words), set by SeqNetProgram_decode() */
+} SeqNet_Program;
+
+/** Wait loop of a controller: a cycle of instructions holding the same outputs on fixed inputs. */
+typedef struct {
+	uint8_t pc;            /* PC where the loop was detected */
+	uint8_t length;        /* Loop length in micro-steps */
+	uint16_t out_word;     /* Packed outputs held by every instruction of the loop */
+	CondSel_Mask depends;  /* Inputs read by the loop, a change of any of them ends it */
+	CondSel_Mask mask;     /* Inputs the loop was detected on */
+} SeqNet_Park;
+
+/** Compile-time switch of the execution profiler (@see SeqNet_ctxProfile).
+  * With 0 the counting is compiled out of the interpreter, an attached profile stays untouched.
+  * The layout of SeqNet_Ctx does not depend on it, so objects built either way link together.
+  */
+#ifndef SEQNET_PROFILE_ENABLED
+#define SEQNET_PROFILE_ENABLED 0
+#endif
+
+/** Number of condition selector indexes (3-bit field). */
+#define SEQNET_SELECTOR_COUNT 8
+
+/** Execution profile of a controller: where the steps of a program go. */
+typedef struct {
+	uint64_t hits[SEQNET_PC_COUNT];          /* Executions of each PC */
+	uint64_t taken[SEQNET_PC_COUNT];         /* Executions of each PC that took the jump */
+	uint64_t selector[SEQNET_SELECTOR_COUNT]; /* Condition evaluations per selector index */
+} SeqNet_Profile;
+
+/** Execution context of one controller instance.
+  * The program is only referenced, so any number of contexts can share one image.
+  */
+typedef struct {
+	const SeqNet_Program* program; /* Predecoded program to execute */
+	uint8_t pc;                    /* Program counter */
+	SeqNet_Profile* profile;       /* Counters updated by every step (SEQNET_PROFILE_ENABLED builds), NULL if not profiled */
+} SeqNet_Ctx;
+
 /** Initializes the sequential network internal state.
   * Note: needs to be called only once at startup
   */
@@ -51,6 +107,120 @@ SEQNET_API void SeqNet_init(void);
   */
 SEQNET_API SeqNet_Out SeqNet_loop(const bool condition_active); 
 
+/** Fetches the current instruction, evaluates its condition and steps to the next state in one pass.
+  * @param[in] in  Condition selector inputs of the current state.
+  * @return Returns with the new instruction values (@see SeqNet_Out).
+  */
+SEQNET_API SeqNet_Out SeqNet_step(const CondSel_In* in);
+
+/** Same as SeqNet_step(), but returns the packed 16-bit instruction word.
+  * @param[in] in  Condition selector inputs of the current state.
+  * @return Returns with the encoded instruction (see bit-fields above).
+  */
+SEQNET_API uint16_t SeqNet_stepRaw(const CondSel_In* in);
+
+/** Executes instructions until the watched outputs change or an input-dependent branch is reached.
+  * The plant is assumed to respond to an output only through the related inputs: the door request
+  * through the door inputs, the reset through the pending calls and a movement through the pending
+  * calls as well. A branch reading none of the inputs touched since @p in was sampled is executed
+  * on @p in, so the plant needs to be updated only once per call. A movement or call reset request
+  * always ends the run, watched or not, since every such step is a plant event.
+  * @param[in]  in         Condition selector inputs of the current state.
+  * @param[in]  watch      Watched output groups (SEQNET_WATCH_*).
+  * @param[in]  max_steps  Maximum number of instructions to execute (at least 1).
+  * @param[out] out        Outputs of the last executed instruction.
+  * @return Returns with the number of executed instructions (micro-steps).
+  */
+SEQNET_API uint32_t SeqNet_runUntil(const CondSel_In* in, const uint16_t watch, const uint32_t max_steps, SeqNet_Out* out);
+
+/** Detects whether the global controller waits in a loop on the given inputs (@see SeqNet_ctxPark).
+  * @param[in]  in    Condition selector inputs of the current state.
+  * @param[out] park  Description of the detected loop.
+  * @return Returns with true, if the controller is parked.
+  */
+SEQNET_API bool SeqNet_park(const CondSel_In* in, SeqNet_Park* park);
+
+/** Attaches a profile to the global controller (@see SeqNet_ctxProfile).
+  * @param[in] profile  Counters to update, NULL detaches.
+  */
+SEQNET_API void SeqNet_profile(SeqNet_Profile* profile);
+
+/** Clears every counter of a profile.
+  * @param[out] profile  Profile to clear.
+  */
+SEQNET_API void SeqNetProfile_reset(SeqNet_Profile* profile);
+
+/** Rebuilds the predecoded instruction table and the identity of a program.
+  * Note: needs to be called after every write to the program words
+  * @param[in,out] program  Program to decode.
+  */
+SEQNET_API void SeqNetProgram_decode(SeqNet_Program* program);
+
+/** Initializes a controller context.
+  * @param[out] ctx      Context to initialize.
+  * @param[in]  program  Decoded program executed by the context.
+  */
+SEQNET_API void SeqNet_ctxInit(SeqNet_Ctx* ctx, const SeqNet_Program* program);
+
+/** Steps the given controller context to the next state.
+  * @param[in,out] ctx               Context to step.
+  * @param[in]     condition_active  True, if the selected condition value is active (or inactive if inversion is activate)
+  * @return Returns with the new instruction values (@see SeqNet_Out).
+  */
+SEQNET_API SeqNet_Out SeqNet_ctxLoop(SeqNet_Ctx* ctx, const bool condition_active);
+
+/** Fused fetch, condition evaluation and step of the given controller context.
+  * @param[in,out] ctx  Context to step.
+  * @param[in]     in   Condition selector inputs of the current state.
+  * @return Returns with the new instruction values (@see SeqNet_Out).
+  */
+SEQNET_API SeqNet_Out SeqNet_ctxStep(SeqNet_Ctx* ctx, const CondSel_In* in);
+
+/** Same as SeqNet_ctxStep(), but returns the packed 16-bit instruction word.
+  * @param[in,out] ctx  Context to step.
+  * @param[in]     in   Condition selector inputs of the current state.
+  * @return Returns with the encoded instruction (see bit-fields above).
+  */
+SEQNET_API uint16_t SeqNet_ctxStepRaw(SeqNet_Ctx* ctx, const CondSel_In* in);
+
+/** Macro-step of the given controller context (@see SeqNet_runUntil).
+  * @param[in,out] ctx        Context to step.
+  * @param[in]     in         Condition selector inputs of the current state.
+  * @param[in]     watch      Watched output groups (SEQNET_WATCH_*).
+  * @param[in]     max_steps  Maximum number of instructions to execute (at least 1).
+  * @param[out]    out        Outputs of the last executed instruction.
+  * @return Returns with the number of executed instructions (micro-steps).
+  */
+SEQNET_API uint32_t SeqNet_ctxRunUntil(SeqNet_Ctx* ctx, const CondSel_In* in, const uint16_t watch, const uint32_t max_steps, SeqNet_Out* out);
+
+/** Detects whether a controller context waits in a loop on the given inputs.
+  * The context is parked, if stepping it on fixed inputs returns to the current PC while every
+  * instruction on the way holds the same outputs without requesting a movement. Until one of the
+  * inputs in park->depends changes, the controller only cycles through the loop.
+  * @param[in]  ctx   Context to inspect (not modified).
+  * @param[in]  in    Condition selector inputs of the current state.
+  * @param[out] park  Description of the detected loop.
+  * @return Returns with true, if the context is parked.
+  */
+SEQNET_API bool SeqNet_ctxPark(const SeqNet_Ctx* ctx, const CondSel_In* in, SeqNet_Park* park);
+
+/** Advances a parked context by the given number of micro-steps in one jump.
+  * @param[in,out] ctx    Parked context (@see SeqNet_ctxPark).
+  * @param[in]     park   Loop the context is parked in.
+  * @param[in]     ticks  Number of micro-steps to skip.
+  */
+SEQNET_API void SeqNet_ctxFastForward(SeqNet_Ctx* ctx, const SeqNet_Park* park, const uint64_t ticks);
+
+/** Attaches a profile to a controller context.
+  * Every step of the interpreter (loop, step, macro-step and fast-forward) counts the executed PC,
+  * whether its jump was taken and the evaluated selector. The profile is not cleared, so it
+  * accumulates over runs and may be shared by contexts of the same thread.
+  * Note: the counters are only updated in builds with SEQNET_PROFILE_ENABLED=1
+  * @param[in,out] ctx      Context to profile.
+  * @param[in]     profile  Counters to update, NULL detaches.
+  */
+SEQNET_API void SeqNet_ctxProfile(SeqNet_Ctx* ctx, SeqNet_Profile* profile);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,87 @@
+/**
+ * @file seqnet_aot.h
+ * @brief Ahead-of-time compiler from a program memory image to specialized C.
+ *
+ * SeqNetAot_generate() translates a program into a C source file that executes it
+ * without decoding: one `case` per PC for the single-step engines and one label per PC
+ * with direct `goto`s for the multi-step engine. Conditions with a constant selector
+ * (reserved / constant false) are folded into unconditional jumps or fall-throughs.
+ *
+ * The generated file defines the SeqNetAot_ctx* functions declared below, which are
+ * drop-in replacements of SeqNet_ctxLoop() / SeqNet_ctxStep() for the compiled program
+ * (the program reference of the context is ignored). It is built by `make aot`.
+ *
+ * The engine replaces the context form of SeqNet_loop() (same signature as
+ * SeqNet_ctxLoop()) instead of the global SeqNet_loop() symbol itself: the global
+ * wrapper keeps interpreting ProgMem, which the unit tests rewrite at runtime, and the
+ * AOT build links both engines to verify one against the other.
+ *
+ * Jump address 255 has no word in the program memory; the generated engine executes
+ * the trap word there (@see SEQNET_TRAP_WORD) and stays at PC 255.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "condsel.h"
+#include "seqnet.h"
+
+/**
+ * @brief Plant callback of the multi-step engine.
+ *
+ * Called after every executed instruction: applies its outputs to the plant
+ * and refreshes the condition inputs for the next instruction.
+ *
+ * @param[in]     user  User data passed to SeqNetAot_ctxRun().
+ * @param[in]     out   Outputs of the executed instruction.
+ * @param[in,out] in    Condition inputs, to be updated for the next instruction.
+ */
+typedef void (*SeqNetAot_Plant)(void* user, const SeqNet_Out* out, CondSel_In* in);
+
+/**
+ * @brief Writes the specialized C engine of a program.
+ *
+ * @param[in] file     Output stream of the generated source.
+ * @param[in] program  Decoded program to compile.
+ * @param[in] name     Name of the program, recorded in the generated header comment.
+ * @return Returns with true on success, false on an output error.
+ */
+bool SeqNetAot_generate(FILE* file, const SeqNet_Program* program, const char* name);
+
+// === Functions defined by the generated engine ===
+
+/**
+ * @brief Compiled equivalent of SeqNet_ctxLoop().
+ * @param[in,out] ctx               Context to step (only the PC is used).
+ * @param[in]     condition_active  True, if the selected condition value is active.
+ * @return Returns with the outputs of the executed instruction.
+ */
+SeqNet_Out SeqNetAot_ctxLoop(SeqNet_Ctx* ctx, const bool condition_active);
+
+/**
+ * @brief Compiled equivalent of SeqNet_ctxStep().
+ * @param[in,out] ctx  Context to step (only the PC is used).
+ * @param[in]     in   Condition selector inputs of the current state.
+ * @return Returns with the outputs of the executed instruction.
+ */
+SeqNet_Out SeqNetAot_ctxStep(SeqNet_Ctx* ctx, const CondSel_In* in);
+
+/**
+ * @brief Executes @p steps instructions, threading the PCs with direct gotos.
+ * @param[in,out] ctx    Context to step (only the PC is used).
+ * @param[in,out] in     Condition inputs of the current state, updated by the plant.
+ * @param[in]     steps  Number of instructions to execute.
+ * @param[in]     plant  Plant callback invoked after every instruction.
+ * @param[in]     user   User data of the plant callback.
+ */
+void SeqNetAot_ctxRun(SeqNet_Ctx* ctx, CondSel_In* in, uint32_t steps, SeqNetAot_Plant plant, void* user);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file seqnet_asm.h
+ * @brief Assembly language of the microprograms: assembler, disassembler and optimizer.
+ *
+ * One instruction per line, labels instead of hard-coded jump addresses:
+ *
+ *     ; full-line comment
+ *     idle:     open        goto dispatch if pend_any    ; comment of the instruction
+ *               open        goto idle
+ *     move_up:  close up    goto wait_up
+ *     wait_up:  close       goto move_up unless pend_same
+ *
+ * Outputs: `open` or `close` (door, default close), `up`, `down`, `reset`.
+ * Jump: `goto <label|pc>` alone is unconditional, `if <cond>` jumps when the condition
+ * is active, `unless <cond>` when it is inactive; without a jump the next PC follows.
+ * Conditions: pend_any, pend_below, pend_same, pend_above, door_closed, door_opened,
+ * reserved, false. Every encodable word (jump address below SEQNET_PROGMEM_SIZE) has a
+ * text form, so disassembling and assembling again returns the same words.
+ *
+ * The optimizer removes micro-steps that only repeat outputs (stuttering): it threads
+ * jumps past words that neither move nor reset and whose outputs equal the ones of the
+ * word before or after them, drops the words no entry point reaches any more and lays
+ * the rest out in chains so that the likelier successor of a branch falls through.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "seqnet.h"
+#include "test_lift.h"
+
+/// Size of a label, terminator included
+#define SEQNET_ASM_NAME_SIZE        (32U)
+/// Size of an instruction comment, terminator included
+#define SEQNET_ASM_COMMENT_SIZE     (96U)
+/// PC of a word dropped by the optimizer (@see SeqNetAsmReport_t.map)
+#define SEQNET_ASM_PC_NONE          (0xFFU)
+
+/**
+ * @brief Result of the assembler and the optimizer.
+ */
+typedef enum SeqNetAsmStatus_t {
+    SEQNET_ASM_OK              = 0,  ///< Success
+    SEQNET_ASM_SYNTAX          = 1,  ///< Unknown keyword, malformed operand or conflicting door outputs
+    SEQNET_ASM_UNKNOWN_LABEL   = 2,  ///< Jump to an undefined label
+    SEQNET_ASM_DUPLICATE_LABEL = 3,  ///< Label defined twice, or a second label of one instruction
+    SEQNET_ASM_BAD_TARGET      = 4,  ///< Jump outside the program memory
+    SEQNET_ASM_TOO_LONG        = 5   ///< More than SEQNET_PROGMEM_SIZE words, or a label / comment too long
+} SeqNetAsmStatus_t;
+
+/**
+ * @brief Program with its labels and comments.
+ */
+typedef struct {
+    uint16_t words[SEQNET_PROGMEM_SIZE];                           ///< Encoded instructions, zero beyond count
+    uint16_t count;                                                ///< Number of instructions
+    char symbols[SEQNET_PROGMEM_SIZE][SEQNET_ASM_NAME_SIZE];       ///< Label of every PC, empty if none
+    char comments[SEQNET_PROGMEM_SIZE][SEQNET_ASM_COMMENT_SIZE];   ///< Comment of every PC, empty if none
+} SeqNetAsmProgram_t;
+
+/**
+ * @brief Outcome of an optimization.
+ */
+typedef struct {
+    uint16_t words_before;                ///< Instructions of the source program
+    uint16_t words_after;                 ///< Instructions of the optimized program
+    uint16_t threaded;                    ///< Jumps and fall-throughs retargeted past a redundant word
+    uint16_t removed;                     ///< Source words no entry point reaches any more
+    uint16_t inverted;                    ///< Branches inverted so that the chosen successor falls through
+    uint16_t trampolines;                 ///< Jumps inserted where neither successor could fall through
+    uint8_t map[SEQNET_PROGMEM_SIZE];     ///< New PC of every source PC, SEQNET_ASM_PC_NONE if dropped
+} SeqNetAsmReport_t;
+
+/**
+ * @brief Wraps raw words into a program without labels and comments.
+ *
+ * @param[out] program  Program to fill.
+ * @param[in]  words    Instruction words.
+ * @param[in]  count    Number of words (at most SEQNET_PROGMEM_SIZE).
+ */
+void SeqNetAsmProgram_init(SeqNetAsmProgram_t* program, const uint16_t* words, uint16_t count);
+
+/**
+ * @brief Assembles a source text.
+ *
+ * @param[in]  source   NUL-terminated source text.
+ * @param[out] program  Assembled words, labels and comments.
+ * @param[out] line     Line of the first error (1-based), 0 on success.
+ * @return Returns with SEQNET_ASM_OK or the reason of the failure.
+ */
+SeqNetAsmStatus_t SeqNetAsm_assemble(const char* source, SeqNetAsmProgram_t* program, uint32_t* line);
+
+/**
+ * @brief Writes the source text of a program.
+ *
+ * Jump targets without a label get a generated one ("L<pc>"), unless the program
+ * already uses that name, then the PC is written.
+ *
+ * @param[in] program  Program to list.
+ * @param[in] out      Text output.
+ * @return Returns with false if the output failed.
+ */
+bool SeqNetAsm_disassemble(const SeqNetAsmProgram_t* program, FILE* out);
+
+/**
+ * @brief Optimizes a program (@see the file description for the transformations).
+ *
+ * PC 0 stays the reset entry. Words that are only entered directly (e.g. a preset PC of
+ * a test case) are kept if listed in @p entries; report->map translates such PCs.
+ * The result serves the same output sequence up to repeated outputs, every movement
+ * and call reset of the source is kept.
+ *
+ * @param[in]  source       Program to optimize.
+ * @param[in]  entries      Additional entry PCs, or NULL.
+ * @param[in]  entry_count  Number of additional entry PCs.
+ * @param[in]  profile      Execution profile of the source choosing the hot successor of
+ *                          every branch, or NULL to keep the source fall-throughs.
+ * @param[out] target       Optimized program (must not be @p source).
+ * @param[out] report       Statistics and PC map of the optimization.
+ * @return Returns with SEQNET_ASM_OK, SEQNET_ASM_BAD_TARGET (entry outside the memory)
+ *         or SEQNET_ASM_TOO_LONG (the layout needs more than SEQNET_PROGMEM_SIZE words).
+ */
+SeqNetAsmStatus_t SeqNetAsm_optimize(const SeqNetAsmProgram_t* source, const uint8_t* entries, uint16_t entry_count,
+                                     const SeqNet_Profile* profile, SeqNetAsmProgram_t* target, SeqNetAsmReport_t* report);
+
+/**
+ * @brief Measures how soon a program serves a scenario suite, the figure the optimizer improves.
+ *
+ * Every case runs from its entry PC until the plant first reaches the end state of the
+ * case, its step budget is not applied. A case that never gets there within
+ * LIFT_TEST_MAX_STEPS counts LIFT_TEST_MAX_STEPS + 1 micro-steps.
+ *
+ * @param[in]     program  Decoded program.
+ * @param[in]     cases    Scenario suite.
+ * @param[in]     entries  Entry PC of every case (e.g. mapped by report->map), or NULL for the PC presets.
+ * @param[in]     count    Number of cases.
+ * @param[in,out] profile  Profile the executed words are added to (a source for SeqNetAsm_optimize()), or NULL.
+ * @param[out]    steps    Micro-steps of every case, or NULL.
+ * @return Returns with the micro-steps summed over the suite.
+ */
+uint32_t SeqNetAsm_measure(const SeqNet_Program* program, const LiftTestCase_t* const* cases, const uint8_t* entries,
+                           uint16_t count, SeqNet_Profile* profile, uint32_t* steps);
+
+/**
+ * @brief Returns the printable name of a status.
+ * @param[in] status  Status value.
+ * @return Constant name string.
+ */
+const char* SeqNetAsmStatus_name(SeqNetAsmStatus_t status);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file seqnet_batch.h
+ * @brief Structure-of-arrays engine stepping many controllers that share one program.
+ *
+ * Every car of a batch owns one slot in the caller-provided arrays: its PC, its packed
+ * condition inputs (@see CondSel_Mask) and its last packed output word. One call to
+ * SeqNetBatch_step() advances all cars by one instruction, which is equivalent to
+ * calling SeqNet_ctxStepRaw() for each of them.
+ *
+ * The step kernel is selected at runtime: AVX2 (8 cars, gather + blend), SSE4.1
+ * (4 cars, blend) or a portable scalar loop. No memory is allocated by the engine.
+ *
+ * The table has a row for every 8-bit PC: a car jumping to 255, past the program
+ * memory, executes the trap word there and halts (@see SEQNET_TRAP_WORD).
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "condsel.h"
+#include "seqnet.h"
+
+/// Rows of the batch table: the program memory and the trap row at PC 255
+#define SEQNET_BATCH_TABLE_SIZE  (SEQNET_PROGMEM_SIZE + 1U)
+
+/**
+ * @brief Step kernels of the batch engine.
+ */
+typedef enum SeqNetBatchKernel_t {
+    SEQNET_BATCH_KERNEL_AUTO   = 0,  ///< Best kernel supported by the running CPU
+    SEQNET_BATCH_KERNEL_SCALAR = 1,  ///< Portable scalar loop
+    SEQNET_BATCH_KERNEL_SSE41  = 2,  ///< SSE4.1, 4 cars per iteration
+    SEQNET_BATCH_KERNEL_AVX2   = 3   ///< AVX2, 8 cars per iteration
+} SeqNetBatchKernel_t;
+
+/**
+ * @brief Batch of controllers executing the same program.
+ */
+typedef struct {
+    uint32_t table[SEQNET_BATCH_TABLE_SIZE]; ///< Widened instructions: word | (1 << cond_sel) << 16
+    uint8_t* pc;                             ///< [count] program counters
+    const CondSel_Mask* in;                  ///< [count] packed condition inputs
+    uint16_t* out;                           ///< [count] packed output words of the last step
+    uint32_t count;                          ///< Number of cars
+    SeqNetBatchKernel_t kernel;              ///< Resolved step kernel (never AUTO)
+} SeqNetBatch_t;
+
+/**
+ * @brief Initializes a batch over caller-owned arrays and selects the best kernel.
+ *
+ * The program is copied into the batch table, later writes to it need a new init.
+ *
+ * @param[out] batch    Batch to initialize.
+ * @param[in]  program  Program executed by every car.
+ * @param[in]  pc       Array of @p count program counters.
+ * @param[in]  in       Array of @p count packed condition inputs.
+ * @param[in]  out      Array of @p count output words.
+ * @param[in]  count    Number of cars.
+ */
+void SeqNetBatch_init(SeqNetBatch_t* batch, const SeqNet_Program* program,
+                      uint8_t* pc, const CondSel_Mask* in, uint16_t* out, uint32_t count);
+
+/**
+ * @brief Selects the step kernel of a batch.
+ *
+ * Kernels not supported by the running CPU fall back to the next best one.
+ *
+ * @param[in,out] batch      Batch to configure.
+ * @param[in]     requested  Requested kernel (AUTO selects the best available).
+ * @return Returns with the kernel actually selected.
+ */
+SeqNetBatchKernel_t SeqNetBatch_select(SeqNetBatch_t* batch, SeqNetBatchKernel_t requested);
+
+/**
+ * @brief Advances every car of the batch by one instruction.
+ *
+ * Reads `in[i]`, writes `out[i]` and updates `pc[i]` for each car.
+ *
+ * @param[in,out] batch  Batch to step.
+ */
+void SeqNetBatch_step(SeqNetBatch_t* batch);
+
+/**
+ * @brief Returns the printable name of a kernel.
+ * @param[in] kernel  Kernel identifier.
+ * @return Constant name string.
+ */
+const char* SeqNetBatchKernel_name(SeqNetBatchKernel_t kernel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,205 @@
+/**
+ * @file seqnet_image.h
+ * @brief Versioned, checksummed binary program images and a memory-mapped loader.
+ *
+ * An image file is a container of one or more program images, so a program search can
+ * keep thousands of candidates in one file. All fields are little-endian and every
+ * block starts at a multiple of 4 bytes:
+ *
+ *     file header      magic "SQIM", version, image count, CRC-32 of the directory
+ *     directory        one entry per image: offset, size, program id, CRC-32 of the image
+ *     image blocks     image header, instruction words, optional sections
+ *
+ * A section is a list of NUL-terminated texts attached to PCs (symbols, comments).
+ * Opening a file maps it and checks the header and the directory only, each image is
+ * checked when it is loaded, without copying or parsing anything else.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "seqnet.h"
+
+/// Magic number of an image file ("SQIM")
+#define SEQNET_IMAGE_MAGIC              (0x4D495153UL)
+/// Version of the image file format
+#define SEQNET_IMAGE_VERSION            (1U)
+/// Size of the file header in bytes
+#define SEQNET_IMAGE_HEADER_SIZE        (16U)
+/// Size of a directory entry in bytes
+#define SEQNET_IMAGE_ENTRY_SIZE         (16U)
+/// Size of an image header in bytes
+#define SEQNET_IMAGE_BLOCK_HEADER_SIZE  (8U)
+
+/**
+ * @brief Result of the image functions.
+ */
+typedef enum SeqNetImageStatus_t {
+    SEQNET_IMAGE_OK           = 0,  ///< Success
+    SEQNET_IMAGE_IO_ERROR     = 1,  ///< The file cannot be opened, mapped or written
+    SEQNET_IMAGE_BAD_MAGIC    = 2,  ///< Not an image file
+    SEQNET_IMAGE_BAD_VERSION  = 3,  ///< Unsupported format version
+    SEQNET_IMAGE_TRUNCATED    = 4,  ///< A block lies outside the file or the image
+    SEQNET_IMAGE_BAD_CHECKSUM = 5,  ///< The directory or an image is corrupted
+    SEQNET_IMAGE_BAD_PROGRAM  = 6,  ///< Too many words, a jump outside the program memory or a text over 255 characters
+    SEQNET_IMAGE_FULL         = 7,  ///< The writer's directory is full
+    SEQNET_IMAGE_NO_IMAGE     = 8   ///< Image index out of range
+} SeqNetImageStatus_t;
+
+/**
+ * @brief Section kinds.
+ */
+typedef enum SeqNetImageSection_t {
+    SEQNET_IMAGE_SECTION_SYMBOLS  = 1,  ///< Label of a PC
+    SEQNET_IMAGE_SECTION_COMMENTS = 2   ///< Comment of a PC
+} SeqNetImageSection_t;
+
+/**
+ * @brief Opened image file (mapped or borrowed memory).
+ */
+typedef struct {
+    const uint8_t* data;    ///< File contents
+    size_t size;            ///< File size in bytes
+    uint32_t count;         ///< Number of images
+    void* mapping;          ///< Platform mapping handle, NULL for borrowed memory
+} SeqNetImageFile_t;
+
+/**
+ * @brief View of one image inside an opened file, valid while the file is open.
+ */
+typedef struct {
+    uint32_t id;                ///< Program id stored in the directory (@see SeqNet_Program.id)
+    uint16_t word_count;        ///< Number of instruction words
+    const uint8_t* words;       ///< Little-endian instruction words
+    const uint8_t* symbols;     ///< Symbol section records, NULL if absent
+    uint32_t symbols_size;      ///< Size of the symbol section
+    const uint8_t* comments;    ///< Comment section records, NULL if absent
+    uint32_t comments_size;     ///< Size of the comment section
+} SeqNetImage_t;
+
+/**
+ * @brief Writer of an image file; the directory is reserved up front.
+ */
+typedef struct {
+    FILE* out;              ///< Seekable output file
+    uint8_t* directory;     ///< Caller-provided directory, capacity * SEQNET_IMAGE_ENTRY_SIZE bytes
+    uint32_t capacity;      ///< Maximum number of images
+    uint32_t count;         ///< Images written so far
+    uint32_t offset;        ///< File offset of the next image
+    bool error;             ///< A write failed
+} SeqNetImageWriter_t;
+
+/**
+ * @brief Starts an image file, reserving the directory of @p capacity images.
+ *
+ * @param[out] writer     Writer to initialize.
+ * @param[in]  out        Output file, opened in binary mode and seekable.
+ * @param[in]  directory  Directory memory of capacity * SEQNET_IMAGE_ENTRY_SIZE bytes.
+ * @param[in]  capacity   Maximum number of images.
+ * @return Returns with SEQNET_IMAGE_OK or SEQNET_IMAGE_IO_ERROR.
+ */
+SeqNetImageStatus_t SeqNetImageWriter_begin(SeqNetImageWriter_t* writer, FILE* out, uint8_t* directory, uint32_t capacity);
+
+/**
+ * @brief Appends a program image.
+ *
+ * @param[in,out] writer    Writer of the file.
+ * @param[in]     words     Instruction words.
+ * @param[in]     count     Number of words (at most SEQNET_PROGMEM_SIZE).
+ * @param[in]     symbols   Label of every PC (@p count entries, NULL entries are skipped), or NULL.
+ * @param[in]     comments  Comment of every PC (@p count entries, NULL entries are skipped), or NULL.
+ * @return Returns with SEQNET_IMAGE_OK, SEQNET_IMAGE_FULL, SEQNET_IMAGE_BAD_PROGRAM or SEQNET_IMAGE_IO_ERROR.
+ */
+SeqNetImageStatus_t SeqNetImageWriter_add(SeqNetImageWriter_t* writer, const uint16_t* words, uint16_t count,
+                                          const char* const* symbols, const char* const* comments);
+
+/**
+ * @brief Writes the file header and the directory.
+ *
+ * @param[in,out] writer  Writer of the file (the file stays open).
+ * @return Returns with SEQNET_IMAGE_OK or SEQNET_IMAGE_IO_ERROR.
+ */
+SeqNetImageStatus_t SeqNetImageWriter_end(SeqNetImageWriter_t* writer);
+
+/**
+ * @brief Memory-maps an image file and checks its header and directory.
+ *
+ * @param[out] file  Opened file.
+ * @param[in]  path  Path of the file.
+ * @return Returns with SEQNET_IMAGE_OK or the reason of the failure (nothing stays mapped).
+ */
+SeqNetImageStatus_t SeqNetImageFile_open(SeqNetImageFile_t* file, const char* path);
+
+/**
+ * @brief Opens an image file already in memory (the memory is borrowed, not copied).
+ *
+ * @param[out] file  Opened file.
+ * @param[in]  data  File contents.
+ * @param[in]  size  Size of the contents.
+ * @return Returns with SEQNET_IMAGE_OK or the reason of the failure.
+ */
+SeqNetImageStatus_t SeqNetImageFile_openMemory(SeqNetImageFile_t* file, const void* data, size_t size);
+
+/**
+ * @brief Unmaps a file opened by SeqNetImageFile_open() (no-op for borrowed memory).
+ *
+ * @param[in,out] file  File to close.
+ */
+void SeqNetImageFile_close(SeqNetImageFile_t* file);
+
+/**
+ * @brief Checks an image and returns a view of it.
+ *
+ * @param[in]  file   Opened file.
+ * @param[in]  index  Index of the image.
+ * @param[out] image  View of the image.
+ * @return Returns with SEQNET_IMAGE_OK or the reason of the failure.
+ */
+SeqNetImageStatus_t SeqNetImage_get(const SeqNetImageFile_t* file, uint32_t index, SeqNetImage_t* image);
+
+/**
+ * @brief Checks an image and loads it into a program (the remaining words are zero).
+ *
+ * @param[in]  file     Opened file.
+ * @param[in]  index    Index of the image.
+ * @param[out] program  Decoded program.
+ * @return Returns with SEQNET_IMAGE_OK or the reason of the failure.
+ */
+SeqNetImageStatus_t SeqNetImage_load(const SeqNetImageFile_t* file, uint32_t index, SeqNet_Program* program);
+
+/**
+ * @brief Checks an image and loads it into the internal program memory (@see ScenarioDefaultProgram_load).
+ *
+ * @param[in] file   Opened file.
+ * @param[in] index  Index of the image.
+ * @return Returns with SEQNET_IMAGE_OK or the reason of the failure (the memory is unchanged).
+ */
+SeqNetImageStatus_t SeqNetImage_install(const SeqNetImageFile_t* file, uint32_t index);
+
+/**
+ * @brief Returns the text attached to a PC in a section.
+ *
+ * @param[in] section  Section records (SeqNetImage_t.symbols or .comments).
+ * @param[in] size     Section size.
+ * @param[in] pc       Program counter.
+ * @return Returns with the NUL-terminated text, or NULL if the PC has none.
+ */
+const char* SeqNetImage_text(const uint8_t* section, uint32_t size, uint8_t pc);
+
+/**
+ * @brief Returns the printable name of a status.
+ * @param[in] status  Status value.
+ * @return Constant name string.
+ */
+const char* SeqNetImageStatus_name(SeqNetImageStatus_t status);
+
+#ifdef __cplusplus
+}
+#endif
@@ -43,12 +43,42 @@ typedef enum DoorRequest_t {
     DOOR_REQ_OPEN    = 1         ///< Need to open the door
 } DoorRequest_t;
 
+/**
+ * @brief Word of the trap row at PC 255, just past the program memory.
+ *
+ * A jump address of 255 is encodable but has no word behind it. Engines keeping a
+ * 256-row table execute this word there: no outputs and an unconditional jump to
+ * itself (inverted fixed 0), so a controller jumping out of the program halts.
+ */
+#define SEQNET_TRAP_WORD  (0xF0FFU)
+
 /**
  * @brief Returns a pointer to the internal program memory array.
- * @return Pointer to ProgMem (256-element array of uint16_t).
+ *
+ * The caller may write through the pointer, so the predecoded table is invalidated.
+ *
+ * @return Pointer to ProgMem (SEQNET_PROGMEM_SIZE-element array of uint16_t).
  */
 uint16_t* SeqNetProgramMemory_get(void);
 
+/**
+ * @brief Marks the predecoded table of the internal program memory as stale.
+ *
+ * Needs to be called after writing through a previously obtained ProgMem pointer.
+ */
+void SeqNetProgramMemory_invalidate(void);
+
+/**
+ * @brief Rebuilds the predecoded table of the internal program memory.
+ */
+void SeqNetProgramMemory_decode(void);
+
+/**
+ * @brief Returns the internal program with an up-to-date predecoded table.
+ * @return Pointer to the internal program (read-only).
+ */
+const SeqNet_Program* SeqNetProgram_get(void);
+
 /**
  * @brief Returns the current Program Counter value.
  * @return Current PC value (0–255).
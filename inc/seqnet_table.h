@@ -0,0 +1,81 @@
+/**
+ * @file seqnet_table.h
+ * @brief Precomputed transition table of a program: (PC, input mask) -> next PC and outputs.
+ *
+ * With SEQNET_PROGMEM_SIZE PCs and five condition inputs the controller is a finite
+ * transition function. The table stores it explicitly (about 8 KiB of next PCs plus
+ * the output word of every PC), so a step is two loads: no decode and no condition
+ * selector evaluation. The table is plain data and may be inspected by analysis tools.
+ *
+ * The table has a row for every 8-bit PC: row 255, past the program memory, is the
+ * trap word (@see SEQNET_TRAP_WORD), so a jump to 255 halts there instead of reading
+ * past the table.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "condsel.h"
+#include "seqnet.h"
+
+/// Rows of a transition table: the program memory and the trap row at PC 255
+#define SEQNET_TABLE_ROWS  (SEQNET_PROGMEM_SIZE + 1U)
+
+/**
+ * @brief Transition table of one program.
+ */
+typedef struct {
+    uint8_t next[SEQNET_TABLE_ROWS][CONDSEL_MASK_COUNT]; ///< Next PC of each (PC, CondSel_Mask)
+    uint16_t out[SEQNET_TABLE_ROWS];                     ///< Packed output word of each PC
+} SeqNetTable_t;
+
+/**
+ * @brief Builds the transition table of a program.
+ *
+ * @param[out] table    Table to fill.
+ * @param[in]  program  Decoded program.
+ */
+void SeqNetTable_build(SeqNetTable_t* table, const SeqNet_Program* program);
+
+/**
+ * @brief Returns the set of inputs the next PC of an instruction depends on.
+ *
+ * An input bit belongs to the set if flipping it changes the next PC for some mask.
+ *
+ * @param[in] table  Transition table.
+ * @param[in] pc     Program counter of the instruction.
+ * @return Returns with the mask of relevant inputs (0 for unconditional instructions).
+ */
+CondSel_Mask SeqNetTable_dependency(const SeqNetTable_t* table, uint8_t pc);
+
+/**
+ * @brief Prints the transitions of the first @p count PCs.
+ *
+ * @param[in] table  Transition table.
+ * @param[in] count  Number of PCs to print.
+ */
+void SeqNetTable_print(const SeqNetTable_t* table, uint8_t count);
+
+/**
+ * @brief Table-driven step: equivalent of SeqNet_ctxStepRaw() for the tabulated program.
+ *
+ * @param[in]     table  Transition table.
+ * @param[in,out] pc     Program counter, replaced by the next one.
+ * @param[in]     mask   Packed condition inputs of the current state.
+ * @return Returns with the packed output word of the executed instruction.
+ */
+static inline uint16_t SeqNetTable_step(const SeqNetTable_t* table, uint8_t* pc, CondSel_Mask mask)
+{
+    const uint16_t out = table->out[*pc];
+    *pc = table->next[*pc][mask & CONDSEL_MASK_ALL];
+    return out;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -11,22 +11,13 @@ extern "C" {
 #include <stdint.h>
 #include "condsel.h"
 #include "seqnet.h"
+#include "lift_plant.h"
+#include "lift_trace.h"
 
 /// Maximum number of floors (adjust if needed)
-#define LIFT_TEST_MAX_FLOORS            (6U)
+#define LIFT_TEST_MAX_FLOORS            LIFT_MAX_FLOORS
 #define LIFT_TEST_MAX_STEPS             (200U)
 
-/**
- * @brief A single step in a test scenario for the lift controller.
- */
-typedef struct
-{
-    uint8_t floor; // Current floor
-    bool is_door_open; // Is the door open?
-    bool is_moving; // Is the lift moving?
-    bool calls[LIFT_TEST_MAX_FLOORS]; // Calls from other floors
-} LiftState_t;
-
 /**
  * @brief Test case step structure.
  */
@@ -40,15 +31,14 @@ typedef struct
 
 
 /**
- * @brief Convert LiftState_t to CondSel_In structure.
- *
- * This function takes the current elevator state (floor, door, calls)
- * and fills a CondSel_In structure used for evaluating logic conditions.
- *
- * @param[in]  state  Pointer to the current lift state.
- * @param[out] out    Pointer to the output CondSel_In structure to be filled.
+ * @brief Outcome of one silently executed test case.
  */
-void LiftStateArray_convert(const LiftState_t* state, CondSel_In* out);
+typedef struct
+{
+    LiftState_t end_state; // Simulated end state
+    uint8_t end_pc; // Program counter after the last step
+    bool passed; // End state equals the expected one
+} LiftTestResult_t;
 
 /**
  * @brief Compares two LiftState_t structures and prints differences if any.
@@ -66,6 +56,56 @@ bool LiftState_compare(const LiftState_t* a, const LiftState_t* b);
  */
 void LiftTestCase_run(const LiftTestCase_t* test, const char* name);
 
+/**
+ * @brief Simulates a test case silently on its own controller context.
+ *
+ * Thread-safe: only @p result is written, the program is read only.
+ *
+ * @param[in]  test     Test case to simulate.
+ * @param[in]  program  Decoded program of the controller.
+ * @param[out] result   Outcome of the case.
+ * @return true if the end state equals the expected one.
+ */
+bool LiftTestCase_exec(const LiftTestCase_t* test, const SeqNet_Program* program, LiftTestResult_t* result);
+
+/**
+ * @brief Same as LiftTestCase_exec(), recording every step into a binary trace.
+ *
+ * @param[in]     test     Test case to simulate.
+ * @param[in]     program  Decoded program of the controller.
+ * @param[out]    result   Outcome of the case.
+ * @param[in,out] trace    Recorder (NULL disables tracing).
+ * @return true if the end state equals the expected one.
+ */
+bool LiftTestCase_execTraced(const LiftTestCase_t* test, const SeqNet_Program* program, LiftTestResult_t* result,
+                             LiftTrace_t* trace);
+
+/**
+ * @brief Attaches a binary trace recorder to LiftTestCase_run().
+ *
+ * Every run starts with a keyframe and records each step, the text of the debug log
+ * can be reproduced offline with LiftTrace_decode().
+ *
+ * @param[in] trace  Recorder, NULL detaches.
+ */
+void LiftTestTrace_attach(LiftTrace_t* trace);
+
+/**
+ * @brief Executes test cases on a pool of worker threads.
+ *
+ * Workers claim chunks of cases dynamically and write the outcome of case i into
+ * results[i], so the results are in case order regardless of the scheduling.
+ *
+ * @param[in]  tests    Array of @p count test cases.
+ * @param[in]  count    Number of test cases.
+ * @param[in]  program  Decoded program of the controller.
+ * @param[out] results  Array of @p count results.
+ * @param[in]  threads  Number of worker threads (1..LIFT_THREAD_MAX).
+ * @return Number of passed cases.
+ */
+uint32_t LiftTestCases_runParallel(const LiftTestCase_t* tests, uint32_t count, const SeqNet_Program* program,
+                                   LiftTestResult_t* results, uint32_t threads);
+
 // Extern declarations for test cases
 extern const LiftTestCase_t test_case_open_door_same_floor;
 extern const LiftTestCase_t test_case_already_open;
@@ -89,6 +129,17 @@ extern const LiftTestCase_t test_case_down_two_floors;
  */
 void LiftTestAll_run(void);
 
+/**
+ * @brief Runs all tests with SeqNet_runUntil() macro-steps and checks that the
+ *        end states equal the single-step simulation.
+ */
+void LiftTestAllMacro_run(void);
+
+/**
+ * @brief Runs all tests on the parallel runner and checks it against serial execution.
+ */
+void LiftTestAllParallel_run(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_check.h
+ * @brief Public test entry point for the model checker.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Checks the loaded program and seeded faulty variants of it with the model checker.
+ */
+void LiftCheckAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_event.h
+ * @brief Public test entry point for the event-driven simulation.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Verifies the event-driven simulation against the tick-driven one on the loaded program.
+ */
+void LiftEventAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_fuzz.h
+ * @brief Public test entry point for the scenario fuzzer.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fuzzes the loaded program and checks that failures replay from their seed.
+ */
+void LiftFuzzAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
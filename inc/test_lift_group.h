@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_group.h
+ * @brief Public test entry point for the group dispatcher.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Checks call assignment, pluggable costs and a simulated bank of cars.
+ */
+void LiftGroupAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
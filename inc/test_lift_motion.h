@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_motion.h
+ * @brief Public test entry point for the continuous-time plant.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Cross-checks the integration kernels, the trip limits and the service order of the continuous-time plant.
+ */
+void LiftMotionAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
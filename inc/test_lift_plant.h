@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_plant.h
+ * @brief Public test entry point for the lift plant and its call bitset.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Compares the bitset condition inputs with a floor by floor scan on random states.
+ */
+void LiftPlantAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_scenario.h
+ * @brief Public test entry point for the scenario files and the streaming runner.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Writes, reads and streams scenario files.
+ */
+void LiftScenarioAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
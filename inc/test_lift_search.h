@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_search.h
+ * @brief Public test entry point for the genetic microprogram search.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Evaluates candidates and evolves the default program.
+ */
+void LiftSearchAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
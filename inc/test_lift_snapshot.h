@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_snapshot.h
+ * @brief Public test entry point for the emulator snapshots.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Checks that restored and forked snapshots continue exactly like an uninterrupted run.
+ */
+void LiftSnapshotAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_trace.h
+ * @brief Public test entry point for the binary trace recorder.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Records the lift test cases, decodes the trace and compares it with the text step log.
+ */
+void LiftTraceAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file test_lift_traffic.h
+ * @brief Public test entry point for the traffic simulator.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Checks the radix heap and the traffic simulation against its tick-by-tick reference.
+ */
+void LiftTrafficAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,21 @@
+/**
+ * @file test_seqnet_aot.h
+ * @brief Public test entry point for the generated (ahead-of-time compiled) engine.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Verifies the generated engine of the default program against the interpreter.
+ *
+ * Only available in builds linking the generated engine (SEQNET_AOT_ENABLED, `make aot`).
+ */
+void SeqNetAotAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
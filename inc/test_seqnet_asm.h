@@ -0,0 +1,19 @@
+/**
+ * @file test_seqnet_asm.h
+ * @brief Public test entry point for the microprogram assembler and optimizer.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Assembles, lists and optimizes microprograms.
+ */
+void SeqNetAsmAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
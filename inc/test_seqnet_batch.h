@@ -0,0 +1,19 @@
+/**
+ * @file test_seqnet_batch.h
+ * @brief Public test entry point for the batch stepping engine.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Cross-checks every available batch kernel against SeqNet_ctxStepRaw().
+ */
+void SeqNetBatchAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file test_seqnet_image.h
+ * @brief Public test entry point for the binary program images.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Round-trips program images through mapped files and checks the corruption detection.
+ */
+void SeqNetImageAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
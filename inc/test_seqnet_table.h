@@ -0,0 +1,19 @@
+/**
+ * @file test_seqnet_table.h
+ * @brief Public test entry point for the transition table module.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Verifies the table-driven step against the interpreter for every PC and input mask.
+ */
+void SeqNetTableAllCases_test(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -89,3 +89,128 @@ bool CondSel_calc(const bool invert, const uint8_t index, const CondSel_In value
 
     return result;
 }
+
+/**
+ * @brief Packs the input values into a CondSel_Mask.
+ *
+ * @param[in] values  Structure containing all condition inputs.
+ * @return CondSel_Mask  One bit per input signal (CONDSEL_MASK_*).
+ */
+CondSel_Mask CondSel_pack(const CondSel_In* values)
+{
+    LIFT_ASSERT(values != NULL);
+
+    return (CondSel_Mask)
+    (
+        ((uint8_t)values->call_pending_below << 0) |
+        ((uint8_t)values->call_pending_same  << 1) |
+        ((uint8_t)values->call_pending_above << 2) |
+        ((uint8_t)values->door_closed        << 3) |
+        ((uint8_t)values->door_open          << 4)
+    );
+}
+
+/**
+ * @brief Returns the result of a condition check based on packed inputs, without branches.
+ *
+ * The mask is widened so that bit N holds the value of selector index N
+ * (bit 0: any pending, bits 1..5: the signals, bits 6..7: constant zero),
+ * then the selected bit is shifted out and XOR-ed with the inversion flag.
+ *
+ * @param[in] invert  If true, the selected result will be logically negated before return.
+ * @param[in] index   Index of the condition to evaluate (0–7).
+ * @param[in] mask    Packed condition inputs.
+ * @return bool       The result of the selected condition (possibly inverted).
+ */
+bool CondSel_calcMask(const bool invert, const uint8_t index, const CondSel_Mask mask)
+{
+    LIFT_ASSERT(CONDSEL_MAXIMUM_INDEX >= index);
+
+    const uint32_t selectable = ((uint32_t)(mask & CONDSEL_MASK_ALL) << 1) |
+                                (uint32_t)((mask & CONDSEL_MASK_PENDING) != 0);
+
+    return (bool)(((selectable >> (index & CONDSEL_MAXIMUM_INDEX)) & 0x1U) ^ (uint32_t)invert);
+}
+
+/**
+ * @brief Returns the inputs a selector index reads.
+ *
+ * @param[in] index   Index of the condition (0–7).
+ * @return CondSel_Mask  Inputs the selected value depends on.
+ */
+CondSel_Mask CondSel_dependency(const uint8_t index)
+{
+    static const CondSel_Mask dependency[CONDSEL_MAXIMUM_INDEX + 1] =
+    {
+        CONDSEL_MASK_PENDING,  // Any pending call
+        CONDSEL_MASK_BELOW,
+        CONDSEL_MASK_SAME,
+        CONDSEL_MASK_ABOVE,
+        CONDSEL_MASK_CLOSED,
+        CONDSEL_MASK_OPEN,
+        0,                     // Reserved
+        0                      // Constant false
+    };
+
+    LIFT_ASSERT(CONDSEL_MAXIMUM_INDEX >= index);
+
+    return dependency[index & CONDSEL_MAXIMUM_INDEX];
+}
+
+/**
+ * @brief Evaluates the same selector index for 64 bitsliced instances.
+ *
+ * @param[in] invert  If true, every result bit is negated.
+ * @param[in] index   Index of the condition to evaluate (0–7).
+ * @param[in] values  Input planes, bit i of each plane belongs to instance i.
+ * @return uint64_t   Result plane.
+ */
+uint64_t CondSel_calcSliced(const bool invert, const uint8_t index, const CondSel_Planes* values)
+{
+    LIFT_ASSERT(values != NULL);
+    LIFT_ASSERT(CONDSEL_MAXIMUM_INDEX >= index);
+
+    const uint64_t selectable[CONDSEL_MAXIMUM_INDEX + 1] =
+    {
+        values->call_pending_below | values->call_pending_same | values->call_pending_above,
+        values->call_pending_below,
+        values->call_pending_same,
+        values->call_pending_above,
+        values->door_closed,
+        values->door_open,
+        0,  // Reserved
+        0   // Constant false
+    };
+
+    return selectable[index & CONDSEL_MAXIMUM_INDEX] ^ (0 - (uint64_t)invert);
+}
+
+/**
+ * @brief Evaluates a per-instance selector index and inversion for 64 bitsliced instances.
+ *
+ * The eight selectable planes are reduced by a 3-level multiplexer tree
+ * driven by the index planes, so every instance may select a different input.
+ *
+ * @param[in] sel     Selector index and inversion planes.
+ * @param[in] values  Input planes, bit i of each plane belongs to instance i.
+ * @return uint64_t   Result plane.
+ */
+uint64_t CondSel_calcSlicedSel(const CondSel_SelPlanes* sel, const CondSel_Planes* values)
+{
+    LIFT_ASSERT(sel != NULL);
+    LIFT_ASSERT(values != NULL);
+
+    const uint64_t any = values->call_pending_below | values->call_pending_same | values->call_pending_above;
+
+    // Level 0: select by index bit 0 (pairs 0/1, 2/3, 4/5; 6/7 are constant zero)
+    const uint64_t m01 = (any                        & ~sel->index0) | (values->call_pending_below & sel->index0);
+    const uint64_t m23 = (values->call_pending_same  & ~sel->index0) | (values->call_pending_above & sel->index0);
+    const uint64_t m45 = (values->door_closed        & ~sel->index0) | (values->door_open          & sel->index0);
+
+    // Level 1: select by index bit 1
+    const uint64_t m0123 = (m01 & ~sel->index1) | (m23 & sel->index1);
+    const uint64_t m4567 = (m45 & ~sel->index1);
+
+    // Level 2: select by index bit 2, then invert
+    return ((m0123 & ~sel->index2) | (m4567 & sel->index2)) ^ sel->invert;
+}
@@ -0,0 +1,445 @@
+/**
+ * @file lift_check.c
+ * @brief Implements the explicit-state model checker.
+ */
+
+#include <string.h>
+#include "lift_check.h"
+#include "lift_thread.h"
+#include "seqnet_internal.h"  // for DOOR_REQ_*
+#include "lift_assert.h"
+
+// Packed state layout
+#define LIFT_CHECK_SHIFT_PC             (32U)
+#define LIFT_CHECK_SHIFT_FLOOR          (40U)
+#define LIFT_CHECK_BIT_DOOR             (48U)
+#define LIFT_CHECK_BIT_MOVING           (49U)
+#define LIFT_CHECK_SHIFT_VERDICT        (56U)
+#define LIFT_CHECK_MASK_CALLS           (0xFFFFFFFFULL)
+
+/// No violation recorded
+#define LIFT_CHECK_NONE                 (UINT64_MAX)
+/// Frontier entries claimed by a worker at once
+#define LIFT_CHECK_CHUNK                (64U)
+/// Slot marker of a failed insertion
+#define LIFT_CHECK_FULL                 (UINT32_MAX)
+
+/**
+ * @brief State of one BFS level, shared by the workers.
+ */
+typedef struct
+{
+    const SeqNet_Program* program;
+    const LiftCheckConfig_t* config;
+    const LiftCheckWorkspace_t* workspace;
+    const uint32_t* current;      ///< Level being expanded
+    uint32_t* next;               ///< Next level
+    uint32_t current_count;       ///< Entries of the current level
+    uint32_t cursor;              ///< Next unclaimed entry of the current level (atomic)
+    uint32_t next_count;          ///< Entries of the next level (atomic)
+    uint32_t states;              ///< Visited states (atomic)
+    uint32_t limit;               ///< Maximum number of visited states
+    uint64_t violation;           ///< Smallest (verdict, state) pair found (atomic)
+    bool overflow;                ///< The visited set is full (atomic)
+} LiftCheckJob_t;
+
+uint64_t LiftCheck_pack(const LiftCheckState_t* state)
+{
+    return (uint64_t)state->calls |
+           ((uint64_t)state->pc << LIFT_CHECK_SHIFT_PC) |
+           ((uint64_t)state->floor << LIFT_CHECK_SHIFT_FLOOR) |
+           ((uint64_t)state->is_door_open << LIFT_CHECK_BIT_DOOR) |
+           ((uint64_t)state->is_moving << LIFT_CHECK_BIT_MOVING);
+}
+
+void LiftCheck_unpack(uint64_t key, LiftCheckState_t* state)
+{
+    state->calls = (uint32_t)(key & LIFT_CHECK_MASK_CALLS);
+    state->pc = (uint8_t)(key >> LIFT_CHECK_SHIFT_PC);
+    state->floor = (uint8_t)(key >> LIFT_CHECK_SHIFT_FLOOR);
+    state->is_door_open = ((key >> LIFT_CHECK_BIT_DOOR) & 1U) != 0;
+    state->is_moving = ((key >> LIFT_CHECK_BIT_MOVING) & 1U) != 0;
+}
+
+/**
+ * @brief Returns true, if the instruction of a state requests both directions.
+ */
+static bool LiftCheck_isConflict(const SeqNet_Program* program, uint64_t key)
+{
+    const SeqNet_Out* out = &program->decoded[(uint8_t)(key >> LIFT_CHECK_SHIFT_PC)];
+    return out->req_move_up && out->req_move_down;
+}
+
+/**
+ * @brief Executes one controller step on a packed state.
+ *
+ * Mirrors LiftStateArray_convert() and LiftPlant_apply() on the call bitmask.
+ * The instruction must not be a move conflict (@see LiftCheck_isConflict).
+ *
+ * @return Returns with the property violated by the successor, LIFT_CHECK_OK if none.
+ */
+static LiftCheckVerdict_t LiftCheck_step(const SeqNet_Program* program, uint8_t floors, uint64_t key, uint64_t* next)
+{
+    LiftCheckState_t state;
+    LiftCheck_unpack(key, &state);
+
+    const uint32_t below = (1U << state.floor) - 1U;
+    const uint32_t same = 1U << state.floor;
+    const CondSel_In in = {
+        .call_pending_below = (state.calls & below) != 0,
+        .call_pending_same  = (state.calls & same) != 0,
+        .call_pending_above = (state.calls & ~(below | same)) != 0,
+        .door_closed        = !state.is_door_open,
+        .door_open          = state.is_door_open
+    };
+
+    SeqNet_Ctx ctx;
+    SeqNet_ctxInit(&ctx, program);
+    ctx.pc = state.pc;
+    const SeqNet_Out out = SeqNet_ctxStep(&ctx, &in);
+    state.pc = ctx.pc;
+
+    if (DOOR_REQ_OPEN == out.req_door_state)
+    {
+        state.is_door_open = true;
+    }
+    else if (DOOR_REQ_CLOSE == out.req_door_state)
+    {
+        state.is_door_open = false;
+    }
+
+    if (out.req_reset)
+    {
+        state.calls &= ~same;
+    }
+
+    state.is_moving = out.req_move_up || out.req_move_down;
+    if (out.req_move_up)
+    {
+        state.floor++;
+    }
+    else if (out.req_move_down)
+    {
+        state.floor--;
+    }
+
+    *next = LiftCheck_pack(&state);
+
+    if (state.floor >= floors)
+    {
+        return LIFT_CHECK_FLOOR_RANGE;
+    }
+    if (state.is_moving && state.is_door_open)
+    {
+        return LIFT_CHECK_DOOR_OPEN_MOVING;
+    }
+    return LIFT_CHECK_OK;
+}
+
+/**
+ * @brief Returns true, if the calls of a state are all served within @p bound steps without new arrivals.
+ *
+ * Paths running into a safety violation count as served, the violation itself is
+ * reported by the search.
+ */
+static bool LiftCheck_isServed(const SeqNet_Program* program, uint8_t floors, uint64_t key, uint16_t bound)
+{
+    for (uint16_t i = 0; i < bound; ++i)
+    {
+        if ((key & LIFT_CHECK_MASK_CALLS) == 0)
+        {
+            return true;
+        }
+        if (LiftCheck_isConflict(program, key) ||
+            (LiftCheck_step(program, floors, key, &key) != LIFT_CHECK_OK))
+        {
+            return true;
+        }
+    }
+    return (key & LIFT_CHECK_MASK_CALLS) == 0;
+}
+
+/**
+ * @brief Mixes a packed state into a hash (splitmix64 finalizer).
+ */
+static inline uint64_t LiftCheck_hash(uint64_t key)
+{
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ULL;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBULL;
+    key ^= key >> 31;
+    return key;
+}
+
+/**
+ * @brief Inserts a state into the visited set, lock-free.
+ *
+ * @return Returns with the slot of the state, or LIFT_CHECK_FULL if the set is full.
+ */
+static uint32_t LiftCheck_insert(LiftCheckJob_t* job, uint64_t key, uint32_t parent, bool* inserted)
+{
+    const LiftCheckWorkspace_t* ws = job->workspace;
+    const uint32_t mask = ws->capacity - 1U;
+    const uint64_t stored = key + 1U;
+    uint32_t slot = (uint32_t)LiftCheck_hash(key) & mask;
+
+    *inserted = false;
+
+    for (uint32_t probe = 0; probe < ws->capacity; ++probe)
+    {
+        uint64_t current = __atomic_load_n(&ws->keys[slot], __ATOMIC_ACQUIRE);
+        if (current == 0)
+        {
+            if (__atomic_add_fetch(&job->states, 1U, __ATOMIC_RELAXED) > job->limit)
+            {
+                __atomic_store_n(&job->overflow, true, __ATOMIC_RELAXED);
+                return LIFT_CHECK_FULL;
+            }
+            if (__atomic_compare_exchange_n(&ws->keys[slot], &current, stored, false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            {
+                ws->parents[slot] = parent;
+                *inserted = true;
+                return slot;
+            }
+            __atomic_sub_fetch(&job->states, 1U, __ATOMIC_RELAXED);  // Lost the race, slot taken meanwhile
+        }
+        if (current == stored)
+        {
+            return slot;
+        }
+        slot = (slot + 1U) & mask;
+    }
+
+    __atomic_store_n(&job->overflow, true, __ATOMIC_RELAXED);
+    return LIFT_CHECK_FULL;
+}
+
+/**
+ * @brief Looks up the slot of a visited state.
+ */
+static uint32_t LiftCheck_find(const LiftCheckWorkspace_t* ws, uint64_t key)
+{
+    const uint32_t mask = ws->capacity - 1U;
+    uint32_t slot = (uint32_t)LiftCheck_hash(key) & mask;
+
+    for (uint32_t probe = 0; probe < ws->capacity; ++probe)
+    {
+        if (ws->keys[slot] == key + 1U) return slot;
+        if (ws->keys[slot] == 0) break;
+        slot = (slot + 1U) & mask;
+    }
+    return LIFT_CHECK_FULL;
+}
+
+/**
+ * @brief Records a violation, keeping the smallest (verdict, state) pair.
+ */
+static void LiftCheck_report(LiftCheckJob_t* job, LiftCheckVerdict_t verdict, uint64_t key)
+{
+    const uint64_t tagged = ((uint64_t)verdict << LIFT_CHECK_SHIFT_VERDICT) | key;
+    uint64_t current = __atomic_load_n(&job->violation, __ATOMIC_RELAXED);
+
+    while ((tagged < current) &&
+           !__atomic_compare_exchange_n(&job->violation, &current, tagged, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+/**
+ * @brief Checks a newly visited state and queues it for expansion.
+ */
+static void LiftCheck_visit(LiftCheckJob_t* job, uint64_t key, uint32_t slot)
+{
+    const LiftCheckConfig_t* config = job->config;
+
+    if ((config->service_bound != 0) &&
+        !LiftCheck_isServed(job->program, config->floors, key, config->service_bound))
+    {
+        LiftCheck_report(job, LIFT_CHECK_SERVICE, key);
+        return;
+    }
+
+    const uint32_t index = __atomic_fetch_add(&job->next_count, 1U, __ATOMIC_RELAXED);
+    job->next[index] = slot;
+}
+
+/**
+ * @brief Expands one state: every call arrival (or none) followed by one controller step.
+ */
+static void LiftCheck_expand(LiftCheckJob_t* job, uint32_t slot)
+{
+    const LiftCheckConfig_t* config = job->config;
+    const uint64_t key = job->workspace->keys[slot] - 1U;
+
+    if (LiftCheck_isConflict(job->program, key))
+    {
+        LiftCheck_report(job, LIFT_CHECK_MOVE_CONFLICT, key);
+        return;
+    }
+
+    for (int16_t arrival = -1; arrival < (int16_t)config->floors; ++arrival)
+    {
+        uint64_t source = key;
+        if (arrival >= 0)
+        {
+            const uint64_t call = 1ULL << arrival;
+            if (!config->arrivals || ((key & call) != 0)) continue;
+            source |= call;
+        }
+
+        uint64_t next;
+        const LiftCheckVerdict_t verdict = LiftCheck_step(job->program, config->floors, source, &next);
+
+        bool inserted;
+        const uint32_t next_slot = LiftCheck_insert(job, next, slot, &inserted);
+        if (next_slot == LIFT_CHECK_FULL)
+        {
+            return;
+        }
+
+        if (verdict != LIFT_CHECK_OK)
+        {
+            LiftCheck_report(job, verdict, next);
+        }
+        else if (inserted)
+        {
+            LiftCheck_visit(job, next, next_slot);
+        }
+    }
+}
+
+/**
+ * @brief Worker of one BFS level: claims chunks of the current level until it is exhausted.
+ */
+static void LiftCheck_worker(void* arg)
+{
+    LiftCheckJob_t* job = (LiftCheckJob_t*)arg;
+
+    for (;;)
+    {
+        const uint32_t begin = __atomic_fetch_add(&job->cursor, LIFT_CHECK_CHUNK, __ATOMIC_RELAXED);
+        if (begin >= job->current_count || __atomic_load_n(&job->overflow, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+
+        const uint32_t end = (begin + LIFT_CHECK_CHUNK < job->current_count) ? begin + LIFT_CHECK_CHUNK : job->current_count;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            LiftCheck_expand(job, job->current[i]);
+        }
+    }
+}
+
+void LiftCheck_run(const SeqNet_Program* program, const LiftCheckConfig_t* config,
+                   const LiftCheckState_t* initial, const LiftCheckWorkspace_t* workspace,
+                   LiftCheckResult_t* result)
+{
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT(config != NULL);
+    LIFT_ASSERT(initial != NULL);
+    LIFT_ASSERT(workspace != NULL);
+    LIFT_ASSERT(result != NULL);
+    LIFT_ASSERT((config->floors > 0) && (config->floors <= LIFT_CHECK_MAX_FLOORS));
+    LIFT_ASSERT(initial->floor < config->floors);
+    LIFT_ASSERT((config->floors == LIFT_CHECK_MAX_FLOORS) || ((initial->calls >> config->floors) == 0));
+    LIFT_ASSERT((workspace->capacity != 0) && ((workspace->capacity & (workspace->capacity - 1U)) == 0));
+
+    memset(workspace->keys, 0, (size_t)workspace->capacity * sizeof(uint64_t));
+    memset(result, 0, sizeof(LiftCheckResult_t));
+
+    const uint32_t threads = (config->threads == 0) ? 1U :
+                             (config->threads > LIFT_THREAD_MAX) ? LIFT_THREAD_MAX : config->threads;
+
+    LiftCheckJob_t job;
+    memset(&job, 0, sizeof(job));
+    job.program = program;
+    job.config = config;
+    job.workspace = workspace;
+    job.limit = workspace->capacity - workspace->capacity / 4U;
+    job.violation = LIFT_CHECK_NONE;
+    job.current = workspace->current;
+    job.next = workspace->next;
+
+    // Level 0: the initial state
+    const uint64_t root_key = LiftCheck_pack(initial);
+    bool inserted;
+    const uint32_t root_slot = LiftCheck_insert(&job, root_key, 0, &inserted);
+    workspace->parents[root_slot] = root_slot;
+    LiftCheck_visit(&job, root_key, root_slot);
+
+    while ((job.violation == LIFT_CHECK_NONE) && !job.overflow && (job.next_count != 0))
+    {
+        // The level just filled becomes the one to expand
+        uint32_t* expanded = (uint32_t*)job.current;
+        job.current = job.next;
+        job.next = expanded;
+        job.current_count = job.next_count;
+        job.next_count = 0;
+        job.cursor = 0;
+
+        LiftThread_runAll(LiftCheck_worker, &job, 0, threads);
+        result->depth++;
+    }
+
+    result->states = (job.states > job.limit) ? job.limit : job.states;
+
+    if (job.violation != LIFT_CHECK_NONE)
+    {
+        const uint64_t key = job.violation & ~(~0ULL << LIFT_CHECK_SHIFT_VERDICT);
+        result->verdict = (LiftCheckVerdict_t)(job.violation >> LIFT_CHECK_SHIFT_VERDICT);
+        result->violation = LiftCheck_find(workspace, key);
+    }
+    else if (job.overflow)
+    {
+        result->verdict = LIFT_CHECK_OUT_OF_MEMORY;
+    }
+}
+
+uint32_t LiftCheck_trace(const LiftCheckWorkspace_t* workspace, const LiftCheckResult_t* result,
+                         LiftCheckState_t* trace, uint32_t max_length)
+{
+    LIFT_ASSERT(workspace != NULL);
+    LIFT_ASSERT(result != NULL);
+
+    if ((result->verdict == LIFT_CHECK_OK) || (result->verdict == LIFT_CHECK_OUT_OF_MEMORY))
+    {
+        return 0;
+    }
+
+    // Length of the parent chain
+    uint32_t length = 1;
+    for (uint32_t slot = result->violation; workspace->parents[slot] != slot; slot = workspace->parents[slot])
+    {
+        ++length;
+    }
+    if (length > max_length)
+    {
+        return 0;
+    }
+
+    uint32_t slot = result->violation;
+    for (uint32_t i = length; i > 0; --i)
+    {
+        LiftCheck_unpack(workspace->keys[slot] - 1U, &trace[i - 1U]);
+        slot = workspace->parents[slot];
+    }
+    return length;
+}
+
+const char* LiftCheckVerdict_name(LiftCheckVerdict_t verdict)
+{
+    switch (verdict)
+    {
+        case LIFT_CHECK_OK:               return "ok";
+        case LIFT_CHECK_MOVE_CONFLICT:    return "move up and down at once";
+        case LIFT_CHECK_DOOR_OPEN_MOVING: return "moving with the door open";
+        case LIFT_CHECK_FLOOR_RANGE:      return "floor out of range";
+        case LIFT_CHECK_SERVICE:          return "calls not served in time";
+        case LIFT_CHECK_OUT_OF_MEMORY:    return "out of memory";
+        default:                          return "unknown";
+    }
+}
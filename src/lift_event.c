@@ -0,0 +1,102 @@
+/**
+ * @file lift_event.c
+ * @brief Implements the tick-driven and event-driven simulation modes.
+ */
+
+#include <string.h>
+#include "lift_event.h"
+#include "lift_assert.h"
+
+/**
+ * @brief Registers the calls injected at the current tick.
+ */
+static void LiftEventSim_inject(LiftEventSim_t* sim, const LiftCallInjection_t* calls, uint32_t call_count)
+{
+    while ((sim->next_call < call_count) && (calls[sim->next_call].tick <= sim->tick))
+    {
+        const uint16_t floor = calls[sim->next_call].floor;
+        LIFT_ASSERT(floor < LIFT_MAX_FLOORS);
+        LiftInputs_callSet(&sim->plant, floor);
+        ++sim->next_call;
+    }
+}
+
+/**
+ * @brief Executes one controller step and applies its outputs to the plant.
+ */
+static void LiftEventSim_step(LiftEventSim_t* sim)
+{
+    const SeqNet_Out out = SeqNet_ctxStep(&sim->ctx, &sim->plant.in);
+    LiftInputs_apply(&sim->plant, &out);
+
+    ++sim->steps;
+    ++sim->tick;
+}
+
+/**
+ * @brief Returns true, if applying the outputs leaves the plant state unchanged.
+ */
+static bool LiftEventSim_isAtRest(const LiftState_t* state, const SeqNet_Out* out)
+{
+    LiftState_t next = *state;
+    LiftPlant_apply(&next, out);
+    return LiftState_equal(&next, state);
+}
+
+void LiftEventSim_init(LiftEventSim_t* sim, const SeqNet_Program* program, const LiftState_t* initial, uint8_t pc)
+{
+    LIFT_ASSERT(sim != NULL);
+    LIFT_ASSERT(initial != NULL);
+
+    memset(sim, 0, sizeof(LiftEventSim_t));
+    LiftInputs_init(&sim->plant, initial);
+    SeqNet_ctxInit(&sim->ctx, program);
+    sim->ctx.pc = pc;
+}
+
+void LiftEventSim_runTicks(LiftEventSim_t* sim, uint64_t end_tick, const LiftCallInjection_t* calls, uint32_t call_count)
+{
+    LIFT_ASSERT(sim != NULL);
+
+    while (sim->tick < end_tick)
+    {
+        LiftEventSim_inject(sim, calls, call_count);
+        LiftEventSim_step(sim);
+    }
+}
+
+/**
+ * @brief Runs the simulation until @p end_tick, skipping the ticks spent parked.
+ *
+ * A tick can be skipped if the controller is parked on the current inputs and the
+ * plant does not react to the held outputs: then nothing but the PC (inside the loop)
+ * changes until the next injection, so the clock jumps there directly.
+ */
+void LiftEventSim_run(LiftEventSim_t* sim, uint64_t end_tick, const LiftCallInjection_t* calls, uint32_t call_count)
+{
+    LIFT_ASSERT(sim != NULL);
+
+    while (sim->tick < end_tick)
+    {
+        LiftEventSim_inject(sim, calls, call_count);
+
+        SeqNet_Park park;
+        if (SeqNet_ctxPark(&sim->ctx, &sim->plant.in, &park) &&
+            LiftEventSim_isAtRest(&sim->plant.state, &sim->ctx.program->decoded[sim->ctx.pc]))
+        {
+            uint64_t wake = end_tick;
+            if ((sim->next_call < call_count) && (calls[sim->next_call].tick < wake))
+            {
+                wake = calls[sim->next_call].tick;
+            }
+
+            SeqNet_ctxFastForward(&sim->ctx, &park, wake - sim->tick);
+            sim->skipped += wake - sim->tick;
+            sim->tick = wake;
+            ++sim->parks;
+            continue;
+        }
+
+        LiftEventSim_step(sim);
+    }
+}
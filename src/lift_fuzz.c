@@ -0,0 +1,221 @@
+/**
+ * @file lift_fuzz.c
+ * @brief Implements the randomized scenario fuzzer.
+ */
+
+#include <string.h>
+#include "lift_fuzz.h"
+#include "lift_plant.h"
+#include "lift_thread.h"
+#include "lift_random.h"
+#include "seqnet_internal.h"  // for BIT_*
+#include "lift_assert.h"
+
+/// Seeds claimed by a worker at once
+#define LIFT_FUZZ_CHUNK                 (1024U)
+
+/**
+ * @brief Seeds of a fuzzing run, shared by the workers.
+ */
+typedef struct
+{
+    const SeqNetTable_t* table;
+    const LiftFuzzConfig_t* config;
+    uint64_t first_seed;
+    uint64_t count;
+    uint64_t cursor;   ///< First unclaimed scenario index (atomic)
+    uint64_t failed;   ///< Lowest failing scenario index found so far, count if none (atomic)
+} LiftFuzzJob_t;
+
+/**
+ * @brief Worker of a fuzzing run with its lowest failure.
+ */
+typedef struct
+{
+    LiftFuzzJob_t* job;
+    uint64_t failed;               ///< Lowest failing scenario index of the worker, UINT64_MAX if none
+    LiftCheckVerdict_t verdict;    ///< Verdict of that scenario
+    uint32_t step;                 ///< Step of the violation
+} LiftFuzzWorker_t;
+
+LiftCheckVerdict_t LiftFuzz_scenario(const SeqNetTable_t* table, const LiftFuzzConfig_t* config,
+                                     uint64_t seed, uint32_t* step)
+{
+    LIFT_ASSERT(table != NULL);
+    LIFT_ASSERT(config != NULL);
+    LIFT_ASSERT((config->presets == NULL) || (config->preset_count > 0));
+    LIFT_ASSERT(config->floors <= LIFT_MAX_FLOORS);
+
+    const uint16_t floors = (config->floors != 0) ? config->floors : (uint16_t)LIFT_MAX_FLOORS;
+    uint64_t random = LiftRandom_mix(seed) | 1U;  // xorshift must not start from 0
+    const uint64_t initial = LiftRandom_next64(&random);
+
+    // Initial state and start PC
+    LiftState_t state = {
+        .floor = (uint16_t)(initial % floors),
+        .is_door_open = ((initial >> 8) & 1U) != 0,
+        .is_moving = false
+    };
+    for (uint32_t w = 0; w < LIFT_CALL_WORDS; ++w)
+    {
+        const uint32_t first = w * LIFT_CALL_WORD_BITS;
+        const uint64_t word = LiftRandom_next64(&random);
+        state.calls.words[w] = (first >= floors) ? 0U :
+                               (floors - first >= LIFT_CALL_WORD_BITS) ? word :
+                               (word & (LIFT_CALL(floors - first) - 1U));
+    }
+    uint8_t pc = (config->presets != NULL) ?
+                 config->presets[(initial >> 32) % config->preset_count] :
+                 (uint8_t)((initial >> 32) % SEQNET_PROGMEM_SIZE);
+
+    LiftInputs_t plant;
+    LiftInputs_init(&plant, &state);
+
+    // Arrival step of each pending call, overdue calls are detected when cleared or at the end
+    uint32_t since[LIFT_MAX_FLOORS] = { 0 };
+    const uint32_t bound = (config->service_bound != 0) ? config->service_bound : UINT32_MAX;
+    const uint64_t arrival_mask = (1ULL << (config->injection_shift & 63U)) - 1U;
+    const bool arrival_enabled = (config->injection_shift != 0);
+
+    for (uint32_t i = 0; i < config->steps; ++i)
+    {
+        // Call injection
+        const uint64_t r = LiftRandom_next64(&random);
+        const uint16_t target = (uint16_t)(((r >> 32) * floors) >> 32);  // Multiply-shift range reduction
+        if (arrival_enabled && ((r & arrival_mask) == 0) && !LiftCalls_get(&plant.state.calls, target))
+        {
+            since[target] = i;
+            LiftInputs_callSet(&plant, target);
+        }
+
+        // Controller
+        const uint16_t word = SeqNetTable_step(table, &pc, CondSel_pack(&plant.in));
+        const SeqNet_Out out = SeqNetInstruction_convert(word);
+        const uint16_t floor = plant.state.floor;
+        const bool cleared = out.req_reset && plant.in.call_pending_same;
+        const uint32_t waited = i - since[floor];
+
+        // Invariants, checked before the plant is touched
+        const bool conflict = out.req_move_up && out.req_move_down;
+        const bool open_moving = (DOOR_REQ_OPEN == out.req_door_state) && (out.req_move_up || out.req_move_down);
+        const bool out_of_range = (out.req_move_up && (floor + 1U >= floors)) ||
+                                  (out.req_move_down && (floor == 0));
+        const bool overdue = cleared && (waited > bound);
+
+        if (conflict || open_moving || out_of_range || overdue)
+        {
+            if (step != NULL) *step = overdue ? (i - waited + bound) : i;
+            return conflict     ? LIFT_CHECK_MOVE_CONFLICT :
+                   open_moving  ? LIFT_CHECK_DOOR_OPEN_MOVING :
+                   out_of_range ? LIFT_CHECK_FLOOR_RANGE :
+                                  LIFT_CHECK_SERVICE;
+        }
+
+        // Plant
+        LiftInputs_apply(&plant, &out);
+    }
+
+    // Calls still pending at the end
+    for (uint16_t f = 0; f < floors; ++f)
+    {
+        if (LiftCalls_get(&plant.state.calls, f) && (config->steps - since[f] > bound))
+        {
+            if (step != NULL) *step = since[f] + bound;
+            return LIFT_CHECK_SERVICE;
+        }
+    }
+
+    if (step != NULL) *step = config->steps;
+    return LIFT_CHECK_OK;
+}
+
+/**
+ * @brief Lowers the shared failure index to @p index, unless a lower one is already known.
+ */
+static void LiftFuzz_report(LiftFuzzJob_t* job, uint64_t index)
+{
+    uint64_t current = __atomic_load_n(&job->failed, __ATOMIC_RELAXED);
+
+    while ((index < current) &&
+           !__atomic_compare_exchange_n(&job->failed, &current, index, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+/**
+ * @brief Worker of a fuzzing run: claims chunks of seeds until none is left below the lowest failure.
+ *
+ * Chunks are claimed in ascending order and a chunk is only abandoned at an index at
+ * or above a known failure, so every seed below the lowest failure is run.
+ */
+static void LiftFuzz_worker(void* arg)
+{
+    LiftFuzzWorker_t* worker = (LiftFuzzWorker_t*)arg;
+    LiftFuzzJob_t* job = worker->job;
+
+    for (;;)
+    {
+        const uint64_t start = __atomic_fetch_add(&job->cursor, LIFT_FUZZ_CHUNK, __ATOMIC_RELAXED);
+        if (start >= __atomic_load_n(&job->failed, __ATOMIC_RELAXED)) return;
+
+        const uint64_t end = (job->count - start > LIFT_FUZZ_CHUNK) ? (start + LIFT_FUZZ_CHUNK) : job->count;
+        for (uint64_t i = start; i < end; ++i)
+        {
+            uint32_t step;
+            const LiftCheckVerdict_t verdict = LiftFuzz_scenario(job->table, job->config, job->first_seed + i, &step);
+            if (verdict != LIFT_CHECK_OK)
+            {
+                // Every later seed of the worker is higher, this is its lowest failure
+                worker->failed = i;
+                worker->verdict = verdict;
+                worker->step = step;
+                LiftFuzz_report(job, i);
+                return;
+            }
+        }
+    }
+}
+
+uint64_t LiftFuzz_run(const SeqNetTable_t* table, const LiftFuzzConfig_t* config,
+                      uint64_t first_seed, uint64_t count, LiftFuzzReport_t* report)
+{
+    LIFT_ASSERT(config != NULL);
+    LIFT_ASSERT(report != NULL);
+
+    memset(report, 0, sizeof(LiftFuzzReport_t));
+    if (count == 0) return 0;
+
+    const uint32_t threads = (config->threads == 0) ? 1U :
+                             (config->threads > LIFT_THREAD_MAX) ? LIFT_THREAD_MAX : config->threads;
+
+    LiftFuzzJob_t job = {
+        .table = table,
+        .config = config,
+        .first_seed = first_seed,
+        .count = count,
+        .cursor = 0,
+        .failed = count
+    };
+    LiftFuzzWorker_t workers[LIFT_THREAD_MAX];
+    for (uint32_t t = 0; t < threads; ++t)
+    {
+        workers[t].job = &job;
+        workers[t].failed = UINT64_MAX;
+    }
+
+    LiftThread_runAll(LiftFuzz_worker, workers, sizeof(LiftFuzzWorker_t), threads);
+
+    // The lowest failure is the one of the worker that ran it
+    for (uint32_t t = 0; t < threads; ++t)
+    {
+        if (workers[t].failed == job.failed)
+        {
+            report->verdict = workers[t].verdict;
+            report->seed = first_seed + job.failed;
+            report->step = workers[t].step;
+            return job.failed + 1U;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file lift_group.c
+ * @brief Implements the group control of a bank of cars.
+ */
+
+#include <string.h>
+#include "lift_group.h"
+#include "lift_assert.h"
+
+uint32_t LiftGroupCost_default(const LiftGroupCarView_t* car, uint16_t floor, const void* context)
+{
+    const LiftGroupWeights_t* weights = (const LiftGroupWeights_t*)context;
+
+    const uint32_t distance = (floor > car->floor) ? (uint32_t)(floor - car->floor) : (uint32_t)(car->floor - floor);
+    const bool behind = ((car->direction > 0) && (floor < car->floor)) ||
+                        ((car->direction < 0) && (floor > car->floor));
+
+    return distance * weights->distance + (behind ? weights->reversal : 0U) + car->load * weights->load;
+}
+
+void LiftGroup_init(LiftGroup_t* group, const SeqNet_Program* program, uint8_t cars, const LiftState_t* initial,
+                    LiftGroupCost_t cost, const void* context)
+{
+    LIFT_ASSERT(group != NULL);
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT((cars > 0) && (cars <= LIFT_GROUP_MAX_CARS));
+    LIFT_ASSERT(cost != NULL);
+
+    memset(group, 0, sizeof(LiftGroup_t));
+    memset(group->owner, LIFT_GROUP_NO_CAR, sizeof(group->owner));
+    group->cars = cars;
+    group->cost = cost;
+    group->cost_context = context;
+
+    LiftState_t idle;
+    memset(&idle, 0, sizeof(idle));
+    for (uint8_t i = 0; i < cars; ++i)
+    {
+        SeqNet_ctxInit(&group->ctx[i], program);
+        LiftInputs_init(&group->plant[i], (initial != NULL) ? &initial[i] : &idle);
+
+        LiftGroupCarView_t* view = &group->view[i];
+        view->floor = group->plant[i].state.floor;
+        view->direction = 0;
+        view->is_door_open = group->plant[i].state.is_door_open;
+        view->load = (uint16_t)LiftCalls_count(&group->plant[i].state.calls);
+    }
+}
+
+uint8_t LiftGroup_select(const LiftGroup_t* group, uint16_t floor)
+{
+    LIFT_ASSERT(group != NULL);
+
+    uint8_t best = 0;
+    uint32_t best_cost = group->cost(&group->view[0], floor, group->cost_context);
+    for (uint8_t i = 1; i < group->cars; ++i)
+    {
+        const uint32_t cost = group->cost(&group->view[i], floor, group->cost_context);
+        if (cost < best_cost)
+        {
+            best = i;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Registers a call in the memory of a car and updates its load.
+ * @return Returns with true, if the load of the car changed.
+ */
+static inline bool LiftGroup_assign(LiftGroup_t* group, uint8_t car, uint16_t floor)
+{
+    LiftInputs_t* plant = &group->plant[car];
+    if (LiftCalls_get(&plant->state.calls, floor))
+    {
+        return false;
+    }
+    LiftInputs_callSet(plant, floor);
+    group->view[car].load++;
+    return true;
+}
+
+/**
+ * @brief Evaluates the cost of a pending hall call with a car, the owner without the call itself.
+ */
+static inline uint32_t LiftGroup_cost(LiftGroup_t* group, uint8_t car, uint16_t floor)
+{
+    LiftGroupCarView_t view = group->view[car];
+    if ((group->owner[floor] == car) && !LiftCalls_get(&group->cabin[car], floor))
+    {
+        view.load--;
+    }
+    group->evaluations++;
+    return group->cost(&view, floor, group->cost_context);
+}
+
+/**
+ * @brief Re-evaluates the cached costs of a car for every pending hall call.
+ */
+static void LiftGroup_rate(LiftGroup_t* group, uint8_t car)
+{
+    for (uint16_t k = 0; k < group->pending_count; ++k)
+    {
+        const uint16_t floor = group->pending[k];
+        group->costs[floor][car] = LiftGroup_cost(group, car, floor);
+    }
+}
+
+/**
+ * @brief Hands a hall call over to another car.
+ */
+static void LiftGroup_reassign(LiftGroup_t* group, uint16_t floor, uint8_t car)
+{
+    const uint8_t owner = group->owner[floor];
+    if (!LiftCalls_get(&group->cabin[owner], floor))
+    {
+        LiftInputs_callClear(&group->plant[owner], floor);
+        group->view[owner].load--;
+    }
+    group->owner[floor] = car;
+    LiftGroup_assign(group, car, floor);
+    group->reassigned++;
+}
+
+/**
+ * @brief Re-evaluates the costs of a car whose view changed and reassigns the hall calls
+ *        it became cheaper or dearer for. The costs of the other cars stay cached.
+ */
+static void LiftGroup_update(LiftGroup_t* group, uint8_t car)
+{
+    uint32_t touched = 0;
+
+    for (uint16_t k = 0; k < group->pending_count; ++k)
+    {
+        const uint16_t floor = group->pending[k];
+        uint32_t* costs = group->costs[floor];
+        const uint8_t owner = group->owner[floor];
+        costs[car] = LiftGroup_cost(group, car, floor);
+
+        // A car standing at the floor or stopping there anyway keeps the call
+        if ((group->view[owner].floor == floor) || LiftCalls_get(&group->cabin[owner], floor))
+        {
+            continue;
+        }
+
+        uint8_t best = owner;
+        if (owner == car)
+        {
+            for (uint8_t i = 0; i < group->cars; ++i)
+            {
+                if (costs[i] < costs[best])
+                {
+                    best = i;
+                }
+            }
+        }
+        else if (costs[car] < costs[owner])
+        {
+            best = car;
+        }
+
+        if (best != owner)
+        {
+            LiftGroup_reassign(group, floor, best);
+            touched |= (1U << owner) | (1U << best);
+        }
+    }
+
+    // The loads of the cars of a hand-over changed, their cached costs follow
+    for (uint8_t i = 0; touched != 0; ++i, touched >>= 1)
+    {
+        if (touched & 1U)
+        {
+            LiftGroup_rate(group, i);
+        }
+    }
+}
+
+uint8_t LiftGroup_hallCall(LiftGroup_t* group, uint16_t floor)
+{
+    LIFT_ASSERT(group != NULL);
+    LIFT_ASSERT(floor < LIFT_MAX_FLOORS);
+
+    if (group->owner[floor] != LIFT_GROUP_NO_CAR)
+    {
+        return group->owner[floor];
+    }
+
+    // The only full evaluation: a new call is rated with every car
+    uint32_t* costs = group->costs[floor];
+    uint8_t car = 0;
+    for (uint8_t i = 0; i < group->cars; ++i)
+    {
+        costs[i] = LiftGroup_cost(group, i, floor);
+        if (costs[i] < costs[car])
+        {
+            car = i;
+        }
+    }
+
+    LiftCalls_set(&group->hall, floor);
+    group->slot[floor] = group->pending_count;
+    group->pending[group->pending_count++] = floor;
+    group->owner[floor] = car;
+    group->dispatched++;
+    if (LiftGroup_assign(group, car, floor))
+    {
+        LiftGroup_update(group, car);
+    }
+    return group->owner[floor];
+}
+
+void LiftGroup_carCall(LiftGroup_t* group, uint8_t car, uint16_t floor)
+{
+    LIFT_ASSERT(group != NULL);
+    LIFT_ASSERT(car < group->cars);
+    LIFT_ASSERT(floor < LIFT_MAX_FLOORS);
+
+    LiftCalls_set(&group->cabin[car], floor);
+    if (LiftGroup_assign(group, car, floor))
+    {
+        LiftGroup_update(group, car);
+    }
+    else if (group->owner[floor] == car)
+    {
+        // The owner stops at the floor anyway, it is no longer rated without the call
+        group->costs[floor][car] = LiftGroup_cost(group, car, floor);
+    }
+}
+
+/**
+ * @brief Removes a served hall call from the pending list.
+ */
+static inline void LiftGroup_serve(LiftGroup_t* group, uint16_t floor)
+{
+    const uint16_t last = group->pending[--group->pending_count];
+    group->pending[group->slot[floor]] = last;
+    group->slot[last] = group->slot[floor];
+
+    LiftCalls_clear(&group->hall, floor);
+    group->owner[floor] = LIFT_GROUP_NO_CAR;
+    group->served++;
+}
+
+void LiftGroup_step(LiftGroup_t* group)
+{
+    LIFT_ASSERT(group != NULL);
+
+    for (uint8_t i = 0; i < group->cars; ++i)
+    {
+        LiftInputs_t* plant = &group->plant[i];
+        LiftGroupCarView_t* view = &group->view[i];
+        const LiftGroupCarView_t previous = *view;
+
+        const uint16_t floor = plant->state.floor;
+        const SeqNet_Out out = SeqNet_ctxStep(&group->ctx[i], &plant->in);
+        const bool serves = out.req_reset && plant->in.call_pending_same;
+        LiftInputs_apply(plant, &out);
+
+        // Only the fields changed by this step are touched
+        if (serves)
+        {
+            view->load--;
+            LiftCalls_clear(&group->cabin[i], floor);
+            if (group->owner[floor] == i)
+            {
+                LiftGroup_serve(group, floor);
+            }
+        }
+        if (plant->state.floor != floor)
+        {
+            view->floor = plant->state.floor;
+            view->direction = (plant->state.floor > floor) ? 1 : -1;
+        }
+        if (view->load == 0)
+        {
+            view->direction = 0;
+        }
+        view->is_door_open = plant->state.is_door_open;
+
+        if ((view->floor != previous.floor) || (view->direction != previous.direction) ||
+            (view->load != previous.load) || (view->is_door_open != previous.is_door_open))
+        {
+            LiftGroup_update(group, i);
+        }
+    }
+}
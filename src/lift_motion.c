@@ -0,0 +1,657 @@
+/**
+ * @file lift_motion.c
+ * @brief Implements the continuous-time plant with SIMD integration kernels.
+ *
+ * The speed pattern of a car is the jerk-limited braking curve
+ *     v(d) = sqrt(c^2 + 2 * Ab * d) - c,  c = Ab^2 / (2 * J)
+ * (braking with Ab from constant speed ends exactly at distance d), evaluated at the
+ * state the car reaches after releasing its current acceleration. The acceleration
+ * follows the pattern with a feed-forward term and a proportional speed loop, and
+ * changes by at most J * dt per step. The square root is a Newton iteration, so the
+ * model needs no libm and every kernel computes the same bits.
+ */
+
+#include <string.h>
+#include "lift_motion.h"
+#include "seqnet_internal.h"  // for BIT_*
+#include "lift_assert.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define LIFT_MOTION_X86 1
+    #include <immintrin.h>
+#else
+    #define LIFT_MOTION_X86 0
+#endif
+
+/// Share of the acceleration limit used by the braking pattern (the rest is control margin)
+#define LIFT_MOTION_BRAKE_SHARE     (0.8f)
+
+/// Gain of the speed loop [1/s]
+#define LIFT_MOTION_SPEED_GAIN      (6.0f)
+
+/// Speed below which a car inside the level tolerance is levelled [m/s]
+#define LIFT_MOTION_LEVEL_SPEED     (0.01f)
+
+/// Initial guess of the square root: halved exponent of the IEEE-754 single
+#define LIFT_MOTION_SQRT_SEED       (0x1FBD1DF5U)
+
+/**
+ * @brief Per-step constants shared by the kernels.
+ */
+typedef struct
+{
+    float dt;           // Integration step
+    float accel;        // Acceleration limit
+    float jerk_step;    // Acceleration change limit per step
+    float inv_jerk;     // 1 / jerk limit
+    float brake;        // Braking deceleration of the pattern
+    float c;            // Brake^2 / (2 * jerk)
+    float c2;           // c^2
+    float two_brake;    // 2 * brake
+    float speed;        // Rated speed
+    float level;        // Level tolerance
+    float dwell;        // Door hold time
+} LiftMotionConst_t;
+
+/**
+ * @brief Derives the kernel constants from the parameters.
+ */
+static void LiftMotion_const(const LiftMotionParams_t* params, LiftMotionConst_t* k)
+{
+    k->dt = params->dt;
+    k->accel = params->max_accel;
+    k->jerk_step = params->max_jerk * params->dt;
+    k->inv_jerk = 1.0f / params->max_jerk;
+    k->brake = LIFT_MOTION_BRAKE_SHARE * params->max_accel;
+    k->c = k->brake * k->brake * 0.5f * k->inv_jerk;
+    k->c2 = k->c * k->c;
+    k->two_brake = 2.0f * k->brake;
+    k->speed = params->max_speed;
+    k->level = params->level_tolerance;
+    k->dwell = params->door_dwell;
+}
+
+static inline float LiftMotion_min(float a, float b) { return (a < b) ? a : b; }
+static inline float LiftMotion_max(float a, float b) { return (a > b) ? a : b; }
+
+/**
+ * @brief Square root of a positive number, three Newton steps from the exponent guess.
+ */
+static inline float LiftMotion_sqrt(float x)
+{
+    uint32_t bits;
+    float y;
+
+    memcpy(&bits, &x, sizeof(bits));
+    bits = (bits >> 1) + LIFT_MOTION_SQRT_SEED;
+    memcpy(&y, &bits, sizeof(y));
+    y = 0.5f * (y + x / y);
+    y = 0.5f * (y + x / y);
+    y = 0.5f * (y + x / y);
+    return y;
+}
+
+// === Kernels ===
+
+/**
+ * @brief Portable kernel: integrates the cars in [first, count).
+ *
+ * The operations are the lane operations of the vector kernels in the same order.
+ *
+ * @param[in,out] motion  Model to integrate.
+ * @param[in]     k       Kernel constants.
+ * @param[in]     first   Index of the first car to integrate.
+ */
+static void LiftMotion_integrateScalar(LiftMotion_t* motion, const LiftMotionConst_t* k, uint32_t first)
+{
+    const LiftMotionArrays_t* car = &motion->car;
+
+    for (uint32_t i = first; i < motion->count; ++i)
+    {
+        // Work in the direction of the target
+        const float e = car->target[i] - car->position[i];
+        const float s = (e >= 0.0f) ? 1.0f : -1.0f;
+        const float dd = e * s;
+        float vv = car->velocity[i] * s;
+        float aa = car->accel[i] * s;
+
+        // State after releasing the acceleration
+        const float ap = LiftMotion_max(aa, 0.0f);
+        const float tr = ap * k->inv_jerk;
+        const float vq = vv + ap * tr * 0.5f;
+        const float dq = LiftMotion_max(dd - (vv + ap * tr * (1.0f / 3.0f)) * tr, 0.0f);
+
+        // Speed pattern and its slope
+        float vp = LiftMotion_sqrt(k->c2 + k->two_brake * dq) - k->c;
+        float ff = 0.0f - (vq * k->brake) / (vp + k->c);
+        const bool cruise = (vp >= k->speed);
+        vp = cruise ? k->speed : vp;
+        ff = cruise ? 0.0f : ff;
+
+        // Jerk-limited acceleration, then velocity and position
+        const float ar = LiftMotion_min(LiftMotion_max(ff + LIFT_MOTION_SPEED_GAIN * (vp - vq), 0.0f - k->accel), k->accel);
+        aa = aa + LiftMotion_min(LiftMotion_max(ar - aa, 0.0f - k->jerk_step), k->jerk_step);
+        vv = vv + aa * k->dt;
+        float a = aa * s;
+        float v = vv * s;
+        float x = car->position[i] + v * k->dt;
+
+        // Levelling: snap to the floor inside the tolerance at creep speed
+        const float e2 = car->target[i] - x;
+        const bool level = (e2 < k->level) && (e2 > 0.0f - k->level) &&
+                           (v < LIFT_MOTION_LEVEL_SPEED) && (v > 0.0f - LIFT_MOTION_LEVEL_SPEED);
+        car->position[i] = level ? car->target[i] : x;
+        car->velocity[i] = level ? 0.0f : v;
+        car->accel[i] = level ? 0.0f : a;
+
+        // Door travel and hold time
+        const float door = LiftMotion_min(LiftMotion_max(car->door[i] + car->door_rate[i] * k->dt, 0.0f), 1.0f);
+        car->door[i] = door;
+        car->dwell[i] = (door >= 1.0f) ? LiftMotion_max(car->dwell[i] - k->dt, 0.0f) : k->dwell;
+    }
+}
+
+#if LIFT_MOTION_X86
+
+/**
+ * @brief SSE4.1 kernel: 4 cars per iteration.
+ *
+ * @param[in,out] motion  Model to integrate.
+ * @param[in]     k       Kernel constants.
+ * @return Index of the first car left for the scalar tail.
+ */
+__attribute__((target("sse4.1")))
+static uint32_t LiftMotion_integrateSse41(LiftMotion_t* motion, const LiftMotionConst_t* k)
+{
+    const LiftMotionArrays_t* car = &motion->car;
+    const __m128 zero      = _mm_setzero_ps();
+    const __m128 one       = _mm_set1_ps(1.0f);
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    const __m128 half      = _mm_set1_ps(0.5f);
+    const __m128 third     = _mm_set1_ps(1.0f / 3.0f);
+    const __m128 dt        = _mm_set1_ps(k->dt);
+    const __m128 accel     = _mm_set1_ps(k->accel);
+    const __m128 neg_accel = _mm_set1_ps(0.0f - k->accel);
+    const __m128 jerk      = _mm_set1_ps(k->jerk_step);
+    const __m128 neg_jerk  = _mm_set1_ps(0.0f - k->jerk_step);
+    const __m128 inv_jerk  = _mm_set1_ps(k->inv_jerk);
+    const __m128 brake     = _mm_set1_ps(k->brake);
+    const __m128 c         = _mm_set1_ps(k->c);
+    const __m128 c2        = _mm_set1_ps(k->c2);
+    const __m128 two_brake = _mm_set1_ps(k->two_brake);
+    const __m128 speed     = _mm_set1_ps(k->speed);
+    const __m128 gain      = _mm_set1_ps(LIFT_MOTION_SPEED_GAIN);
+    const __m128 level     = _mm_set1_ps(k->level);
+    const __m128 neg_level = _mm_set1_ps(0.0f - k->level);
+    const __m128 creep     = _mm_set1_ps(LIFT_MOTION_LEVEL_SPEED);
+    const __m128 neg_creep = _mm_set1_ps(0.0f - LIFT_MOTION_LEVEL_SPEED);
+    const __m128 dwell     = _mm_set1_ps(k->dwell);
+    const __m128i seed     = _mm_set1_epi32((int32_t)LIFT_MOTION_SQRT_SEED);
+
+    uint32_t i = 0;
+    for (; i + 4 <= motion->count; i += 4)
+    {
+        const __m128 target = _mm_loadu_ps(&car->target[i]);
+        const __m128 pos = _mm_loadu_ps(&car->position[i]);
+
+        const __m128 e = _mm_sub_ps(target, pos);
+        const __m128 s = _mm_blendv_ps(minus_one, one, _mm_cmpge_ps(e, zero));
+        const __m128 dd = _mm_mul_ps(e, s);
+        __m128 vv = _mm_mul_ps(_mm_loadu_ps(&car->velocity[i]), s);
+        __m128 aa = _mm_mul_ps(_mm_loadu_ps(&car->accel[i]), s);
+
+        const __m128 ap = _mm_max_ps(aa, zero);
+        const __m128 tr = _mm_mul_ps(ap, inv_jerk);
+        const __m128 vq = _mm_add_ps(vv, _mm_mul_ps(_mm_mul_ps(ap, tr), half));
+        const __m128 dq = _mm_max_ps(_mm_sub_ps(dd, _mm_mul_ps(_mm_add_ps(vv, _mm_mul_ps(_mm_mul_ps(ap, tr), third)), tr)), zero);
+
+        const __m128 x2 = _mm_add_ps(c2, _mm_mul_ps(two_brake, dq));
+        __m128 y = _mm_castsi128_ps(_mm_add_epi32(_mm_srli_epi32(_mm_castps_si128(x2), 1), seed));
+        y = _mm_mul_ps(half, _mm_add_ps(y, _mm_div_ps(x2, y)));
+        y = _mm_mul_ps(half, _mm_add_ps(y, _mm_div_ps(x2, y)));
+        y = _mm_mul_ps(half, _mm_add_ps(y, _mm_div_ps(x2, y)));
+        __m128 vp = _mm_sub_ps(y, c);
+        __m128 ff = _mm_sub_ps(zero, _mm_div_ps(_mm_mul_ps(vq, brake), _mm_add_ps(vp, c)));
+        const __m128 cruise = _mm_cmpge_ps(vp, speed);
+        vp = _mm_blendv_ps(vp, speed, cruise);
+        ff = _mm_blendv_ps(ff, zero, cruise);
+
+        const __m128 ar = _mm_min_ps(_mm_max_ps(_mm_add_ps(ff, _mm_mul_ps(gain, _mm_sub_ps(vp, vq))), neg_accel), accel);
+        aa = _mm_add_ps(aa, _mm_min_ps(_mm_max_ps(_mm_sub_ps(ar, aa), neg_jerk), jerk));
+        vv = _mm_add_ps(vv, _mm_mul_ps(aa, dt));
+        const __m128 a = _mm_mul_ps(aa, s);
+        const __m128 v = _mm_mul_ps(vv, s);
+        const __m128 x = _mm_add_ps(pos, _mm_mul_ps(v, dt));
+
+        const __m128 e2 = _mm_sub_ps(target, x);
+        const __m128 lev = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(e2, level), _mm_cmpgt_ps(e2, neg_level)),
+                                      _mm_and_ps(_mm_cmplt_ps(v, creep), _mm_cmpgt_ps(v, neg_creep)));
+        _mm_storeu_ps(&car->position[i], _mm_blendv_ps(x, target, lev));
+        _mm_storeu_ps(&car->velocity[i], _mm_blendv_ps(v, zero, lev));
+        _mm_storeu_ps(&car->accel[i], _mm_blendv_ps(a, zero, lev));
+
+        const __m128 door = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_loadu_ps(&car->door[i]),
+                                                             _mm_mul_ps(_mm_loadu_ps(&car->door_rate[i]), dt)), zero), one);
+        _mm_storeu_ps(&car->door[i], door);
+        const __m128 held = _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&car->dwell[i]), dt), zero);
+        _mm_storeu_ps(&car->dwell[i], _mm_blendv_ps(dwell, held, _mm_cmpge_ps(door, one)));
+    }
+
+    return i;
+}
+
+/**
+ * @brief AVX2 kernel: 8 cars per iteration.
+ *
+ * @param[in,out] motion  Model to integrate.
+ * @param[in]     k       Kernel constants.
+ * @return Index of the first car left for the scalar tail.
+ */
+__attribute__((target("avx2")))
+static uint32_t LiftMotion_integrateAvx2(LiftMotion_t* motion, const LiftMotionConst_t* k)
+{
+    const LiftMotionArrays_t* car = &motion->car;
+    const __m256 zero      = _mm256_setzero_ps();
+    const __m256 one       = _mm256_set1_ps(1.0f);
+    const __m256 minus_one = _mm256_set1_ps(-1.0f);
+    const __m256 half      = _mm256_set1_ps(0.5f);
+    const __m256 third     = _mm256_set1_ps(1.0f / 3.0f);
+    const __m256 dt        = _mm256_set1_ps(k->dt);
+    const __m256 accel     = _mm256_set1_ps(k->accel);
+    const __m256 neg_accel = _mm256_set1_ps(0.0f - k->accel);
+    const __m256 jerk      = _mm256_set1_ps(k->jerk_step);
+    const __m256 neg_jerk  = _mm256_set1_ps(0.0f - k->jerk_step);
+    const __m256 inv_jerk  = _mm256_set1_ps(k->inv_jerk);
+    const __m256 brake     = _mm256_set1_ps(k->brake);
+    const __m256 c         = _mm256_set1_ps(k->c);
+    const __m256 c2        = _mm256_set1_ps(k->c2);
+    const __m256 two_brake = _mm256_set1_ps(k->two_brake);
+    const __m256 speed     = _mm256_set1_ps(k->speed);
+    const __m256 gain      = _mm256_set1_ps(LIFT_MOTION_SPEED_GAIN);
+    const __m256 level     = _mm256_set1_ps(k->level);
+    const __m256 neg_level = _mm256_set1_ps(0.0f - k->level);
+    const __m256 creep     = _mm256_set1_ps(LIFT_MOTION_LEVEL_SPEED);
+    const __m256 neg_creep = _mm256_set1_ps(0.0f - LIFT_MOTION_LEVEL_SPEED);
+    const __m256 dwell     = _mm256_set1_ps(k->dwell);
+    const __m256i seed     = _mm256_set1_epi32((int32_t)LIFT_MOTION_SQRT_SEED);
+
+    uint32_t i = 0;
+    for (; i + 8 <= motion->count; i += 8)
+    {
+        const __m256 target = _mm256_loadu_ps(&car->target[i]);
+        const __m256 pos = _mm256_loadu_ps(&car->position[i]);
+
+        const __m256 e = _mm256_sub_ps(target, pos);
+        const __m256 s = _mm256_blendv_ps(minus_one, one, _mm256_cmp_ps(e, zero, _CMP_GE_OQ));
+        const __m256 dd = _mm256_mul_ps(e, s);
+        __m256 vv = _mm256_mul_ps(_mm256_loadu_ps(&car->velocity[i]), s);
+        __m256 aa = _mm256_mul_ps(_mm256_loadu_ps(&car->accel[i]), s);
+
+        const __m256 ap = _mm256_max_ps(aa, zero);
+        const __m256 tr = _mm256_mul_ps(ap, inv_jerk);
+        const __m256 vq = _mm256_add_ps(vv, _mm256_mul_ps(_mm256_mul_ps(ap, tr), half));
+        const __m256 dq = _mm256_max_ps(_mm256_sub_ps(dd, _mm256_mul_ps(_mm256_add_ps(vv, _mm256_mul_ps(_mm256_mul_ps(ap, tr), third)), tr)), zero);
+
+        const __m256 x2 = _mm256_add_ps(c2, _mm256_mul_ps(two_brake, dq));
+        __m256 y = _mm256_castsi256_ps(_mm256_add_epi32(_mm256_srli_epi32(_mm256_castps_si256(x2), 1), seed));
+        y = _mm256_mul_ps(half, _mm256_add_ps(y, _mm256_div_ps(x2, y)));
+        y = _mm256_mul_ps(half, _mm256_add_ps(y, _mm256_div_ps(x2, y)));
+        y = _mm256_mul_ps(half, _mm256_add_ps(y, _mm256_div_ps(x2, y)));
+        __m256 vp = _mm256_sub_ps(y, c);
+        __m256 ff = _mm256_sub_ps(zero, _mm256_div_ps(_mm256_mul_ps(vq, brake), _mm256_add_ps(vp, c)));
+        const __m256 cruise = _mm256_cmp_ps(vp, speed, _CMP_GE_OQ);
+        vp = _mm256_blendv_ps(vp, speed, cruise);
+        ff = _mm256_blendv_ps(ff, zero, cruise);
+
+        const __m256 ar = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(ff, _mm256_mul_ps(gain, _mm256_sub_ps(vp, vq))), neg_accel), accel);
+        aa = _mm256_add_ps(aa, _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(ar, aa), neg_jerk), jerk));
+        vv = _mm256_add_ps(vv, _mm256_mul_ps(aa, dt));
+        const __m256 a = _mm256_mul_ps(aa, s);
+        const __m256 v = _mm256_mul_ps(vv, s);
+        const __m256 x = _mm256_add_ps(pos, _mm256_mul_ps(v, dt));
+
+        const __m256 e2 = _mm256_sub_ps(target, x);
+        const __m256 lev = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(e2, level, _CMP_LT_OQ), _mm256_cmp_ps(e2, neg_level, _CMP_GT_OQ)),
+                                         _mm256_and_ps(_mm256_cmp_ps(v, creep, _CMP_LT_OQ), _mm256_cmp_ps(v, neg_creep, _CMP_GT_OQ)));
+        _mm256_storeu_ps(&car->position[i], _mm256_blendv_ps(x, target, lev));
+        _mm256_storeu_ps(&car->velocity[i], _mm256_blendv_ps(v, zero, lev));
+        _mm256_storeu_ps(&car->accel[i], _mm256_blendv_ps(a, zero, lev));
+
+        const __m256 door = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(_mm256_loadu_ps(&car->door[i]),
+                                                                      _mm256_mul_ps(_mm256_loadu_ps(&car->door_rate[i]), dt)), zero), one);
+        _mm256_storeu_ps(&car->door[i], door);
+        const __m256 held = _mm256_max_ps(_mm256_sub_ps(_mm256_loadu_ps(&car->dwell[i]), dt), zero);
+        _mm256_storeu_ps(&car->dwell[i], _mm256_blendv_ps(dwell, held, _mm256_cmp_ps(door, one, _CMP_GE_OQ)));
+    }
+
+    return i;
+}
+
+#endif // LIFT_MOTION_X86
+
+// === Discrete plant logic ===
+
+/**
+ * @brief Finds the nearest pending call in [lo, hi), scanning upwards or downwards.
+ *
+ * @param[in] calls  Call bitset.
+ * @param[in] lo     First floor of the range.
+ * @param[in] hi     Floor after the last floor of the range.
+ * @param[in] up     Scan direction (true: lowest floor first).
+ * @return Floor of the call, or -1 if the range has no call.
+ */
+static int32_t LiftMotion_findCall(const LiftCalls_t* calls, uint32_t lo, uint32_t hi, bool up)
+{
+    if (lo >= hi) return -1;
+
+    const uint32_t first = lo / LIFT_CALL_WORD_BITS;
+    const uint32_t last = (hi - 1U) / LIFT_CALL_WORD_BITS;
+
+    for (uint32_t n = 0; n <= last - first; ++n)
+    {
+        const uint32_t w = up ? (first + n) : (last - n);
+        uint64_t bits = calls->words[w];
+        if (w == first) bits &= ~0ULL << (lo % LIFT_CALL_WORD_BITS);
+        if (w == last) bits &= ~0ULL >> (LIFT_CALL_WORD_BITS - 1U - ((hi - 1U) % LIFT_CALL_WORD_BITS));
+        if (bits != 0)
+        {
+            const uint32_t bit = up ? (uint32_t)__builtin_ctzll(bits) : 63U - (uint32_t)__builtin_clzll(bits);
+            return (int32_t)(w * LIFT_CALL_WORD_BITS + bit);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Returns whether a running car can still stop at a distance (in its direction).
+ *
+ * Same pattern as the kernels: the speed after releasing the acceleration must not
+ * exceed the pattern speed of the distance left after the release.
+ */
+static bool LiftMotion_canStop(const LiftMotionConst_t* k, float distance, float vv, float aa)
+{
+    const float ap = LiftMotion_max(aa, 0.0f);
+    const float tr = ap * k->inv_jerk;
+    const float vq = vv + ap * tr * 0.5f;
+    const float dq = distance - (vv + ap * tr * (1.0f / 3.0f)) * tr;
+
+    return (dq >= 0.0f) && ((vq <= 0.0f) || (k->c2 + k->two_brake * dq >= (vq + k->c) * (vq + k->c)));
+}
+
+/**
+ * @brief Moves the target of a running car to the nearest call it can still stop at.
+ */
+static void LiftMotion_retarget(LiftMotion_t* motion, const LiftMotionConst_t* k, uint32_t i)
+{
+    const LiftMotionArrays_t* car = &motion->car;
+    const float height = motion->params.floor_height;
+    const bool up = (car->direction[i] > 0);
+    const float s = up ? 1.0f : -1.0f;
+    const float q = car->position[i] / height;
+    const int32_t target = (int32_t)(car->target[i] / height + 0.5f);
+    int32_t below = (int32_t)q;  // Position is never below floor 0 by more than the tolerance
+    if ((float)below > q) below--;
+
+    // First floor ahead the car can stop at
+    int32_t f = up ? (below + 1) : (((float)below < q) ? below : (below - 1));
+    while ((up ? (f < target) : (f > target)) && !LiftMotion_canStop(k, ((float)f * height - car->position[i]) * s,
+                                                car->velocity[i] * s, car->accel[i] * s))
+    {
+        f += up ? 1 : -1;
+    }
+    if (up ? (f >= target) : (f <= target)) return;
+
+    const int32_t call = up ? LiftMotion_findCall(&car->plant[i].state.calls, (uint32_t)f, (uint32_t)target, true)
+                            : LiftMotion_findCall(&car->plant[i].state.calls, (uint32_t)target + 1U, (uint32_t)f + 1U, false);
+    if (call >= 0)
+    {
+        car->target[i] = (float)call * height;
+    }
+}
+
+/**
+ * @brief Starts a run of a levelled car with a closed door, if a floor is reachable.
+ */
+static void LiftMotion_start(LiftMotion_t* motion, uint32_t i, bool up)
+{
+    const LiftMotionArrays_t* car = &motion->car;
+    const uint32_t floor = car->plant[i].state.floor;
+    int32_t call = up ? LiftMotion_findCall(&car->plant[i].state.calls, floor + 1U, motion->params.floors, true)
+                      : LiftMotion_findCall(&car->plant[i].state.calls, 0, floor, false);
+
+    if (call < 0)
+    {
+        // No call in the direction: one floor, as LiftPlant_apply() would
+        if (up ? (floor + 1U >= motion->params.floors) : (floor == 0)) return;
+        call = up ? (int32_t)floor + 1 : (int32_t)floor - 1;
+    }
+
+    car->target[i] = (float)call * motion->params.floor_height;
+    car->direction[i] = up ? 1 : -1;
+    car->plant[i].state.is_moving = true;
+}
+
+/**
+ * @brief Updates the floor, the arrival and the condition inputs of one car.
+ */
+static void LiftMotion_senseCar(LiftMotion_t* motion, uint32_t i)
+{
+    const LiftMotionArrays_t* car = &motion->car;
+    LiftInputs_t* plant = &car->plant[i];
+
+    // Arrival: the kernel snapped the car onto its target
+    if ((car->direction[i] != 0) && (car->position[i] == car->target[i]) && (car->velocity[i] == 0.0f))
+    {
+        car->direction[i] = 0;
+        plant->state.is_moving = false;
+    }
+
+    // Floor: nearest floor level
+    const float q = car->position[i] / motion->params.floor_height + 0.5f;
+    uint32_t floor = (q > 0.0f) ? (uint32_t)q : 0U;
+    if (floor >= motion->params.floors) floor = motion->params.floors - 1U;
+    while (plant->state.floor < floor) LiftInputs_floorUp(plant);
+    while (plant->state.floor > floor) LiftInputs_floorDown(plant);
+
+    // Door end positions (the plant owns these fields, the hooks only know open or closed)
+    plant->state.is_door_open = (car->door[i] > 0.0f);
+    plant->in.door_open = (car->door[i] >= 1.0f);
+    plant->in.door_closed = (car->door[i] <= 0.0f);
+
+    // Same-floor arrival is only reported for a levelled car
+    CondSel_Mask mask = CondSel_pack(&plant->in);
+    if (car->direction[i] != 0) mask &= (CondSel_Mask)~CONDSEL_MASK_SAME;
+    car->in[i] = mask;
+}
+
+// === API functions ===
+
+void LiftMotionParams_default(LiftMotionParams_t* params, uint16_t floors)
+{
+    LIFT_ASSERT(params != NULL);
+
+    params->dt = 0.01f;
+    params->floor_height = 3.5f;
+    params->max_speed = 1.6f;
+    params->max_accel = 1.0f;
+    params->max_jerk = 1.5f;
+    params->level_tolerance = 0.002f;
+    params->door_time = 2.5f;
+    params->door_dwell = 2.0f;
+    params->floors = floors;
+}
+
+void LiftMotion_init(LiftMotion_t* motion, const LiftMotionParams_t* params,
+                     const LiftMotionArrays_t* arrays, uint32_t count)
+{
+    LIFT_ASSERT(motion != NULL);
+    LIFT_ASSERT(params != NULL);
+    LIFT_ASSERT(arrays != NULL);
+    LIFT_ASSERT((params->floors >= 2U) && (params->floors <= LIFT_MAX_FLOORS));
+    LIFT_ASSERT((params->dt > 0.0f) && (params->max_jerk > 0.0f) && (params->door_time > 0.0f));
+
+    motion->params = *params;
+    motion->car = *arrays;
+    motion->count = count;
+
+    const LiftState_t ground = { .floor = 0, .is_door_open = false, .is_moving = false, .calls = LIFT_CALLS_NONE };
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        LiftMotion_place(motion, i, &ground);
+    }
+
+    LiftMotion_select(motion, SEQNET_BATCH_KERNEL_AUTO);
+}
+
+/**
+ * @brief Selects the integration kernel, falling back to the best supported one.
+ */
+SeqNetBatchKernel_t LiftMotion_select(LiftMotion_t* motion, SeqNetBatchKernel_t requested)
+{
+    LIFT_ASSERT(motion != NULL);
+
+    SeqNetBatchKernel_t kernel = SEQNET_BATCH_KERNEL_SCALAR;
+
+#if LIFT_MOTION_X86
+    __builtin_cpu_init();
+    const bool has_avx2 = __builtin_cpu_supports("avx2");
+    const bool has_sse41 = __builtin_cpu_supports("sse4.1");
+
+    if (((requested == SEQNET_BATCH_KERNEL_AUTO) || (requested == SEQNET_BATCH_KERNEL_AVX2)) && has_avx2)
+    {
+        kernel = SEQNET_BATCH_KERNEL_AVX2;
+    }
+    else if ((requested != SEQNET_BATCH_KERNEL_SCALAR) && has_sse41)
+    {
+        kernel = SEQNET_BATCH_KERNEL_SSE41;
+    }
+#else
+    (void)requested;
+#endif
+
+    motion->kernel = kernel;
+    return kernel;
+}
+
+void LiftMotion_place(LiftMotion_t* motion, uint32_t car, const LiftState_t* state)
+{
+    LIFT_ASSERT(motion != NULL);
+    LIFT_ASSERT(state != NULL);
+    LIFT_ASSERT(car < motion->count);
+    LIFT_ASSERT(state->floor < motion->params.floors);
+
+    const LiftMotionArrays_t* arrays = &motion->car;
+    const float rate = 1.0f / motion->params.door_time;
+
+    arrays->position[car] = (float)state->floor * motion->params.floor_height;
+    arrays->velocity[car] = 0.0f;
+    arrays->accel[car] = 0.0f;
+    arrays->target[car] = arrays->position[car];
+    arrays->door[car] = state->is_door_open ? 1.0f : 0.0f;
+    arrays->door_rate[car] = state->is_door_open ? rate : -rate;
+    arrays->dwell[car] = 0.0f;
+    arrays->direction[car] = 0;
+
+    LiftState_t levelled = *state;
+    levelled.is_moving = false;
+    LiftInputs_init(&arrays->plant[car], &levelled);
+    LiftMotion_senseCar(motion, car);
+}
+
+/**
+ * @brief Applies the output words: door commands, call resets and latched move requests.
+ */
+void LiftMotion_command(LiftMotion_t* motion, const uint16_t* out)
+{
+    LIFT_ASSERT(motion != NULL);
+    LIFT_ASSERT((motion->count == 0) || (out != NULL));
+
+    const LiftMotionArrays_t* car = &motion->car;
+    const float rate = 1.0f / motion->params.door_time;
+    LiftMotionConst_t k;
+    LiftMotion_const(&motion->params, &k);
+
+    for (uint32_t i = 0; i < motion->count; ++i)
+    {
+        const uint16_t word = out[i];
+        const bool up = ((word >> BIT_MOVE_UP) & 1U) != 0;
+        const bool down = ((word >> BIT_MOVE_DOWN) & 1U) != 0;
+        const bool levelled = (car->direction[i] == 0);
+        LIFT_ASSERT(!(up && down));
+
+        // DOORS: only a levelled car opens, an open door is held for the dwell time
+        if (((word >> BIT_DOOR_STATE) & 1U) == DOOR_REQ_OPEN)
+        {
+            car->door_rate[i] = levelled ? rate : -rate;
+        }
+        else
+        {
+            car->door_rate[i] = ((car->door[i] >= 1.0f) && (car->dwell[i] > 0.0f)) ? rate : -rate;
+        }
+
+        // CALLS
+        if ((((word >> BIT_REQ_RESET) & 1U) != 0) && levelled)
+        {
+            LiftInputs_callReset(&car->plant[i]);
+        }
+
+        // MOVEMENT
+        if (!levelled)
+        {
+            LiftMotion_retarget(motion, &k, i);
+        }
+        else if ((up || down) && (car->door[i] <= 0.0f) && !car->plant[i].in.call_pending_same)
+        {
+            LiftMotion_start(motion, i, up);
+        }
+    }
+}
+
+/**
+ * @brief Advances the motion and the door of every car by one integration step.
+ *
+ * The vector kernels handle full groups of 4 or 8 cars, the rest is integrated by the scalar loop.
+ */
+void LiftMotion_integrate(LiftMotion_t* motion)
+{
+    LIFT_ASSERT(motion != NULL);
+
+    LiftMotionConst_t k;
+    LiftMotion_const(&motion->params, &k);
+    uint32_t first = 0;
+
+#if LIFT_MOTION_X86
+    switch (motion->kernel)
+    {
+        case SEQNET_BATCH_KERNEL_AVX2:
+            first = LiftMotion_integrateAvx2(motion, &k);
+            break;
+
+        case SEQNET_BATCH_KERNEL_SSE41:
+            first = LiftMotion_integrateSse41(motion, &k);
+            break;
+
+        default:
+            break;
+    }
+#endif
+
+    LiftMotion_integrateScalar(motion, &k, first);
+}
+
+void LiftMotion_sense(LiftMotion_t* motion)
+{
+    LIFT_ASSERT(motion != NULL);
+
+    for (uint32_t i = 0; i < motion->count; ++i)
+    {
+        LiftMotion_senseCar(motion, i);
+    }
+}
+
+void LiftMotion_step(LiftMotion_t* motion, const uint16_t* out)
+{
+    LiftMotion_command(motion, out);
+    LiftMotion_integrate(motion);
+    LiftMotion_sense(motion);
+}
@@ -0,0 +1,238 @@
+/**
+ * @file lift_plant.c
+ * @brief Implements the emulated lift plant.
+ */
+
+#include <string.h>
+#include "lift_plant.h"
+#include "seqnet_internal.h"  // for DOOR_REQ_*
+#include "lift_assert.h"
+
+/**
+ * @brief Converts a high-level lift state into condition selector input format.
+ *
+ * This function takes the current elevator state (floor, door, calls)
+ * and fills a CondSel_In structure used for evaluating logic conditions.
+ *
+ * @param[in]  state  Pointer to the current lift state.
+ * @param[out] out    Pointer to the output CondSel_In structure to be filled.
+ */
+void LiftStateArray_convert(const LiftState_t* state, CondSel_In* out)
+{
+    // Door state
+    out->door_closed = !state->is_door_open;
+    out->door_open = state->is_door_open;
+    /*printf("O: %d, C: %d\n",
+           out->door_open ? 1 : 0,
+           out->door_closed ? 1 : 0);*/
+
+    // Calls: the words below and above the word of the floor only need a zero test
+    const uint32_t word = state->floor / LIFT_CALL_WORD_BITS;
+    const uint32_t bit = state->floor % LIFT_CALL_WORD_BITS;
+    uint64_t below = 0;
+    uint64_t above = 0;
+    bool same = false;
+
+    if (word < LIFT_CALL_WORDS)
+    {
+        const uint64_t current = state->calls.words[word];
+        const uint64_t same_bit = 1ULL << bit;
+        below = current & (same_bit - 1U);
+        same = (current & same_bit) != 0;
+        above = current & ~(same_bit | (same_bit - 1U));
+    }
+
+    for (uint32_t i = 0; i < LIFT_CALL_WORDS; ++i)
+    {
+        if (i < word) below |= state->calls.words[i];
+        if (i > word) above |= state->calls.words[i];
+    }
+
+    out->call_pending_below = (below != 0);
+    out->call_pending_same  = same;
+    out->call_pending_above = (above != 0);
+}
+
+/**
+ * @brief Applies the outputs of one controller step to the lift state.
+ *
+ * @param[in,out] state  Lift state to update.
+ * @param[in]     out    Outputs of the executed instruction.
+ */
+void LiftPlant_apply(LiftState_t* state, const SeqNet_Out* out)
+{
+    // DOORS
+    if (DOOR_REQ_OPEN == out->req_door_state)
+    {
+        state->is_door_open = true;
+    }
+    else if (DOOR_REQ_CLOSE == out->req_door_state)
+    {
+        state->is_door_open = false;
+    }
+
+    // CALLS
+    if (out->req_reset)
+    {
+        // Reset the call state for the current floor
+        if (state->floor < LIFT_MAX_FLOORS)
+        {
+            LiftCalls_clear(&state->calls, state->floor);
+        }
+    }
+
+    // MOVEMENT
+    if (out->req_move_up && !out->req_move_down)
+    {
+        state->is_moving = true;
+        state->floor++;
+    }
+    else if (out->req_move_down && !out->req_move_up)
+    {
+        state->is_moving = true;
+        state->floor--;
+    }
+    else if (!out->req_move_down && !out->req_move_up)
+    {
+        state->is_moving = false; // Stop moving if no direction is requested
+    }
+    else
+    {
+        LIFT_ASSERT(false);
+    }
+}
+
+uint32_t LiftCalls_count(const LiftCalls_t* calls)
+{
+    LIFT_ASSERT(calls != NULL);
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < LIFT_CALL_WORDS; ++i)
+    {
+        count += (uint32_t)__builtin_popcountll(calls->words[i]);
+    }
+    return count;
+}
+
+bool LiftCalls_equal(const LiftCalls_t* a, const LiftCalls_t* b)
+{
+    LIFT_ASSERT(a != NULL);
+    LIFT_ASSERT(b != NULL);
+
+    return memcmp(a->words, b->words, sizeof(a->words)) == 0;
+}
+
+bool LiftState_equal(const LiftState_t* a, const LiftState_t* b)
+{
+    LIFT_ASSERT(a != NULL);
+    LIFT_ASSERT(b != NULL);
+
+    return (a->floor == b->floor) && (a->is_door_open == b->is_door_open) && (a->is_moving == b->is_moving) &&
+           LiftCalls_equal(&a->calls, &b->calls);
+}
+
+const char* LiftCalls_format(const LiftCalls_t* calls, char* text)
+{
+    LIFT_ASSERT(calls != NULL);
+    LIFT_ASSERT(text != NULL);
+
+    char* end = text;
+    for (uint32_t i = 0; i < LIFT_MAX_FLOORS; ++i)
+    {
+        if (i != 0)
+        {
+            *end++ = ',';
+            *end++ = ' ';
+        }
+        *end++ = LiftCalls_get(calls, (uint16_t)i) ? '1' : '0';
+    }
+    *end = '\0';
+    return text;
+}
+
+void LiftInputs_init(LiftInputs_t* inputs, const LiftState_t* state)
+{
+    LIFT_ASSERT(inputs != NULL);
+    LIFT_ASSERT(state != NULL);
+
+    inputs->state = *state;
+    LiftStateArray_convert(&inputs->state, &inputs->in);
+    LiftInputs_sync(inputs);
+}
+
+void LiftInputs_sync(LiftInputs_t* inputs)
+{
+    LIFT_ASSERT(inputs != NULL);
+
+    const uint32_t word = inputs->state.floor / LIFT_CALL_WORD_BITS;
+    const uint64_t same_bit = 1ULL << (inputs->state.floor % LIFT_CALL_WORD_BITS);
+    uint32_t below = 0;
+    uint32_t above = 0;
+    bool same = false;
+
+    for (uint32_t i = 0; i < LIFT_CALL_WORDS; ++i)
+    {
+        const uint64_t bits = inputs->state.calls.words[i];
+        if (i < word)
+        {
+            below += (uint32_t)__builtin_popcountll(bits);
+        }
+        else if (i > word)
+        {
+            above += (uint32_t)__builtin_popcountll(bits);
+        }
+        else
+        {
+            below += (uint32_t)__builtin_popcountll(bits & (same_bit - 1U));
+            above += (uint32_t)__builtin_popcountll(bits & ~(same_bit | (same_bit - 1U)));
+            same = (bits & same_bit) != 0;
+        }
+    }
+
+    inputs->below = (uint16_t)below;
+    inputs->above = (uint16_t)above;
+    inputs->in.call_pending_below = (below != 0);
+    inputs->in.call_pending_same  = same;
+    inputs->in.call_pending_above = (above != 0);
+}
+
+/**
+ * @brief Applies the outputs of one controller step through the hooks.
+ *
+ * @param[in,out] inputs  Tracker to update.
+ * @param[in]     out     Outputs of the executed instruction.
+ */
+void LiftInputs_apply(LiftInputs_t* inputs, const SeqNet_Out* out)
+{
+    // DOORS
+    if ((DOOR_REQ_OPEN == out->req_door_state) != inputs->state.is_door_open)
+    {
+        LiftInputs_door(inputs, DOOR_REQ_OPEN == out->req_door_state);
+    }
+
+    // CALLS
+    if (out->req_reset)
+    {
+        LiftInputs_callReset(inputs);
+    }
+
+    // MOVEMENT
+    if (out->req_move_up && !out->req_move_down)
+    {
+        inputs->state.is_moving = true;
+        LiftInputs_floorUp(inputs);
+    }
+    else if (out->req_move_down && !out->req_move_up)
+    {
+        inputs->state.is_moving = true;
+        LiftInputs_floorDown(inputs);
+    }
+    else if (!out->req_move_down && !out->req_move_up)
+    {
+        inputs->state.is_moving = false; // Stop moving if no direction is requested
+    }
+    else
+    {
+        LIFT_ASSERT(false);
+    }
+}
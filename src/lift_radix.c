@@ -0,0 +1,131 @@
+/**
+ * @file lift_radix.c
+ * @brief Implements the radix heap.
+ */
+
+#include "lift_radix.h"
+#include "lift_assert.h"
+
+/**
+ * @brief Returns the bucket of a key: 0 for the last key, else 1 + the highest differing bit.
+ */
+static inline uint32_t LiftRadix_bucket(uint64_t last, uint64_t key)
+{
+    const uint64_t diff = key ^ last;
+    return (diff == 0) ? 0U : (64U - (uint32_t)__builtin_clzll(diff));
+}
+
+/**
+ * @brief Links a node into its bucket.
+ */
+static inline void LiftRadix_link(LiftRadixHeap_t* heap, uint32_t node)
+{
+    const uint32_t bucket = LiftRadix_bucket(heap->last, heap->nodes[node].key);
+    heap->nodes[node].next = heap->heads[bucket];
+    heap->heads[bucket] = node;
+    if (bucket != 0)
+    {
+        heap->used |= 1ULL << (bucket - 1U);
+    }
+}
+
+void LiftRadix_init(LiftRadixHeap_t* heap, LiftRadixNode_t* nodes, uint32_t capacity)
+{
+    LIFT_ASSERT(heap != NULL);
+    LIFT_ASSERT((nodes != NULL) || (capacity == 0));
+
+    heap->nodes = nodes;
+    heap->capacity = capacity;
+    heap->count = 0;
+    heap->last = 0;
+    heap->used = 0;
+    for (uint32_t i = 0; i < LIFT_RADIX_BUCKETS; ++i)
+    {
+        heap->heads[i] = LIFT_RADIX_NONE;
+    }
+
+    // Free list through every node
+    heap->free = (capacity > 0) ? 0U : LIFT_RADIX_NONE;
+    for (uint32_t i = 0; i < capacity; ++i)
+    {
+        nodes[i].next = (i + 1U < capacity) ? i + 1U : LIFT_RADIX_NONE;
+    }
+}
+
+bool LiftRadix_push(LiftRadixHeap_t* heap, uint64_t key, uint32_t value)
+{
+    LIFT_ASSERT(heap != NULL);
+    LIFT_ASSERT(key >= heap->last);
+
+    const uint32_t node = heap->free;
+    if (node == LIFT_RADIX_NONE)
+    {
+        return false;
+    }
+    heap->free = heap->nodes[node].next;
+
+    heap->nodes[node].key = key;
+    heap->nodes[node].value = value;
+    LiftRadix_link(heap, node);
+    heap->count++;
+    return true;
+}
+
+bool LiftRadix_top(LiftRadixHeap_t* heap, uint64_t* key)
+{
+    LIFT_ASSERT(heap != NULL);
+    LIFT_ASSERT(key != NULL);
+
+    if (heap->count == 0)
+    {
+        return false;
+    }
+
+    if (heap->heads[0] == LIFT_RADIX_NONE)
+    {
+        // The lowest non-empty bucket holds the minimum; it becomes the new last key and
+        // every node of the bucket moves to a lower one
+        const uint32_t bucket = 1U + (uint32_t)__builtin_ctzll(heap->used);
+        uint32_t node = heap->heads[bucket];
+        uint64_t min = heap->nodes[node].key;
+        for (uint32_t i = heap->nodes[node].next; i != LIFT_RADIX_NONE; i = heap->nodes[i].next)
+        {
+            if (heap->nodes[i].key < min)
+            {
+                min = heap->nodes[i].key;
+            }
+        }
+
+        heap->last = min;
+        heap->heads[bucket] = LIFT_RADIX_NONE;
+        heap->used &= ~(1ULL << (bucket - 1U));
+        while (node != LIFT_RADIX_NONE)
+        {
+            const uint32_t next = heap->nodes[node].next;
+            LiftRadix_link(heap, node);
+            node = next;
+        }
+    }
+
+    *key = heap->last;
+    return true;
+}
+
+bool LiftRadix_pop(LiftRadixHeap_t* heap, uint64_t* key, uint32_t* value)
+{
+    LIFT_ASSERT(value != NULL);
+
+    if (!LiftRadix_top(heap, key))
+    {
+        return false;
+    }
+
+    const uint32_t node = heap->heads[0];
+    heap->heads[0] = heap->nodes[node].next;
+    *value = heap->nodes[node].value;
+
+    heap->nodes[node].next = heap->free;
+    heap->free = node;
+    heap->count--;
+    return true;
+}
@@ -0,0 +1,612 @@
+/**
+ * @file lift_scenario.c
+ * @brief Implements the scenario files and the streaming runner.
+ */
+
+#include <string.h>
+#include "lift_scenario.h"
+#include "lift_thread.h"
+#include "lift_assert.h"
+
+/// Size of the fixed part of a binary record in bytes
+#define LIFT_SCENARIO_RECORD_SIZE       (12U)
+/// Size of a binary injection in bytes
+#define LIFT_SCENARIO_INJECTION_SIZE    (6U)
+
+/// Flags of a binary record
+#define LIFT_SCENARIO_FLAG_INITIAL_OPEN     (1U << 0)
+#define LIFT_SCENARIO_FLAG_INITIAL_MOVING   (1U << 1)
+#define LIFT_SCENARIO_FLAG_END_OPEN         (1U << 2)
+#define LIFT_SCENARIO_FLAG_END_MOVING       (1U << 3)
+
+/**
+ * @brief Work shared by the workers of one batch.
+ */
+typedef struct
+{
+    const LiftScenario_t* batch;
+    const SeqNet_Program* program;
+    uint32_t count;        // Scenarios of the batch
+    uint32_t cursor;       // Next unclaimed scenario (atomic)
+} LiftScenarioJob_t;
+
+/**
+ * @brief Argument of one worker: the shared job and the outcome of the worker.
+ */
+typedef struct
+{
+    LiftScenarioJob_t* job;
+    uint32_t passed;       // Passed scenarios
+    uint32_t first_failed; // Lowest failing index in the batch, UINT32_MAX if none
+} LiftScenarioWorker_t;
+
+static inline uint16_t LiftScenario_get16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t LiftScenario_get32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void LiftScenario_put16(uint8_t* p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static inline void LiftScenario_put32(uint8_t* p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief Checks the floors of a scenario and the order of its injections.
+ */
+static LiftScenarioStatus_t LiftScenario_check(const LiftScenario_t* scenario)
+{
+    if ((scenario->initial_state.floor >= LIFT_MAX_FLOORS) || (scenario->end_state.floor >= LIFT_MAX_FLOORS))
+    {
+        return LIFT_SCENARIO_BAD_FLOOR;
+    }
+    for (uint32_t i = 0; i < scenario->injection_count; ++i)
+    {
+        if (scenario->injections[i].floor >= LIFT_MAX_FLOORS) return LIFT_SCENARIO_BAD_FLOOR;
+        if ((i > 0) && (scenario->injections[i].tick < scenario->injections[i - 1U].tick)) return LIFT_SCENARIO_SYNTAX;
+    }
+    return LIFT_SCENARIO_OK;
+}
+
+/* ---------------------------------------------------------------------------------------------- */
+/* Text form                                                                                      */
+/* ---------------------------------------------------------------------------------------------- */
+
+static const char* LiftScenarioText_skip(const char* p)
+{
+    while ((*p == ' ') || (*p == '\t')) ++p;
+    return p;
+}
+
+/**
+ * @brief Parses a decimal number below 2^32.
+ */
+static bool LiftScenarioText_number(const char** p, uint32_t* value)
+{
+    const char* s = *p;
+    uint64_t v = 0;
+
+    if ((*s < '0') || (*s > '9')) return false;
+    while ((*s >= '0') && (*s <= '9'))
+    {
+        v = v * 10U + (uint64_t)(*s - '0');
+        if (v > UINT32_MAX) return false;
+        ++s;
+    }
+    *p = s;
+    *value = (uint32_t)v;
+    return true;
+}
+
+/**
+ * @brief Matches a keyword followed by a separator.
+ */
+static bool LiftScenarioText_keyword(const char** p, const char* keyword)
+{
+    const size_t length = strlen(keyword);
+    const char end = (*p)[length];
+
+    if ((strncmp(*p, keyword, length) != 0) || !((end == ' ') || (end == '\t') || (end == '|') || (end == '\0')))
+    {
+        return false;
+    }
+    *p += length;
+    return true;
+}
+
+/**
+ * @brief Parses "floor door motion calls" of a state.
+ */
+static LiftScenarioStatus_t LiftScenarioText_state(const char** p, LiftState_t* state)
+{
+    uint32_t value;
+    const char* s = LiftScenarioText_skip(*p);
+
+    memset(state, 0, sizeof(LiftState_t));
+    if (!LiftScenarioText_number(&s, &value)) return LIFT_SCENARIO_SYNTAX;
+    if (value >= LIFT_MAX_FLOORS) return LIFT_SCENARIO_BAD_FLOOR;
+    state->floor = (uint16_t)value;
+
+    s = LiftScenarioText_skip(s);
+    if (LiftScenarioText_keyword(&s, "open")) state->is_door_open = true;
+    else if (!LiftScenarioText_keyword(&s, "closed")) return LIFT_SCENARIO_SYNTAX;
+
+    s = LiftScenarioText_skip(s);
+    if (LiftScenarioText_keyword(&s, "moving")) state->is_moving = true;
+    else if (!LiftScenarioText_keyword(&s, "idle")) return LIFT_SCENARIO_SYNTAX;
+
+    s = LiftScenarioText_skip(s);
+    if (!LiftScenarioText_keyword(&s, "-"))
+    {
+        for (;;)
+        {
+            if (!LiftScenarioText_number(&s, &value)) return LIFT_SCENARIO_SYNTAX;
+            if (value >= LIFT_MAX_FLOORS) return LIFT_SCENARIO_BAD_FLOOR;
+            LiftCalls_set(&state->calls, (uint16_t)value);
+            if (*s != ',') break;
+            ++s;
+        }
+    }
+
+    *p = LiftScenarioText_skip(s);
+    return LIFT_SCENARIO_OK;
+}
+
+/**
+ * @brief Parses one scenario line (comment and line end already removed).
+ */
+static LiftScenarioStatus_t LiftScenarioText_parse(const char* p, LiftScenario_t* scenario)
+{
+    uint32_t value;
+    LiftScenarioStatus_t status;
+
+    // pc steps
+    p = LiftScenarioText_skip(p);
+    if (!LiftScenarioText_number(&p, &value) || (value >= SEQNET_PROGMEM_SIZE)) return LIFT_SCENARIO_SYNTAX;
+    scenario->PC_preset = (uint8_t)value;
+    p = LiftScenarioText_skip(p);
+    if (!LiftScenarioText_number(&p, &scenario->steps)) return LIFT_SCENARIO_SYNTAX;
+
+    // | initial | end
+    p = LiftScenarioText_skip(p);
+    if (*p++ != '|') return LIFT_SCENARIO_SYNTAX;
+    if ((status = LiftScenarioText_state(&p, &scenario->initial_state)) != LIFT_SCENARIO_OK) return status;
+    if (*p++ != '|') return LIFT_SCENARIO_SYNTAX;
+    if ((status = LiftScenarioText_state(&p, &scenario->end_state)) != LIFT_SCENARIO_OK) return status;
+
+    // [| tick:floor ...]
+    scenario->injection_count = 0;
+    if (*p == '|')
+    {
+        p = LiftScenarioText_skip(p + 1);
+        while (*p != '\0')
+        {
+            uint32_t tick;
+            if (!LiftScenarioText_number(&p, &tick) || (*p++ != ':') || !LiftScenarioText_number(&p, &value))
+            {
+                return LIFT_SCENARIO_SYNTAX;
+            }
+            if (value >= LIFT_MAX_FLOORS) return LIFT_SCENARIO_BAD_FLOOR;
+            if (scenario->injection_count >= LIFT_SCENARIO_MAX_INJECTIONS) return LIFT_SCENARIO_TOO_MANY;
+
+            LiftCallInjection_t* injection = &scenario->injections[scenario->injection_count++];
+            injection->tick = tick;
+            injection->floor = (uint16_t)value;
+            p = LiftScenarioText_skip(p);
+        }
+    }
+
+    return (*p == '\0') ? LiftScenario_check(scenario) : LIFT_SCENARIO_SYNTAX;
+}
+
+/**
+ * @brief Reads text lines until a scenario is found.
+ */
+static LiftScenarioStatus_t LiftScenarioText_next(LiftScenarioReader_t* reader, LiftScenario_t* scenario)
+{
+    for (;;)
+    {
+        if (fgets(reader->text, sizeof(reader->text), reader->in) == NULL)
+        {
+            return ferror(reader->in) ? LIFT_SCENARIO_IO_ERROR : LIFT_SCENARIO_END;
+        }
+        reader->line++;
+
+        // A line filling the buffer without its end is too long
+        size_t length = strlen(reader->text);
+        if ((length == sizeof(reader->text) - 1U) && (reader->text[length - 1U] != '\n') && !feof(reader->in))
+        {
+            return LIFT_SCENARIO_SYNTAX;
+        }
+
+        char* comment = strchr(reader->text, '#');
+        if (comment != NULL) *comment = '\0';
+        length = strcspn(reader->text, "\r\n");
+        reader->text[length] = '\0';
+
+        if (*LiftScenarioText_skip(reader->text) != '\0')
+        {
+            return LiftScenarioText_parse(reader->text, scenario);
+        }
+    }
+}
+
+/**
+ * @brief Writes "floor door motion calls" of a state.
+ */
+static void LiftScenarioText_writeState(FILE* out, const LiftState_t* state)
+{
+    fprintf(out, "%u %s %s ", (unsigned)state->floor, state->is_door_open ? "open" : "closed",
+            state->is_moving ? "moving" : "idle");
+
+    bool first = true;
+    for (uint32_t w = 0; w < LIFT_CALL_WORDS; ++w)
+    {
+        for (uint64_t bits = state->calls.words[w]; bits != 0; bits &= bits - 1U)
+        {
+            fprintf(out, first ? "%u" : ",%u", (unsigned)(w * LIFT_CALL_WORD_BITS + (uint32_t)__builtin_ctzll(bits)));
+            first = false;
+        }
+    }
+    if (first) fputc('-', out);
+}
+
+/* ---------------------------------------------------------------------------------------------- */
+/* Binary form                                                                                    */
+/* ---------------------------------------------------------------------------------------------- */
+
+/**
+ * @brief Unpacks the call bytes of a state, the bits above LIFT_MAX_FLOORS must be zero.
+ */
+static bool LiftScenarioBinary_calls(const uint8_t* bytes, uint32_t count, LiftCalls_t* calls)
+{
+    memset(calls, 0, sizeof(LiftCalls_t));
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (bytes[i] == 0) continue;
+        if (i >= LIFT_SCENARIO_CALL_BYTES) return false;
+        calls->words[i / 8U] |= (uint64_t)bytes[i] << (8U * (i % 8U));
+    }
+    const uint32_t top = LIFT_MAX_FLOORS % LIFT_CALL_WORD_BITS;
+    return (top == 0) || ((calls->words[LIFT_CALL_WORDS - 1U] >> top) == 0);
+}
+
+static LiftScenarioStatus_t LiftScenarioBinary_next(LiftScenarioReader_t* reader, LiftScenario_t* scenario)
+{
+    uint8_t* bytes = (uint8_t*)reader->text;
+    const size_t read = fread(bytes, 1, LIFT_SCENARIO_RECORD_SIZE, reader->in);
+    if (read != LIFT_SCENARIO_RECORD_SIZE)
+    {
+        return ferror(reader->in) ? LIFT_SCENARIO_IO_ERROR : (read == 0) ? LIFT_SCENARIO_END : LIFT_SCENARIO_TRUNCATED;
+    }
+
+    const uint8_t flags = bytes[5];
+    scenario->steps = LiftScenario_get32(&bytes[0]);
+    scenario->PC_preset = bytes[4];
+    scenario->injection_count = LiftScenario_get16(&bytes[6]);
+    scenario->initial_state.floor = LiftScenario_get16(&bytes[8]);
+    scenario->initial_state.is_door_open = (flags & LIFT_SCENARIO_FLAG_INITIAL_OPEN) != 0;
+    scenario->initial_state.is_moving = (flags & LIFT_SCENARIO_FLAG_INITIAL_MOVING) != 0;
+    scenario->end_state.floor = LiftScenario_get16(&bytes[10]);
+    scenario->end_state.is_door_open = (flags & LIFT_SCENARIO_FLAG_END_OPEN) != 0;
+    scenario->end_state.is_moving = (flags & LIFT_SCENARIO_FLAG_END_MOVING) != 0;
+    if ((scenario->PC_preset >= SEQNET_PROGMEM_SIZE) || (flags > 0x0FU)) return LIFT_SCENARIO_SYNTAX;
+    if (scenario->injection_count > LIFT_SCENARIO_MAX_INJECTIONS) return LIFT_SCENARIO_TOO_MANY;
+
+    // Calls of both states, then the injections
+    const uint32_t calls_size = 2U * reader->call_bytes;
+    if (fread(bytes, 1, calls_size, reader->in) != calls_size)
+    {
+        return ferror(reader->in) ? LIFT_SCENARIO_IO_ERROR : LIFT_SCENARIO_TRUNCATED;
+    }
+    if (!LiftScenarioBinary_calls(bytes, reader->call_bytes, &scenario->initial_state.calls) ||
+        !LiftScenarioBinary_calls(&bytes[reader->call_bytes], reader->call_bytes, &scenario->end_state.calls))
+    {
+        return LIFT_SCENARIO_BAD_FLOOR;
+    }
+
+    const uint32_t injections_size = scenario->injection_count * LIFT_SCENARIO_INJECTION_SIZE;
+    if (fread(bytes, 1, injections_size, reader->in) != injections_size)
+    {
+        return ferror(reader->in) ? LIFT_SCENARIO_IO_ERROR : LIFT_SCENARIO_TRUNCATED;
+    }
+    for (uint32_t i = 0; i < scenario->injection_count; ++i)
+    {
+        scenario->injections[i].tick = LiftScenario_get32(&bytes[i * LIFT_SCENARIO_INJECTION_SIZE]);
+        scenario->injections[i].floor = LiftScenario_get16(&bytes[i * LIFT_SCENARIO_INJECTION_SIZE + 4U]);
+    }
+
+    return LiftScenario_check(scenario);
+}
+
+static void LiftScenarioBinary_write(LiftScenarioWriter_t* writer, const LiftScenario_t* scenario)
+{
+    uint8_t bytes[LIFT_SCENARIO_RECORD_SIZE + 2U * LIFT_SCENARIO_CALL_BYTES];
+    const uint8_t flags = (uint8_t)((scenario->initial_state.is_door_open ? LIFT_SCENARIO_FLAG_INITIAL_OPEN : 0U) |
+                                    (scenario->initial_state.is_moving ? LIFT_SCENARIO_FLAG_INITIAL_MOVING : 0U) |
+                                    (scenario->end_state.is_door_open ? LIFT_SCENARIO_FLAG_END_OPEN : 0U) |
+                                    (scenario->end_state.is_moving ? LIFT_SCENARIO_FLAG_END_MOVING : 0U));
+
+    LiftScenario_put32(&bytes[0], scenario->steps);
+    bytes[4] = scenario->PC_preset;
+    bytes[5] = flags;
+    LiftScenario_put16(&bytes[6], scenario->injection_count);
+    LiftScenario_put16(&bytes[8], scenario->initial_state.floor);
+    LiftScenario_put16(&bytes[10], scenario->end_state.floor);
+    for (uint32_t i = 0; i < LIFT_SCENARIO_CALL_BYTES; ++i)
+    {
+        bytes[LIFT_SCENARIO_RECORD_SIZE + i] = (uint8_t)(scenario->initial_state.calls.words[i / 8U] >> (8U * (i % 8U)));
+        bytes[LIFT_SCENARIO_RECORD_SIZE + LIFT_SCENARIO_CALL_BYTES + i] =
+            (uint8_t)(scenario->end_state.calls.words[i / 8U] >> (8U * (i % 8U)));
+    }
+    writer->error |= (fwrite(bytes, 1, sizeof(bytes), writer->out) != sizeof(bytes));
+
+    for (uint32_t i = 0; i < scenario->injection_count; ++i)
+    {
+        uint8_t injection[LIFT_SCENARIO_INJECTION_SIZE];
+        LiftScenario_put32(&injection[0], scenario->injections[i].tick);
+        LiftScenario_put16(&injection[4], scenario->injections[i].floor);
+        writer->error |= (fwrite(injection, 1, sizeof(injection), writer->out) != sizeof(injection));
+    }
+}
+
+/* ---------------------------------------------------------------------------------------------- */
+/* Reader and writer                                                                              */
+/* ---------------------------------------------------------------------------------------------- */
+
+LiftScenarioStatus_t LiftScenarioReader_begin(LiftScenarioReader_t* reader, FILE* in)
+{
+    LIFT_ASSERT(reader != NULL);
+    LIFT_ASSERT(in != NULL);
+
+    memset(reader, 0, sizeof(LiftScenarioReader_t));
+    reader->in = in;
+    reader->format = LIFT_SCENARIO_TEXT;
+
+    // A text file starts with a digit, a comment or a blank, a binary one with the magic 'L'
+    const int first = getc(in);
+    if (first == EOF) return ferror(in) ? LIFT_SCENARIO_IO_ERROR : LIFT_SCENARIO_OK;
+    if (first != (int)(LIFT_SCENARIO_MAGIC & 0xFFU))
+    {
+        return (ungetc(first, in) == first) ? LIFT_SCENARIO_OK : LIFT_SCENARIO_IO_ERROR;
+    }
+
+    uint8_t header[LIFT_SCENARIO_HEADER_SIZE];
+    header[0] = (uint8_t)first;
+    if (fread(&header[1], 1, sizeof(header) - 1U, in) != sizeof(header) - 1U)
+    {
+        return ferror(in) ? LIFT_SCENARIO_IO_ERROR : LIFT_SCENARIO_TRUNCATED;
+    }
+    if (LiftScenario_get32(&header[0]) != LIFT_SCENARIO_MAGIC) return LIFT_SCENARIO_BAD_MAGIC;
+    if (LiftScenario_get16(&header[4]) != LIFT_SCENARIO_VERSION) return LIFT_SCENARIO_BAD_VERSION;
+
+    // Both call vectors of a record are read into the line buffer
+    reader->format = LIFT_SCENARIO_BINARY;
+    reader->call_bytes = LiftScenario_get16(&header[6]);
+    if ((2U * reader->call_bytes > sizeof(reader->text)) ||
+        (LIFT_SCENARIO_MAX_INJECTIONS * LIFT_SCENARIO_INJECTION_SIZE > sizeof(reader->text)))
+    {
+        return LIFT_SCENARIO_BAD_FLOOR;
+    }
+    return LIFT_SCENARIO_OK;
+}
+
+LiftScenarioStatus_t LiftScenarioReader_next(LiftScenarioReader_t* reader, LiftScenario_t* scenario)
+{
+    LIFT_ASSERT(reader != NULL);
+    LIFT_ASSERT(scenario != NULL);
+
+    const LiftScenarioStatus_t status = (reader->format == LIFT_SCENARIO_BINARY) ?
+                                        LiftScenarioBinary_next(reader, scenario) :
+                                        LiftScenarioText_next(reader, scenario);
+    reader->index += (status == LIFT_SCENARIO_OK);
+    return status;
+}
+
+LiftScenarioStatus_t LiftScenarioWriter_begin(LiftScenarioWriter_t* writer, FILE* out, LiftScenarioFormat_t format)
+{
+    LIFT_ASSERT(writer != NULL);
+    LIFT_ASSERT(out != NULL);
+
+    memset(writer, 0, sizeof(LiftScenarioWriter_t));
+    writer->out = out;
+    writer->format = format;
+
+    if (format == LIFT_SCENARIO_BINARY)
+    {
+        uint8_t header[LIFT_SCENARIO_HEADER_SIZE];
+        LiftScenario_put32(&header[0], LIFT_SCENARIO_MAGIC);
+        LiftScenario_put16(&header[4], LIFT_SCENARIO_VERSION);
+        LiftScenario_put16(&header[6], (uint16_t)LIFT_SCENARIO_CALL_BYTES);
+        writer->error = (fwrite(header, 1, sizeof(header), out) != sizeof(header));
+    }
+    else
+    {
+        writer->error = (fputs("# pc steps | floor door motion calls | floor door motion calls | tick:floor ...\n", out) < 0);
+    }
+    return writer->error ? LIFT_SCENARIO_IO_ERROR : LIFT_SCENARIO_OK;
+}
+
+LiftScenarioStatus_t LiftScenarioWriter_add(LiftScenarioWriter_t* writer, const LiftScenario_t* scenario)
+{
+    LIFT_ASSERT(writer != NULL);
+    LIFT_ASSERT(scenario != NULL);
+
+    if (scenario->injection_count > LIFT_SCENARIO_MAX_INJECTIONS) return LIFT_SCENARIO_TOO_MANY;
+
+    if (writer->format == LIFT_SCENARIO_BINARY)
+    {
+        LiftScenarioBinary_write(writer, scenario);
+    }
+    else
+    {
+        fprintf(writer->out, "%u %u | ", (unsigned)scenario->PC_preset, (unsigned)scenario->steps);
+        LiftScenarioText_writeState(writer->out, &scenario->initial_state);
+        fputs(" | ", writer->out);
+        LiftScenarioText_writeState(writer->out, &scenario->end_state);
+        if (scenario->injection_count != 0)
+        {
+            fputs(" |", writer->out);
+            for (uint32_t i = 0; i < scenario->injection_count; ++i)
+            {
+                fprintf(writer->out, " %u:%u", (unsigned)scenario->injections[i].tick,
+                        (unsigned)scenario->injections[i].floor);
+            }
+        }
+        writer->error |= (fputc('\n', writer->out) == EOF);
+    }
+
+    writer->count++;
+    return writer->error ? LIFT_SCENARIO_IO_ERROR : LIFT_SCENARIO_OK;
+}
+
+LiftScenarioStatus_t LiftScenarioWriter_end(LiftScenarioWriter_t* writer)
+{
+    LIFT_ASSERT(writer != NULL);
+
+    writer->error |= (fflush(writer->out) != 0) || (ferror(writer->out) != 0);
+    return writer->error ? LIFT_SCENARIO_IO_ERROR : LIFT_SCENARIO_OK;
+}
+
+/* ---------------------------------------------------------------------------------------------- */
+/* Runner                                                                                         */
+/* ---------------------------------------------------------------------------------------------- */
+
+bool LiftScenario_run(const LiftScenario_t* scenario, const SeqNet_Program* program, LiftScenarioResult_t* result)
+{
+    LIFT_ASSERT(scenario != NULL);
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT(result != NULL);
+
+    LiftInputs_t plant;
+    SeqNet_Ctx ctx;
+    uint32_t next = 0;
+
+    SeqNet_ctxInit(&ctx, program);
+    ctx.pc = scenario->PC_preset;
+    LiftInputs_init(&plant, &scenario->initial_state);
+
+    for (uint32_t step = 0; step < scenario->steps; ++step)
+    {
+        // Calls of the tick arrive before the controller step
+        while ((next < scenario->injection_count) && (scenario->injections[next].tick == step))
+        {
+            LiftInputs_callSet(&plant, scenario->injections[next++].floor);
+        }
+
+        const uint8_t pc = ctx.pc;
+        SeqNet_ctxStepRaw(&ctx, &plant.in);
+        LiftInputs_apply(&plant, &program->decoded[pc]);
+    }
+
+    result->end_state = plant.state;
+    result->end_pc = ctx.pc;
+    result->passed = LiftState_equal(&result->end_state, &scenario->end_state);
+    return result->passed;
+}
+
+/**
+ * @brief Worker of a batch: claims scenarios until none is left.
+ */
+static void LiftScenario_worker(void* arg)
+{
+    LiftScenarioWorker_t* worker = (LiftScenarioWorker_t*)arg;
+    LiftScenarioJob_t* job = worker->job;
+
+    for (;;)
+    {
+        const uint32_t i = __atomic_fetch_add(&job->cursor, 1U, __ATOMIC_RELAXED);
+        if (i >= job->count) break;
+
+        LiftScenarioResult_t result;
+        if (LiftScenario_run(&job->batch[i], job->program, &result))
+        {
+            worker->passed++;
+        }
+        else if (i < worker->first_failed)
+        {
+            worker->first_failed = i;
+        }
+    }
+}
+
+bool LiftScenario_stream(LiftScenarioReader_t* reader, const SeqNet_Program* program, LiftScenario_t* batch,
+                         uint32_t capacity, uint32_t threads, LiftScenarioReport_t* report)
+{
+    LIFT_ASSERT(reader != NULL);
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT((batch != NULL) && (capacity > 0));
+    LIFT_ASSERT((threads > 0) && (threads <= LIFT_THREAD_MAX));
+    LIFT_ASSERT(report != NULL);
+
+    LiftScenarioWorker_t workers[LIFT_THREAD_MAX];
+    memset(report, 0, sizeof(LiftScenarioReport_t));
+    report->first_failed = UINT64_MAX;
+
+    do
+    {
+        // Fill the batch, a read error ends the run after the scenarios read before it
+        uint32_t count = 0;
+        report->status = LIFT_SCENARIO_OK;
+        while ((count < capacity) && (report->status == LIFT_SCENARIO_OK))
+        {
+            report->status = LiftScenarioReader_next(reader, &batch[count]);
+            count += (report->status == LIFT_SCENARIO_OK);
+        }
+
+        LiftScenarioJob_t job = { .batch = batch, .program = program, .count = count, .cursor = 0 };
+        const uint32_t used = (count < threads) ? ((count != 0) ? count : 1U) : threads;
+        for (uint32_t t = 0; t < used; ++t)
+        {
+            workers[t].job = &job;
+            workers[t].passed = 0;
+            workers[t].first_failed = UINT32_MAX;
+        }
+        LiftThread_runAll(LiftScenario_worker, workers, sizeof(LiftScenarioWorker_t), used);
+
+        uint32_t first_failed = UINT32_MAX;
+        for (uint32_t t = 0; t < used; ++t)
+        {
+            report->passed += workers[t].passed;
+            first_failed = (workers[t].first_failed < first_failed) ? workers[t].first_failed : first_failed;
+        }
+        if ((first_failed != UINT32_MAX) && (report->first_failed == UINT64_MAX))
+        {
+            report->first_failed = report->count + first_failed;
+        }
+        report->count += count;
+    } while (report->status == LIFT_SCENARIO_OK);
+
+    report->line = reader->line;
+    return (report->status == LIFT_SCENARIO_END) && (report->passed == report->count);
+}
+
+const char* LiftScenarioStatus_name(LiftScenarioStatus_t status)
+{
+    switch (status)
+    {
+    case LIFT_SCENARIO_OK:          return "OK";
+    case LIFT_SCENARIO_END:         return "END";
+    case LIFT_SCENARIO_IO_ERROR:    return "IO_ERROR";
+    case LIFT_SCENARIO_BAD_MAGIC:   return "BAD_MAGIC";
+    case LIFT_SCENARIO_BAD_VERSION: return "BAD_VERSION";
+    case LIFT_SCENARIO_TRUNCATED:   return "TRUNCATED";
+    case LIFT_SCENARIO_SYNTAX:      return "SYNTAX";
+    case LIFT_SCENARIO_BAD_FLOOR:   return "BAD_FLOOR";
+    case LIFT_SCENARIO_TOO_MANY:    return "TOO_MANY";
+    default:                        return "UNKNOWN";
+    }
+}
@@ -0,0 +1,397 @@
+/**
+ * @file lift_search.c
+ * @brief Implements the parallel genetic search of microprograms.
+ */
+
+#include <string.h>
+#include "lift_search.h"
+#include "lift_plant.h"
+#include "lift_thread.h"
+#include "lift_random.h"
+#include "seqnet_internal.h"  // for BIT_*, MASK_*
+#include "lift_assert.h"
+
+/// Kinds of word mutations (@see LiftSearch_mutate)
+#define LIFT_SEARCH_MUTATION_KINDS      (5U)
+
+/**
+ * @brief Work shared by the workers of one evaluation round.
+ */
+typedef struct
+{
+    LiftSearch_t* search;
+    const uint16_t* slots;     // Pool slots to evaluate
+    const uint8_t* skip;       // Non-zero for the slots not to evaluate (duplicates)
+    uint32_t count;            // Number of slots
+    uint32_t cursor;           // Next unclaimed slot (atomic)
+    uint32_t rejected;         // Invalid candidates (atomic)
+} LiftSearchJob_t;
+
+/**
+ * @brief Argument of one worker: the shared job and the table of the worker.
+ */
+typedef struct
+{
+    LiftSearchJob_t* job;
+    SeqNetTable_t* table;
+} LiftSearchWorker_t;
+
+/**
+ * @brief Runs one suite scenario, stopping at the first invariant violation.
+ * @return Returns with true, if the scenario ends in its expected state without a violation.
+ */
+static bool LiftSearch_scenario(const LiftTestCase_t* test, const SeqNet_Program* program,
+                                LiftSearchFitness_t* fitness, uint8_t* visited)
+{
+    LiftInputs_t plant;
+    SeqNet_Ctx ctx;
+    SeqNet_ctxInit(&ctx, program);
+    ctx.pc = test->PC_preset;
+    LiftInputs_init(&plant, &test->initial_state);
+
+    bool served = LiftState_equal(&plant.state, &test->end_state);
+    uint32_t steps = 0;
+
+    for (uint32_t step = 0; step < test->steps; ++step)
+    {
+        const SeqNet_Out* out = &program->decoded[ctx.pc];
+        const bool open = (DOOR_REQ_OPEN == out->req_door_state);
+        const bool moves = out->req_move_up || out->req_move_down;
+
+        // Same invariants as the model checker, checked before the plant is touched
+        if ((out->req_move_up && out->req_move_down) || (open && moves) ||
+            (out->req_move_up && (plant.state.floor + 1U >= LIFT_MAX_FLOORS)) ||
+            (out->req_move_down && (plant.state.floor == 0)))
+        {
+            return false;
+        }
+
+        visited[ctx.pc] = 1;
+        fitness->door_cycles += (open && !plant.state.is_door_open);
+        SeqNet_ctxStep(&ctx, &plant.in);
+        LiftInputs_apply(&plant, out);
+
+        if (!served && LiftState_equal(&plant.state, &test->end_state))
+        {
+            served = true;
+            steps = step + 1U;
+        }
+    }
+
+    fitness->steps += steps;
+    return LiftState_equal(&plant.state, &test->end_state);
+}
+
+bool LiftSearch_evaluate(const LiftSearchConfig_t* config, const SeqNet_Program* program,
+                         SeqNetTable_t* table, LiftSearchFitness_t* fitness)
+{
+    LIFT_ASSERT(config != NULL);
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT(table != NULL);
+    LIFT_ASSERT(fitness != NULL);
+
+    uint8_t visited[SEQNET_PROGMEM_SIZE];
+    memset(visited, 0, sizeof(visited));
+    memset(fitness, 0, sizeof(LiftSearchFitness_t));
+
+    // Suite first: it is short and rejects most broken candidates
+    for (uint32_t i = 0; i < config->case_count; ++i)
+    {
+        if (!LiftSearch_scenario(&config->cases[i], program, fitness, visited))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        fitness->words += visited[pc];
+    }
+
+    // Random traffic, stopping at the first failing scenario
+    if (config->traffic_count != 0)
+    {
+        LiftFuzzReport_t report;
+        SeqNetTable_build(table, program);
+        LiftFuzz_run(table, &config->traffic, config->traffic_seed, config->traffic_count, &report);
+        if (report.verdict != LIFT_CHECK_OK)
+        {
+            return false;
+        }
+    }
+
+    fitness->valid = true;
+    return true;
+}
+
+int LiftSearchFitness_compare(const LiftSearchFitness_t* a, const LiftSearchFitness_t* b)
+{
+    if (a->valid != b->valid) return a->valid ? -1 : 1;
+    if (!a->valid) return 0;
+    if (a->steps != b->steps) return (a->steps < b->steps) ? -1 : 1;
+    if (a->door_cycles != b->door_cycles) return (a->door_cycles < b->door_cycles) ? -1 : 1;
+    if (a->words != b->words) return (a->words < b->words) ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Worker of an evaluation round: claims slots until none is left.
+ */
+static void LiftSearch_worker(void* arg)
+{
+    LiftSearchWorker_t* worker = (LiftSearchWorker_t*)arg;
+    LiftSearchJob_t* job = worker->job;
+    LiftSearchCandidate_t* pool = job->search->workspace.pool;
+    uint32_t rejected = 0;
+
+    for (;;)
+    {
+        const uint32_t i = __atomic_fetch_add(&job->cursor, 1U, __ATOMIC_RELAXED);
+        if (i >= job->count) break;
+        if (job->skip[i]) continue;
+
+        LiftSearchCandidate_t* candidate = &pool[job->slots[i]];
+        rejected += !LiftSearch_evaluate(&job->search->config, &candidate->program, worker->table, &candidate->fitness);
+    }
+
+    __atomic_fetch_add(&job->rejected, rejected, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Evaluates the candidates of the given slots on the configured threads.
+ * @return Returns with the number of rejected candidates.
+ */
+static uint32_t LiftSearch_evaluateAll(LiftSearch_t* search, const uint16_t* slots, const uint8_t* skip, uint32_t count)
+{
+    LiftSearchJob_t job = {
+        .search = search,
+        .slots = slots,
+        .skip = skip,
+        .count = count,
+        .cursor = 0,
+        .rejected = 0
+    };
+    LiftSearchWorker_t workers[LIFT_THREAD_MAX];
+
+    for (uint32_t t = 0; t < search->config.threads; ++t)
+    {
+        workers[t].job = &job;
+        workers[t].table = &search->workspace.tables[t];
+    }
+
+    LiftThread_runAll(LiftSearch_worker, workers, sizeof(LiftSearchWorker_t), search->config.threads);
+    return job.rejected;
+}
+
+/**
+ * @brief Applies one random mutation to a word of a program image.
+ */
+static void LiftSearch_mutate(LiftSearch_t* search, uint16_t* words)
+{
+    const uint32_t length = search->config.length;
+    const uint64_t r = LiftRandom_next64(&search->random);
+    uint16_t* word = &words[(r >> 8) % length];
+    const uint32_t value = (uint32_t)(r >> 32);
+
+    switch (r % LIFT_SEARCH_MUTATION_KINDS)
+    {
+    case 0: // Jump address
+        *word = (uint16_t)((*word & ~(MASK_JUMP_ADDR << BIT_JUMP_ADDR)) | ((value % length) << BIT_JUMP_ADDR));
+        break;
+    case 1: // Condition
+        *word = (uint16_t)((*word & ~(MASK_COND_SEL << BIT_COND_SEL)) | ((value & MASK_COND_SEL) << BIT_COND_SEL));
+        break;
+    case 2: // Inversion
+        *word ^= (uint16_t)(1U << BIT_COND_INV);
+        break;
+    case 3: // One output: move up, move down, door or reset
+        *word ^= (uint16_t)(1U << (BIT_MOVE_UP + (value & 3U)));
+        break;
+    default: // Copy of another word
+        *word = words[value % length];
+        break;
+    }
+}
+
+/**
+ * @brief Picks a parent by a binary tournament over the ranked population.
+ */
+static const LiftSearchCandidate_t* LiftSearch_select(LiftSearch_t* search)
+{
+    const uint64_t r = LiftRandom_next64(&search->random);
+    const uint32_t a = (uint32_t)(r % search->config.population);
+    const uint32_t b = (uint32_t)((r >> 32) % search->config.population);
+    return &search->workspace.pool[search->rank[(a < b) ? a : b]];
+}
+
+/**
+ * @brief Mutates a copy of @p parent (and crosses it with @p other if given) into @p child.
+ */
+static void LiftSearch_breed(LiftSearch_t* search, const LiftSearchCandidate_t* parent,
+                             const LiftSearchCandidate_t* other, LiftSearchCandidate_t* child)
+{
+    memcpy(child->program.words, parent->program.words, sizeof(child->program.words));
+
+    // One-point crossover inside the mutable words
+    if (other != NULL)
+    {
+        const uint32_t cut = (uint32_t)(LiftRandom_next64(&search->random) % search->config.length);
+        memcpy(&child->program.words[cut], &other->program.words[cut],
+               (search->config.length - cut) * sizeof(uint16_t));
+    }
+
+    const uint32_t mutations = 1U + (uint32_t)(LiftRandom_next64(&search->random) % search->config.mutations);
+    for (uint32_t m = 0; m < mutations; ++m)
+    {
+        LiftSearch_mutate(search, child->program.words);
+    }
+
+    SeqNetProgram_decode(&child->program);
+    memset(&child->fitness, 0, sizeof(LiftSearchFitness_t));
+}
+
+/**
+ * @brief Checks whether the program of @p child equals one of the given slots.
+ */
+static bool LiftSearch_duplicate(const LiftSearch_t* search, const LiftSearchCandidate_t* child,
+                                 const uint16_t* slots, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const LiftSearchCandidate_t* other = &search->workspace.pool[slots[i]];
+        if ((other != child) && (other->program.id == child->program.id) &&
+            (memcmp(other->program.words, child->program.words, sizeof(child->program.words)) == 0))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Ranks the pool slots from best to worst, equal candidates keep their order.
+ */
+static void LiftSearch_sort(LiftSearch_t* search, uint16_t* slots, uint32_t count)
+{
+    const LiftSearchCandidate_t* pool = search->workspace.pool;
+
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        const uint16_t slot = slots[i];
+        uint32_t j = i;
+        while ((j > 0) && (LiftSearchFitness_compare(&pool[slot].fitness, &pool[slots[j - 1U]].fitness) < 0))
+        {
+            slots[j] = slots[j - 1U];
+            --j;
+        }
+        slots[j] = slot;
+    }
+}
+
+void LiftSearch_init(LiftSearch_t* search, const LiftSearchConfig_t* config,
+                     const LiftSearchWorkspace_t* workspace, const SeqNet_Program* seed)
+{
+    LIFT_ASSERT(search != NULL);
+    LIFT_ASSERT(config != NULL);
+    LIFT_ASSERT(workspace != NULL);
+    LIFT_ASSERT(seed != NULL);
+    LIFT_ASSERT((config->cases != NULL) || (config->case_count == 0));
+    LIFT_ASSERT(config->population > 0);
+    LIFT_ASSERT((uint32_t)config->population + config->offspring <= LIFT_SEARCH_MAX_POOL);
+    LIFT_ASSERT((config->length > 0) && (config->length <= SEQNET_PROGMEM_SIZE));
+    LIFT_ASSERT(config->mutations > 0);
+    LIFT_ASSERT((config->threads > 0) && (config->threads <= LIFT_THREAD_MAX));
+
+    memset(search, 0, sizeof(LiftSearch_t));
+    search->config = *config;
+    search->workspace = *workspace;
+    search->random = config->seed | 1U;  // xorshift must not start from 0
+
+    // The seed and its mutants, the mutants equal to an earlier member are not evaluated
+    const uint32_t population = config->population;
+    uint8_t skip[LIFT_SEARCH_MAX_POOL];
+    LiftSearchCandidate_t* pool = workspace->pool;
+
+    pool[0].program = *seed;
+    skip[0] = 0;
+    search->rank[0] = 0;
+    for (uint32_t i = 1; i < population; ++i)
+    {
+        LiftSearch_breed(search, &pool[0], NULL, &pool[i]);
+        search->rank[i] = (uint16_t)i;
+        skip[i] = LiftSearch_duplicate(search, &pool[i], search->rank, i);
+    }
+
+    LiftSearch_evaluateAll(search, search->rank, skip, population);
+    search->evaluated = population;
+    LiftSearch_sort(search, search->rank, population);
+}
+
+void LiftSearch_generation(LiftSearch_t* search, LiftSearchReport_t* report)
+{
+    LIFT_ASSERT(search != NULL);
+    LIFT_ASSERT(report != NULL);
+
+    const uint32_t population = search->config.population;
+    const uint32_t offspring = search->config.offspring;
+    const uint32_t total = population + offspring;
+    uint16_t* children = &search->rank[population];
+    uint8_t skip[LIFT_SEARCH_MAX_POOL];
+    uint8_t is_child[LIFT_SEARCH_MAX_POOL];
+
+    memset(report, 0, sizeof(LiftSearchReport_t));
+    memset(is_child, 0, sizeof(is_child));
+
+    // Children go to the slots ranked below the population (the first generation uses the unused ones)
+    if (search->generation == 0)
+    {
+        for (uint32_t i = 0; i < offspring; ++i)
+        {
+            children[i] = (uint16_t)(population + i);
+        }
+    }
+
+    // Breeding is sequential, so the children only depend on the seed
+    for (uint32_t i = 0; i < offspring; ++i)
+    {
+        const LiftSearchCandidate_t* parent = LiftSearch_select(search);
+        const LiftSearchCandidate_t* other = NULL;
+        if ((population > 1) && (LiftRandom_next64(&search->random) & 1U))
+        {
+            other = LiftSearch_select(search);
+        }
+
+        LiftSearchCandidate_t* child = &search->workspace.pool[children[i]];
+        LiftSearch_breed(search, parent, other, child);
+        skip[i] = LiftSearch_duplicate(search, child, search->rank, population + i);
+        is_child[children[i]] = 1;
+        report->duplicates += skip[i];
+    }
+
+    report->bred = offspring;
+    report->rejected = LiftSearch_evaluateAll(search, children, skip, offspring);
+    search->evaluated += offspring - report->duplicates;
+
+    // (mu + lambda) selection: children first, so an equal child replaces its parent (neutral drift)
+    uint16_t order[LIFT_SEARCH_MAX_POOL];
+    memcpy(order, children, offspring * sizeof(uint16_t));
+    memcpy(&order[offspring], search->rank, population * sizeof(uint16_t));
+    LiftSearch_sort(search, order, total);
+    memcpy(search->rank, order, total * sizeof(uint16_t));
+
+    search->generation++;
+    report->generation = search->generation;
+    report->best = search->workspace.pool[search->rank[0]].fitness;
+    for (uint32_t i = 0; i < population; ++i)
+    {
+        report->valid += search->workspace.pool[search->rank[i]].fitness.valid;
+        report->accepted += is_child[search->rank[i]];
+    }
+}
+
+const LiftSearchCandidate_t* LiftSearch_best(const LiftSearch_t* search)
+{
+    LIFT_ASSERT(search != NULL);
+
+    return &search->workspace.pool[search->rank[0]];
+}
@@ -0,0 +1,105 @@
+/**
+ * @file lift_snapshot.c
+ * @brief Implements snapshots of a running simulation.
+ */
+
+#include "lift_snapshot.h"
+#include "seqnet_internal.h"  // for SeqNetPC_*, SeqNetProgram_get
+#include "lift_assert.h"
+
+/**
+ * @brief Packs a plant state into a snapshot.
+ */
+static void LiftSnapshot_pack(LiftSnapshot_t* snapshot, const LiftState_t* state)
+{
+    snapshot->floor = state->floor;
+    snapshot->flags = (uint8_t)((state->is_door_open ? LIFT_SNAPSHOT_DOOR_OPEN : 0U) |
+                                (state->is_moving ? LIFT_SNAPSHOT_MOVING : 0U));
+    snapshot->calls = state->calls;
+}
+
+/**
+ * @brief Unpacks the plant state of a snapshot.
+ */
+static void LiftSnapshot_unpack(const LiftSnapshot_t* snapshot, LiftState_t* state)
+{
+    state->floor = snapshot->floor;
+    state->is_door_open = (snapshot->flags & LIFT_SNAPSHOT_DOOR_OPEN) != 0;
+    state->is_moving = (snapshot->flags & LIFT_SNAPSHOT_MOVING) != 0;
+    state->calls = snapshot->calls;
+}
+
+void LiftSnapshot_take(LiftSnapshot_t* snapshot, const SeqNet_Ctx* ctx, const LiftState_t* state)
+{
+    LIFT_ASSERT(snapshot != NULL);
+    LIFT_ASSERT(ctx != NULL);
+    LIFT_ASSERT(state != NULL);
+
+    snapshot->program_id = ctx->program->id;
+    snapshot->pc = ctx->pc;
+    LiftSnapshot_pack(snapshot, state);
+}
+
+bool LiftSnapshot_restore(const LiftSnapshot_t* snapshot, SeqNet_Ctx* ctx, LiftState_t* state)
+{
+    LIFT_ASSERT(snapshot != NULL);
+    LIFT_ASSERT(ctx != NULL);
+    LIFT_ASSERT(state != NULL);
+
+    if (ctx->program->id != snapshot->program_id)
+    {
+        return false;
+    }
+
+    ctx->pc = snapshot->pc;
+    LiftSnapshot_unpack(snapshot, state);
+    return true;
+}
+
+void LiftSnapshot_takeGlobal(LiftSnapshot_t* snapshot, const LiftState_t* state)
+{
+    LIFT_ASSERT(snapshot != NULL);
+    LIFT_ASSERT(state != NULL);
+
+    snapshot->program_id = SeqNetProgram_get()->id;
+    snapshot->pc = SeqNetPC_get();
+    LiftSnapshot_pack(snapshot, state);
+}
+
+bool LiftSnapshot_restoreGlobal(const LiftSnapshot_t* snapshot, LiftState_t* state)
+{
+    LIFT_ASSERT(snapshot != NULL);
+    LIFT_ASSERT(state != NULL);
+
+    if (SeqNetProgram_get()->id != snapshot->program_id)
+    {
+        return false;
+    }
+
+    SeqNetPC_set(snapshot->pc);
+    LiftSnapshot_unpack(snapshot, state);
+    return true;
+}
+
+uint32_t LiftSnapshot_fork(const LiftSnapshot_t* snapshot, const SeqNet_Program* program,
+                           SeqNet_Ctx* ctxs, LiftState_t* states, uint32_t count)
+{
+    LIFT_ASSERT(snapshot != NULL);
+    LIFT_ASSERT(program != NULL);
+
+    if ((program->id != snapshot->program_id) || (count == 0))
+    {
+        return 0;
+    }
+
+    // Unpack once, then copy
+    SeqNet_ctxInit(&ctxs[0], program);
+    ctxs[0].pc = snapshot->pc;
+    LiftSnapshot_unpack(snapshot, &states[0]);
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        ctxs[i] = ctxs[0];
+        states[i] = states[0];
+    }
+    return count;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file lift_thread.c
+ * @brief Implements the thread shim.
+ */
+
+#include "lift_thread.h"
+#include "lift_assert.h"
+
+#if defined(_WIN32)
+
+static DWORD WINAPI LiftThread_entry(LPVOID param)
+{
+    LiftThread_t* thread = (LiftThread_t*)param;
+    thread->fn(thread->arg);
+    return 0;
+}
+
+bool LiftThread_start(LiftThread_t* thread, LiftThread_Fn fn, void* arg)
+{
+    thread->fn = fn;
+    thread->arg = arg;
+    thread->handle = CreateThread(NULL, 0, LiftThread_entry, thread, 0, NULL);
+    return thread->handle != NULL;
+}
+
+void LiftThread_join(LiftThread_t* thread)
+{
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+}
+
+#else
+
+static void* LiftThread_entry(void* param)
+{
+    LiftThread_t* thread = (LiftThread_t*)param;
+    thread->fn(thread->arg);
+    return NULL;
+}
+
+bool LiftThread_start(LiftThread_t* thread, LiftThread_Fn fn, void* arg)
+{
+    thread->fn = fn;
+    thread->arg = arg;
+    return pthread_create(&thread->handle, NULL, LiftThread_entry, thread) == 0;
+}
+
+void LiftThread_join(LiftThread_t* thread)
+{
+    pthread_join(thread->handle, NULL);
+}
+
+#endif
+
+void LiftThread_runAll(LiftThread_Fn fn, void* args, uint32_t stride, uint32_t count)
+{
+    LIFT_ASSERT(count <= LIFT_THREAD_MAX);
+
+    LiftThread_t threads[LIFT_THREAD_MAX];
+    bool started[LIFT_THREAD_MAX] = { false };
+    uint8_t* base = (uint8_t*)args;
+
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        started[i] = LiftThread_start(&threads[i], fn, base + (size_t)i * stride);
+    }
+
+    if (count > 0)
+    {
+        fn(base);
+    }
+
+    for (uint32_t i = 1; i < count; ++i)
+    {
+        if (started[i])
+        {
+            LiftThread_join(&threads[i]);
+        }
+        else
+        {
+            fn(base + (size_t)i * stride);
+        }
+    }
+}
@@ -0,0 +1,296 @@
+/**
+ * @file lift_trace.c
+ * @brief Implements the binary step trace recorder and its decoder.
+ */
+
+#include <string.h>
+#include "lift_trace.h"
+#include "seqnet_internal.h"  // for BIT_*, DOOR_REQ_*
+#include "lift_assert.h"
+
+/// Call bits of the records
+#define LIFT_TRACE_RECORD_CALLS         ((1ULL << LIFT_TRACE_RECORD_FLOORS) - 1U)
+
+/**
+ * @brief Packs the door and moving flags of a state.
+ */
+static inline uint8_t LiftTrace_flags(const LiftState_t* state)
+{
+    return (uint8_t)((state->is_door_open ? LIFT_TRACE_DOOR_OPEN : 0U) |
+                     (state->is_moving ? LIFT_TRACE_MOVING : 0U));
+}
+
+/**
+ * @brief Writes the records in [flushed, written) to the sink, in at most two writes.
+ */
+static void LiftTrace_write(LiftTrace_t* trace)
+{
+    const uint32_t mask = trace->capacity - 1U;
+
+    while (trace->flushed < trace->written)
+    {
+        const uint32_t begin = (uint32_t)(trace->flushed & mask);
+        uint64_t count = trace->written - trace->flushed;
+        if (count > trace->capacity - begin)
+        {
+            count = trace->capacity - begin;  // Up to the end of the ring, the rest in the next pass
+        }
+
+        if (fwrite(&trace->records[begin], sizeof(LiftTraceRecord_t), (size_t)count, trace->sink) != (size_t)count)
+        {
+            trace->error = true;
+        }
+        trace->flushed += count;
+    }
+}
+
+/**
+ * @brief Appends a record, making room first if the ring is full.
+ */
+static inline void LiftTrace_push(LiftTrace_t* trace, const LiftTraceRecord_t* record)
+{
+    if ((trace->written - trace->flushed) == trace->capacity)
+    {
+        if (trace->sink != NULL)
+        {
+            LiftTrace_write(trace);
+        }
+        else
+        {
+            trace->flushed++;  // Flight recorder: the oldest record is overwritten
+        }
+    }
+
+    trace->records[trace->written & (trace->capacity - 1U)] = *record;
+    trace->written++;
+}
+
+void LiftTrace_init(LiftTrace_t* trace, LiftTraceRecord_t* buffer, uint32_t capacity, FILE* sink)
+{
+    LIFT_ASSERT(trace != NULL);
+    LIFT_ASSERT(buffer != NULL);
+    LIFT_ASSERT((capacity != 0) && ((capacity & (capacity - 1U)) == 0));
+
+    memset(trace, 0, sizeof(LiftTrace_t));
+    trace->records = buffer;
+    trace->capacity = capacity;
+    trace->sink = sink;
+
+    if (sink != NULL)
+    {
+        const LiftTraceHeader_t header = {
+            .magic = LIFT_TRACE_MAGIC,
+            .version = LIFT_TRACE_VERSION,
+            .record_size = sizeof(LiftTraceRecord_t),
+            .floors = LIFT_MAX_FLOORS,
+            .reserved = 0
+        };
+        trace->error = (fwrite(&header, sizeof(header), 1, sink) != 1);
+    }
+}
+
+/**
+ * @brief Appends a call record for every flipped call above the record floors.
+ */
+static void LiftTrace_pushCalls(LiftTrace_t* trace, const LiftCalls_t* flipped)
+{
+    for (uint32_t i = 0; i < LIFT_CALL_WORDS; ++i)
+    {
+        uint64_t bits = flipped->words[i] & ((i == 0) ? ~LIFT_TRACE_RECORD_CALLS : ~0ULL);
+        while (bits != 0)
+        {
+            const LiftTraceRecord_t record = {
+                .kind = LIFT_TRACE_KIND_CALL,
+                .out_word = (uint16_t)(i * LIFT_CALL_WORD_BITS + (uint32_t)__builtin_ctzll(bits))
+            };
+            LiftTrace_push(trace, &record);
+            bits &= bits - 1U;
+        }
+    }
+}
+
+void LiftTrace_begin(LiftTrace_t* trace, uint8_t pc, const LiftState_t* state)
+{
+    LIFT_ASSERT(trace != NULL);
+    LIFT_ASSERT(state != NULL);
+
+    trace->floor = state->floor;
+    trace->calls = state->calls;
+    trace->flags = LiftTrace_flags(state);
+
+    const LiftTraceRecord_t record = {
+        .kind = LIFT_TRACE_KIND_STATE,
+        .a = pc,
+        .b = (uint8_t)trace->floor,
+        .mask = (uint8_t)(trace->floor >> 8),
+        .out_word = 0,
+        .calls = (uint8_t)(trace->calls.words[0] & LIFT_TRACE_RECORD_CALLS),
+        .flags = trace->flags
+    };
+    LiftTrace_push(trace, &record);
+    LiftTrace_pushCalls(trace, &trace->calls);
+}
+
+void LiftTrace_step(LiftTrace_t* trace, uint8_t pc_pre, uint8_t pc_post, CondSel_Mask mask,
+                    uint16_t out_word, const LiftState_t* state)
+{
+    const uint8_t flags = LiftTrace_flags(state);
+    const uint8_t floor_delta = (state->floor == (uint16_t)(trace->floor + 1U)) ? LIFT_TRACE_FLOOR_UP :
+                                (state->floor == (uint16_t)(trace->floor - 1U)) ? LIFT_TRACE_FLOOR_DOWN : 0U;
+    LIFT_ASSERT((floor_delta != 0) || (state->floor == trace->floor));
+
+    LiftCalls_t flipped;
+    uint64_t changed = 0;
+    for (uint32_t i = 0; i < LIFT_CALL_WORDS; ++i)
+    {
+        flipped.words[i] = state->calls.words[i] ^ trace->calls.words[i];
+        changed |= flipped.words[i];
+    }
+
+    const LiftTraceRecord_t record = {
+        .kind = LIFT_TRACE_KIND_STEP,
+        .a = pc_pre,
+        .b = pc_post,
+        .mask = mask,
+        .out_word = out_word,
+        .calls = (uint8_t)(flipped.words[0] & LIFT_TRACE_RECORD_CALLS),
+        .flags = (uint8_t)(floor_delta | (flags ^ trace->flags))
+    };
+    LiftTrace_push(trace, &record);
+    if ((changed & ~LIFT_TRACE_RECORD_CALLS) != 0)
+    {
+        LiftTrace_pushCalls(trace, &flipped);
+    }
+
+    trace->floor = state->floor;
+    trace->calls = state->calls;
+    trace->flags = flags;
+}
+
+bool LiftTrace_flush(LiftTrace_t* trace)
+{
+    LIFT_ASSERT(trace != NULL);
+
+    if (trace->sink != NULL)
+    {
+        LiftTrace_write(trace);
+        trace->error = (fflush(trace->sink) != 0) || trace->error;
+    }
+    return !trace->error;
+}
+
+uint32_t LiftTrace_pending(const LiftTrace_t* trace)
+{
+    LIFT_ASSERT(trace != NULL);
+    return (uint32_t)(trace->written - trace->flushed);
+}
+
+/**
+ * @brief Prints the calls as the lift tests do.
+ */
+static void LiftTrace_printCalls(FILE* out, const LiftCalls_t* calls)
+{
+    char text[LIFT_CALLS_TEXT_SIZE];
+    fprintf(out, "Calls: [%s]", LiftCalls_format(calls, text));
+}
+
+/**
+ * @brief Prints the "INT:" line of a keyframe.
+ */
+static void LiftTrace_printKeyframe(FILE* out, uint16_t floor, const LiftCalls_t* calls, uint8_t flags, uint8_t pc)
+{
+    fprintf(out, "INT: Floor: %d, Door Open: %s, Moving: %s, ",
+            floor, (flags & LIFT_TRACE_DOOR_OPEN) ? "Y" : "N", (flags & LIFT_TRACE_MOVING) ? "Y" : "N");
+    LiftTrace_printCalls(out, calls);
+    fprintf(out, ", PC preset: %d\n", pc);
+}
+
+bool LiftTrace_decode(FILE* in, FILE* out)
+{
+    LIFT_ASSERT(in != NULL);
+    LIFT_ASSERT(out != NULL);
+
+    LiftTraceHeader_t header;
+    if ((fread(&header, sizeof(header), 1, in) != 1) ||
+        (header.magic != LIFT_TRACE_MAGIC) || (header.version == 0) || (header.version > LIFT_TRACE_VERSION) ||
+        (header.record_size != sizeof(LiftTraceRecord_t)) || (header.floors != LIFT_MAX_FLOORS))
+    {
+        return false;
+    }
+
+    // Decoded in blocks, mirroring the large writes of the recorder
+    LiftTraceRecord_t block[256];
+    LiftCalls_t calls = LIFT_CALLS_NONE;
+    uint16_t floor = 0;
+    uint8_t flags = 0, keyframe_pc = 0;
+    uint32_t step = 0;
+    bool started = false;
+    bool keyframe_pending = false;  // The "INT:" line waits for the call records of the keyframe
+    size_t count;
+
+    while ((count = fread(block, sizeof(LiftTraceRecord_t), sizeof(block) / sizeof(block[0]), in)) > 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const LiftTraceRecord_t* record = &block[i];
+
+            if (record->kind == LIFT_TRACE_KIND_CALL)
+            {
+                if (!started || (record->out_word < LIFT_TRACE_RECORD_FLOORS) || (record->out_word >= LIFT_MAX_FLOORS))
+                {
+                    return false;
+                }
+                calls.words[record->out_word / LIFT_CALL_WORD_BITS] ^= 1ULL << (record->out_word % LIFT_CALL_WORD_BITS);
+                continue;
+            }
+
+            if (keyframe_pending)
+            {
+                LiftTrace_printKeyframe(out, floor, &calls, flags, keyframe_pc);
+                keyframe_pending = false;
+            }
+
+            if (record->kind == LIFT_TRACE_KIND_STATE)
+            {
+                floor = (uint16_t)(record->b | (record->mask << 8));
+                calls = (LiftCalls_t)LIFT_CALLS_INIT(record->calls);
+                flags = record->flags;
+                keyframe_pc = record->a;
+                step = 0;
+                started = true;
+                keyframe_pending = true;
+                continue;
+            }
+
+            if ((record->kind != LIFT_TRACE_KIND_STEP) || !started)
+            {
+                return false;
+            }
+
+            // Same layout as the debug log of LiftTestCase_run(), state before the step
+            fprintf(out, "Step %02u: Floor: %d, Door Open: %s, Moving: %s, prePC: %02d, postPC: %02d, Reset: %d, ",
+                    step, floor,
+                    (flags & LIFT_TRACE_DOOR_OPEN) ? "Y" : "N",
+                    (flags & LIFT_TRACE_MOVING) ? "Y" : "N",
+                    record->a, record->b,
+                    (record->out_word >> BIT_REQ_RESET) & 1U);
+            LiftTrace_printCalls(out, &calls);
+            fprintf(out, ", Up: %d, Down: %d, DReq: %d\n",
+                    (record->out_word >> BIT_MOVE_UP) & 1U,
+                    (record->out_word >> BIT_MOVE_DOWN) & 1U,
+                    ((record->out_word >> BIT_DOOR_STATE) & 1U) == DOOR_REQ_OPEN ? 1 : 0);
+
+            floor = (uint16_t)(floor + ((record->flags & LIFT_TRACE_FLOOR_UP) ? 1 : 0) -
+                                       ((record->flags & LIFT_TRACE_FLOOR_DOWN) ? 1 : 0));
+            calls.words[0] ^= record->calls;
+            flags ^= (uint8_t)(record->flags & (LIFT_TRACE_DOOR_TOGGLE | LIFT_TRACE_MOVING_TOGGLE));
+            ++step;
+        }
+    }
+
+    if (keyframe_pending)
+    {
+        LiftTrace_printKeyframe(out, floor, &calls, flags, keyframe_pc);
+    }
+    return ferror(in) == 0;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file lift_traffic.c
+ * @brief Implements the discrete-event building traffic simulation.
+ */
+
+#include <string.h>
+#include "lift_traffic.h"
+#include "lift_assert.h"
+
+/// Fractional bits of the event keys: arrival times are kept in 1/1024 ticks, so the
+/// streams do not drift by rounding every inter-arrival time to whole ticks
+#define LIFT_TRAFFIC_KEY_FRACTION       (10U)
+/// End of a passenger list
+#define LIFT_TRAFFIC_NONE               (0xFFFFFFFFUL)
+
+/**
+ * @brief State of a running simulation.
+ */
+typedef struct
+{
+    const LiftTrafficConfig_t* config;
+    LiftTrafficPassenger_t* passengers;
+    LiftTrafficReport_t* report;
+    LiftInputs_t plant;
+    uint32_t free;              ///< First free passenger record
+    uint64_t random;            ///< State of the random stream
+    double mean_interval;       ///< Mean time between two arrivals of one origin floor, in key units
+    uint32_t* waiting;          ///< Passengers waiting on a floor
+    uint32_t* riding;           ///< Passengers in the car travelling to a floor
+} LiftTrafficSim_t;
+
+/**
+ * @brief Step of the random stream (xorshift64*).
+ */
+static inline uint64_t LiftTraffic_random(LiftTrafficSim_t* sim)
+{
+    uint64_t x = sim->random;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    sim->random = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Returns -ln(u) of a uniform u in (0, 1], without the math library.
+ *
+ * u = r / 2^53 with r = m * 2^e, m in [1, 2): ln u = e * ln 2 + ln m - 53 * ln 2 and
+ * ln m = 2 * atanh((m - 1) / (m + 1)), whose series converges fast on [0, 1/3).
+ */
+static double LiftTraffic_exponential(LiftTrafficSim_t* sim)
+{
+    static const double ln2 = 0.69314718055994530942;
+
+    const uint64_t r = (LiftTraffic_random(sim) >> 11) + 1U;
+    const uint32_t e = 63U - (uint32_t)__builtin_clzll(r);
+    const double m = (double)r / (double)(1ULL << e);
+    const double s = (m - 1.0) / (m + 1.0);
+    const double s2 = s * s;
+    const double ln_m = 2.0 * s * (1.0 + s2 * (1.0 / 3.0 + s2 * (1.0 / 5.0 + s2 * (1.0 / 7.0 + s2 * (1.0 / 9.0 + s2 / 11.0)))));
+
+    return (53.0 - (double)e) * ln2 - ln_m;
+}
+
+/**
+ * @brief Returns the key of the next arrival of a stream.
+ */
+static inline uint64_t LiftTraffic_next(LiftTrafficSim_t* sim, uint64_t key)
+{
+    return key + (uint64_t)(LiftTraffic_exponential(sim) * sim->mean_interval);
+}
+
+/**
+ * @brief Returns the destination of a passenger starting on a floor.
+ */
+static uint16_t LiftTraffic_destination(LiftTrafficSim_t* sim, uint16_t origin)
+{
+    const uint32_t floors = sim->config->floors;
+    const uint32_t r = (uint32_t)(LiftTraffic_random(sim) >> 32);
+    uint32_t destination;
+
+    switch (sim->config->profile)
+    {
+        case LIFT_TRAFFIC_UP_PEAK:
+            destination = 1U + r % (floors - 1U);
+            break;
+        case LIFT_TRAFFIC_DOWN_PEAK:
+            destination = 0;
+            break;
+        case LIFT_TRAFFIC_INTER_FLOOR:
+            destination = 1U + r % (floors - 2U);
+            destination += (destination >= origin);
+            break;
+        case LIFT_TRAFFIC_UNIFORM:
+        default:
+            destination = r % (floors - 1U);
+            destination += (destination >= origin);
+            break;
+    }
+    return (uint16_t)destination;
+}
+
+/**
+ * @brief A passenger arrives on a floor and calls the car.
+ */
+static void LiftTraffic_arrive(LiftTrafficSim_t* sim, uint16_t origin, uint64_t tick)
+{
+    sim->report->arrived++;
+
+    const uint32_t passenger = sim->free;
+    if (passenger == LIFT_TRAFFIC_NONE)
+    {
+        sim->report->dropped++;
+        return;
+    }
+    sim->free = sim->passengers[passenger].next;
+
+    sim->passengers[passenger].arrival = tick;
+    sim->passengers[passenger].destination = LiftTraffic_destination(sim, origin);
+    sim->passengers[passenger].next = sim->waiting[origin];
+    sim->waiting[origin] = passenger;
+    LiftInputs_callSet(&sim->plant, origin);
+}
+
+/**
+ * @brief The car serves a floor: riders to it alight, the waiting passengers board.
+ */
+static void LiftTraffic_serve(LiftTrafficSim_t* sim, uint16_t floor, uint64_t tick)
+{
+    LiftTrafficReport_t* report = sim->report;
+    uint32_t passenger = sim->riding[floor];
+
+    while (passenger != LIFT_TRAFFIC_NONE)
+    {
+        LiftTrafficPassenger_t* p = &sim->passengers[passenger];
+        const uint32_t next = p->next;
+        const uint64_t journey = tick - p->arrival;
+
+        report->delivered++;
+        report->journey_sum += journey;
+        report->journey_max = (journey > report->journey_max) ? journey : report->journey_max;
+
+        p->next = sim->free;
+        sim->free = passenger;
+        passenger = next;
+    }
+    sim->riding[floor] = LIFT_TRAFFIC_NONE;
+
+    passenger = sim->waiting[floor];
+    while (passenger != LIFT_TRAFFIC_NONE)
+    {
+        LiftTrafficPassenger_t* p = &sim->passengers[passenger];
+        const uint32_t next = p->next;
+        const uint64_t wait = tick - p->arrival;
+        const uint32_t bucket = (wait == 0) ? 0U : (64U - (uint32_t)__builtin_clzll(wait));
+
+        report->boarded++;
+        report->wait_sum += wait;
+        report->wait_max = (wait > report->wait_max) ? wait : report->wait_max;
+        report->wait_histogram[(bucket < LIFT_TRAFFIC_HISTOGRAM) ? bucket : LIFT_TRAFFIC_HISTOGRAM - 1U]++;
+
+        p->next = sim->riding[p->destination];
+        sim->riding[p->destination] = passenger;
+        LiftInputs_callSet(&sim->plant, p->destination);
+        passenger = next;
+    }
+    sim->waiting[floor] = LIFT_TRAFFIC_NONE;
+}
+
+/**
+ * @brief Returns true, if applying the outputs leaves the plant state unchanged.
+ */
+static bool LiftTraffic_isAtRest(const LiftState_t* state, const SeqNet_Out* out)
+{
+    LiftState_t next = *state;
+    LiftPlant_apply(&next, out);
+    return LiftState_equal(&next, state);
+}
+
+void LiftTraffic_run(const SeqNet_Program* program, const LiftTrafficConfig_t* config,
+                     const LiftTrafficWorkspace_t* workspace, LiftTrafficReport_t* report)
+{
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT(config != NULL);
+    LIFT_ASSERT(workspace != NULL);
+    LIFT_ASSERT(report != NULL);
+    LIFT_ASSERT((config->floors >= 2U) && (config->floors <= LIFT_MAX_FLOORS));
+    LIFT_ASSERT((config->profile != LIFT_TRAFFIC_INTER_FLOOR) || (config->floors >= 3U));
+    LIFT_ASSERT((config->arrivals_per_hour > 0.0) && (config->ticks_per_hour > 0U));
+    LIFT_ASSERT(workspace->event_capacity >= config->floors);
+    LIFT_ASSERT(workspace->lists != NULL);
+
+    LiftTrafficSim_t simulation;
+    LiftTrafficSim_t* sim = &simulation;
+    memset(report, 0, sizeof(LiftTrafficReport_t));
+    sim->waiting = workspace->lists;
+    sim->riding = workspace->lists + config->floors;
+    memset(workspace->lists, 0xFF, 2U * config->floors * sizeof(uint32_t));
+    sim->config = config;
+    sim->passengers = workspace->passengers;
+    sim->report = report;
+    sim->random = config->seed | 1U;
+
+    LiftState_t idle;
+    memset(&idle, 0, sizeof(idle));
+    LiftInputs_init(&sim->plant, &idle);
+
+    sim->free = (workspace->passenger_capacity > 0) ? 0U : LIFT_TRAFFIC_NONE;
+    for (uint32_t i = 0; i < workspace->passenger_capacity; ++i)
+    {
+        workspace->passengers[i].next = (i + 1U < workspace->passenger_capacity) ? i + 1U : LIFT_TRAFFIC_NONE;
+    }
+
+    // One Poisson stream per origin floor of the profile
+    const uint16_t first = ((config->profile == LIFT_TRAFFIC_DOWN_PEAK) || (config->profile == LIFT_TRAFFIC_INTER_FLOOR)) ? 1U : 0U;
+    const uint16_t last = (config->profile == LIFT_TRAFFIC_UP_PEAK) ? 0U : (uint16_t)(config->floors - 1U);
+    const double streams = (double)(last - first + 1U);
+    sim->mean_interval = streams * (double)config->ticks_per_hour / config->arrivals_per_hour *
+                         (double)(1U << LIFT_TRAFFIC_KEY_FRACTION);
+
+    LiftRadixHeap_t events;
+    LiftRadix_init(&events, workspace->events, workspace->event_capacity);
+    for (uint16_t origin = first; origin <= last; ++origin)
+    {
+        LiftRadix_push(&events, LiftTraffic_next(sim, 0), origin);
+    }
+
+    SeqNet_Ctx ctx;
+    SeqNet_ctxInit(&ctx, program);
+    uint64_t tick = 0;
+
+    while (tick < config->duration)
+    {
+        // Arrivals up to and including this tick, before the controller step of the tick
+        uint64_t key;
+        while (LiftRadix_top(&events, &key) && ((key >> LIFT_TRAFFIC_KEY_FRACTION) <= tick))
+        {
+            uint32_t origin;
+            LiftRadix_pop(&events, &key, &origin);
+            LiftTraffic_arrive(sim, (uint16_t)origin, tick);
+            LiftRadix_push(&events, LiftTraffic_next(sim, key), origin);
+        }
+
+        SeqNet_Park park;
+        if (!config->tick_by_tick && SeqNet_ctxPark(&ctx, &sim->plant.in, &park) &&
+            LiftTraffic_isAtRest(&sim->plant.state, &program->decoded[ctx.pc]))
+        {
+            uint64_t wake = key >> LIFT_TRAFFIC_KEY_FRACTION;
+            wake = (wake < config->duration) ? wake : config->duration;
+            SeqNet_ctxFastForward(&ctx, &park, wake - tick);
+            tick = wake;
+            continue;
+        }
+
+        const uint16_t floor = sim->plant.state.floor;
+        const SeqNet_Out out = SeqNet_ctxStep(&ctx, &sim->plant.in);
+        const bool serves = out.req_reset && sim->plant.in.call_pending_same;
+        LiftInputs_apply(&sim->plant, &out);
+        if (serves)
+        {
+            LiftTraffic_serve(sim, floor, tick);
+        }
+        report->steps++;
+        ++tick;
+    }
+
+    report->ticks = tick;
+    report->mean_wait = (report->boarded > 0) ? (double)report->wait_sum / (double)report->boarded : 0.0;
+    report->mean_journey = (report->delivered > 0) ? (double)report->journey_sum / (double)report->delivered : 0.0;
+    report->throughput_per_hour = (tick > 0) ? (double)report->delivered * config->ticks_per_hour / (double)tick : 0.0;
+}
+
+uint64_t LiftTraffic_waitPercentile(const LiftTrafficReport_t* report, uint32_t percent)
+{
+    LIFT_ASSERT(report != NULL);
+    LIFT_ASSERT(percent <= 100U);
+
+    const uint64_t target = (report->boarded * percent + 99U) / 100U;
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < LIFT_TRAFFIC_HISTOGRAM; ++i)
+    {
+        count += report->wait_histogram[i];
+        if (count >= target)
+        {
+            return (i == 0) ? 0U : ((1ULL << i) - 1U);
+        }
+    }
+    return report->wait_max;
+}
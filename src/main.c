@@ -9,7 +9,23 @@
 #include "test_assertion.h"
 #include "test_condsel.h"
 #include "test_seqnet.h"
+#include "test_seqnet_batch.h"
+#include "test_seqnet_aot.h"
+#include "test_seqnet_table.h"
 #include "test_lift.h"
+#include "test_lift_plant.h"
+#include "test_lift_event.h"
+#include "test_lift_check.h"
+#include "test_lift_fuzz.h"
+#include "test_lift_trace.h"
+#include "test_lift_snapshot.h"
+#include "test_lift_group.h"
+#include "test_lift_traffic.h"
+#include "test_lift_motion.h"
+#include "test_seqnet_image.h"
+#include "test_seqnet_asm.h"
+#include "test_lift_search.h"
+#include "test_lift_scenario.h"
 #include "scenario_loader.h"
 
 #define ENABLE_ASSERT 1  // <-- Toggle this to 0 to disable
@@ -32,11 +48,41 @@ int main(void)
 
     CondSelAllCases_test();  // Run all condition selector tests
     SeqNetAllCases_test();   // Run SeqNet tests
+    SeqNetBatchAllCases_test();  // Run batch engine kernel tests
+    SeqNetTableAllCases_test();  // Run transition table tests
+#if SEQNET_AOT_ENABLED
+    SeqNetAotAllCases_test();  // Verify the generated engine (make aot)
+#endif
 
     ScenarioDefaultProgram_load();  // Load default program into SeqNet
     ScenarioProgram_print();  // Print the default program memory
+    LiftPlantAllCases_test();  // Check the call bitset against a floor by floor scan
+    LiftEventAllCases_test();  // Check the event-driven simulation against per-tick stepping
+    LiftCheckAllCases_test();  // Model check the default program and faulty variants
+    LiftFuzzAllCases_test();  // Fuzz the default program with random scenarios
+    LiftTraceAllCases_test();  // Record and decode binary step traces
+    LiftSnapshotAllCases_test();  // Restore and fork emulator snapshots
+    LiftGroupAllCases_test();  // Dispatch hall calls over a bank of cars
+    LiftTrafficAllCases_test();  // Simulate passenger traffic with the discrete-event engine
+    LiftMotionAllCases_test();  // Integrate jerk-limited car motion and door travel
+    SeqNetImageAllCases_test();  // Write, map and verify binary program images
+    SeqNetAsmAllCases_test();  // Assemble, list and optimize microprograms
+    LiftSearchAllCases_test();  // Evolve faster microprograms with the parallel genetic search
+    LiftScenarioAllCases_test();  // Write, read and stream scenario files
+
+#if SEQNET_PROFILE_ENABLED
+    static SeqNet_Profile profile;
+    SeqNet_profile(&profile);  // Count where the lift test cases spend their steps
+#endif
 
     LiftTestAll_run();  // Run all lift test cases
+
+#if SEQNET_PROFILE_ENABLED
+    SeqNet_profile(NULL);
+    ScenarioProgramProfile_print(&profile);  // Annotated listing of the default program
+#endif
+    LiftTestAllMacro_run();  // Check macro-step equivalence on all lift test cases
+    LiftTestAllParallel_run();  // Run all lift test cases on the parallel runner
     
     return 0;
 }
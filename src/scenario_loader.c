@@ -5,72 +5,59 @@
 
 #include "scenario_loader.h"
 #include "seqnet.h"
-#include "seqnet_internal.h"  // For BIT_*, MASK_*
-#include "condsel_internal.h"  // CONDSEL ENUMs
+#include "seqnet_internal.h"  // For SeqNetProgramMemory_*
+#include "seqnet_asm.h"
+#include "lift_assert.h"
 #include <stdint.h>
 #include <stdio.h>
 
-/// Predefined scenario steps in sequential logic order
-static const SeqNet_Out default_program[] = {
-    // PC 0: Check for any pending call → jump to PC 4 if exists
-    { .jump_addr = 2,  .cond_sel = CONDSEL_ENUM_PEND_ANY, .cond_inv = 0, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_OPEN, .req_reset = 0 },
-
-    // PC 1: Idle loop if no call → jump to PC 0
-    { .jump_addr = 0,  .cond_sel = CONDSEL_ENUM_CONST_FALSE, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_OPEN, .req_reset = 0 },
-
-    // PC 2: If call on same floor → jump to PC 13
-    { .jump_addr = 13, .cond_sel = CONDSEL_ENUM_PEND_ONLY_SAME, .cond_inv = 0, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_OPEN, .req_reset = 0 },
-
-    // PC 3: Request to close door → jump to PC 4
-    { .jump_addr = 4,  .cond_sel = CONDSEL_ENUM_CONST_FALSE, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 4: Wait until door is closed (loop)
-    { .jump_addr = 4,  .cond_sel = CONDSEL_ENUM_DOOR_CLOSED, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 5: If call below → jump to PC 10
-    { .jump_addr = 10,  .cond_sel = CONDSEL_ENUM_PEND_ONLY_BELOW, .cond_inv = 0, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 6: If NOT call above → jump to PC 0
-    { .jump_addr = 0, .cond_sel = CONDSEL_ENUM_PEND_ONLY_ABOVE, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 7: Move up → jump to PC 8
-    { .jump_addr = 8, .cond_sel = CONDSEL_ENUM_CONST_FALSE, .cond_inv = 1, .req_move_up = 1, .req_move_down = 0, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 8: Wait until floor reached (up)
-    { .jump_addr = 7, .cond_sel = CONDSEL_ENUM_PEND_ONLY_SAME, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 9: Stop moving (up) → jump to Door open PC 14
-    { .jump_addr = 13, .cond_sel = CONDSEL_ENUM_CONST_FALSE, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 10: Move down → jump to PC 11
-    { .jump_addr = 11,  .cond_sel = CONDSEL_ENUM_CONST_FALSE, .cond_inv = 1, .req_move_up = 0, .req_move_down = 1, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 11: Wait until floor reached (down)
-    { .jump_addr = 10,  .cond_sel = CONDSEL_ENUM_PEND_ONLY_SAME, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 12: Stop moving → jump to Door open PC 14
-    { .jump_addr = 14, .cond_sel = CONDSEL_ENUM_CONST_FALSE, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_CLOSE, .req_reset = 0 },
-
-    // PC 13: Open door → jump to PC 14
-    { .jump_addr = 14, .cond_sel = CONDSEL_ENUM_CONST_FALSE, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_OPEN, .req_reset = 0 },
-
-    // PC 14: Wait until door is open (loop)
-    { .jump_addr = 14, .cond_sel = CONDSEL_ENUM_DOOR_OPENED, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_OPEN, .req_reset = 0 },
-
-    // PC 15: Reset call → jump to idle (PC 0)
-    { .jump_addr = 0,  .cond_sel = CONDSEL_ENUM_CONST_FALSE, .cond_inv = 1, .req_move_up = 0, .req_move_down = 0, .req_door_state = DOOR_REQ_OPEN, .req_reset = 1 },
-};
+/// Default program: serves the calls of the current direction first, then reverses
+static const char default_program_source[] =
+    "idle:         open        goto dispatch if pend_any            ; Any pending call: dispatch it\n"
+    "              open        goto idle                            ; Idle loop, no call\n"
+    "dispatch:     open        goto open_door if pend_same          ; Call on the same floor: open the door\n"
+    "close_door:   close       goto wait_closed                     ; Request to close the door\n"
+    "wait_closed:  close       goto wait_closed unless door_closed  ; Wait until the door is closed\n"
+    "              close       goto move_down if pend_below         ; Call below: move down\n"
+    "              close       goto idle unless pend_above          ; No call above: back to idle\n"
+    "move_up:      close up    goto wait_up                         ; Move up one floor\n"
+    "wait_up:      close       goto move_up unless pend_same        ; Keep moving until a called floor\n"
+    "              close       goto open_door                       ; Stop moving (up), open the door\n"
+    "move_down:    close down  goto wait_down                       ; Move down one floor\n"
+    "wait_down:    close       goto move_down unless pend_same      ; Keep moving until a called floor\n"
+    "              close       goto wait_open                       ; Stop moving (down), open the door\n"
+    "open_door:    open        goto wait_open                       ; Request to open the door\n"
+    "wait_open:    open        goto wait_open unless door_opened    ; Wait until the door is open\n"
+    "              open reset  goto idle                            ; Reset the served call, back to idle\n";
+
+/// Number of instructions of the default program, set by ScenarioDefaultProgram_load()
+static uint16_t default_program_count = 0;
+
+const char* ScenarioDefaultProgram_source(void)
+{
+    return default_program_source;
+}
 
 /**
  * @brief Loads the default instruction set into program memory.
  */
 void ScenarioDefaultProgram_load(void)
 {
+    static SeqNetAsmProgram_t program;
+    uint32_t line;
+    const SeqNetAsmStatus_t status = SeqNetAsm_assemble(default_program_source, &program, &line);
+    LIFT_ASSERT(status == SEQNET_ASM_OK);
+    (void)status;
+
     uint16_t* ProgMem = SeqNetProgramMemory_get();
-    for (uint8_t i = 0; i < sizeof(default_program)/sizeof(default_program[0]); ++i)
+    for (uint16_t i = 0; i < SEQNET_PROGMEM_SIZE; ++i)
     {
-        ProgMem[i] = SeqNetOut_convert(&default_program[i]);
+        ProgMem[i] = program.words[i];
     }
+    default_program_count = program.count;
+
+    // Build the predecoded table once for the new image
+    SeqNetProgramMemory_decode();
 }
 
 /**
@@ -78,13 +65,13 @@ void ScenarioDefaultProgram_load(void)
  */
 void ScenarioProgram_print(void)
 {
-    uint16_t* ProgMem = SeqNetProgramMemory_get();
+    const SeqNet_Program* program = SeqNetProgram_get();
     printf("=== Program Memory Dump ===\n");
     printf(" PC | Jmp | MU | MD | DR | R | CSEL | CIN | Hex \n");
     printf("----+-----+----+----+----+---+------+-----+------\n");
-    for (uint8_t i = 0; i < sizeof(default_program)/sizeof(default_program[0]); ++i)
+    for (uint8_t i = 0; i < default_program_count; ++i)
     {
-        SeqNet_Out instr = SeqNetInstruction_convert(ProgMem[i]);
+        const SeqNet_Out instr = program->decoded[i];
         printf("%3u | %3u | %2u | %2u | %2s | %u |  %2u  |  %u  | 0x%04X\n",
                i,
                instr.jump_addr,
@@ -94,7 +81,53 @@ void ScenarioProgram_print(void)
                instr.req_reset,
                instr.cond_sel,
                instr.cond_inv,
-               ProgMem[i]);
+               program->words[i]);
     }
     printf("============================\n");
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Prints the program memory listing annotated with an execution profile.
+ *
+ * @param[in] profile  Counters collected while running the program.
+ */
+void ScenarioProgramProfile_print(const SeqNet_Profile* profile)
+{
+    const SeqNet_Program* program = SeqNetProgram_get();
+    uint64_t total = 0;
+    for (uint16_t i = 0; i < SEQNET_PROGMEM_SIZE; ++i)
+    {
+        total += profile->hits[i];
+    }
+
+    printf("=== Program Profile (%llu steps) ===\n", (unsigned long long)total);
+    printf(" PC | Jmp | MU | MD | DR | R | CSEL | CIN | Hex    |     Hits |  Share |    Taken | Not taken\n");
+    printf("----+-----+----+----+----+---+------+-----+--------+----------+--------+----------+----------\n");
+    for (uint16_t i = 0; i < SEQNET_PROGMEM_SIZE; ++i)
+    {
+        // Listed: the loaded program and every other PC that was executed
+        if ((i >= default_program_count) && (profile->hits[i] == 0)) continue;
+
+        const SeqNet_Out instr = program->decoded[i];
+        printf("%3u | %3u | %2u | %2u | %2s | %u |  %2u  |  %u  | 0x%04X | %8llu | %5.1f%% | %8llu | %8llu\n",
+               i,
+               instr.jump_addr,
+               instr.req_move_up,
+               instr.req_move_down,
+               instr.req_door_state ? "OP" : "CL",
+               instr.req_reset,
+               instr.cond_sel,
+               instr.cond_inv,
+               program->words[i],
+               (unsigned long long)profile->hits[i],
+               (total != 0) ? 100.0 * (double)profile->hits[i] / (double)total : 0.0,
+               (unsigned long long)profile->taken[i],
+               (unsigned long long)(profile->hits[i] - profile->taken[i]));
+    }
+    printf("Selector evaluations:");
+    for (uint8_t i = 0; i < SEQNET_SELECTOR_COUNT; ++i)
+    {
+        printf(" [%u] %llu", i, (unsigned long long)profile->selector[i]);
+    }
+    printf("\n============================\n");
+}
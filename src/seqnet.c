@@ -19,13 +19,16 @@
 
 
 /// Size of the program memory
-#define PROGMEM_SIZE 255
+#define PROGMEM_SIZE SEQNET_PROGMEM_SIZE
 
-/// Program memory: holds 16-bit encoded instructions
-static uint16_t SeqNet_ProgMem[PROGMEM_SIZE];
+/// Program memory: holds 16-bit encoded instructions and their predecoded form
+static SeqNet_Program SeqNet_ProgMem;
 
-/// Program Counter: points to the current instruction
-uint8_t SeqNet_PC = 0;
+/// True, if the predecoded table of SeqNet_ProgMem matches its words
+static bool SeqNet_ProgMemDecoded = false;
+
+/// Context behind the global API: executes SeqNet_ProgMem, its PC points to the current instruction
+static SeqNet_Ctx SeqNet_GlobalCtx = { .program = &SeqNet_ProgMem, .pc = 0 };
 
 // === Internal accessors for testing ===
 
@@ -34,11 +37,48 @@ uint8_t SeqNet_PC = 0;
  *
  * This function is intended for testing or emulation purposes only.
  *
- * @return Pointer to the 256-element instruction memory.
+ * @return Pointer to the SEQNET_PROGMEM_SIZE-element instruction memory.
  */
 uint16_t* SeqNetProgramMemory_get(void)
 {
-    return SeqNet_ProgMem;
+    // The caller may write through the pointer
+    SeqNet_ProgMemDecoded = false;
+    return SeqNet_ProgMem.words;
+}
+
+/**
+ * @brief Marks the predecoded table of the internal program memory as stale.
+ *
+ * The table is rebuilt lazily on the next step or by SeqNetProgramMemory_decode().
+ */
+void SeqNetProgramMemory_invalidate(void)
+{
+    SeqNet_ProgMemDecoded = false;
+}
+
+/**
+ * @brief Rebuilds the predecoded table of the internal program memory.
+ */
+void SeqNetProgramMemory_decode(void)
+{
+    SeqNetProgram_decode(&SeqNet_ProgMem);
+    SeqNet_ProgMemDecoded = true;
+}
+
+/**
+ * @brief Returns the internal program with an up-to-date predecoded table.
+ *
+ * Decodes the program memory first if it was invalidated since the last decode.
+ *
+ * @return Pointer to the internal program (read-only).
+ */
+const SeqNet_Program* SeqNetProgram_get(void)
+{
+    if (!SeqNet_ProgMemDecoded)
+    {
+        SeqNetProgramMemory_decode();
+    }
+    return &SeqNet_ProgMem;
 }
 
 /**
@@ -50,8 +90,8 @@ uint16_t* SeqNetProgramMemory_get(void)
  */
 uint8_t SeqNetPC_get(void)
 {
-    DEBUG_PC_PRINTF("DEBUG: PC get: 0x%02X\n", SeqNet_PC);
-    return SeqNet_PC;
+    DEBUG_PC_PRINTF("DEBUG: PC get: 0x%02X\n", SeqNet_GlobalCtx.pc);
+    return SeqNet_GlobalCtx.pc;
 }
 
 /**
@@ -59,13 +99,75 @@ uint8_t SeqNetPC_get(void)
  *
  * Used to initialize or force specific execution flow in tests or emulation.
  *
- * @param value New Program Counter value (must be < 256).
+ * @param value New Program Counter value, 255 is the trap row.
  */
 void SeqNetPC_set(uint8_t value)
 {
-    LIFT_ASSERT(value < PROGMEM_SIZE);
-    SeqNet_PC = value;
-    DEBUG_PC_PRINTF("DEBUG: PC set: 0x%02X\n", SeqNet_PC);
+    SeqNet_GlobalCtx.pc = value;
+    DEBUG_PC_PRINTF("DEBUG: PC set: 0x%02X\n", SeqNet_GlobalCtx.pc);
+}
+
+// === Internal helpers ===
+
+/**
+ * @brief Returns the encoded word of a PC, the trap word at PC 255.
+ */
+static inline uint16_t SeqNetProgram_word(const SeqNet_Program* program, const uint8_t pc)
+{
+    return (pc < PROGMEM_SIZE) ? program->words[pc] : (uint16_t)SEQNET_TRAP_WORD;
+}
+
+/**
+ * @brief Loads the next PC of a context: jump address if the condition is active, else PC + 1.
+ *
+ * @param[in,out] ctx               Context to update.
+ * @param[in]     out               Instruction being executed.
+ * @param[in]     condition_active  Result of the instruction's condition.
+ */
+static inline void SeqNetPC_update(SeqNet_Ctx* ctx, const SeqNet_Out* out, const bool condition_active)
+{
+#if SEQNET_PROFILE_ENABLED
+    if (ctx->profile != NULL)
+    {
+        ctx->profile->hits[ctx->pc]++;
+        ctx->profile->taken[ctx->pc] += condition_active;
+        ctx->profile->selector[out->cond_sel & MASK_COND_SEL]++;
+    }
+#endif
+
+    if (condition_active) 
+    {
+        ctx->pc = out->jump_addr;
+        DEBUG_PC_PRINTF("DEBUG: PC jump: 0x%02X\n", ctx->pc);
+    } 
+    else 
+    {
+        DEBUG_PC_PRINTF("DEBUG: PC before increment: 0x%02X\n", ctx->pc);
+        ctx->pc = (ctx->pc + 1) % PROGMEM_SIZE;
+        DEBUG_PC_PRINTF("DEBUG: PC increment: 0x%02X\n", ctx->pc);
+    }
+}
+
+/**
+ * @brief Returns the condition inputs the plant may change in response to the outputs of an instruction.
+ *
+ * @param[in] out  Outputs of the instruction.
+ * @return CondSel_Mask  Inputs possibly touched by the outputs.
+ */
+static inline CondSel_Mask SeqNetOut_affects(const SeqNet_Out* out)
+{
+    CondSel_Mask affected = CONDSEL_MASK_CLOSED | CONDSEL_MASK_OPEN;  // The door is always driven
+
+    if (out->req_reset)
+    {
+        affected |= CONDSEL_MASK_SAME;
+    }
+    if (out->req_move_up || out->req_move_down)
+    {
+        affected |= CONDSEL_MASK_PENDING;
+    }
+
+    return affected;
 }
 
 // === API functions ===
@@ -77,44 +179,276 @@ void SeqNetPC_set(uint8_t value)
  */
 void SeqNet_init(void)
 {
-    SeqNet_PC = 0;
+    // The attached profile survives re-initialization
+    SeqNet_Profile* profile = SeqNet_GlobalCtx.profile;
+    SeqNet_ctxInit(&SeqNet_GlobalCtx, &SeqNet_ProgMem);
+    SeqNet_GlobalCtx.profile = profile;
 }
 
 /**
  * @brief Executes the current instruction and advances or jumps the PC.
  * 
- * This function fetches the current instruction from memory (at PC),
- * interprets it field-by-field, returns the requested output structure,
- * and updates PC based on the `condition_active` flag.
+ * Thin wrapper stepping the global context (@see SeqNet_ctxLoop).
  * 
  * @param[in] condition_active  True if the selected condition is active (or inverted false).
  * @return SeqNet_Out           Decoded instruction fields.
  */
 SeqNet_Out SeqNet_loop(const bool condition_active)
 {
-    // Fetch current instruction from memory
-    LIFT_ASSERT(SeqNet_PC < PROGMEM_SIZE);
-    uint16_t instr = SeqNet_ProgMem[SeqNet_PC];
+    // Rebuild the predecoded table if the program memory was written
+    if (!SeqNet_ProgMemDecoded)
+    {
+        SeqNetProgramMemory_decode();
+    }
+    return SeqNet_ctxLoop(&SeqNet_GlobalCtx, condition_active);
+}
 
-    // Decode instruction into output structure
-    SeqNet_Out out = SeqNetInstruction_convert(instr);
+/**
+ * @brief Fused step of the global context (@see SeqNet_ctxStep).
+ *
+ * @param[in] in  Condition selector inputs of the current state.
+ * @return SeqNet_Out  Decoded instruction fields.
+ */
+SeqNet_Out SeqNet_step(const CondSel_In* in)
+{
+    if (!SeqNet_ProgMemDecoded)
+    {
+        SeqNetProgramMemory_decode();
+    }
+    return SeqNet_ctxStep(&SeqNet_GlobalCtx, in);
+}
 
-    // Update PC based on condition
-    if (condition_active) 
+/**
+ * @brief Fused step of the global context returning the packed word (@see SeqNet_ctxStepRaw).
+ *
+ * @param[in] in  Condition selector inputs of the current state.
+ * @return uint16_t  Encoded instruction.
+ */
+uint16_t SeqNet_stepRaw(const CondSel_In* in)
+{
+    if (!SeqNet_ProgMemDecoded)
     {
-        SeqNet_PC = out.jump_addr;
-        DEBUG_PC_PRINTF("DEBUG: PC jump: 0x%02X\n", SeqNet_PC);
-    } 
-    else 
+        SeqNetProgramMemory_decode();
+    }
+    return SeqNet_ctxStepRaw(&SeqNet_GlobalCtx, in);
+}
+
+/**
+ * @brief Macro-step of the global context (@see SeqNet_ctxRunUntil).
+ */
+uint32_t SeqNet_runUntil(const CondSel_In* in, const uint16_t watch, const uint32_t max_steps, SeqNet_Out* out)
+{
+    if (!SeqNet_ProgMemDecoded)
+    {
+        SeqNetProgramMemory_decode();
+    }
+    return SeqNet_ctxRunUntil(&SeqNet_GlobalCtx, in, watch, max_steps, out);
+}
+
+/**
+ * @brief Wait loop detection of the global context (@see SeqNet_ctxPark).
+ */
+bool SeqNet_park(const CondSel_In* in, SeqNet_Park* park)
+{
+    if (!SeqNet_ProgMemDecoded)
     {
-        DEBUG_PC_PRINTF("DEBUG: PC before increment: 0x%02X\n", SeqNet_PC);
-        SeqNet_PC = (SeqNet_PC + 1) % PROGMEM_SIZE;
-        DEBUG_PC_PRINTF("DEBUG: PC increment: 0x%02X\n", SeqNet_PC);
+        SeqNetProgramMemory_decode();
     }
+    return SeqNet_ctxPark(&SeqNet_GlobalCtx, in, park);
+}
+
+/**
+ * @brief Attaches a profile to the global context (@see SeqNet_ctxProfile).
+ */
+void SeqNet_profile(SeqNet_Profile* profile)
+{
+    SeqNet_ctxProfile(&SeqNet_GlobalCtx, profile);
+}
+
+/**
+ * @brief Clears every counter of a profile.
+ *
+ * @param[out] profile  Profile to clear.
+ */
+void SeqNetProfile_reset(SeqNet_Profile* profile)
+{
+    LIFT_ASSERT(profile != NULL);
+    memset(profile, 0, sizeof(SeqNet_Profile));
+}
+
+/**
+ * @brief Rebuilds the predecoded instruction table of a program.
+ *
+ * Row 255 holds the trap word (@see SEQNET_TRAP_WORD), so a jump past the program
+ * memory halts there like in the table-driven engines.
+ * The identity is the FNV-1a hash of the words, so equal images share it.
+ *
+ * @param[in,out] program  Program whose words are decoded into its table.
+ */
+void SeqNetProgram_decode(SeqNet_Program* program)
+{
+    LIFT_ASSERT(program != NULL);
+
+    uint32_t id = 2166136261U;
+    for (uint16_t i = 0; i < PROGMEM_SIZE; ++i)
+    {
+        program->decoded[i] = SeqNetInstruction_convert(program->words[i]);
+        id = (id ^ (program->words[i] & 0xFFU)) * 16777619U;
+        id = (id ^ (program->words[i] >> 8)) * 16777619U;
+    }
+    program->decoded[PROGMEM_SIZE] = SeqNetInstruction_convert(SEQNET_TRAP_WORD);
+    program->id = id;
+}
+
+/**
+ * @brief Initializes a controller context.
+ *
+ * PC is set to 0, the program is only referenced (not copied).
+ *
+ * @param[out] ctx      Context to initialize.
+ * @param[in]  program  Decoded program executed by the context.
+ */
+void SeqNet_ctxInit(SeqNet_Ctx* ctx, const SeqNet_Program* program)
+{
+    LIFT_ASSERT(ctx != NULL);
+    LIFT_ASSERT(program != NULL);
+
+    ctx->program = program;
+    ctx->pc = 0;
+    ctx->profile = NULL;
+}
+
+/**
+ * @brief Attaches a profile to a controller context.
+ *
+ * @param[in,out] ctx      Context to profile.
+ * @param[in]     profile  Counters to update, NULL detaches.
+ */
+void SeqNet_ctxProfile(SeqNet_Ctx* ctx, SeqNet_Profile* profile)
+{
+    LIFT_ASSERT(ctx != NULL);
+    ctx->profile = profile;
+}
+
+/**
+ * @brief Executes the current instruction of a context and advances or jumps its PC.
+ * 
+ * This function fetches the current predecoded instruction (at PC),
+ * returns the requested output structure, and updates PC based on
+ * the `condition_active` flag.
+ * 
+ * @param[in,out] ctx               Context to step.
+ * @param[in]     condition_active  True if the selected condition is active (or inverted false).
+ * @return SeqNet_Out               Decoded instruction fields.
+ */
+SeqNet_Out SeqNet_ctxLoop(SeqNet_Ctx* ctx, const bool condition_active)
+{
+    // Fetch current predecoded instruction
+    const SeqNet_Out out = ctx->program->decoded[ctx->pc];
+
+    // Update PC based on condition
+    SeqNetPC_update(ctx, &out, condition_active);
+
+    return out;
+}
+
+/**
+ * @brief Fused fetch, condition evaluation and step of a context.
+ *
+ * The predecoded instruction provides the condition selector fields,
+ * so the word is neither fetched nor decoded a second time.
+ *
+ * @param[in,out] ctx  Context to step.
+ * @param[in]     in   Condition selector inputs of the current state.
+ * @return SeqNet_Out  Decoded instruction fields.
+ */
+SeqNet_Out SeqNet_ctxStep(SeqNet_Ctx* ctx, const CondSel_In* in)
+{
+    LIFT_ASSERT(in != NULL);
+    const SeqNet_Out out = ctx->program->decoded[ctx->pc];
+
+    SeqNetPC_update(ctx, &out, CondSel_calcMask(out.cond_inv, out.cond_sel, CondSel_pack(in)));
 
     return out;
 }
 
+/**
+ * @brief Fused step of a context returning the packed instruction word.
+ *
+ * @param[in,out] ctx  Context to step.
+ * @param[in]     in   Condition selector inputs of the current state.
+ * @return uint16_t    Encoded instruction.
+ */
+uint16_t SeqNet_ctxStepRaw(SeqNet_Ctx* ctx, const CondSel_In* in)
+{
+    LIFT_ASSERT(in != NULL);
+    const uint16_t word = SeqNetProgram_word(ctx->program, ctx->pc);
+    const SeqNet_Out* out = &ctx->program->decoded[ctx->pc];
+
+    SeqNetPC_update(ctx, out, CondSel_calcMask(out->cond_inv, out->cond_sel, CondSel_pack(in)));
+
+    return word;
+}
+
+/**
+ * @brief Executes instructions of a context until the watched outputs change
+ *        or an input-dependent branch is reached.
+ *
+ * The first instruction is always executed. Each following one is executed on the
+ * same inputs only if its watched outputs equal the ones of the first instruction,
+ * no movement or call reset was requested so far, and its selector reads none of the
+ * inputs the outputs executed so far may have changed.
+ *
+ * @param[in,out] ctx        Context to step.
+ * @param[in]     in         Condition selector inputs of the current state.
+ * @param[in]     watch      Watched output groups (SEQNET_WATCH_*).
+ * @param[in]     max_steps  Maximum number of instructions to execute.
+ * @param[out]    out        Outputs of the last executed instruction.
+ * @return uint32_t          Number of executed instructions.
+ */
+uint32_t SeqNet_ctxRunUntil(SeqNet_Ctx* ctx, const CondSel_In* in, const uint16_t watch, const uint32_t max_steps, SeqNet_Out* out)
+{
+    LIFT_ASSERT(in != NULL);
+    LIFT_ASSERT(out != NULL);
+    LIFT_ASSERT(max_steps > 0);
+
+    const SeqNet_Program* program = ctx->program;
+    const CondSel_Mask mask = CondSel_pack(in);
+    const uint16_t watched = SeqNetProgram_word(program, ctx->pc) & watch;
+
+    CondSel_Mask affected = 0;
+    uint32_t steps = 0;
+
+    while (steps < max_steps)
+    {
+        const SeqNet_Out* instr = &program->decoded[ctx->pc];
+
+        if (steps > 0)
+        {
+            // Stop if the watched outputs change or the branch reads a touched input
+            if (((SeqNetProgram_word(program, ctx->pc) & watch) != watched) ||
+                ((CondSel_dependency(instr->cond_sel) & affected) != 0))
+            {
+                break;
+            }
+        }
+
+        *out = *instr;
+        SeqNetPC_update(ctx, instr, CondSel_calcMask(instr->cond_inv, instr->cond_sel, mask));
+        ++steps;
+
+        // Every movement or call reset step is a plant event, watched or not
+        if (instr->req_move_up || instr->req_move_down || instr->req_reset)
+        {
+            break;
+        }
+
+        affected |= SeqNetOut_affects(instr);
+    }
+
+    return steps;
+}
+
 /**
  * @brief Convert a 16-bit instruction to SeqNet_Out structure.
  * 
@@ -158,4 +492,98 @@ uint16_t SeqNetOut_convert(const SeqNet_Out* out)
     instr |= ((out->cond_inv      & 0x1)              << BIT_COND_INV);
 
     return instr;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Detects whether a controller context waits in a loop on the given inputs.
+ *
+ * Walks the program from the current PC on fixed inputs. The walk fails as soon as an
+ * instruction holds different outputs or requests a movement, and succeeds when it gets
+ * back to the starting PC. A cycle not containing the current PC is not reported, the
+ * controller enters it after a few more steps.
+ *
+ * @param[in]  ctx   Context to inspect.
+ * @param[in]  in    Condition selector inputs of the current state.
+ * @param[out] park  Description of the detected loop.
+ * @return bool      True, if the context is parked.
+ */
+bool SeqNet_ctxPark(const SeqNet_Ctx* ctx, const CondSel_In* in, SeqNet_Park* park)
+{
+    LIFT_ASSERT(in != NULL);
+    LIFT_ASSERT(park != NULL);
+
+    const SeqNet_Program* program = ctx->program;
+    const CondSel_Mask mask = CondSel_pack(in);
+    const uint16_t held = SeqNetProgram_word(program, ctx->pc) & SEQNET_WATCH_ALL;
+
+    CondSel_Mask depends = 0;
+    uint8_t pc = ctx->pc;
+
+    for (uint16_t length = 1; length <= PROGMEM_SIZE; ++length)
+    {
+        const SeqNet_Out* instr = &program->decoded[pc];
+
+        if (((SeqNetProgram_word(program, pc) & SEQNET_WATCH_ALL) != held) ||
+            instr->req_move_up || instr->req_move_down)
+        {
+            return false;
+        }
+
+        depends |= CondSel_dependency(instr->cond_sel);
+        pc = CondSel_calcMask(instr->cond_inv, instr->cond_sel, mask) ?
+             instr->jump_addr : (uint8_t)((pc + 1) % PROGMEM_SIZE);
+
+        if (pc == ctx->pc)
+        {
+            park->pc = ctx->pc;
+            park->length = (uint8_t)length;
+            park->out_word = held;
+            park->depends = depends;
+            park->mask = mask;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Advances a parked context by the given number of micro-steps in one jump.
+ *
+ * Whole loop iterations leave the PC unchanged, only the remainder is stepped
+ * (an attached profile still counts every skipped instruction).
+ *
+ * @param[in,out] ctx    Parked context.
+ * @param[in]     park   Loop the context is parked in.
+ * @param[in]     ticks  Number of micro-steps to skip.
+ */
+void SeqNet_ctxFastForward(SeqNet_Ctx* ctx, const SeqNet_Park* park, const uint64_t ticks)
+{
+    LIFT_ASSERT(park != NULL);
+    LIFT_ASSERT(park->length > 0);
+    LIFT_ASSERT(ctx->pc == park->pc);
+
+#if SEQNET_PROFILE_ENABLED
+    // Whole loop iterations: every instruction of the loop once per iteration
+    const uint64_t iterations = ticks / park->length;
+    if ((ctx->profile != NULL) && (iterations > 0))
+    {
+        uint8_t pc = ctx->pc;
+        for (uint8_t i = 0; i < park->length; ++i)
+        {
+            const SeqNet_Out* instr = &ctx->program->decoded[pc];
+            const bool taken = CondSel_calcMask(instr->cond_inv, instr->cond_sel, park->mask);
+            ctx->profile->hits[pc] += iterations;
+            ctx->profile->taken[pc] += taken ? iterations : 0;
+            ctx->profile->selector[instr->cond_sel & MASK_COND_SEL] += iterations;
+            pc = taken ? instr->jump_addr : (uint8_t)((pc + 1) % PROGMEM_SIZE);
+        }
+    }
+#endif
+
+    for (uint64_t i = ticks % park->length; i > 0; --i)
+    {
+        const SeqNet_Out* instr = &ctx->program->decoded[ctx->pc];
+        SeqNetPC_update(ctx, instr, CondSel_calcMask(instr->cond_inv, instr->cond_sel, park->mask));
+    }
+}
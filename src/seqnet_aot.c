@@ -0,0 +1,229 @@
+/**
+ * @file seqnet_aot.c
+ * @brief Implements the ahead-of-time compiler from a program image to specialized C.
+ */
+
+#include "seqnet_aot.h"
+#include "seqnet_internal.h"  // for BIT_*, MASK_*
+#include "condsel_internal.h"  // CONDSEL ENUMs
+#include "lift_assert.h"
+
+/// C expressions of the selectable condition values, indexed by selector
+static const char* const SeqNetAot_conditions[] = {
+    "(in->call_pending_below || in->call_pending_same || in->call_pending_above)",
+    "in->call_pending_below",
+    "in->call_pending_same",
+    "in->call_pending_above",
+    "in->door_closed",
+    "in->door_open",
+    "false",
+    "false"
+};
+
+/**
+ * @brief Returns true, if the selector of an instruction does not depend on the inputs.
+ */
+static bool SeqNetAot_isConstant(const SeqNet_Out* instr)
+{
+    return (instr->cond_sel == CONDSEL_ENUM_RESERVED) ||
+           (instr->cond_sel == CONDSEL_ENUM_CONST_FALSE);
+}
+
+/**
+ * @brief Returns the fall-through address of a PC.
+ */
+static uint8_t SeqNetAot_next(uint8_t pc)
+{
+    return (uint8_t)((pc + 1) % SEQNET_PROGMEM_SIZE);
+}
+
+/**
+ * @brief Writes the condition expression of an instruction (with inversion).
+ */
+static void SeqNetAot_writeCondition(FILE* file, const SeqNet_Out* instr)
+{
+    fprintf(file, "%s%s%s",
+            instr->cond_inv ? "!(" : "",
+            SeqNetAot_conditions[instr->cond_sel & MASK_COND_SEL],
+            instr->cond_inv ? ")" : "");
+}
+
+/**
+ * @brief Writes a direct transfer to a PC of the multi-step engine.
+ *
+ * Explicit words have their own label; all-zero words share the generic handler,
+ * a jump to 255 (past the program memory) goes to the trap.
+ */
+static void SeqNetAot_writeGoto(FILE* file, const SeqNet_Program* program, uint8_t target)
+{
+    if (target >= SEQNET_PROGMEM_SIZE)
+    {
+        fprintf(file, "goto pc_trap;");
+    }
+    else if (program->words[target] != 0)
+    {
+        fprintf(file, "goto pc_%u;", target);
+    }
+    else
+    {
+        fprintf(file, "pc = %u; goto pc_zero;", target);
+    }
+}
+
+/**
+ * @brief Writes the specialized C engine of a program.
+ *
+ * Every non-zero word gets its own case / label, the remaining (all-zero) words
+ * share one generic handler, so the result matches the interpreter on all PCs.
+ * PC 255 executes the trap word (@see SEQNET_TRAP_WORD) like the batch engine.
+ */
+bool SeqNetAot_generate(FILE* file, const SeqNet_Program* program, const char* name)
+{
+    LIFT_ASSERT(file != NULL);
+    LIFT_ASSERT(program != NULL);
+
+    fprintf(file, "/**\n");
+    fprintf(file, " * @file seqnet_aot_%s.c\n", (name != NULL) ? name : "program");
+    fprintf(file, " * @brief Specialized engine generated by SeqNetAot_generate(). Do not edit.\n");
+    fprintf(file, " *\n");
+    fprintf(file, " *  PC | Word   | Condition\n");
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        if (program->words[pc] == 0) continue;
+        const SeqNet_Out* instr = &program->decoded[pc];
+        fprintf(file, " * %3u | 0x%04X | %s%s -> %u%s\n",
+                pc, program->words[pc],
+                instr->cond_inv ? "!" : "",
+                SeqNetAot_conditions[instr->cond_sel & MASK_COND_SEL],
+                instr->jump_addr,
+                SeqNetAot_isConstant(instr) ? (instr->cond_inv ? " (always)" : " (never)") : "");
+    }
+    fprintf(file, " */\n\n");
+    fprintf(file, "#include \"seqnet.h\"\n");
+    fprintf(file, "#include \"seqnet_aot.h\"\n\n");
+
+    // Outputs, the omitted entries are all-zero words, the last one is the trap
+    const SeqNet_Out trap = SeqNetInstruction_convert(SEQNET_TRAP_WORD);
+    fprintf(file, "/// Outputs of every PC, the trap at PC %u\n", SEQNET_PROGMEM_SIZE);
+    fprintf(file, "static const SeqNet_Out SeqNetAot_outputs[SEQNET_PROGMEM_SIZE + 1] = {\n");
+    for (uint16_t pc = 0; pc <= SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        if ((pc < SEQNET_PROGMEM_SIZE) && (program->words[pc] == 0)) continue;
+        const SeqNet_Out* o = (pc < SEQNET_PROGMEM_SIZE) ? &program->decoded[pc] : &trap;
+        fprintf(file, "    [%u] = { .cond_inv = %u, .cond_sel = %u, .req_reset = %u, .req_door_state = %u, "
+                      ".req_move_down = %u, .req_move_up = %u, .jump_addr = %u },\n",
+                pc, o->cond_inv, o->cond_sel, o->req_reset, o->req_door_state,
+                o->req_move_down, o->req_move_up, o->jump_addr);
+    }
+    fprintf(file, "};\n\n");
+
+    // Drop-in replacement of SeqNet_ctxLoop()
+    fprintf(file, "SeqNet_Out SeqNetAot_ctxLoop(SeqNet_Ctx* ctx, const bool condition_active)\n{\n");
+    fprintf(file, "    const uint8_t pc = ctx->pc;\n\n");
+    fprintf(file, "    switch (pc)\n    {\n");
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        if (program->words[pc] == 0) continue;
+        fprintf(file, "        case %u: ctx->pc = condition_active ? %u : %u; break;\n",
+                pc, program->decoded[pc].jump_addr, SeqNetAot_next((uint8_t)pc));
+    }
+    fprintf(file, "        case %u: break;\n", SEQNET_PROGMEM_SIZE);
+    fprintf(file, "        default: ctx->pc = condition_active ? 0 : (uint8_t)((pc + 1) %% SEQNET_PROGMEM_SIZE); break;\n");
+    fprintf(file, "    }\n\n");
+    fprintf(file, "    return SeqNetAot_outputs[pc];\n}\n\n");
+
+    // Drop-in replacement of SeqNet_ctxStep(), constant conditions folded
+    fprintf(file, "SeqNet_Out SeqNetAot_ctxStep(SeqNet_Ctx* ctx, const CondSel_In* in)\n{\n");
+    fprintf(file, "    const uint8_t pc = ctx->pc;\n\n");
+    fprintf(file, "    switch (pc)\n    {\n");
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        if (program->words[pc] == 0) continue;
+        const SeqNet_Out* instr = &program->decoded[pc];
+        if (SeqNetAot_isConstant(instr))
+        {
+            fprintf(file, "        case %u: ctx->pc = %u; break;\n",
+                    pc, instr->cond_inv ? instr->jump_addr : SeqNetAot_next((uint8_t)pc));
+        }
+        else
+        {
+            fprintf(file, "        case %u: ctx->pc = ", pc);
+            SeqNetAot_writeCondition(file, instr);
+            fprintf(file, " ? %u : %u; break;\n", instr->jump_addr, SeqNetAot_next((uint8_t)pc));
+        }
+    }
+    fprintf(file, "        case %u: break;\n", SEQNET_PROGMEM_SIZE);
+    fprintf(file, "        default: ctx->pc = %s ? 0 : (uint8_t)((pc + 1) %% SEQNET_PROGMEM_SIZE); break;\n",
+            SeqNetAot_conditions[CONDSEL_ENUM_PEND_ANY]);
+    fprintf(file, "    }\n\n");
+    fprintf(file, "    return SeqNetAot_outputs[pc];\n}\n\n");
+
+    // Multi-step engine, one label per PC threaded with direct gotos
+    fprintf(file, "void SeqNetAot_ctxRun(SeqNet_Ctx* ctx, CondSel_In* in, uint32_t steps, SeqNetAot_Plant plant, void* user)\n{\n");
+    fprintf(file, "    uint8_t pc = ctx->pc;\n");
+    fprintf(file, "    bool cond;\n\n");
+    fprintf(file, "    switch (pc)\n    {\n");
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        if (program->words[pc] == 0) continue;
+        fprintf(file, "        case %u: goto pc_%u;\n", pc, pc);
+    }
+    fprintf(file, "        case %u: goto pc_trap;\n", SEQNET_PROGMEM_SIZE);
+    fprintf(file, "        default: goto pc_zero;\n");
+    fprintf(file, "    }\n\n");
+
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        if (program->words[pc] == 0) continue;
+        const SeqNet_Out* instr = &program->decoded[pc];
+        const uint8_t next = SeqNetAot_next((uint8_t)pc);
+
+        fprintf(file, "pc_%u:\n", pc);
+        fprintf(file, "    if (steps == 0) { ctx->pc = %u; return; }\n", pc);
+        fprintf(file, "    --steps;\n");
+        if (SeqNetAot_isConstant(instr))
+        {
+            fprintf(file, "    plant(user, &SeqNetAot_outputs[%u], in);\n", pc);
+            fprintf(file, "    ");
+            SeqNetAot_writeGoto(file, program, instr->cond_inv ? instr->jump_addr : next);
+            fprintf(file, "\n\n");
+        }
+        else
+        {
+            fprintf(file, "    cond = ");
+            SeqNetAot_writeCondition(file, instr);
+            fprintf(file, ";\n");
+            fprintf(file, "    plant(user, &SeqNetAot_outputs[%u], in);\n", pc);
+            fprintf(file, "    if (cond) { ");
+            SeqNetAot_writeGoto(file, program, instr->jump_addr);
+            fprintf(file, " }\n    ");
+            SeqNetAot_writeGoto(file, program, next);
+            fprintf(file, "\n\n");
+        }
+    }
+
+    // Trap past the program memory: no outputs, stays there
+    fprintf(file, "pc_trap:\n");
+    fprintf(file, "    if (steps == 0) { ctx->pc = %u; return; }\n", SEQNET_PROGMEM_SIZE);
+    fprintf(file, "    --steps;\n");
+    fprintf(file, "    plant(user, &SeqNetAot_outputs[%u], in);\n", SEQNET_PROGMEM_SIZE);
+    fprintf(file, "    goto pc_trap;\n\n");
+
+    // Shared handler of the all-zero words: "jump to 0 if any call is pending"
+    fprintf(file, "pc_zero:\n");
+    fprintf(file, "    if (steps == 0) { ctx->pc = pc; return; }\n");
+    fprintf(file, "    --steps;\n");
+    fprintf(file, "    cond = %s;\n", SeqNetAot_conditions[CONDSEL_ENUM_PEND_ANY]);
+    fprintf(file, "    plant(user, &SeqNetAot_outputs[pc], in);\n");
+    fprintf(file, "    pc = cond ? 0 : (uint8_t)((pc + 1) %% SEQNET_PROGMEM_SIZE);\n");
+    fprintf(file, "    switch (pc)\n    {\n");
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        if (program->words[pc] == 0) continue;
+        fprintf(file, "        case %u: goto pc_%u;\n", pc, pc);
+    }
+    fprintf(file, "        default: goto pc_zero;\n");
+    fprintf(file, "    }\n}\n");
+
+    return ferror(file) == 0;
+}
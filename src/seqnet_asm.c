@@ -0,0 +1,780 @@
+/**
+ * @file seqnet_asm.c
+ * @brief Implements the assembler, the disassembler and the optimizer of the microprograms.
+ */
+
+#include <string.h>
+#include "seqnet_asm.h"
+#include "seqnet_internal.h"  // for BIT_*, MASK_*, SeqNetOut_convert()
+#include "condsel_internal.h"  // CONDSEL ENUMs
+#include "lift_assert.h"
+
+/// Output bits of a word: movement, door and call reset
+#define SEQNET_ASM_OUTPUTS      ((uint16_t)((1U << BIT_MOVE_UP) | (1U << BIT_MOVE_DOWN) | (1U << BIT_DOOR_STATE) | (1U << BIT_REQ_RESET)))
+/// Outputs acting on the plant every time they are executed, never dropped by the optimizer
+#define SEQNET_ASM_ACTIONS      ((uint16_t)((1U << BIT_MOVE_UP) | (1U << BIT_MOVE_DOWN) | (1U << BIT_REQ_RESET)))
+/// Most tokens of a source line
+#define SEQNET_ASM_TOKENS       (16U)
+/// Column of the instruction in a listing
+#define SEQNET_ASM_CODE_COLUMN  (16)
+/// Column of the comment in a listing
+#define SEQNET_ASM_NOTE_COLUMN  (48)
+
+/// Names of the condition selectors (@see ConditionSelectorIndexes_t)
+static const char* const SeqNetAsm_conditions[SEQNET_SELECTOR_COUNT] = {
+    "pend_any", "pend_below", "pend_same", "pend_above", "door_closed", "door_opened", "reserved", "false"
+};
+
+/// Keywords, not usable as labels (the condition names neither)
+static const char* const SeqNetAsm_keywords[] = {
+    "open", "close", "up", "down", "reset", "goto", "if", "unless"
+};
+
+/**
+ * @brief Slice of the source text.
+ */
+typedef struct {
+    const char* text;
+    size_t length;
+} SeqNetAsmToken_t;
+
+/**
+ * @brief Instruction of the optimizer graph.
+ */
+typedef struct {
+    uint16_t outputs;   // Output bits of the word
+    uint8_t cond;       // Selector and inversion bits of a branch (word >> BIT_COND_SEL)
+    uint8_t next[2];    // Successor when the jump is taken (or the only one), fall-through of a branch
+} SeqNetAsmNode_t;
+
+// === Helpers ===
+
+static inline bool SeqNetAsm_space(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r');
+}
+
+static inline bool SeqNetAsm_alpha(char c)
+{
+    return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || (c == '_');
+}
+
+static inline bool SeqNetAsm_digit(char c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+static bool SeqNetAsm_is(const SeqNetAsmToken_t* token, const char* word)
+{
+    return (strlen(word) == token->length) && (memcmp(token->text, word, token->length) == 0);
+}
+
+/**
+ * @brief Index of a condition name, SEQNET_SELECTOR_COUNT if the token is none.
+ */
+static uint8_t SeqNetAsm_condition(const SeqNetAsmToken_t* token)
+{
+    uint8_t sel = 0;
+    while ((sel < SEQNET_SELECTOR_COUNT) && !SeqNetAsm_is(token, SeqNetAsm_conditions[sel]))
+    {
+        ++sel;
+    }
+    return sel;
+}
+
+/**
+ * @brief Returns true, if the token can name a label.
+ */
+static bool SeqNetAsm_identifier(const SeqNetAsmToken_t* token)
+{
+    if ((token->length == 0) || !SeqNetAsm_alpha(token->text[0])) return false;
+    for (size_t i = 1; i < token->length; ++i)
+    {
+        if (!SeqNetAsm_alpha(token->text[i]) && !SeqNetAsm_digit(token->text[i])) return false;
+    }
+    for (size_t i = 0; i < sizeof(SeqNetAsm_keywords) / sizeof(SeqNetAsm_keywords[0]); ++i)
+    {
+        if (SeqNetAsm_is(token, SeqNetAsm_keywords[i])) return false;
+    }
+    return SeqNetAsm_condition(token) == SEQNET_SELECTOR_COUNT;
+}
+
+/**
+ * @brief PC of a label, SEQNET_ASM_PC_NONE if undefined.
+ */
+static uint8_t SeqNetAsm_find(const SeqNetAsmProgram_t* program, const char* name, size_t length)
+{
+    for (uint16_t pc = 0; pc < program->count; ++pc)
+    {
+        if ((strlen(program->symbols[pc]) == length) && (memcmp(program->symbols[pc], name, length) == 0))
+        {
+            return (uint8_t)pc;
+        }
+    }
+    return SEQNET_ASM_PC_NONE;
+}
+
+/**
+ * @brief True, if the jump of a word is never taken (constant false selector).
+ */
+static inline bool SeqNetAsm_never(const SeqNet_Out* out)
+{
+    return ((out->cond_sel == CONDSEL_ENUM_RESERVED) || (out->cond_sel == CONDSEL_ENUM_CONST_FALSE)) && !out->cond_inv;
+}
+
+/**
+ * @brief True, if the jump of a word is always taken.
+ */
+static inline bool SeqNetAsm_always(const SeqNet_Out* out)
+{
+    return ((out->cond_sel == CONDSEL_ENUM_RESERVED) || (out->cond_sel == CONDSEL_ENUM_CONST_FALSE)) && out->cond_inv;
+}
+
+/**
+ * @brief True, if the listing of a word has a jump (anything but the plain "no jump" encoding).
+ */
+static inline bool SeqNetAsm_jumps(const SeqNet_Out* out)
+{
+    return (out->cond_sel != CONDSEL_ENUM_CONST_FALSE) || out->cond_inv || (out->jump_addr != 0);
+}
+
+// === Assembler ===
+
+void SeqNetAsmProgram_init(SeqNetAsmProgram_t* program, const uint16_t* words, uint16_t count)
+{
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT(count <= SEQNET_PROGMEM_SIZE);
+    LIFT_ASSERT((count == 0) || (words != NULL));
+
+    memset(program, 0, sizeof(*program));
+    if (count != 0)
+    {
+        memcpy(program->words, words, count * sizeof(uint16_t));
+    }
+    program->count = count;
+}
+
+/**
+ * @brief Assembles the instruction of one line (without its label).
+ *
+ * @param[in]  tokens  Tokens of the instruction.
+ * @param[in]  count   Number of tokens (at least 1).
+ * @param[out] out     Decoded instruction, jump address set for numeric targets.
+ * @param[out] target  Label of the jump target, length 0 if numeric or none.
+ * @return Returns with SEQNET_ASM_OK or the reason of the failure.
+ */
+static SeqNetAsmStatus_t SeqNetAsm_instruction(const SeqNetAsmToken_t* tokens, size_t count,
+                                               SeqNet_Out* out, SeqNetAsmToken_t* target)
+{
+    bool door = false;
+    memset(out, 0, sizeof(*out));
+    out->cond_sel = CONDSEL_ENUM_CONST_FALSE;
+    target->length = 0;
+
+    size_t i = 0;
+    for (; (i < count) && !SeqNetAsm_is(&tokens[i], "goto"); ++i)
+    {
+        const SeqNetAsmToken_t* token = &tokens[i];
+        bool* flag;
+        if (SeqNetAsm_is(token, "open") || SeqNetAsm_is(token, "close"))
+        {
+            if (door) return SEQNET_ASM_SYNTAX;
+            door = true;
+            out->req_door_state = SeqNetAsm_is(token, "open") ? DOOR_REQ_OPEN : DOOR_REQ_CLOSE;
+            continue;
+        }
+        else if (SeqNetAsm_is(token, "up"))     flag = &out->req_move_up;
+        else if (SeqNetAsm_is(token, "down"))   flag = &out->req_move_down;
+        else if (SeqNetAsm_is(token, "reset"))  flag = &out->req_reset;
+        else return SEQNET_ASM_SYNTAX;
+
+        if (*flag) return SEQNET_ASM_SYNTAX;
+        *flag = true;
+    }
+    if (i == count) return SEQNET_ASM_OK;  // No jump
+
+    // goto <target> [if|unless <condition>]
+    if ((count - i != 2U) && (count - i != 4U)) return SEQNET_ASM_SYNTAX;
+    const SeqNetAsmToken_t* operand = &tokens[i + 1U];
+    if (SeqNetAsm_digit(operand->text[0]))
+    {
+        uint32_t pc = 0;
+        for (size_t d = 0; d < operand->length; ++d)
+        {
+            if (!SeqNetAsm_digit(operand->text[d])) return SEQNET_ASM_SYNTAX;
+            pc = pc * 10U + (uint32_t)(operand->text[d] - '0');
+            if (pc >= SEQNET_PROGMEM_SIZE) return SEQNET_ASM_BAD_TARGET;
+        }
+        out->jump_addr = (uint8_t)pc;
+    }
+    else if (SeqNetAsm_identifier(operand))
+    {
+        *target = *operand;
+    }
+    else
+    {
+        return SEQNET_ASM_SYNTAX;
+    }
+
+    out->cond_inv = true;  // Unconditional: inverted constant false
+    if (count - i == 4U)
+    {
+        const bool when = SeqNetAsm_is(&tokens[i + 2U], "if");
+        if (!when && !SeqNetAsm_is(&tokens[i + 2U], "unless")) return SEQNET_ASM_SYNTAX;
+        const uint8_t sel = SeqNetAsm_condition(&tokens[i + 3U]);
+        if (sel == SEQNET_SELECTOR_COUNT) return SEQNET_ASM_SYNTAX;
+        out->cond_sel = sel;
+        out->cond_inv = !when;
+    }
+    return SEQNET_ASM_OK;
+}
+
+SeqNetAsmStatus_t SeqNetAsm_assemble(const char* source, SeqNetAsmProgram_t* program, uint32_t* line)
+{
+    LIFT_ASSERT(source != NULL);
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT(line != NULL);
+
+    // Label jumps are resolved once every label is known
+    SeqNetAsmToken_t fixups[SEQNET_PROGMEM_SIZE];
+    uint32_t fixup_lines[SEQNET_PROGMEM_SIZE];
+    SeqNetAsmToken_t label = { NULL, 0 };
+    uint32_t label_line = 0;
+
+    memset(program, 0, sizeof(*program));
+    *line = 0;
+
+    const char* cursor = source;
+    for (uint32_t number = 1; *cursor != '\0'; ++number)
+    {
+        const char* end = cursor;
+        while ((*end != '\0') && (*end != '\n')) ++end;
+        const char* note = cursor;
+        while ((note < end) && (*note != ';')) ++note;
+
+        // Tokens of the code part
+        SeqNetAsmToken_t tokens[SEQNET_ASM_TOKENS];
+        size_t count = 0;
+        for (const char* p = cursor; p < note;)
+        {
+            if (SeqNetAsm_space(*p))
+            {
+                ++p;
+                continue;
+            }
+            const char* start = p;
+            while ((p < note) && !SeqNetAsm_space(*p)) ++p;
+            if (count == SEQNET_ASM_TOKENS)
+            {
+                *line = number;
+                return SEQNET_ASM_SYNTAX;
+            }
+            tokens[count].text = start;
+            tokens[count].length = (size_t)(p - start);
+            ++count;
+        }
+        cursor = (*end == '\n') ? end + 1 : end;
+
+        // Optional label, it names the next instruction
+        size_t first = 0;
+        SeqNetAsmStatus_t status = SEQNET_ASM_OK;
+        if ((count > 0) && (tokens[0].text[tokens[0].length - 1U] == ':'))
+        {
+            SeqNetAsmToken_t name = { tokens[0].text, tokens[0].length - 1U };
+            if (!SeqNetAsm_identifier(&name))                     status = SEQNET_ASM_SYNTAX;
+            else if (name.length >= SEQNET_ASM_NAME_SIZE)         status = SEQNET_ASM_TOO_LONG;
+            else if ((label.length != 0) ||
+                     (SeqNetAsm_find(program, name.text, name.length) != SEQNET_ASM_PC_NONE)) status = SEQNET_ASM_DUPLICATE_LABEL;
+            label = name;
+            label_line = number;
+            first = 1;
+        }
+        if ((status == SEQNET_ASM_OK) && (first < count) && (program->count == SEQNET_PROGMEM_SIZE))
+        {
+            status = SEQNET_ASM_TOO_LONG;
+        }
+        if (status != SEQNET_ASM_OK)
+        {
+            *line = number;
+            return status;
+        }
+        if (first == count) continue;  // Empty, comment or label only
+
+        const uint16_t pc = program->count;
+        SeqNet_Out out;
+        status = SeqNetAsm_instruction(&tokens[first], count - first, &out, &fixups[pc]);
+        if (status != SEQNET_ASM_OK)
+        {
+            *line = number;
+            return status;
+        }
+        program->words[pc] = SeqNetOut_convert(&out);
+        fixup_lines[pc] = number;
+
+        if (label.length != 0)
+        {
+            memcpy(program->symbols[pc], label.text, label.length);
+            label.length = 0;
+        }
+
+        // Comment, without the surrounding blanks
+        const char* text = (note < end) ? note + 1 : end;
+        const char* stop = end;
+        while ((text < stop) && SeqNetAsm_space(*text)) ++text;
+        while ((stop > text) && SeqNetAsm_space(stop[-1])) --stop;
+        if ((size_t)(stop - text) >= SEQNET_ASM_COMMENT_SIZE)
+        {
+            *line = number;
+            return SEQNET_ASM_TOO_LONG;
+        }
+        memcpy(program->comments[pc], text, (size_t)(stop - text));
+        program->count++;
+    }
+
+    // A label after the last instruction names no word
+    if (label.length != 0)
+    {
+        *line = label_line;
+        return SEQNET_ASM_SYNTAX;
+    }
+
+    for (uint16_t pc = 0; pc < program->count; ++pc)
+    {
+        if (fixups[pc].length == 0) continue;
+
+        const uint8_t target = SeqNetAsm_find(program, fixups[pc].text, fixups[pc].length);
+        if (target == SEQNET_ASM_PC_NONE)
+        {
+            *line = fixup_lines[pc];
+            return SEQNET_ASM_UNKNOWN_LABEL;
+        }
+        program->words[pc] |= (uint16_t)(target << BIT_JUMP_ADDR);
+    }
+    return SEQNET_ASM_OK;
+}
+
+// === Disassembler ===
+
+bool SeqNetAsm_disassemble(const SeqNetAsmProgram_t* program, FILE* out)
+{
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT(out != NULL);
+
+    // Name of every PC: its label, or a generated one for jump targets
+    char names[SEQNET_PROGMEM_SIZE][SEQNET_ASM_NAME_SIZE];
+    bool target[SEQNET_PROGMEM_SIZE] = { false };
+    for (uint16_t pc = 0; pc < program->count; ++pc)
+    {
+        const SeqNet_Out instr = SeqNetInstruction_convert(program->words[pc]);
+        if (SeqNetAsm_jumps(&instr) && (instr.jump_addr < SEQNET_PROGMEM_SIZE))
+        {
+            target[instr.jump_addr] = true;
+        }
+    }
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        names[pc][0] = '\0';
+        if (pc >= program->count) continue;
+
+        if (program->symbols[pc][0] != '\0')
+        {
+            memcpy(names[pc], program->symbols[pc], SEQNET_ASM_NAME_SIZE);
+            names[pc][SEQNET_ASM_NAME_SIZE - 1U] = '\0';
+        }
+        else if (target[pc])
+        {
+            snprintf(names[pc], SEQNET_ASM_NAME_SIZE, "L%u", (unsigned)pc);
+            if (SeqNetAsm_find(program, names[pc], strlen(names[pc])) != SEQNET_ASM_PC_NONE) names[pc][0] = '\0';
+        }
+    }
+
+    for (uint16_t pc = 0; pc < program->count; ++pc)
+    {
+        const SeqNet_Out instr = SeqNetInstruction_convert(program->words[pc]);
+        char code[SEQNET_ASM_NOTE_COLUMN + SEQNET_ASM_NAME_SIZE];
+        int length = snprintf(code, sizeof(code), "%s%s%s%s", (instr.req_door_state == DOOR_REQ_OPEN) ? "open" : "close",
+                              instr.req_move_up ? " up" : "", instr.req_move_down ? " down" : "", instr.req_reset ? " reset" : "");
+
+        if (SeqNetAsm_jumps(&instr))
+        {
+            char number[4];
+            const char* name = (instr.jump_addr < SEQNET_PROGMEM_SIZE) ? names[instr.jump_addr] : "";
+            if (name[0] == '\0')
+            {
+                snprintf(number, sizeof(number), "%u", (unsigned)instr.jump_addr);
+                name = number;
+            }
+            length += snprintf(&code[length], sizeof(code) - (size_t)length, "%*sgoto %s", (length < 12) ? 12 - length : 1, "", name);
+            if ((instr.cond_sel != CONDSEL_ENUM_CONST_FALSE) || !instr.cond_inv)
+            {
+                snprintf(&code[length], sizeof(code) - (size_t)length, " %s %s", instr.cond_inv ? "unless" : "if",
+                         SeqNetAsm_conditions[instr.cond_sel & MASK_COND_SEL]);
+            }
+        }
+
+        char label[SEQNET_ASM_NAME_SIZE + 1U] = "";
+        if (names[pc][0] != '\0')
+        {
+            snprintf(label, sizeof(label), "%s:", names[pc]);
+        }
+        if (program->comments[pc][0] != '\0')
+        {
+            fprintf(out, "%-*s %-*s ; %.*s\n", SEQNET_ASM_CODE_COLUMN - 1, label, SEQNET_ASM_NOTE_COLUMN - SEQNET_ASM_CODE_COLUMN - 1,
+                    code, (int)(SEQNET_ASM_COMMENT_SIZE - 1U), program->comments[pc]);
+        }
+        else
+        {
+            fprintf(out, "%-*s %s\n", SEQNET_ASM_CODE_COLUMN - 1, label, code);
+        }
+    }
+    return ferror(out) == 0;
+}
+
+// === Optimizer ===
+
+/**
+ * @brief Builds the graph node of a word.
+ */
+static void SeqNetAsm_node(uint16_t word, uint16_t pc, SeqNetAsmNode_t* node)
+{
+    const SeqNet_Out instr = SeqNetInstruction_convert(word);
+    const uint8_t next = (uint8_t)((pc + 1U) % SEQNET_PROGMEM_SIZE);
+
+    node->outputs = word & SEQNET_ASM_OUTPUTS;
+    node->cond = (uint8_t)(word >> BIT_COND_SEL);
+    node->next[1] = SEQNET_ASM_PC_NONE;
+    if (SeqNetAsm_never(&instr))
+    {
+        node->next[0] = next;
+    }
+    else if (SeqNetAsm_always(&instr) || (instr.jump_addr == next))
+    {
+        node->next[0] = instr.jump_addr;
+    }
+    else
+    {
+        node->next[0] = instr.jump_addr;
+        node->next[1] = next;
+    }
+}
+
+/**
+ * @brief Marks the nodes reachable from PC 0 and the entries.
+ * @return Returns with the number of reachable nodes.
+ */
+static uint16_t SeqNetAsm_reach(const SeqNetAsmNode_t* nodes, const uint8_t* entries, uint16_t entry_count, bool* reached)
+{
+    uint8_t stack[SEQNET_PROGMEM_SIZE];
+    uint16_t depth = 0;
+    uint16_t count = 0;
+
+    memset(reached, 0, SEQNET_PROGMEM_SIZE * sizeof(bool));
+    for (uint16_t i = 0; i <= entry_count; ++i)
+    {
+        const uint8_t root = (i == 0) ? 0U : entries[i - 1U];
+        if (reached[root]) continue;
+        reached[root] = true;
+        stack[depth++] = root;
+        ++count;
+
+        while (depth > 0)
+        {
+            const SeqNetAsmNode_t* node = &nodes[stack[--depth]];
+            for (uint8_t k = 0; k < 2U; ++k)
+            {
+                const uint8_t next = node->next[k];
+                if ((next == SEQNET_ASM_PC_NONE) || reached[next]) continue;
+                reached[next] = true;
+                stack[depth++] = next;
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Retargets an edge past the redundant words it leads to.
+ *
+ * A word is redundant on the edge if it has a single successor, neither moves nor
+ * resets, and repeats the outputs of the word before it or of its successor.
+ *
+ * @return Returns with the number of words skipped.
+ */
+static uint16_t SeqNetAsm_thread(const SeqNetAsmNode_t* nodes, uint16_t outputs, uint8_t* next)
+{
+    uint16_t skipped = 0;
+    for (uint16_t hop = 0; hop < SEQNET_PROGMEM_SIZE; ++hop)
+    {
+        const SeqNetAsmNode_t* node = &nodes[*next];
+        const uint8_t after = node->next[0];
+        if ((node->next[1] != SEQNET_ASM_PC_NONE) || (after == *next) || ((node->outputs & SEQNET_ASM_ACTIONS) != 0) ||
+            ((node->outputs != outputs) && (node->outputs != nodes[after].outputs)))
+        {
+            break;
+        }
+        *next = after;
+        ++skipped;
+    }
+    return skipped;
+}
+
+/**
+ * @brief Successor of a branch that should fall through: 0 (taken) if the profile says
+ *        the jump is taken more often than not, else 1 (the source fall-through).
+ */
+static inline uint8_t SeqNetAsm_hot(const SeqNet_Profile* profile, uint8_t pc)
+{
+    return ((profile != NULL) && (2U * profile->taken[pc] > profile->hits[pc])) ? 0U : 1U;
+}
+
+/**
+ * @brief Order of the follower choice: branches before single successors, hot words first.
+ */
+static inline uint64_t SeqNetAsm_rank(const SeqNetAsmNode_t* nodes, const SeqNet_Profile* profile, uint8_t pc)
+{
+    const uint64_t hits = (profile != NULL) ? profile->hits[pc] : 0U;
+    return ((nodes[pc].next[1] == SEQNET_ASM_PC_NONE) ? (1ULL << 63) : 0U) | ((1ULL << 62) - 1U - (hits & ((1ULL << 62) - 1U)));
+}
+
+/**
+ * @brief Places @p to right after @p from, unless it already follows another word,
+ *        it is the reset entry or the link would close a cycle.
+ * @return Returns with true, if linked.
+ */
+static bool SeqNetAsm_link(uint8_t* follower, uint8_t* leader, uint8_t from, uint8_t to)
+{
+    if ((to == 0) || (leader[to] != SEQNET_ASM_PC_NONE)) return false;
+    for (uint8_t pc = to; pc != SEQNET_ASM_PC_NONE; pc = follower[pc])
+    {
+        if (pc == from) return false;
+    }
+    follower[from] = to;
+    leader[to] = from;
+    return true;
+}
+
+SeqNetAsmStatus_t SeqNetAsm_optimize(const SeqNetAsmProgram_t* source, const uint8_t* entries, uint16_t entry_count,
+                                     const SeqNet_Profile* profile, SeqNetAsmProgram_t* target, SeqNetAsmReport_t* report)
+{
+    LIFT_ASSERT(source != NULL);
+    LIFT_ASSERT(target != NULL);
+    LIFT_ASSERT(target != source);
+    LIFT_ASSERT(report != NULL);
+    LIFT_ASSERT((entry_count == 0) || (entries != NULL));
+
+    SeqNetAsmNode_t nodes[SEQNET_PROGMEM_SIZE];
+    bool reached[SEQNET_PROGMEM_SIZE];
+    uint8_t slot[SEQNET_PROGMEM_SIZE];          // Source PC placed at every new PC
+    bool trampoline[SEQNET_PROGMEM_SIZE];       // The new PC jumps to the cold successor of the word before it
+    uint8_t* pos = report->map;
+
+    memset(report, 0, sizeof(*report));
+    report->words_before = source->count;
+    for (uint16_t i = 0; i < entry_count; ++i)
+    {
+        if (entries[i] >= SEQNET_PROGMEM_SIZE) return SEQNET_ASM_BAD_TARGET;
+    }
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        SeqNetAsm_node(source->words[pc], pc, &nodes[pc]);
+    }
+
+    // Jump threading until nothing changes; retargeting only shrinks the reachable set
+    SeqNetAsm_reach(nodes, entries, entry_count, reached);
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+        {
+            SeqNetAsmNode_t* node = &nodes[pc];
+            if (!reached[pc]) continue;
+
+            for (uint8_t k = 0; k < 2U; ++k)
+            {
+                if (node->next[k] == SEQNET_ASM_PC_NONE) continue;
+                const uint16_t skipped = SeqNetAsm_thread(nodes, node->outputs, &node->next[k]);
+                report->threaded += (skipped != 0);
+                changed = changed || (skipped != 0);
+            }
+            if (node->next[0] == node->next[1])
+            {
+                node->next[1] = SEQNET_ASM_PC_NONE;  // Both ways lead to the same word
+            }
+        }
+    }
+    SeqNetAsm_reach(nodes, entries, entry_count, reached);
+
+    // Followers: every branch needs one of its successors right after it, the hottest
+    // branches choose first. Followers never form a cycle and never precede PC 0.
+    uint8_t follower[SEQNET_PROGMEM_SIZE];
+    uint8_t leader[SEQNET_PROGMEM_SIZE];
+    uint8_t order[SEQNET_PROGMEM_SIZE];
+    uint16_t count = 0;
+    memset(follower, SEQNET_ASM_PC_NONE, sizeof(follower));
+    memset(leader, SEQNET_ASM_PC_NONE, sizeof(leader));
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        if (!reached[pc]) continue;
+
+        // Insertion sort: branches first, then by descending hits, stable
+        uint16_t at = count++;
+        while ((at > 0) && (SeqNetAsm_rank(nodes, profile, (uint8_t)pc) < SeqNetAsm_rank(nodes, profile, order[at - 1U])))
+        {
+            order[at] = order[at - 1U];
+            --at;
+        }
+        order[at] = (uint8_t)pc;
+    }
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        const uint8_t pc = order[i];
+        const SeqNetAsmNode_t* node = &nodes[pc];
+        const uint8_t hot = (node->next[1] == SEQNET_ASM_PC_NONE) ? 0U : SeqNetAsm_hot(profile, pc);
+        if (!SeqNetAsm_link(follower, leader, pc, node->next[hot]) && (node->next[1] != SEQNET_ASM_PC_NONE))
+        {
+            SeqNetAsm_link(follower, leader, pc, node->next[!hot]);
+        }
+    }
+
+    // Layout: the chain of PC 0, the chains of the entries, then the rest in source order
+    memset(pos, SEQNET_ASM_PC_NONE, SEQNET_PROGMEM_SIZE);
+    uint16_t placed = 0;
+    for (uint16_t i = 0; i <= entry_count + SEQNET_PROGMEM_SIZE; ++i)
+    {
+        uint8_t pc;
+        if (i == 0)                     pc = 0;
+        else if (i <= entry_count)      pc = entries[i - 1U];
+        else                            pc = (uint8_t)(i - entry_count - 1U);
+        if ((pc >= SEQNET_PROGMEM_SIZE) || !reached[pc] || (pos[pc] != SEQNET_ASM_PC_NONE)) continue;
+
+        while (leader[pc] != SEQNET_ASM_PC_NONE) pc = leader[pc];
+        for (; pc != SEQNET_ASM_PC_NONE; pc = follower[pc])
+        {
+            const bool jumps = (nodes[pc].next[1] != SEQNET_ASM_PC_NONE) && (follower[pc] == SEQNET_ASM_PC_NONE);
+            if (placed + jumps >= SEQNET_PROGMEM_SIZE) return SEQNET_ASM_TOO_LONG;
+
+            pos[pc] = (uint8_t)placed;
+            slot[placed] = pc;
+            trampoline[placed++] = false;
+            if (jumps)
+            {
+                // Both successors follow other words: jump to the hot one, fall into a jump to the cold one
+                slot[placed] = pc;
+                trampoline[placed++] = true;
+                report->trampolines++;
+            }
+        }
+    }
+
+    // Encoding
+    const uint16_t always = (uint16_t)(((1U << 3) | CONDSEL_ENUM_CONST_FALSE) << BIT_COND_SEL);
+    const uint16_t never = (uint16_t)(CONDSEL_ENUM_CONST_FALSE << BIT_COND_SEL);
+    memset(target, 0, sizeof(*target));
+    target->count = placed;
+    for (uint16_t p = 0; p < placed; ++p)
+    {
+        const uint8_t pc = slot[p];
+        const SeqNetAsmNode_t* node = &nodes[pc];
+        const uint8_t hot = SeqNetAsm_hot(profile, pc);
+        uint16_t word = node->outputs;
+
+        if (trampoline[p])
+        {
+            word |= (uint16_t)(always | pos[node->next[!hot]]);
+        }
+        else if (node->next[1] == SEQNET_ASM_PC_NONE)
+        {
+            word |= (follower[pc] == node->next[0]) ? never : (uint16_t)(always | pos[node->next[0]]);
+        }
+        else if (follower[pc] == node->next[0])
+        {
+            // The taken successor falls through: jump to the other one on the inverted condition
+            word |= (uint16_t)(((node->cond ^ (1U << 3)) << BIT_COND_SEL) | pos[node->next[1]]);
+            report->inverted++;
+        }
+        else if (follower[pc] == node->next[1])
+        {
+            word |= (uint16_t)((node->cond << BIT_COND_SEL) | pos[node->next[0]]);
+        }
+        else
+        {
+            const uint8_t cond = (hot == 0U) ? node->cond : (uint8_t)(node->cond ^ (1U << 3));
+            word |= (uint16_t)((cond << BIT_COND_SEL) | pos[node->next[hot]]);
+            report->inverted += (hot != 0U);
+        }
+        target->words[p] = word;
+
+        if (!trampoline[p])
+        {
+            memcpy(target->symbols[p], source->symbols[pc], SEQNET_ASM_NAME_SIZE);
+            memcpy(target->comments[p], source->comments[pc], SEQNET_ASM_COMMENT_SIZE);
+        }
+    }
+
+    report->words_after = placed;
+    for (uint16_t pc = 0; pc < source->count; ++pc)
+    {
+        report->removed += (pos[pc] == SEQNET_ASM_PC_NONE);
+    }
+    return SEQNET_ASM_OK;
+}
+
+/**
+ * @brief Runs every case until its end state is first reached and sums the micro-steps.
+ */
+uint32_t SeqNetAsm_measure(const SeqNet_Program* program, const LiftTestCase_t* const* cases, const uint8_t* entries,
+                           uint16_t count, SeqNet_Profile* profile, uint32_t* steps)
+{
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT((cases != NULL) || (count == 0));
+
+    uint32_t total = 0;
+    for (uint16_t i = 0; i < count; ++i)
+    {
+        const LiftTestCase_t* test = cases[i];
+        LiftInputs_t plant;
+        SeqNet_Ctx ctx;
+        SeqNet_ctxInit(&ctx, program);
+        ctx.pc = (entries != NULL) ? entries[i] : test->PC_preset;
+        LiftInputs_init(&plant, &test->initial_state);
+
+        uint32_t step = 0;
+        for (; (step <= LIFT_TEST_MAX_STEPS) && !LiftState_equal(&plant.state, &test->end_state); ++step)
+        {
+            const SeqNet_Out* out = &program->decoded[ctx.pc];
+            if (profile != NULL)
+            {
+                profile->hits[ctx.pc]++;
+                profile->taken[ctx.pc] += CondSel_calcMask(out->cond_inv, out->cond_sel, CondSel_pack(&plant.in));
+                profile->selector[out->cond_sel & MASK_COND_SEL]++;
+            }
+            SeqNet_ctxStep(&ctx, &plant.in);
+            LiftInputs_apply(&plant, out);
+        }
+
+        if (steps != NULL)
+        {
+            steps[i] = step;
+        }
+        total += step;
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the printable name of a status.
+ */
+const char* SeqNetAsmStatus_name(SeqNetAsmStatus_t status)
+{
+    switch (status)
+    {
+        case SEQNET_ASM_OK:              return "ok";
+        case SEQNET_ASM_SYNTAX:          return "syntax error";
+        case SEQNET_ASM_UNKNOWN_LABEL:   return "unknown label";
+        case SEQNET_ASM_DUPLICATE_LABEL: return "duplicate label";
+        case SEQNET_ASM_BAD_TARGET:      return "jump outside the program memory";
+        case SEQNET_ASM_TOO_LONG:        return "too long";
+        default:                         return "unknown";
+    }
+}
@@ -0,0 +1,280 @@
+/**
+ * @file seqnet_batch.c
+ * @brief Implements the structure-of-arrays batch stepping engine with SIMD kernels.
+ */
+
+#include "seqnet_batch.h"
+#include "seqnet_internal.h"  // for BIT_*, MASK_*
+#include "lift_assert.h"
+#include <string.h>  // For memcpy
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define SEQNET_BATCH_X86 1
+    #include <immintrin.h>
+#else
+    #define SEQNET_BATCH_X86 0
+#endif
+
+/// Bit position of the one-hot condition selector inside a table entry
+#define BATCH_BIT_SEL_ONEHOT 16
+
+/// Mask of the instruction word inside a table entry
+#define BATCH_MASK_WORD 0xFFFFU
+
+// === Kernels ===
+
+/**
+ * @brief Portable kernel: steps the cars in [first, count).
+ *
+ * @param[in,out] batch  Batch to step.
+ * @param[in]     first  Index of the first car to step.
+ */
+static void SeqNetBatch_stepScalar(SeqNetBatch_t* batch, uint32_t first)
+{
+    const uint32_t* table = batch->table;
+
+    for (uint32_t i = first; i < batch->count; ++i)
+    {
+        const uint32_t pc = batch->pc[i];
+        const uint32_t entry = table[pc];  // Every 8-bit PC has a row, 255 is the trap
+
+        // Selectable values: bit 0 any pending, bits 1..5 the signals
+        const uint32_t mask = batch->in[i] & CONDSEL_MASK_ALL;
+        const uint32_t selectable = (mask << 1) | (uint32_t)((mask & CONDSEL_MASK_PENDING) != 0);
+
+        const uint32_t hit = ((selectable << BATCH_BIT_SEL_ONEHOT) & entry) != 0;
+        const uint32_t cond = hit ^ ((entry >> BIT_COND_INV) & 0x1U);
+
+        const uint32_t seq = (pc + 1) % SEQNET_PROGMEM_SIZE;
+        const uint32_t jmp = (entry >> BIT_JUMP_ADDR) & MASK_JUMP_ADDR;
+
+        batch->out[i] = (uint16_t)(entry & BATCH_MASK_WORD);
+        batch->pc[i] = (uint8_t)(cond ? jmp : seq);
+    }
+}
+
+#if SEQNET_BATCH_X86
+
+/**
+ * @brief SSE4.1 kernel: 4 cars per iteration, scalar gathers and a blend for the PC update.
+ *
+ * @param[in,out] batch  Batch to step.
+ * @return Index of the first car left for the scalar tail.
+ */
+__attribute__((target("sse4.1")))
+static uint32_t SeqNetBatch_stepSse41(SeqNetBatch_t* batch)
+{
+    const uint32_t* table = batch->table;
+    const __m128i one      = _mm_set1_epi32(1);
+    const __m128i pending  = _mm_set1_epi32(CONDSEL_MASK_PENDING);
+    const __m128i all      = _mm_set1_epi32(CONDSEL_MASK_ALL);
+    const __m128i wrap     = _mm_set1_epi32(SEQNET_PROGMEM_SIZE);
+    const __m128i jmp_mask = _mm_set1_epi32(MASK_JUMP_ADDR);
+    const __m128i word     = _mm_set1_epi32(BATCH_MASK_WORD);
+
+    uint32_t i = 0;
+    for (; i + 4 <= batch->count; i += 4)
+    {
+        uint8_t* pc_ptr = &batch->pc[i];
+        int32_t raw;
+
+        memcpy(&raw, pc_ptr, sizeof(raw));
+        const __m128i pc = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(raw));
+        memcpy(&raw, &batch->in[i], sizeof(raw));
+        const __m128i mask = _mm_and_si128(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(raw)), all);
+
+        // Gather the table entries
+        const __m128i entry = _mm_set_epi32((int32_t)table[pc_ptr[3]], (int32_t)table[pc_ptr[2]],
+                                            (int32_t)table[pc_ptr[1]], (int32_t)table[pc_ptr[0]]);
+
+        // Selectable values shifted onto the one-hot selector field
+        const __m128i none = _mm_cmpeq_epi32(_mm_and_si128(mask, pending), _mm_setzero_si128());
+        const __m128i selectable = _mm_or_si128(_mm_slli_epi32(mask, 1 + BATCH_BIT_SEL_ONEHOT),
+                                                _mm_slli_epi32(_mm_andnot_si128(none, one), BATCH_BIT_SEL_ONEHOT));
+
+        // not_cond = !(hit ^ inv) = miss ^ inv
+        const __m128i miss = _mm_cmpeq_epi32(_mm_and_si128(selectable, entry), _mm_setzero_si128());
+        const __m128i inv = _mm_srai_epi32(_mm_slli_epi32(entry, 31 - BIT_COND_INV), 31);
+        const __m128i not_cond = _mm_xor_si128(miss, inv);
+
+        // Next PC: jump address or PC + 1 (wrapped)
+        __m128i seq = _mm_add_epi32(pc, one);
+        seq = _mm_andnot_si128(_mm_cmpeq_epi32(seq, wrap), seq);
+        const __m128i jmp = _mm_and_si128(entry, jmp_mask);
+        const __m128i next = _mm_blendv_epi8(jmp, seq, not_cond);
+
+        // Narrow and store outputs (16-bit) and PCs (8-bit)
+        const __m128i out16 = _mm_packus_epi32(_mm_and_si128(entry, word), _mm_setzero_si128());
+        _mm_storel_epi64((__m128i*)&batch->out[i], out16);
+        const __m128i pc8 = _mm_packus_epi16(_mm_packus_epi32(next, _mm_setzero_si128()), _mm_setzero_si128());
+        raw = _mm_cvtsi128_si32(pc8);
+        memcpy(pc_ptr, &raw, sizeof(raw));
+    }
+
+    return i;
+}
+
+/**
+ * @brief AVX2 kernel: 8 cars per iteration, hardware gather and a blend for the PC update.
+ *
+ * @param[in,out] batch  Batch to step.
+ * @return Index of the first car left for the scalar tail.
+ */
+__attribute__((target("avx2")))
+static uint32_t SeqNetBatch_stepAvx2(SeqNetBatch_t* batch)
+{
+    const int* table = (const int*)batch->table;
+    const __m256i one      = _mm256_set1_epi32(1);
+    const __m256i pending  = _mm256_set1_epi32(CONDSEL_MASK_PENDING);
+    const __m256i all      = _mm256_set1_epi32(CONDSEL_MASK_ALL);
+    const __m256i wrap     = _mm256_set1_epi32(SEQNET_PROGMEM_SIZE);
+    const __m256i jmp_mask = _mm256_set1_epi32(MASK_JUMP_ADDR);
+    const __m256i word     = _mm256_set1_epi32(BATCH_MASK_WORD);
+
+    uint32_t i = 0;
+    for (; i + 8 <= batch->count; i += 8)
+    {
+        const __m256i pc = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&batch->pc[i]));
+        const __m256i mask = _mm256_and_si256(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)&batch->in[i])), all);
+
+        // Gather the table entries
+        const __m256i entry = _mm256_i32gather_epi32(table, pc, 4);
+
+        // Selectable values shifted onto the one-hot selector field
+        const __m256i none = _mm256_cmpeq_epi32(_mm256_and_si256(mask, pending), _mm256_setzero_si256());
+        const __m256i selectable = _mm256_or_si256(_mm256_slli_epi32(mask, 1 + BATCH_BIT_SEL_ONEHOT),
+                                                   _mm256_slli_epi32(_mm256_andnot_si256(none, one), BATCH_BIT_SEL_ONEHOT));
+
+        // not_cond = !(hit ^ inv) = miss ^ inv
+        const __m256i miss = _mm256_cmpeq_epi32(_mm256_and_si256(selectable, entry), _mm256_setzero_si256());
+        const __m256i inv = _mm256_srai_epi32(_mm256_slli_epi32(entry, 31 - BIT_COND_INV), 31);
+        const __m256i not_cond = _mm256_xor_si256(miss, inv);
+
+        // Next PC: jump address or PC + 1 (wrapped)
+        __m256i seq = _mm256_add_epi32(pc, one);
+        seq = _mm256_andnot_si256(_mm256_cmpeq_epi32(seq, wrap), seq);
+        const __m256i jmp = _mm256_and_si256(entry, jmp_mask);
+        const __m256i next = _mm256_blendv_epi8(jmp, seq, not_cond);
+
+        // Narrow to 16-bit: packus works per 128-bit lane, so restore the order with a permute
+        const __m256i out16 = _mm256_permute4x64_epi64(_mm256_packus_epi32(_mm256_and_si256(entry, word), next), 0xD8);
+        _mm_storeu_si128((__m128i*)&batch->out[i], _mm256_castsi256_si128(out16));
+        const __m128i pc8 = _mm_packus_epi16(_mm256_extracti128_si256(out16, 1), _mm_setzero_si128());
+        _mm_storel_epi64((__m128i*)&batch->pc[i], pc8);
+    }
+
+    return i;
+}
+
+#endif // SEQNET_BATCH_X86
+
+// === API functions ===
+
+/**
+ * @brief Initializes a batch over caller-owned arrays and selects the best kernel.
+ *
+ * Each table entry holds the instruction word in bits 0..15 and the one-hot
+ * condition selector (1 << cond_sel) in bits 16..23, so the kernels test the
+ * selected condition with a single AND instead of a variable shift. The last
+ * row is the trap word, so no kernel needs a bounds check on the PC.
+ */
+void SeqNetBatch_init(SeqNetBatch_t* batch, const SeqNet_Program* program,
+                      uint8_t* pc, const CondSel_Mask* in, uint16_t* out, uint32_t count)
+{
+    LIFT_ASSERT(batch != NULL);
+    LIFT_ASSERT(program != NULL);
+    LIFT_ASSERT((count == 0) || ((pc != NULL) && (in != NULL) && (out != NULL)));
+
+    for (uint16_t i = 0; i < SEQNET_PROGMEM_SIZE; ++i)
+    {
+        const SeqNet_Out* instr = &program->decoded[i];
+        batch->table[i] = (uint32_t)SeqNetOut_convert(instr) |
+                          ((uint32_t)1 << (BATCH_BIT_SEL_ONEHOT + (instr->cond_sel & MASK_COND_SEL)));
+    }
+
+    // A jump to 255 lands on the trap row instead of reading past the table
+    const uint32_t trap_sel = (SEQNET_TRAP_WORD >> BIT_COND_SEL) & MASK_COND_SEL;
+    batch->table[SEQNET_PROGMEM_SIZE] = SEQNET_TRAP_WORD | ((uint32_t)1 << (BATCH_BIT_SEL_ONEHOT + trap_sel));
+
+    batch->pc = pc;
+    batch->in = in;
+    batch->out = out;
+    batch->count = count;
+
+    SeqNetBatch_select(batch, SEQNET_BATCH_KERNEL_AUTO);
+}
+
+/**
+ * @brief Selects the step kernel of a batch, falling back to the best supported one.
+ */
+SeqNetBatchKernel_t SeqNetBatch_select(SeqNetBatch_t* batch, SeqNetBatchKernel_t requested)
+{
+    LIFT_ASSERT(batch != NULL);
+
+    SeqNetBatchKernel_t kernel = SEQNET_BATCH_KERNEL_SCALAR;
+
+#if SEQNET_BATCH_X86
+    __builtin_cpu_init();
+    const bool has_avx2 = __builtin_cpu_supports("avx2");
+    const bool has_sse41 = __builtin_cpu_supports("sse4.1");
+
+    if (((requested == SEQNET_BATCH_KERNEL_AUTO) || (requested == SEQNET_BATCH_KERNEL_AVX2)) && has_avx2)
+    {
+        kernel = SEQNET_BATCH_KERNEL_AVX2;
+    }
+    else if ((requested != SEQNET_BATCH_KERNEL_SCALAR) && has_sse41)
+    {
+        kernel = SEQNET_BATCH_KERNEL_SSE41;
+    }
+#else
+    (void)requested;
+#endif
+
+    batch->kernel = kernel;
+    return kernel;
+}
+
+/**
+ * @brief Advances every car of the batch by one instruction.
+ *
+ * The vector kernels handle full groups of 4 or 8 cars, the rest is stepped by the scalar loop.
+ */
+void SeqNetBatch_step(SeqNetBatch_t* batch)
+{
+    LIFT_ASSERT(batch != NULL);
+
+    uint32_t first = 0;
+
+#if SEQNET_BATCH_X86
+    switch (batch->kernel)
+    {
+        case SEQNET_BATCH_KERNEL_AVX2:
+            first = SeqNetBatch_stepAvx2(batch);
+            break;
+
+        case SEQNET_BATCH_KERNEL_SSE41:
+            first = SeqNetBatch_stepSse41(batch);
+            break;
+
+        default:
+            break;
+    }
+#endif
+
+    SeqNetBatch_stepScalar(batch, first);
+}
+
+/**
+ * @brief Returns the printable name of a kernel.
+ */
+const char* SeqNetBatchKernel_name(SeqNetBatchKernel_t kernel)
+{
+    switch (kernel)
+    {
+        case SEQNET_BATCH_KERNEL_AUTO:   return "auto";
+        case SEQNET_BATCH_KERNEL_SCALAR: return "scalar";
+        case SEQNET_BATCH_KERNEL_SSE41:  return "sse4.1";
+        case SEQNET_BATCH_KERNEL_AVX2:   return "avx2";
+        default:                         return "unknown";
+    }
+}
@@ -0,0 +1,471 @@
+/**
+ * @file seqnet_image.c
+ * @brief Implements the binary program image format, its writer and the mapped loader.
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L  // mmap(), fstat()
+#endif
+
+#include <string.h>
+#include "seqnet_image.h"
+#include "seqnet_internal.h"  // for BIT_JUMP_ADDR, MASK_JUMP_ADDR, SeqNetProgramMemory_*
+#include "lift_assert.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// Longest text of a section record
+#define SEQNET_IMAGE_TEXT_MAX           (255U)
+
+/// Size of a section header in bytes
+#define SEQNET_IMAGE_SECTION_HEADER_SIZE (8U)
+
+// === Helpers ===
+
+/// CRC-32 (IEEE 802.3, reflected) of one nibble
+static const uint32_t SeqNetImage_crcTable[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL, 0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL, 0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+/**
+ * @brief Continues a CRC-32 over a buffer (start with 0).
+ */
+static uint32_t SeqNetImage_crc(uint32_t crc, const uint8_t* data, size_t size)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ SeqNetImage_crcTable[crc & 0x0FU];
+        crc = (crc >> 4) ^ SeqNetImage_crcTable[crc & 0x0FU];
+    }
+    return ~crc;
+}
+
+static inline uint16_t SeqNetImage_get16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t SeqNetImage_get32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void SeqNetImage_put16(uint8_t* p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static inline void SeqNetImage_put32(uint8_t* p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/// Rounds a size up to the block alignment
+static inline uint32_t SeqNetImage_align(uint32_t size)
+{
+    return (size + 3U) & ~3U;
+}
+
+// === Writer ===
+
+/**
+ * @brief Writes bytes of the current image and continues its checksum.
+ */
+static void SeqNetImageWriter_put(SeqNetImageWriter_t* writer, const void* data, uint32_t size, uint32_t* crc)
+{
+    if ((size != 0) && (fwrite(data, 1, size, writer->out) != size))
+    {
+        writer->error = true;
+    }
+    *crc = SeqNetImage_crc(*crc, (const uint8_t*)data, size);
+}
+
+/**
+ * @brief Payload size of a section, 0 if no PC has a text.
+ */
+static uint32_t SeqNetImageWriter_sectionSize(const char* const* texts, uint16_t count)
+{
+    uint32_t size = 0;
+    for (uint16_t pc = 0; (texts != NULL) && (pc < count); ++pc)
+    {
+        if (texts[pc] != NULL)
+        {
+            size += 3U + (uint32_t)strlen(texts[pc]);  // PC, length, text, NUL
+        }
+    }
+    return size;
+}
+
+/**
+ * @brief Writes a section with its header and padding.
+ */
+static void SeqNetImageWriter_section(SeqNetImageWriter_t* writer, SeqNetImageSection_t kind,
+                                      const char* const* texts, uint16_t count, uint32_t size, uint32_t* crc)
+{
+    static const uint8_t padding[4] = { 0 };
+    uint8_t header[SEQNET_IMAGE_SECTION_HEADER_SIZE] = { 0 };
+
+    SeqNetImage_put16(&header[0], (uint16_t)kind);
+    SeqNetImage_put32(&header[4], size);
+    SeqNetImageWriter_put(writer, header, sizeof(header), crc);
+
+    for (uint16_t pc = 0; pc < count; ++pc)
+    {
+        if (texts[pc] == NULL) continue;
+
+        const uint8_t record[2] = { (uint8_t)pc, (uint8_t)strlen(texts[pc]) };
+        SeqNetImageWriter_put(writer, record, sizeof(record), crc);
+        SeqNetImageWriter_put(writer, texts[pc], record[1] + 1U, crc);
+    }
+    SeqNetImageWriter_put(writer, padding, SeqNetImage_align(size) - size, crc);
+}
+
+SeqNetImageStatus_t SeqNetImageWriter_begin(SeqNetImageWriter_t* writer, FILE* out, uint8_t* directory, uint32_t capacity)
+{
+    LIFT_ASSERT(writer != NULL);
+    LIFT_ASSERT(out != NULL);
+    LIFT_ASSERT((capacity == 0) || (directory != NULL));
+
+    writer->out = out;
+    writer->directory = directory;
+    writer->capacity = capacity;
+    writer->count = 0;
+    writer->offset = SEQNET_IMAGE_HEADER_SIZE + capacity * SEQNET_IMAGE_ENTRY_SIZE;
+    writer->error = false;
+
+    // Placeholder of the header and the directory, written by SeqNetImageWriter_end()
+    memset(directory, 0, (size_t)capacity * SEQNET_IMAGE_ENTRY_SIZE);
+    static const uint8_t zero[SEQNET_IMAGE_ENTRY_SIZE] = { 0 };
+    writer->error = (fwrite(zero, 1, SEQNET_IMAGE_HEADER_SIZE, out) != SEQNET_IMAGE_HEADER_SIZE);
+    for (uint32_t i = 0; (i < capacity) && !writer->error; ++i)
+    {
+        writer->error = (fwrite(zero, 1, SEQNET_IMAGE_ENTRY_SIZE, out) != SEQNET_IMAGE_ENTRY_SIZE);
+    }
+    return writer->error ? SEQNET_IMAGE_IO_ERROR : SEQNET_IMAGE_OK;
+}
+
+SeqNetImageStatus_t SeqNetImageWriter_add(SeqNetImageWriter_t* writer, const uint16_t* words, uint16_t count,
+                                          const char* const* symbols, const char* const* comments)
+{
+    LIFT_ASSERT(writer != NULL);
+    LIFT_ASSERT((count == 0) || (words != NULL));
+
+    if (writer->count >= writer->capacity) return SEQNET_IMAGE_FULL;
+    if (count > SEQNET_PROGMEM_SIZE) return SEQNET_IMAGE_BAD_PROGRAM;
+
+    // The id is the one the loader computes for the same words
+    SeqNet_Program program;
+    memset(program.words, 0, sizeof(program.words));
+    for (uint16_t pc = 0; pc < count; ++pc)
+    {
+        if (((words[pc] >> BIT_JUMP_ADDR) & MASK_JUMP_ADDR) >= SEQNET_PROGMEM_SIZE) return SEQNET_IMAGE_BAD_PROGRAM;
+        if (((symbols != NULL) && (symbols[pc] != NULL) && (strlen(symbols[pc]) > SEQNET_IMAGE_TEXT_MAX)) ||
+            ((comments != NULL) && (comments[pc] != NULL) && (strlen(comments[pc]) > SEQNET_IMAGE_TEXT_MAX)))
+        {
+            return SEQNET_IMAGE_BAD_PROGRAM;
+        }
+        program.words[pc] = words[pc];
+    }
+    SeqNetProgram_decode(&program);
+
+    const uint32_t symbols_size = SeqNetImageWriter_sectionSize(symbols, count);
+    const uint32_t comments_size = SeqNetImageWriter_sectionSize(comments, count);
+    const uint32_t words_size = SeqNetImage_align(2U * count);
+    uint32_t size = SEQNET_IMAGE_BLOCK_HEADER_SIZE + words_size;
+    size += (symbols_size != 0) ? SEQNET_IMAGE_SECTION_HEADER_SIZE + SeqNetImage_align(symbols_size) : 0U;
+    size += (comments_size != 0) ? SEQNET_IMAGE_SECTION_HEADER_SIZE + SeqNetImage_align(comments_size) : 0U;
+
+    // Image header
+    uint32_t crc = 0;
+    uint8_t header[SEQNET_IMAGE_BLOCK_HEADER_SIZE] = { 0 };
+    SeqNetImage_put16(&header[0], count);
+    SeqNetImage_put16(&header[2], (uint16_t)((symbols_size != 0) + (comments_size != 0)));
+    SeqNetImageWriter_put(writer, header, sizeof(header), &crc);
+
+    // Words, padded
+    uint8_t word[2];
+    for (uint16_t pc = 0; pc < count; ++pc)
+    {
+        SeqNetImage_put16(word, words[pc]);
+        SeqNetImageWriter_put(writer, word, sizeof(word), &crc);
+    }
+    if ((count & 1U) != 0)
+    {
+        word[0] = word[1] = 0;
+        SeqNetImageWriter_put(writer, word, sizeof(word), &crc);
+    }
+
+    if (symbols_size != 0) SeqNetImageWriter_section(writer, SEQNET_IMAGE_SECTION_SYMBOLS, symbols, count, symbols_size, &crc);
+    if (comments_size != 0) SeqNetImageWriter_section(writer, SEQNET_IMAGE_SECTION_COMMENTS, comments, count, comments_size, &crc);
+
+    uint8_t* entry = &writer->directory[writer->count * SEQNET_IMAGE_ENTRY_SIZE];
+    SeqNetImage_put32(&entry[0], writer->offset);
+    SeqNetImage_put32(&entry[4], size);
+    SeqNetImage_put32(&entry[8], program.id);
+    SeqNetImage_put32(&entry[12], crc);
+    writer->count++;
+    writer->offset += size;
+
+    return writer->error ? SEQNET_IMAGE_IO_ERROR : SEQNET_IMAGE_OK;
+}
+
+SeqNetImageStatus_t SeqNetImageWriter_end(SeqNetImageWriter_t* writer)
+{
+    LIFT_ASSERT(writer != NULL);
+
+    const uint32_t directory_size = writer->count * SEQNET_IMAGE_ENTRY_SIZE;
+    uint8_t header[SEQNET_IMAGE_HEADER_SIZE];
+    SeqNetImage_put32(&header[0], SEQNET_IMAGE_MAGIC);
+    SeqNetImage_put16(&header[4], SEQNET_IMAGE_VERSION);
+    SeqNetImage_put16(&header[6], SEQNET_IMAGE_ENTRY_SIZE);
+    SeqNetImage_put32(&header[8], writer->count);
+    SeqNetImage_put32(&header[12], SeqNetImage_crc(0, writer->directory, directory_size));
+
+    // Unused directory entries stay zero, the images are addressed by their offsets
+    if ((fseek(writer->out, 0, SEEK_SET) != 0) ||
+        (fwrite(header, 1, sizeof(header), writer->out) != sizeof(header)) ||
+        (fwrite(writer->directory, 1, directory_size, writer->out) != directory_size) ||
+        (fseek(writer->out, 0, SEEK_END) != 0) ||
+        (fflush(writer->out) != 0))
+    {
+        writer->error = true;
+    }
+    return writer->error ? SEQNET_IMAGE_IO_ERROR : SEQNET_IMAGE_OK;
+}
+
+// === Loader ===
+
+SeqNetImageStatus_t SeqNetImageFile_openMemory(SeqNetImageFile_t* file, const void* data, size_t size)
+{
+    LIFT_ASSERT(file != NULL);
+    LIFT_ASSERT((size == 0) || (data != NULL));
+
+    const uint8_t* bytes = (const uint8_t*)data;
+    file->data = bytes;
+    file->size = size;
+    file->count = 0;
+    file->mapping = NULL;
+
+    if (size < SEQNET_IMAGE_HEADER_SIZE) return SEQNET_IMAGE_TRUNCATED;
+    if (SeqNetImage_get32(&bytes[0]) != SEQNET_IMAGE_MAGIC) return SEQNET_IMAGE_BAD_MAGIC;
+    if ((SeqNetImage_get16(&bytes[4]) != SEQNET_IMAGE_VERSION) ||
+        (SeqNetImage_get16(&bytes[6]) != SEQNET_IMAGE_ENTRY_SIZE))
+    {
+        return SEQNET_IMAGE_BAD_VERSION;
+    }
+
+    const uint32_t count = SeqNetImage_get32(&bytes[8]);
+    const uint64_t directory_size = (uint64_t)count * SEQNET_IMAGE_ENTRY_SIZE;
+    if (SEQNET_IMAGE_HEADER_SIZE + directory_size > size) return SEQNET_IMAGE_TRUNCATED;
+    if (SeqNetImage_crc(0, &bytes[SEQNET_IMAGE_HEADER_SIZE], (size_t)directory_size) != SeqNetImage_get32(&bytes[12]))
+    {
+        return SEQNET_IMAGE_BAD_CHECKSUM;
+    }
+
+    file->count = count;
+    return SEQNET_IMAGE_OK;
+}
+
+SeqNetImageStatus_t SeqNetImageFile_open(SeqNetImageFile_t* file, const char* path)
+{
+    LIFT_ASSERT(file != NULL);
+    LIFT_ASSERT(path != NULL);
+
+    void* view = NULL;
+    size_t size = 0;
+
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) return SEQNET_IMAGE_IO_ERROR;
+
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(handle, &length) || (length.QuadPart == 0) || ((uint64_t)length.QuadPart > (uint64_t)SIZE_MAX))
+    {
+        CloseHandle(handle);
+        return (length.QuadPart == 0) ? SEQNET_IMAGE_TRUNCATED : SEQNET_IMAGE_IO_ERROR;
+    }
+    size = (size_t)length.QuadPart;
+
+    // The view keeps the mapping alive, both handles can be closed
+    HANDLE map = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (map != NULL)
+    {
+        view = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(map);
+    }
+    CloseHandle(handle);
+    if (view == NULL) return SEQNET_IMAGE_IO_ERROR;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return SEQNET_IMAGE_IO_ERROR;
+
+    struct stat info;
+    if ((fstat(fd, &info) != 0) || (info.st_size <= 0))
+    {
+        close(fd);
+        return (info.st_size == 0) ? SEQNET_IMAGE_TRUNCATED : SEQNET_IMAGE_IO_ERROR;
+    }
+    size = (size_t)info.st_size;
+
+    // The mapping stays valid after the descriptor is closed
+    view = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) return SEQNET_IMAGE_IO_ERROR;
+#endif
+
+    const SeqNetImageStatus_t status = SeqNetImageFile_openMemory(file, view, size);
+    file->mapping = view;
+    if (status != SEQNET_IMAGE_OK)
+    {
+        SeqNetImageFile_close(file);
+    }
+    return status;
+}
+
+void SeqNetImageFile_close(SeqNetImageFile_t* file)
+{
+    LIFT_ASSERT(file != NULL);
+
+    if (file->mapping != NULL)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(file->mapping);
+#else
+        munmap(file->mapping, file->size);
+#endif
+    }
+    file->data = NULL;
+    file->size = 0;
+    file->count = 0;
+    file->mapping = NULL;
+}
+
+SeqNetImageStatus_t SeqNetImage_get(const SeqNetImageFile_t* file, uint32_t index, SeqNetImage_t* image)
+{
+    LIFT_ASSERT(file != NULL);
+    LIFT_ASSERT(image != NULL);
+
+    if (index >= file->count) return SEQNET_IMAGE_NO_IMAGE;
+
+    // Directory entry, already covered by the directory checksum
+    const uint8_t* entry = &file->data[SEQNET_IMAGE_HEADER_SIZE + (size_t)index * SEQNET_IMAGE_ENTRY_SIZE];
+    const uint32_t offset = SeqNetImage_get32(&entry[0]);
+    const uint32_t size = SeqNetImage_get32(&entry[4]);
+    if (((offset & 3U) != 0) || (size < SEQNET_IMAGE_BLOCK_HEADER_SIZE) || ((uint64_t)offset + size > file->size))
+    {
+        return SEQNET_IMAGE_TRUNCATED;
+    }
+
+    const uint8_t* block = &file->data[offset];
+    if (SeqNetImage_crc(0, block, size) != SeqNetImage_get32(&entry[12])) return SEQNET_IMAGE_BAD_CHECKSUM;
+
+    memset(image, 0, sizeof(*image));
+    image->id = SeqNetImage_get32(&entry[8]);
+    image->word_count = SeqNetImage_get16(&block[0]);
+    image->words = &block[SEQNET_IMAGE_BLOCK_HEADER_SIZE];
+    if (image->word_count > SEQNET_PROGMEM_SIZE) return SEQNET_IMAGE_BAD_PROGRAM;
+
+    // Sections: unknown kinds are skipped, so later versions can add them
+    uint32_t at = SEQNET_IMAGE_BLOCK_HEADER_SIZE + SeqNetImage_align(2U * image->word_count);
+    const uint16_t sections = SeqNetImage_get16(&block[2]);
+    for (uint16_t s = 0; s < sections; ++s)
+    {
+        if ((uint64_t)at + SEQNET_IMAGE_SECTION_HEADER_SIZE > size) return SEQNET_IMAGE_TRUNCATED;
+
+        const uint16_t kind = SeqNetImage_get16(&block[at]);
+        const uint32_t length = SeqNetImage_get32(&block[at + 4U]);
+        at += SEQNET_IMAGE_SECTION_HEADER_SIZE;
+        if ((uint64_t)at + length > size) return SEQNET_IMAGE_TRUNCATED;
+
+        if (kind == SEQNET_IMAGE_SECTION_SYMBOLS)
+        {
+            image->symbols = &block[at];
+            image->symbols_size = length;
+        }
+        else if (kind == SEQNET_IMAGE_SECTION_COMMENTS)
+        {
+            image->comments = &block[at];
+            image->comments_size = length;
+        }
+        at += SeqNetImage_align(length);
+    }
+    return (at <= size) ? SEQNET_IMAGE_OK : SEQNET_IMAGE_TRUNCATED;
+}
+
+SeqNetImageStatus_t SeqNetImage_load(const SeqNetImageFile_t* file, uint32_t index, SeqNet_Program* program)
+{
+    LIFT_ASSERT(program != NULL);
+
+    SeqNetImage_t image;
+    const SeqNetImageStatus_t status = SeqNetImage_get(file, index, &image);
+    if (status != SEQNET_IMAGE_OK) return status;
+
+    memset(program->words, 0, sizeof(program->words));
+    for (uint16_t pc = 0; pc < image.word_count; ++pc)
+    {
+        const uint16_t word = SeqNetImage_get16(&image.words[2U * pc]);
+        if (((word >> BIT_JUMP_ADDR) & MASK_JUMP_ADDR) >= SEQNET_PROGMEM_SIZE) return SEQNET_IMAGE_BAD_PROGRAM;
+        program->words[pc] = word;
+    }
+    SeqNetProgram_decode(program);
+
+    return (program->id == image.id) ? SEQNET_IMAGE_OK : SEQNET_IMAGE_BAD_CHECKSUM;
+}
+
+SeqNetImageStatus_t SeqNetImage_install(const SeqNetImageFile_t* file, uint32_t index)
+{
+    SeqNet_Program program;
+    const SeqNetImageStatus_t status = SeqNetImage_load(file, index, &program);
+    if (status != SEQNET_IMAGE_OK) return status;
+
+    memcpy(SeqNetProgramMemory_get(), program.words, sizeof(program.words));
+    SeqNetProgramMemory_decode();
+    return SEQNET_IMAGE_OK;
+}
+
+const char* SeqNetImage_text(const uint8_t* section, uint32_t size, uint8_t pc)
+{
+    uint32_t at = 0;
+    while ((section != NULL) && (at + 3U <= size))
+    {
+        const uint32_t length = section[at + 1U];
+        if ((at + 3U + length > size) || (section[at + 2U + length] != '\0')) return NULL;
+        if (section[at] == pc) return (const char*)&section[at + 2U];
+        at += 3U + length;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns the printable name of a status.
+ */
+const char* SeqNetImageStatus_name(SeqNetImageStatus_t status)
+{
+    switch (status)
+    {
+        case SEQNET_IMAGE_OK:           return "ok";
+        case SEQNET_IMAGE_IO_ERROR:     return "i/o error";
+        case SEQNET_IMAGE_BAD_MAGIC:    return "bad magic";
+        case SEQNET_IMAGE_BAD_VERSION:  return "bad version";
+        case SEQNET_IMAGE_TRUNCATED:    return "truncated";
+        case SEQNET_IMAGE_BAD_CHECKSUM: return "bad checksum";
+        case SEQNET_IMAGE_BAD_PROGRAM:  return "bad program";
+        case SEQNET_IMAGE_FULL:         return "directory full";
+        case SEQNET_IMAGE_NO_IMAGE:     return "no image";
+        default:                        return "unknown";
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * @file seqnet_table.c
+ * @brief Builds and inspects the precomputed transition table of a program.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet_table.h"
+#include "seqnet_internal.h"  // for SEQNET_TRAP_WORD
+#include "lift_assert.h"
+
+/**
+ * @brief Builds the transition table of a program.
+ *
+ * Every (PC, mask) pair is evaluated once with the condition selector. The trap row
+ * keeps a controller that jumped to 255 there without outputs.
+ */
+void SeqNetTable_build(SeqNetTable_t* table, const SeqNet_Program* program)
+{
+    LIFT_ASSERT(table != NULL);
+    LIFT_ASSERT(program != NULL);
+
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        const SeqNet_Out* instr = &program->decoded[pc];
+        const uint8_t fall_through = (uint8_t)((pc + 1) % SEQNET_PROGMEM_SIZE);
+
+        table->out[pc] = program->words[pc];
+
+        for (uint16_t mask = 0; mask < CONDSEL_MASK_COUNT; ++mask)
+        {
+            const bool condition_active = CondSel_calcMask(instr->cond_inv, instr->cond_sel, (CondSel_Mask)mask);
+            table->next[pc][mask] = condition_active ? instr->jump_addr : fall_through;
+        }
+    }
+
+    table->out[SEQNET_PROGMEM_SIZE] = SEQNET_TRAP_WORD;
+    memset(table->next[SEQNET_PROGMEM_SIZE], SEQNET_PROGMEM_SIZE, sizeof(table->next[SEQNET_PROGMEM_SIZE]));
+}
+
+/**
+ * @brief Returns the set of inputs the next PC of an instruction depends on.
+ */
+CondSel_Mask SeqNetTable_dependency(const SeqNetTable_t* table, uint8_t pc)
+{
+    LIFT_ASSERT(table != NULL);
+
+    CondSel_Mask depends = 0;
+
+    for (uint16_t mask = 0; mask < CONDSEL_MASK_COUNT; ++mask)
+    {
+        for (uint8_t bit = 0; bit < 5; ++bit)
+        {
+            const uint16_t flipped = mask ^ (1U << bit);
+            if (table->next[pc][mask] != table->next[pc][flipped])
+            {
+                depends |= (CondSel_Mask)(1U << bit);
+            }
+        }
+    }
+
+    return depends;
+}
+
+/**
+ * @brief Prints the transitions of the first PCs in a compact form.
+ *
+ * Instructions with a single successor print it once, the others print
+ * the next PC for every input mask (0x00 .. 0x1F).
+ */
+void SeqNetTable_print(const SeqNetTable_t* table, uint8_t count)
+{
+    LIFT_ASSERT(table != NULL);
+    LIFT_ASSERT(count <= SEQNET_PROGMEM_SIZE);
+
+    printf("=== Transition Table ===\n");
+    printf(" PC | Out    | Deps | Next PC by input mask\n");
+    printf("----+--------+------+----------------------\n");
+    for (uint8_t pc = 0; pc < count; ++pc)
+    {
+        const CondSel_Mask depends = SeqNetTable_dependency(table, pc);
+        printf("%3u | 0x%04X | 0x%02X |", pc, table->out[pc], depends);
+
+        if (depends == 0)
+        {
+            printf(" always %u\n", table->next[pc][0]);
+            continue;
+        }
+
+        for (uint16_t mask = 0; mask < CONDSEL_MASK_COUNT; ++mask)
+        {
+            printf(" %u", table->next[pc][mask]);
+        }
+        printf("\n");
+    }
+    printf("============================\n");
+}
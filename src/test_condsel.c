@@ -16,6 +16,88 @@ typedef struct {
     bool expected;
 } CondSelTestCase_t;
 
+/**
+ * @brief Cross-checks CondSel_calcMask() and the bitsliced evaluators against
+ *        CondSel_calc() for every input mask, selector index and inversion.
+ */
+static void CondSelPackedCases_test(void)
+{
+    printf("[TEST] Running packed and bitsliced CondSel cross-check...\n");
+
+    size_t checked = 0;
+    size_t passed = 0;
+
+    // 32 masks x 8 indexes x 2 inversions = 512 combinations, sliced into 8 groups of 64 lanes
+    for (uint32_t group = 0; group < 8; ++group)
+    {
+        CondSel_Planes planes = { 0 };
+        CondSel_SelPlanes sel = { 0 };
+        bool expected[64];
+
+        for (uint32_t lane = 0; lane < 64; ++lane)
+        {
+            const uint32_t combo = group * 64 + lane;
+            const CondSel_Mask mask = (CondSel_Mask)(combo & CONDSEL_MASK_ALL);
+            const uint8_t index = (uint8_t)((combo >> 5) & 0x7);
+            const bool invert = (combo >> 8) & 0x1;
+            const CondSel_In in = {
+                .call_pending_below = (mask & CONDSEL_MASK_BELOW) != 0,
+                .call_pending_same  = (mask & CONDSEL_MASK_SAME) != 0,
+                .call_pending_above = (mask & CONDSEL_MASK_ABOVE) != 0,
+                .door_closed        = (mask & CONDSEL_MASK_CLOSED) != 0,
+                .door_open          = (mask & CONDSEL_MASK_OPEN) != 0
+            };
+            const uint64_t bit = (uint64_t)1 << lane;
+
+            expected[lane] = CondSel_calc(invert, index, in);
+
+            // Scalar packed evaluator
+            bool ok = (CondSel_pack(&in) == mask) &&
+                      (CondSel_calcMask(invert, index, mask) == expected[lane]);
+
+            // Single-lane uniform sliced evaluator
+            CondSel_Planes single = {
+                .call_pending_below = in.call_pending_below ? bit : 0,
+                .call_pending_same  = in.call_pending_same  ? bit : 0,
+                .call_pending_above = in.call_pending_above ? bit : 0,
+                .door_closed        = in.door_closed        ? bit : 0,
+                .door_open          = in.door_open          ? bit : 0
+            };
+            ok = ok && (((CondSel_calcSliced(invert, index, &single) & bit) != 0) == expected[lane]);
+
+            LIFT_ASSERT(ok);
+            passed += ok;
+            ++checked;
+
+            planes.call_pending_below |= single.call_pending_below;
+            planes.call_pending_same  |= single.call_pending_same;
+            planes.call_pending_above |= single.call_pending_above;
+            planes.door_closed        |= single.door_closed;
+            planes.door_open          |= single.door_open;
+            sel.index0 |= (index & 0x1) ? bit : 0;
+            sel.index1 |= (index & 0x2) ? bit : 0;
+            sel.index2 |= (index & 0x4) ? bit : 0;
+            sel.invert |= invert ? bit : 0;
+        }
+
+        // Per-lane selectors, all 64 lanes at once
+        const uint64_t result = CondSel_calcSlicedSel(&sel, &planes);
+        for (uint32_t lane = 0; lane < 64; ++lane)
+        {
+            bool ok = (((result >> lane) & 0x1) != 0) == expected[lane];
+            if (!ok)
+            {
+                printf("    > Sliced mismatch at combination %u\n", (unsigned)(group * 64 + lane));
+            }
+            LIFT_ASSERT(ok);
+            passed += ok;
+            ++checked;
+        }
+    }
+
+    printf("[TEST] %zu/%zu combinations matched.\n", passed, checked);
+}
+
 /**
  * @brief Runs all defined test cases for the condition selector.
  */
@@ -103,18 +185,21 @@ void CondSelAllCases_test(void)
     {
         CondSelTestCase_t t = tests[i];
         bool result = CondSel_calc(t.invert, t.index, t.inputs);
+        bool result_mask = CondSel_calcMask(t.invert, t.index, CondSel_pack(&t.inputs));
         printf("  - %-40s ... ", t.name);
-        if (result == t.expected) 
+        if ((result == t.expected) && (result_mask == t.expected))
         {
             printf("OK\n");
             passed++;
         } 
         else 
         {
-            printf("FAIL (got %d, expected %d)\n", result, t.expected);
+            printf("FAIL (got %d/%d, expected %d)\n", result, result_mask, t.expected);
         }
-        LIFT_ASSERT(result == t.expected);
+        LIFT_ASSERT((result == t.expected) && (result_mask == t.expected));
     }
 
     printf("[TEST] %zu/%zu tests passed.\n", passed, num_tests);
+
+    CondSelPackedCases_test();
 }
@@ -7,8 +7,25 @@
 #include <stdio.h>
 #include <string.h>
 #include "lift_assert.h"
+#include "lift_thread.h"
+#include "lift_trace.h"
+#include "lift_random.h"
 
 #define LIFT_TEST_DEBUG_LOG_ENABLED 0
+#define LIFT_TEST_TRACE_ENABLED 0                  // Record LiftTestAll_run() into LIFT_TEST_TRACE_FILE
+#define LIFT_TEST_TRACE_FILE            "lift_trace.bin"
+#define LIFT_TEST_TRACE_CAPACITY        (4096U)   // Records buffered between two writes
+#define LIFT_TEST_PARALLEL_CHUNK        (64U)     // Cases claimed by a worker at once
+#define LIFT_TEST_PARALLEL_THREADS      (4U)      // Workers of the parallel self-test
+#define LIFT_TEST_GENERATED_COUNT       (20000U)  // Generated cases of the parallel self-test
+
+/// Binary trace of LiftTestCase_run(), NULL if not attached
+static LiftTrace_t* LiftTest_trace = NULL;
+
+void LiftTestTrace_attach(LiftTrace_t* trace)
+{
+    LiftTest_trace = trace;
+}
 
 /**
  * @brief Simulates a lift test case defined by input-output steps.
@@ -20,12 +37,9 @@ void LiftTestCase_run(const LiftTestCase_t* test, const char* name)
     CondSel_In cond_in;
     SeqNet_Out seq_out;
     LiftState_t actual;
+    static char calls_text[LIFT_CALLS_TEXT_SIZE];
 
-    uint16_t instr = 0;
-    uint16_t pc_pre = 0;
-
-    bool cond_result = false;
-
+    uint8_t pc_pre = 0;
 
     if (test == NULL || test->steps == 0) 
     {
@@ -45,14 +59,18 @@ void LiftTestCase_run(const LiftTestCase_t* test, const char* name)
     // Load the initial state from the test case
     memcpy(&actual, &(test->initial_state), sizeof(LiftState_t));
 
+    if (LiftTest_trace != NULL)
+    {
+        LiftTrace_begin(LiftTest_trace, test->PC_preset, &actual);
+    }
+
     // Print the initial state
     printf (
-        "INT: Floor: %d, Door Open: %s, Moving: %s, Calls: [%d, %d, %d, %d, %d, %d], PC preset: %d\n",
+        "INT: Floor: %d, Door Open: %s, Moving: %s, Calls: [%s], PC preset: %d\n",
             actual.floor,
             actual.is_door_open ? "Y" : "N",
             actual.is_moving ? "Y" : "N",
-            actual.calls[0], actual.calls[1], actual.calls[2],
-            actual.calls[3], actual.calls[4], actual.calls[5],
+            LiftCalls_format(&actual.calls, calls_text),
             test->PC_preset
     );
 
@@ -62,26 +80,16 @@ void LiftTestCase_run(const LiftTestCase_t* test, const char* name)
         // Get actual index of ProgMem
         pc_pre = SeqNetPC_get();
 
-        // Fetch the instruction from ProgMem
-        instr = SeqNetProgramMemory_get()[pc_pre];
-
-        // Convert 16-bit array to instruction
-        SeqNet_Out output = SeqNetInstruction_convert(instr);
-
         // Convert initial lift state to condition selector input format
         LiftStateArray_convert(&actual, &cond_in);
 
-        // Calculate the condition selector input
-        cond_result = CondSel_calc(output.cond_inv, output.cond_sel, cond_in);
-        //printf("Condition result: %s, inv: %d, idx: %d\n", cond_result ? "True" : "False", output.cond_inv, output.cond_sel);
-
-        // Process the sequence network loop
-        seq_out = SeqNet_loop(cond_result);
+        // Fetch, evaluate the condition and process the sequence network in one step
+        seq_out = SeqNet_step(&cond_in);
 
 #if LIFT_TEST_DEBUG_LOG_ENABLED
         // Print the results for debugging
         printf (
-            "Step %02d: Floor: %d, Door Open: %s, Moving: %s, prePC: %02d, postPC: %02d, Reset: %d, Calls: [%d, %d, %d, %d, %d, %d], Up: %d, Down: %d, DReq: %d\n",
+            "Step %02d: Floor: %d, Door Open: %s, Moving: %s, prePC: %02d, postPC: %02d, Reset: %d, Calls: [%s], Up: %d, Down: %d, DReq: %d\n",
                 step,
                 actual.floor,
                 actual.is_door_open ? "Y" : "N",
@@ -89,8 +97,7 @@ void LiftTestCase_run(const LiftTestCase_t* test, const char* name)
                 pc_pre,
                 SeqNetPC_get(), // Get NEW index of ProgMem
                 seq_out.req_reset ? 1 : 0,
-                actual.calls[0], actual.calls[1], actual.calls[2],
-                actual.calls[3], actual.calls[4], actual.calls[5],
+                LiftCalls_format(&actual.calls, calls_text),
                 seq_out.req_move_up ? 1 : 0,
                 seq_out.req_move_down ? 1 : 0,
                 seq_out.req_door_state == DOOR_REQ_OPEN ? 1 : 0
@@ -98,63 +105,31 @@ void LiftTestCase_run(const LiftTestCase_t* test, const char* name)
 #endif //LIFT_TEST_DEBUG_LOG_ENABLED
 
         // EMULATE the lift state change
+        LiftPlant_apply(&actual, &seq_out);
 
-        // DOORS
-        if (DOOR_REQ_OPEN == seq_out.req_door_state)
-        {
-            actual.is_door_open = true;
-        }
-        else if (DOOR_REQ_CLOSE == seq_out.req_door_state)
-        {
-            actual.is_door_open = false;
-        }
-
-        // CALLS
-        if (seq_out.req_reset)
-        {
-            // Reset the call state for the current floor
-            actual.calls[actual.floor] = false;
-        }
-
-        // MOVEMENT
-        if (seq_out.req_move_up && !seq_out.req_move_down)
-        {
-            actual.is_moving = true;
-            actual.floor++;
-        }
-        else if (seq_out.req_move_down && !seq_out.req_move_up)
-        {
-            actual.is_moving = true;
-            actual.floor--;
-        }
-        else if (!seq_out.req_move_down && !seq_out.req_move_up)
-        {
-            actual.is_moving = false; // Stop moving if no direction is requested
-        }
-        else
+        if (LiftTest_trace != NULL)
         {
-            LIFT_ASSERT(false);
+            LiftTrace_step(LiftTest_trace, pc_pre, SeqNetPC_get(), CondSel_pack(&cond_in),
+                           SeqNetOut_convert(&seq_out), &actual);
         }
     }
 
     // Print the last state
     printf (
-        "END: Floor: %d, Door Open: %s, Moving: %s, Calls: [%d, %d, %d, %d, %d, %d]\n",
+        "END: Floor: %d, Door Open: %s, Moving: %s, Calls: [%s]\n",
             actual.floor,
             actual.is_door_open ? "Y" : "N",
             actual.is_moving ? "Y" : "N",
-            actual.calls[0], actual.calls[1], actual.calls[2],
-            actual.calls[3], actual.calls[4], actual.calls[5]
+            LiftCalls_format(&actual.calls, calls_text)
     );
 
     // Print the comparison state
     printf (
-        "REF: Floor: %d, Door Open: %s, Moving: %s, Calls: [%d, %d, %d, %d, %d, %d]\n",
+        "REF: Floor: %d, Door Open: %s, Moving: %s, Calls: [%s]\n",
             test->end_state.floor,
             test->end_state.is_door_open ? "Y" : "N",
             test->end_state.is_moving ? "Y" : "N",
-            test->end_state.calls[0], actual.calls[1], actual.calls[2],
-            test->end_state.calls[3], actual.calls[4], actual.calls[5]
+            LiftCalls_format(&test->end_state.calls, calls_text)
     );
 
     // Print final state
@@ -171,41 +146,6 @@ void LiftTestCase_run(const LiftTestCase_t* test, const char* name)
     printf("============================\n");
 }
 
-/**
- * @brief Converts a high-level lift state into condition selector input format.
- *
- * This function takes the current elevator state (floor, door, calls)
- * and fills a CondSel_In structure used for evaluating logic conditions.
- *
- * @param[in]  state  Pointer to the current lift state.
- * @param[out] out    Pointer to the output CondSel_In structure to be filled.
- */
-void LiftStateArray_convert(const LiftState_t* state, CondSel_In* out)
-{
-    // Door state
-    out->door_closed = !state->is_door_open;
-    out->door_open = state->is_door_open;
-    /*printf("O: %d, C: %d\n",
-           out->door_open ? 1 : 0,
-           out->door_closed ? 1 : 0);*/
-
-    // Calls
-    out->call_pending_below = false;
-    out->call_pending_same  = false;
-    out->call_pending_above = false;
-
-    for (uint8_t i = 0; i < LIFT_TEST_MAX_FLOORS; ++i)
-    {
-        if (!state->calls[i]) continue;
-        if (i < state->floor)
-            out->call_pending_below = true;
-        else if (i == state->floor)
-            out->call_pending_same = true;
-        else
-            out->call_pending_above = true;
-    }
-}
-
 /**
  * @brief Compares two LiftState_t structures and prints differences if any.
  *
@@ -239,14 +179,17 @@ bool LiftState_compare(const LiftState_t* a, const LiftState_t* b)
         match = false;
     }
 
-    for (uint8_t i = 0; i < LIFT_TEST_MAX_FLOORS; ++i)
+    // Floors are only listed one by one when the bitsets differ
+    for (uint16_t i = 0; !LiftCalls_equal(&a->calls, &b->calls) && (i < LIFT_TEST_MAX_FLOORS); ++i)
     {
-        if (a->calls[i] != b->calls[i])
+        const bool expected = LiftCalls_get(&b->calls, i);
+        const bool got = LiftCalls_get(&a->calls, i);
+        if (expected != got)
         {
             printf("Mismatch: calls[%d] (expected: %s, got: %s)\n",
                    i,
-                   b->calls[i] ? "true" : "false",
-                   a->calls[i] ? "true" : "false");
+                   expected ? "true" : "false",
+                   got ? "true" : "false");
             match = false;
         }
     }
@@ -256,101 +199,368 @@ bool LiftState_compare(const LiftState_t* a, const LiftState_t* b)
 
 // Call from current floor, door already open
 const LiftTestCase_t test_case_already_open = {
-    .initial_state = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = { false, true, false, false, false, false } },
-    .end_state     = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(1)) },
+    .end_state     = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 10
 };
 
 // Call from current floor, door closed
 const LiftTestCase_t test_case_open_door_same_floor = {
-    .initial_state = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = { false, false, true, false, false, false } },
-    .end_state     = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(2)) },
+    .end_state     = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 8
 };
 
 // Call from floor below
 const LiftTestCase_t test_case_move_down = {
-    .initial_state = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = { false, true, false, false, false, false } },
-    .end_state     = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(1)) },
+    .end_state     = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 15
 };
 
 // Call from floor above
 const LiftTestCase_t test_case_move_up = {
-    .initial_state = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = { false, false, false, true, false, false } },
-    .end_state     = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(3)) },
+    .end_state     = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 15
 };
 
 // Multiple calls – up and down
 const LiftTestCase_t test_case_multiple_calls = {
-    .initial_state = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = { false, true, false, true, false, false } },
-    .end_state     = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(1) | LIFT_CALL(3)) },
+    .end_state     = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 25
 };
 
 // No calls (idle)
 const LiftTestCase_t test_case_idle = {
-    .initial_state = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
-    .end_state     = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
+    .end_state     = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 10
 };
 
 // Door re-open during closing
 const LiftTestCase_t test_case_reopen_during_close = {
-    .initial_state = { .floor = 3, .is_door_open = false, .is_moving = false, .calls = { false, false, false, true, false, false } },
-    .end_state     = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 3, .is_door_open = false, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(3)) },
+    .end_state     = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 15,
     .PC_preset = 3 // Start at door closing state
 };
 
 // Long trip from bottom to top
 const LiftTestCase_t test_case_bottom_to_top = {
-    .initial_state = { .floor = 0, .is_door_open = false, .is_moving = false, .calls = { false, false, false, false, false, true } },
-    .end_state     = { .floor = 5, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 0, .is_door_open = false, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(5)) },
+    .end_state     = { .floor = 5, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 25
 };
 
 // All floors have calls
 const LiftTestCase_t test_case_all_calls = {
-    .initial_state = { .floor = 0, .is_door_open = false, .is_moving = false, .calls = { true, true, true, true, true, true } },
-    .end_state     = { .floor = 5, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 0, .is_door_open = false, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(0) | LIFT_CALL(1) | LIFT_CALL(2) | LIFT_CALL(3) | LIFT_CALL(4) | LIFT_CALL(5)) },
+    .end_state     = { .floor = 5, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 75
 };
 
 // Stop on middle floor
 const LiftTestCase_t test_case_middle_stop = {
-    .initial_state = { .floor = 0, .is_door_open = true, .is_moving = false, .calls = { false, false, true, false, false, false } },
-    .end_state     = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 0, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(2)) },
+    .end_state     = { .floor = 2, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 16
 };
 
 // Move up 2 floors
 const LiftTestCase_t test_case_up_two_floors = {
-    .initial_state = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = { false, false, false, true, false, false } },
-    .end_state     = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(3)) },
+    .end_state     = { .floor = 3, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 16
 };
 
 // Move down 2 floors
 const LiftTestCase_t test_case_down_two_floors = {
-    .initial_state = { .floor = 4, .is_door_open = false, .is_moving = false, .calls = { false, true, false, false, false, false } },
-    .end_state     = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = { false, false, false, false, false, false } },
+    .initial_state = { .floor = 4, .is_door_open = false, .is_moving = false, .calls = LIFT_CALLS_INIT(LIFT_CALL(1)) },
+    .end_state     = { .floor = 1, .is_door_open = true, .is_moving = false, .calls = LIFT_CALLS_NONE },
     .steps = 18
 };
 
+/**
+ * @brief Named test case entry.
+ */
+typedef struct
+{
+    const LiftTestCase_t* test;
+    const char* name;
+} LiftTestEntry_t;
+
+/// All test cases in execution order
+static const LiftTestEntry_t LiftTestAll_cases[] =
+{
+    { &test_case_already_open,           "already_open" },
+    { &test_case_open_door_same_floor,   "open_door_same_floor" },
+    { &test_case_move_down,              "move_down" },
+    { &test_case_move_up,                "move_up" },
+    { &test_case_multiple_calls,         "multiple_calls" },
+    { &test_case_idle,                   "idle" },
+    { &test_case_reopen_during_close,    "reopen_during_close" },
+    { &test_case_bottom_to_top,          "bottom_to_top" },
+    { &test_case_middle_stop,            "middle_stop" },
+    { &test_case_up_two_floors,          "up_two_floors" },
+    { &test_case_down_two_floors,        "down_two_floors" },
+    { &test_case_all_calls,              "all_calls" },
+};
+
+/// Number of test cases
+#define LIFT_TEST_ALL_COUNT (sizeof(LiftTestAll_cases) / sizeof(LiftTestAll_cases[0]))
+
 void LiftTestAll_run(void)
 {
-    LiftTestCase_run(&test_case_already_open,           "already_open");
-    LiftTestCase_run(&test_case_open_door_same_floor,   "open_door_same_floor");
-    LiftTestCase_run(&test_case_move_down,              "move_down");
-    LiftTestCase_run(&test_case_move_up,                "move_up");
-    LiftTestCase_run(&test_case_multiple_calls,         "multiple_calls");
-    LiftTestCase_run(&test_case_idle,                   "idle");
-    LiftTestCase_run(&test_case_reopen_during_close,    "reopen_during_close");
-    LiftTestCase_run(&test_case_bottom_to_top,          "bottom_to_top");
-    LiftTestCase_run(&test_case_middle_stop,            "middle_stop");
-    LiftTestCase_run(&test_case_up_two_floors,          "up_two_floors");
-    LiftTestCase_run(&test_case_down_two_floors,        "down_two_floors");
-    LiftTestCase_run(&test_case_all_calls,              "all_calls");
+#if LIFT_TEST_TRACE_ENABLED
+    // Decode with: lift_tracedump lift_trace.bin
+    static LiftTraceRecord_t records[LIFT_TEST_TRACE_CAPACITY];
+    static LiftTrace_t trace;
+    FILE* file = fopen(LIFT_TEST_TRACE_FILE, "wb");
+    if (file != NULL)
+    {
+        LiftTrace_init(&trace, records, LIFT_TEST_TRACE_CAPACITY, file);
+        LiftTestTrace_attach(&trace);
+    }
+#endif //LIFT_TEST_TRACE_ENABLED
+
+    for (size_t i = 0; i < LIFT_TEST_ALL_COUNT; ++i)
+    {
+        LiftTestCase_run(LiftTestAll_cases[i].test, LiftTestAll_cases[i].name);
+    }
+
+#if LIFT_TEST_TRACE_ENABLED
+    if (file != NULL)
+    {
+        LiftTestTrace_attach(NULL);
+        LiftTrace_flush(&trace);
+        fclose(file);
+    }
+#endif //LIFT_TEST_TRACE_ENABLED
+}
+
+/**
+ * @brief Simulates a test case silently, either step by step or with SeqNet_runUntil().
+ *
+ * @param[in]  test         Test case to simulate.
+ * @param[in]  macro        True to use macro-steps, false for single steps.
+ * @param[out] end          Lift state after test->steps micro-steps.
+ * @param[out] plant_calls  Number of plant updates.
+ */
+static void LiftTestCase_simulate(const LiftTestCase_t* test, bool macro, LiftState_t* end, uint32_t* plant_calls)
+{
+    CondSel_In cond_in;
+    SeqNet_Out seq_out;
+
+    SeqNet_init();
+    SeqNetPC_set(test->PC_preset);
+    memcpy(end, &(test->initial_state), sizeof(LiftState_t));
+    *plant_calls = 0;
+
+    uint32_t step = 0;
+    while (step < test->steps)
+    {
+        LiftStateArray_convert(end, &cond_in);
+
+        if (macro)
+        {
+            step += SeqNet_runUntil(&cond_in, SEQNET_WATCH_ALL, test->steps - step, &seq_out);
+        }
+        else
+        {
+            seq_out = SeqNet_step(&cond_in);
+            ++step;
+        }
+
+        LiftPlant_apply(end, &seq_out);
+        ++(*plant_calls);
+    }
+}
+
+void LiftTestAllMacro_run(void)
+{
+    printf("[TEST] Running SeqNet_runUntil() scenario equivalence...\n");
+
+    size_t passed = 0;
+    uint32_t total_single = 0;
+    uint32_t total_macro = 0;
+
+    for (size_t i = 0; i < LIFT_TEST_ALL_COUNT; ++i)
+    {
+        const LiftTestCase_t* test = LiftTestAll_cases[i].test;
+        LiftState_t single_end, macro_end;
+        uint32_t single_calls, macro_calls;
+
+        LiftTestCase_simulate(test, false, &single_end, &single_calls);
+        LiftTestCase_simulate(test, true, &macro_end, &macro_calls);
+
+        bool ok = LiftState_compare(&macro_end, &single_end) &&
+                  LiftState_compare(&macro_end, &(test->end_state));
+
+        printf("  - %-24s plant updates %3u -> %3u ... %s\n",
+               LiftTestAll_cases[i].name, (unsigned)single_calls, (unsigned)macro_calls, ok ? "OK" : "FAIL");
+
+        LIFT_ASSERT(ok);
+        passed += ok;
+        total_single += single_calls;
+        total_macro += macro_calls;
+    }
+
+    printf("[TEST] %zu/%zu scenarios matched, plant updates %u -> %u.\n",
+           passed, (size_t)LIFT_TEST_ALL_COUNT, (unsigned)total_single, (unsigned)total_macro);
+}
+
+bool LiftTestCase_exec(const LiftTestCase_t* test, const SeqNet_Program* program, LiftTestResult_t* result)
+{
+    return LiftTestCase_execTraced(test, program, result, NULL);
+}
+
+bool LiftTestCase_execTraced(const LiftTestCase_t* test, const SeqNet_Program* program, LiftTestResult_t* result,
+                             LiftTrace_t* trace)
+{
+    LiftInputs_t plant;
+    SeqNet_Ctx ctx;
+
+    SeqNet_ctxInit(&ctx, program);
+    ctx.pc = test->PC_preset;
+    LiftInputs_init(&plant, &test->initial_state);
+
+    if (trace != NULL)
+    {
+        LiftTrace_begin(trace, ctx.pc, &plant.state);
+    }
+
+    for (uint8_t step = 0; step < test->steps; ++step)
+    {
+        const uint8_t pc_pre = ctx.pc;
+        const CondSel_Mask mask = (trace != NULL) ? CondSel_pack(&plant.in) : 0;
+        const uint16_t word = SeqNet_ctxStepRaw(&ctx, &plant.in);
+        LiftInputs_apply(&plant, &program->decoded[pc_pre]);
+
+        if (trace != NULL)
+        {
+            LiftTrace_step(trace, pc_pre, ctx.pc, mask, word, &plant.state);
+        }
+    }
+
+    result->end_state = plant.state;
+    result->end_pc = ctx.pc;
+    result->passed = LiftState_equal(&result->end_state, &test->end_state);
+    return result->passed;
+}
+
+/**
+ * @brief Work shared by the workers of the parallel runner.
+ */
+typedef struct
+{
+    const LiftTestCase_t* tests;
+    const SeqNet_Program* program;
+    LiftTestResult_t* results;
+    uint32_t count;
+    uint32_t cursor;   // Next unclaimed case (atomic)
+    uint32_t passed;   // Passed cases (atomic)
+} LiftTestParallelJob_t;
+
+/**
+ * @brief Worker of the parallel runner: claims chunks of cases until none is left.
+ */
+static void LiftTestParallel_worker(void* arg)
+{
+    LiftTestParallelJob_t* job = (LiftTestParallelJob_t*)arg;
+    uint32_t passed = 0;
+
+    for (;;)
+    {
+        const uint32_t begin = __atomic_fetch_add(&job->cursor, LIFT_TEST_PARALLEL_CHUNK, __ATOMIC_RELAXED);
+        if (begin >= job->count) break;
+
+        const uint32_t end = (begin + LIFT_TEST_PARALLEL_CHUNK < job->count) ? begin + LIFT_TEST_PARALLEL_CHUNK : job->count;
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            passed += LiftTestCase_exec(&job->tests[i], job->program, &job->results[i]);
+        }
+    }
+
+    __atomic_fetch_add(&job->passed, passed, __ATOMIC_RELAXED);
+}
+
+uint32_t LiftTestCases_runParallel(const LiftTestCase_t* tests, uint32_t count, const SeqNet_Program* program,
+                                   LiftTestResult_t* results, uint32_t threads)
+{
+    LIFT_ASSERT((tests != NULL) || (count == 0));
+    LIFT_ASSERT(program != NULL);
+
+    LiftTestParallelJob_t job = {
+        .tests = tests,
+        .program = program,
+        .results = results,
+        .count = count,
+        .cursor = 0,
+        .passed = 0
+    };
+
+    if (threads == 0) threads = 1;
+    if (threads > LIFT_THREAD_MAX) threads = LIFT_THREAD_MAX;
+
+    LiftThread_runAll(LiftTestParallel_worker, &job, 0, threads);
+    return job.passed;
+}
+
+void LiftTestAllParallel_run(void)
+{
+    printf("[TEST] Running LiftTestCases_runParallel() cases...\n");
+
+    const SeqNet_Program* program = SeqNetProgram_get();
+    static LiftTestCase_t tests[LIFT_TEST_GENERATED_COUNT];
+    static LiftTestResult_t serial[LIFT_TEST_GENERATED_COUNT];
+    static LiftTestResult_t parallel[LIFT_TEST_GENERATED_COUNT];
+
+    // Named cases, reported in table order
+    for (size_t i = 0; i < LIFT_TEST_ALL_COUNT; ++i)
+    {
+        tests[i] = *LiftTestAll_cases[i].test;
+    }
+    uint32_t passed = LiftTestCases_runParallel(tests, LIFT_TEST_ALL_COUNT, program, parallel, LIFT_TEST_PARALLEL_THREADS);
+    for (size_t i = 0; i < LIFT_TEST_ALL_COUNT; ++i)
+    {
+        printf("  - %-40s ... %s\n", LiftTestAll_cases[i].name, parallel[i].passed ? "OK" : "FAIL");
+        LIFT_ASSERT(parallel[i].passed);
+    }
+
+    // Generated cases: the parallel results must equal the serial ones case by case
+    uint32_t seed = 0xACE1U;
+    for (uint32_t i = 0; i < LIFT_TEST_GENERATED_COUNT; ++i)
+    {
+        LiftTestCase_t* test = &tests[i];
+        memset(test, 0, sizeof(LiftTestCase_t));
+        LiftRandom_next32(&seed);
+        test->initial_state.floor = (uint16_t)((seed >> 16) % LIFT_TEST_MAX_FLOORS);
+        test->initial_state.is_door_open = ((seed >> 8) & 1U) != 0;
+        for (uint16_t f = 0; (f < LIFT_TEST_MAX_FLOORS) && (f < 12U); ++f)
+        {
+            LiftCalls_assign(&test->initial_state.calls, f, ((seed >> (20U + f)) & 1U) != 0);
+        }
+        test->steps = (uint8_t)(1U + (seed % LIFT_TEST_MAX_STEPS));
+    }
+
+    for (uint32_t i = 0; i < LIFT_TEST_GENERATED_COUNT; ++i)
+    {
+        LiftTestCase_exec(&tests[i], program, &serial[i]);
+    }
+    LiftTestCases_runParallel(tests, LIFT_TEST_GENERATED_COUNT, program, parallel, LIFT_TEST_PARALLEL_THREADS);
+
+    uint32_t matched = 0;
+    for (uint32_t i = 0; i < LIFT_TEST_GENERATED_COUNT; ++i)
+    {
+        matched += LiftState_equal(&serial[i].end_state, &parallel[i].end_state) && (serial[i].end_pc == parallel[i].end_pc);
+    }
+    bool ok = (matched == LIFT_TEST_GENERATED_COUNT);
+    printf("  - %-40s ... %s (%u/%u)\n", "generated cases, serial vs parallel", ok ? "OK" : "FAIL",
+           matched, (unsigned)LIFT_TEST_GENERATED_COUNT);
+    LIFT_ASSERT(ok);
+
+    printf("[TEST] %u/%zu named cases passed on %u threads.\n",
+           passed, (size_t)LIFT_TEST_ALL_COUNT, (unsigned)LIFT_TEST_PARALLEL_THREADS);
 }
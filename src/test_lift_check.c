@@ -0,0 +1,189 @@
+/**
+ * @file test_lift_check.c
+ * @brief Unit tests of the explicit-state model checker.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "condsel_internal.h"
+#include "lift_check.h"
+#include "lift_plant.h"
+#include "lift_assert.h"
+
+#define LIFT_CHECK_TEST_CAPACITY    (1U << 16)  // Visited set size, power of two
+#define LIFT_CHECK_TEST_TRACE       (128U)      // Longest trace kept
+#define LIFT_CHECK_TEST_THREADS     (4U)        // Workers of the parallel runs
+#define LIFT_CHECK_TEST_FLOORS      (6U)        // Floors of the checked building
+
+static uint64_t LiftCheckTest_keys[LIFT_CHECK_TEST_CAPACITY];
+static uint32_t LiftCheckTest_parents[LIFT_CHECK_TEST_CAPACITY];
+static uint32_t LiftCheckTest_current[LIFT_CHECK_TEST_CAPACITY];
+static uint32_t LiftCheckTest_next[LIFT_CHECK_TEST_CAPACITY];
+
+static const LiftCheckWorkspace_t LiftCheckTest_workspace = {
+    .keys = LiftCheckTest_keys,
+    .parents = LiftCheckTest_parents,
+    .current = LiftCheckTest_current,
+    .next = LiftCheckTest_next,
+    .capacity = LIFT_CHECK_TEST_CAPACITY
+};
+
+/**
+ * @brief Replays a trace with the reference plant and returns true, if every transition is valid.
+ *
+ * A valid transition registers at most one new call, then executes one step.
+ */
+static bool LiftCheckTrace_replay(const SeqNet_Program* program, const LiftCheckState_t* trace, uint32_t length)
+{
+    for (uint32_t i = 0; i + 1U < length; ++i)
+    {
+        const LiftCheckState_t* from = &trace[i];
+        const LiftCheckState_t* to = &trace[i + 1U];
+
+        LiftState_t state;
+        memset(&state, 0, sizeof(state));
+        state.floor = from->floor;
+        state.is_door_open = from->is_door_open;
+        state.is_moving = from->is_moving;
+        for (uint16_t f = 0; (f < LIFT_MAX_FLOORS) && (f < LIFT_CHECK_MAX_FLOORS); ++f)
+        {
+            // Calls of the source plus the arrival, the reset of the step is applied below
+            LiftCalls_assign(&state.calls, f, (((from->calls | to->calls) >> f) & 1U) != 0);
+        }
+
+        CondSel_In in;
+        SeqNet_Ctx ctx;
+        SeqNet_ctxInit(&ctx, program);
+        ctx.pc = from->pc;
+        LiftStateArray_convert(&state, &in);
+        const SeqNet_Out out = SeqNet_ctxStep(&ctx, &in);
+        LiftPlant_apply(&state, &out);
+
+        uint32_t calls = 0;
+        for (uint16_t f = 0; (f < LIFT_MAX_FLOORS) && (f < LIFT_CHECK_MAX_FLOORS); ++f)
+        {
+            calls |= (uint32_t)LiftCalls_get(&state.calls, f) << f;
+        }
+
+        if ((ctx.pc != to->pc) || (state.floor != to->floor) || (state.is_door_open != to->is_door_open) ||
+            (state.is_moving != to->is_moving) || (calls != to->calls))
+        {
+            printf("    > Transition %u does not replay\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns whether a building fits into the lift state, so its traces can be replayed.
+ */
+static bool LiftCheckTest_replayable(uint32_t floors)
+{
+    return floors <= LIFT_MAX_FLOORS;
+}
+
+/**
+ * @brief Runs the checker on one program and compares the verdict with the expected one.
+ */
+static bool LiftCheckCase_run(const char* name, const SeqNet_Program* program, const LiftCheckConfig_t* config,
+                              LiftCheckVerdict_t expected, LiftCheckResult_t* result)
+{
+    LiftCheckState_t initial;
+    memset(&initial, 0, sizeof(initial));
+
+    LiftCheck_run(program, config, &initial, &LiftCheckTest_workspace, result);
+
+    bool ok = (result->verdict == expected);
+    if (ok && (expected != LIFT_CHECK_OK))
+    {
+        // Counterexample: starts in the initial state, replays with the reference plant
+        static LiftCheckState_t trace[LIFT_CHECK_TEST_TRACE];
+        const uint32_t length = LiftCheck_trace(&LiftCheckTest_workspace, result, trace, LIFT_CHECK_TEST_TRACE);
+        ok = (length > 0) && (LiftCheck_pack(&trace[0]) == LiftCheck_pack(&initial)) &&
+             (!LiftCheckTest_replayable(config->floors) || LiftCheckTrace_replay(program, trace, length));
+        if (ok && (expected == LIFT_CHECK_DOOR_OPEN_MOVING))
+        {
+            ok = trace[length - 1U].is_door_open && trace[length - 1U].is_moving;
+        }
+    }
+
+    printf("  - %-40s ... %s (%s, %u states, depth %u)\n", name, ok ? "OK" : "FAIL",
+           LiftCheckVerdict_name(result->verdict), result->states, result->depth);
+    return ok;
+}
+
+/**
+ * @brief Checks the loaded program and seeded faulty variants of it with the model checker.
+ */
+void LiftCheckAllCases_test(void)
+{
+    printf("[TEST] Running LiftCheck_run() cases...\n");
+
+    const SeqNet_Program* program = SeqNetProgram_get();
+    static SeqNet_Program faulty;
+    LiftCheckResult_t result;
+    LiftCheckResult_t parallel;
+    size_t checked = 0;
+    size_t passed = 0;
+    bool ok;
+
+    // The default program satisfies every property
+    LiftCheckConfig_t config = { .floors = LIFT_CHECK_TEST_FLOORS, .arrivals = true, .service_bound = 256, .threads = 1 };
+    ok = LiftCheckCase_run("default program", program, &config, LIFT_CHECK_OK, &result);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+
+    // Beyond the test floor count, the parallel search must visit the same states
+    config.floors = LIFT_CHECK_TEST_FLOORS + 2U;
+    config.service_bound = 512;
+    ok = LiftCheckCase_run("default program, 8 floors", program, &config, LIFT_CHECK_OK, &result);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+    config.threads = LIFT_CHECK_TEST_THREADS;
+    ok = LiftCheckCase_run("default program, 8 floors, 4 threads", program, &config, LIFT_CHECK_OK, &parallel);
+    if (ok && ((parallel.states != result.states) || (parallel.depth != result.depth)))
+    {
+        printf("    > %u states, depth %u on one thread\n", result.states, result.depth);
+        ok = false;
+    }
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+
+    // Too tight service bound
+    config.floors = LIFT_CHECK_TEST_FLOORS;
+    config.service_bound = 16;
+    ok = LiftCheckCase_run("default program, service bound 16", program, &config, LIFT_CHECK_SERVICE, &result);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+    config.service_bound = 256;
+
+    // Door left open while moving up (PC 7)
+    memcpy(faulty.words, program->words, sizeof(faulty.words));
+    faulty.words[7] |= (uint16_t)(DOOR_REQ_OPEN << BIT_DOOR_STATE);
+    SeqNetProgram_decode(&faulty);
+    ok = LiftCheckCase_run("door open on move up", &faulty, &config, LIFT_CHECK_DOOR_OPEN_MOVING, &result);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+
+    // Both directions requested while moving down (PC 10)
+    memcpy(faulty.words, program->words, sizeof(faulty.words));
+    faulty.words[10] |= (uint16_t)(1U << BIT_MOVE_UP);
+    SeqNetProgram_decode(&faulty);
+    ok = LiftCheckCase_run("move up and down on move down", &faulty, &config, LIFT_CHECK_MOVE_CONFLICT, &result);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+
+    // Moving up without waiting for the called floor (PC 8 always jumps back)
+    memcpy(faulty.words, program->words, sizeof(faulty.words));
+    faulty.words[8] = (uint16_t)((faulty.words[8] & ~(MASK_COND_SEL << BIT_COND_SEL)) |
+                                 (CONDSEL_ENUM_CONST_FALSE << BIT_COND_SEL) | (1U << BIT_COND_INV));
+    SeqNetProgram_decode(&faulty);
+    ok = LiftCheckCase_run("move up past the called floor", &faulty, &config, LIFT_CHECK_FLOOR_RANGE, &result);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+
+    printf("[TEST] %zu/%zu model checking cases passed.\n", passed, checked);
+}
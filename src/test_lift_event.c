@@ -0,0 +1,76 @@
+/**
+ * @file test_lift_event.c
+ * @brief Unit tests of the event-driven simulation.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "lift_event.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+#define LIFT_EVENT_TEST_CALLS      (64U)        // Call injections per scenario
+#define LIFT_EVENT_TEST_HORIZON    (1000000U)   // Simulated ticks per scenario
+#define LIFT_EVENT_TEST_SCENARIOS  (4U)         // Number of random scenarios
+
+/**
+ * @brief Verifies the event-driven simulation against the tick-driven one on the loaded program.
+ *
+ * Calls are injected at random, sparse ticks so the controller spends most of the
+ * horizon idle; both modes must end in the same plant state and PC.
+ */
+void LiftEventAllCases_test(void)
+{
+    printf("[TEST] Running LiftEventSim_run() cross-check...\n");
+
+    const SeqNet_Program* program = SeqNetProgram_get();
+    static LiftCallInjection_t calls[LIFT_EVENT_TEST_CALLS];
+
+    size_t checked = 0;
+    size_t passed = 0;
+    uint32_t seed = 0x5EED1234U;
+
+    for (uint32_t scenario = 0; scenario < LIFT_EVENT_TEST_SCENARIOS; ++scenario)
+    {
+        // Sorted, random injection ticks
+        uint32_t tick = 0;
+        for (uint32_t i = 0; i < LIFT_EVENT_TEST_CALLS; ++i)
+        {
+            LiftRandom_next32(&seed);
+            tick += (seed >> 8) % (2U * LIFT_EVENT_TEST_HORIZON / LIFT_EVENT_TEST_CALLS);
+            LiftRandom_next32(&seed);
+            calls[i].tick = tick;
+            calls[i].floor = (uint8_t)((seed >> 16) % LIFT_MAX_FLOORS);
+        }
+
+        LiftState_t initial;
+        memset(&initial, 0, sizeof(initial));
+        initial.floor = (uint8_t)(scenario % LIFT_MAX_FLOORS);
+
+        LiftEventSim_t ref;
+        LiftEventSim_t sim;
+        LiftEventSim_init(&ref, program, &initial, 0);
+        LiftEventSim_init(&sim, program, &initial, 0);
+        LiftEventSim_runTicks(&ref, LIFT_EVENT_TEST_HORIZON, calls, LIFT_EVENT_TEST_CALLS);
+        LiftEventSim_run(&sim, LIFT_EVENT_TEST_HORIZON, calls, LIFT_EVENT_TEST_CALLS);
+
+        bool ok = (sim.tick == ref.tick) && (sim.ctx.pc == ref.ctx.pc) &&
+                  LiftState_equal(&sim.plant.state, &ref.plant.state) &&
+                  (sim.steps + sim.skipped == ref.steps);
+        printf("  - Scenario %-31u ... %s (%llu steps, %llu ticks skipped in %u parks)\n",
+               scenario, ok ? "OK" : "FAIL",
+               (unsigned long long)sim.steps, (unsigned long long)sim.skipped, sim.parks);
+        if (!ok)
+        {
+            printf("    > PC %u (expected %u), floor %u (expected %u)\n",
+                   sim.ctx.pc, ref.ctx.pc, sim.plant.state.floor, ref.plant.state.floor);
+        }
+        LIFT_ASSERT(ok);
+        passed += ok;
+        ++checked;
+    }
+
+    printf("[TEST] %zu/%zu scenarios matched.\n", passed, checked);
+}
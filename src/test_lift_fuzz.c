@@ -0,0 +1,112 @@
+/**
+ * @file test_lift_fuzz.c
+ * @brief Unit tests of the scenario fuzzer.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "seqnet_table.h"
+#include "lift_fuzz.h"
+#include "lift_assert.h"
+
+#define LIFT_FUZZ_TEST_SCENARIOS    (200000U)  // Scenarios per run
+#define LIFT_FUZZ_TEST_FLOORS       (6U)       // Floors of the fuzzed building
+#define LIFT_FUZZ_TEST_SEED         (0x1F0CACC1AULL)
+#define LIFT_FUZZ_TEST_THREADS      (4U)       // Worker threads of the threaded run
+
+/**
+ * @brief Fuzzes the loaded program and checks that failures replay from their seed.
+ */
+void LiftFuzzAllCases_test(void)
+{
+    printf("[TEST] Running LiftFuzz_run() cases...\n");
+
+    static SeqNetTable_t table;
+    SeqNetTable_build(&table, SeqNetProgram_get());
+
+    // Entry points of the default program: idle and door closing (as in the lift test cases)
+    static const uint8_t presets[] = { 0, 3 };
+
+    LiftFuzzConfig_t config = {
+        .floors = LIFT_FUZZ_TEST_FLOORS,
+        .steps = 64,
+        .service_bound = 256,
+        .injection_shift = 4,
+        .presets = presets,
+        .preset_count = sizeof(presets) / sizeof(presets[0])
+    };
+    LiftFuzzReport_t report;
+    size_t checked = 0;
+    size_t passed = 0;
+
+    // From its entry points, the default program keeps every invariant
+    uint64_t executed = LiftFuzz_run(&table, &config, LIFT_FUZZ_TEST_SEED, LIFT_FUZZ_TEST_SCENARIOS, &report);
+    bool ok = (report.verdict == LIFT_CHECK_OK) && (executed == LIFT_FUZZ_TEST_SCENARIOS);
+    printf("  - %-40s ... %s (%llu scenarios, %s)\n", "default program, entry PCs", ok ? "OK" : "FAIL",
+           (unsigned long long)executed, LiftCheckVerdict_name(report.verdict));
+    if (!ok)
+    {
+        printf("    > Seed 0x%llX, step %u\n", (unsigned long long)report.seed, report.step);
+    }
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+
+    // Too tight service bound, reported with the step the call became overdue
+    config.service_bound = 8;
+    executed = LiftFuzz_run(&table, &config, LIFT_FUZZ_TEST_SEED, LIFT_FUZZ_TEST_SCENARIOS, &report);
+    uint32_t replay_step = 0;
+    LiftCheckVerdict_t replay = LiftFuzz_scenario(&table, &config, report.seed, &replay_step);
+    ok = (report.verdict == LIFT_CHECK_SERVICE) && (replay == report.verdict) && (replay_step == report.step);
+    printf("  - %-40s ... %s (%s after %llu scenarios, seed 0x%llX, step %u)\n", "default program, service bound 8",
+           ok ? "OK" : "FAIL", LiftCheckVerdict_name(report.verdict), (unsigned long long)executed,
+           (unsigned long long)report.seed, report.step);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+    config.service_bound = 256;
+
+    // From an arbitrary PC (e.g. inside a move loop) the invariants can break: the
+    // failure must be found and must replay from its seed alone
+    config.presets = NULL;
+    config.preset_count = 0;
+    executed = LiftFuzz_run(&table, &config, LIFT_FUZZ_TEST_SEED, LIFT_FUZZ_TEST_SCENARIOS, &report);
+
+    replay = LiftFuzz_scenario(&table, &config, report.seed, &replay_step);
+    ok = (report.verdict != LIFT_CHECK_OK) && (replay == report.verdict) && (replay_step == report.step);
+    printf("  - %-40s ... %s (%s after %llu scenarios, seed 0x%llX, step %u)\n", "default program, any PC",
+           ok ? "OK" : "FAIL", LiftCheckVerdict_name(report.verdict), (unsigned long long)executed,
+           (unsigned long long)report.seed, report.step);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+
+    // The report of a threaded run is the lowest failing seed, the same as on one thread
+    LiftFuzzReport_t threaded;
+    config.threads = LIFT_FUZZ_TEST_THREADS;
+    const uint64_t executed_threaded = LiftFuzz_run(&table, &config, LIFT_FUZZ_TEST_SEED, LIFT_FUZZ_TEST_SCENARIOS, &threaded);
+    config.threads = 0;
+    ok = (executed_threaded == executed) && (threaded.verdict == report.verdict) &&
+         (threaded.seed == report.seed) && (threaded.step == report.step);
+    printf("  - %-40s ... %s (%u threads, seed 0x%llX)\n", "threaded run, same first failure", ok ? "OK" : "FAIL",
+           LIFT_FUZZ_TEST_THREADS, (unsigned long long)threaded.seed);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+
+    // Faulty program: the door is left open while moving up (PC 7)
+    static SeqNet_Program faulty;
+    memcpy(faulty.words, SeqNetProgram_get()->words, sizeof(faulty.words));
+    faulty.words[7] |= (uint16_t)(DOOR_REQ_OPEN << BIT_DOOR_STATE);
+    SeqNetProgram_decode(&faulty);
+    SeqNetTable_build(&table, &faulty);
+    config.presets = presets;
+    config.preset_count = sizeof(presets) / sizeof(presets[0]);
+
+    executed = LiftFuzz_run(&table, &config, LIFT_FUZZ_TEST_SEED, LIFT_FUZZ_TEST_SCENARIOS, &report);
+    ok = (report.verdict == LIFT_CHECK_DOOR_OPEN_MOVING);
+    printf("  - %-40s ... %s (%s after %llu scenarios)\n", "door open on move up", ok ? "OK" : "FAIL",
+           LiftCheckVerdict_name(report.verdict), (unsigned long long)executed);
+    LIFT_ASSERT(ok);
+    passed += ok; ++checked;
+
+    printf("[TEST] %zu/%zu fuzzing cases passed.\n", passed, checked);
+}
@@ -0,0 +1,151 @@
+/**
+ * @file test_lift_group.c
+ * @brief Unit tests of the group dispatcher.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "lift_group.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+#define LIFT_GROUP_TEST_CARS        (4U)       // Cars of the simulated bank
+#define LIFT_GROUP_TEST_STEPS       (200000U)  // Simulated steps
+#define LIFT_GROUP_TEST_CALL_PERIOD (16U * ((LIFT_MAX_FLOORS + 5U) / 6U))  // Mean steps between hall calls, below saturation
+#define LIFT_GROUP_TEST_BOUND       (256U + 32U * LIFT_MAX_FLOORS)  // Steps allowed to serve a hall call
+
+/// Weights of the default cost used by the tests
+static const LiftGroupWeights_t LiftGroupTest_weights = { .distance = 4, .reversal = 16, .load = 8 };
+
+/**
+ * @brief Cost function that always prefers the highest car.
+ */
+static uint32_t LiftGroupTest_highest(const LiftGroupCarView_t* car, uint16_t floor, const void* context)
+{
+    (void)floor;
+    (void)context;
+    return (uint32_t)(LIFT_MAX_FLOORS - 1U - car->floor);
+}
+
+/**
+ * @brief Checks that every pending hall call sits in the memory of its owner and the loads are exact.
+ */
+static bool LiftGroupTest_consistent(const LiftGroup_t* group)
+{
+    for (uint16_t f = 0; f < LIFT_MAX_FLOORS; ++f)
+    {
+        const uint8_t owner = group->owner[f];
+        if (LiftCalls_get(&group->hall, f) != (owner != LIFT_GROUP_NO_CAR)) return false;
+        if ((owner != LIFT_GROUP_NO_CAR) && !LiftCalls_get(&group->plant[owner].state.calls, f)) return false;
+    }
+    for (uint8_t i = 0; i < group->cars; ++i)
+    {
+        if (group->view[i].load != LiftCalls_count(&group->plant[i].state.calls)) return false;
+        if (group->view[i].floor != group->plant[i].state.floor) return false;
+    }
+
+    // Every pending call is listed once and its cached costs are up to date
+    if (group->pending_count != LiftCalls_count(&group->hall)) return false;
+    for (uint16_t k = 0; k < group->pending_count; ++k)
+    {
+        const uint16_t f = group->pending[k];
+        if (!LiftCalls_get(&group->hall, f) || (group->slot[f] != k)) return false;
+        for (uint8_t i = 0; i < group->cars; ++i)
+        {
+            LiftGroupCarView_t view = group->view[i];
+            view.load -= (uint16_t)((group->owner[f] == i) && !LiftCalls_get(&group->cabin[i], f));
+            if (group->costs[f][i] != group->cost(&view, f, group->cost_context)) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks call assignment, pluggable costs and a simulated bank of cars.
+ */
+void LiftGroupAllCases_test(void)
+{
+    printf("[TEST] Running LiftGroup_hallCall() cases...\n");
+
+    const SeqNet_Program* program = SeqNetProgram_get();
+    static LiftGroup_t group;
+    LiftState_t initial[LIFT_GROUP_TEST_CARS];
+    size_t passed = 0;
+    bool ok;
+
+    // Idle cars on floors 0, 1, 3 and 5
+    memset(initial, 0, sizeof(initial));
+    initial[1].floor = 1;
+    initial[2].floor = 3;
+    initial[3].floor = LIFT_MAX_FLOORS - 1U;
+
+    // The nearest car takes the call, a repeated call keeps its owner, the load steers the next one
+    LiftGroup_init(&group, program, LIFT_GROUP_TEST_CARS, initial, LiftGroupCost_default, &LiftGroupTest_weights);
+    ok = (LiftGroup_hallCall(&group, 2) == 1) && (LiftGroup_hallCall(&group, 2) == 1) && (group.dispatched == 1) &&
+         (LiftGroup_hallCall(&group, 1) == 0) && (group.view[1].load == 1) && LiftGroupTest_consistent(&group);
+    printf("  - %-40s ... %s\n", "nearest car, load and repeated call", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // A car call loads the owner: the call is handed over to the car standing next to it
+    LiftGroup_init(&group, program, LIFT_GROUP_TEST_CARS, initial, LiftGroupCost_default, &LiftGroupTest_weights);
+    ok = (LiftGroup_hallCall(&group, 2) == 1);
+    const uint64_t evaluations = group.evaluations;
+    LiftGroup_carCall(&group, 1, LIFT_MAX_FLOORS - 1U);
+    ok = ok && (group.owner[2] == 2) && (group.reassigned == 1) && (group.dispatched == 1) &&
+         !LiftCalls_get(&group.plant[1].state.calls, 2) && LiftCalls_get(&group.plant[2].state.calls, 2) &&
+         (group.evaluations - evaluations <= 3U) && LiftGroupTest_consistent(&group);
+    printf("  - %-40s ... %s\n", "reassignment to a cheaper car", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // Pluggable cost
+    LiftGroup_init(&group, program, LIFT_GROUP_TEST_CARS, initial, LiftGroupTest_highest, NULL);
+    ok = (LiftGroup_hallCall(&group, 0) == LIFT_GROUP_TEST_CARS - 1U) && LiftGroupTest_consistent(&group);
+    printf("  - %-40s ... %s\n", "custom cost function", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // Random hall and car calls: every hall call is served by its owner within the bound
+    static uint32_t since[LIFT_MAX_FLOORS];
+    uint32_t seed = 0x6A7EU;
+    uint32_t worst = 0;
+    LiftGroup_init(&group, program, LIFT_GROUP_TEST_CARS, initial, LiftGroupCost_default, &LiftGroupTest_weights);
+    ok = true;
+    for (uint32_t step = 0; ok && (step < LIFT_GROUP_TEST_STEPS); ++step)
+    {
+        LiftRandom_next32(&seed);
+        const uint16_t floor = (uint16_t)((seed >> 16) % LIFT_MAX_FLOORS);
+        if (((seed >> 8) % LIFT_GROUP_TEST_CALL_PERIOD) == 0)
+        {
+            if (group.owner[floor] == LIFT_GROUP_NO_CAR)
+            {
+                since[floor] = step;
+            }
+            LiftGroup_hallCall(&group, floor);
+        }
+        else if (((seed >> 8) % (16U * LIFT_GROUP_TEST_CALL_PERIOD)) == 1U)
+        {
+            LiftGroup_carCall(&group, (uint8_t)((seed >> 4) % LIFT_GROUP_TEST_CARS), floor);
+        }
+
+        LiftGroup_step(&group);
+        for (uint16_t f = 0; f < LIFT_MAX_FLOORS; ++f)
+        {
+            if (LiftCalls_get(&group.hall, f) && (step - since[f] > worst))
+            {
+                worst = step - since[f];
+            }
+        }
+        ok = LiftGroupTest_consistent(&group) && (worst <= LIFT_GROUP_TEST_BOUND);
+    }
+    ok = ok && (group.dispatched > 0) && (group.served + LiftCalls_count(&group.hall) == group.dispatched);
+    printf("  - %-40s ... %s (%llu calls, %llu reassigned, longest wait %u steps)\n", "simulated bank of cars",
+           ok ? "OK" : "FAIL", (unsigned long long)group.dispatched, (unsigned long long)group.reassigned, worst);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/4 group cases passed.\n", passed);
+}
@@ -0,0 +1,270 @@
+/**
+ * @file test_lift_motion.c
+ * @brief Unit tests of the continuous-time plant.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_batch.h"
+#include "seqnet_internal.h"
+#include "lift_motion.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+#define LIFT_MOTION_TEST_FLOORS     ((LIFT_MAX_FLOORS < 16U) ? LIFT_MAX_FLOORS : 16U)  // Building of the tests
+#define LIFT_MOTION_TEST_CARS       (1027U)         // Cars of a bank (not a multiple of 8: scalar tail)
+#define LIFT_MOTION_TEST_KERNEL_STEPS (6000U)       // Integration steps of the kernel cross-check (one minute)
+#define LIFT_MOTION_TEST_SERVICE    (60000U)        // Step bound of serving the calls of a bank (10 minutes)
+#define LIFT_MOTION_TEST_ORDER      (64U)           // Served floors recorded per car
+
+static float LiftMotionTest_position[LIFT_MOTION_TEST_CARS];
+static float LiftMotionTest_velocity[LIFT_MOTION_TEST_CARS];
+static float LiftMotionTest_accel[LIFT_MOTION_TEST_CARS];
+static float LiftMotionTest_target[LIFT_MOTION_TEST_CARS];
+static float LiftMotionTest_door[LIFT_MOTION_TEST_CARS];
+static float LiftMotionTest_doorRate[LIFT_MOTION_TEST_CARS];
+static float LiftMotionTest_dwell[LIFT_MOTION_TEST_CARS];
+static int8_t LiftMotionTest_direction[LIFT_MOTION_TEST_CARS];
+static LiftInputs_t LiftMotionTest_plant[LIFT_MOTION_TEST_CARS];
+static CondSel_Mask LiftMotionTest_in[LIFT_MOTION_TEST_CARS];
+
+static const LiftMotionArrays_t LiftMotionTest_arrays = {
+    .position = LiftMotionTest_position, .velocity = LiftMotionTest_velocity, .accel = LiftMotionTest_accel,
+    .target = LiftMotionTest_target, .door = LiftMotionTest_door, .door_rate = LiftMotionTest_doorRate,
+    .dwell = LiftMotionTest_dwell, .direction = LiftMotionTest_direction, .plant = LiftMotionTest_plant,
+    .in = LiftMotionTest_in
+};
+
+/**
+ * @brief Uniform float in [lo, hi).
+ */
+static float LiftMotionTest_uniform(uint32_t* state, float lo, float hi)
+{
+    return lo + (hi - lo) * (float)(LiftRandom_next32(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Integrates random states with every kernel, the results must be bit-identical.
+ */
+static bool LiftMotionTest_kernels(const LiftMotionParams_t* params)
+{
+    static float reference[7][LIFT_MOTION_TEST_CARS];
+    float* const lanes[7] = {
+        LiftMotionTest_position, LiftMotionTest_velocity, LiftMotionTest_accel, LiftMotionTest_target,
+        LiftMotionTest_door, LiftMotionTest_doorRate, LiftMotionTest_dwell
+    };
+    const SeqNetBatchKernel_t kernels[] = { SEQNET_BATCH_KERNEL_SCALAR, SEQNET_BATCH_KERNEL_SSE41, SEQNET_BATCH_KERNEL_AVX2 };
+    LiftMotion_t motion;
+    bool ok = true;
+
+    LiftMotion_init(&motion, params, &LiftMotionTest_arrays, LIFT_MOTION_TEST_CARS);
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k)
+    {
+        // Same random cars for every kernel: moving, braking, levelling, doors in travel
+        uint32_t seed = 0x3E7A11FU;
+        const float top = (float)(params->floors - 1U) * params->floor_height;
+        for (uint32_t i = 0; i < LIFT_MOTION_TEST_CARS; ++i)
+        {
+            LiftMotionTest_position[i] = LiftMotionTest_uniform(&seed, 0.0f, top);
+            LiftMotionTest_velocity[i] = LiftMotionTest_uniform(&seed, -params->max_speed, params->max_speed);
+            LiftMotionTest_accel[i] = LiftMotionTest_uniform(&seed, -params->max_accel, params->max_accel);
+            LiftMotionTest_target[i] = (float)(LiftRandom_next32(&seed) % params->floors) * params->floor_height;
+            LiftMotionTest_door[i] = LiftMotionTest_uniform(&seed, 0.0f, 1.0f);
+            LiftMotionTest_doorRate[i] = ((LiftRandom_next32(&seed) & 1U) ? 1.0f : -1.0f) / params->door_time;
+            LiftMotionTest_dwell[i] = LiftMotionTest_uniform(&seed, 0.0f, params->door_dwell);
+        }
+
+        LiftMotion_select(&motion, kernels[k]);
+        for (uint32_t step = 0; step < LIFT_MOTION_TEST_KERNEL_STEPS; ++step)
+        {
+            LiftMotion_integrate(&motion);
+        }
+
+        for (size_t lane = 0; lane < 7U; ++lane)
+        {
+            if (k == 0)
+            {
+                memcpy(reference[lane], lanes[lane], sizeof(reference[lane]));
+            }
+            else if (memcmp(reference[lane], lanes[lane], sizeof(reference[lane])) != 0)
+            {
+                ok = false;
+            }
+        }
+
+        // After the run every car is levelled at its target
+        for (uint32_t i = 0; i < LIFT_MOTION_TEST_CARS; ++i)
+        {
+            ok = ok && (LiftMotionTest_position[i] == LiftMotionTest_target[i]) && (LiftMotionTest_velocity[i] == 0.0f);
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Drives one car from floor 0 to a call, checking the limits of every step.
+ *
+ * @return Travel time in seconds, or a negative value on a violated limit.
+ */
+static float LiftMotionTest_trip(const LiftMotionParams_t* params, uint16_t floor)
+{
+    const float slack = 1e-4f;
+    const uint16_t run = (uint16_t)((1U << BIT_MOVE_UP) | (DOOR_REQ_CLOSE << BIT_DOOR_STATE));
+    const float target = (float)floor * params->floor_height;
+    LiftState_t state = { .floor = 0, .is_door_open = false, .is_moving = false, .calls = LIFT_CALLS_NONE };
+    LiftCalls_set(&state.calls, floor);
+    LiftMotion_t motion;
+
+    LiftMotion_init(&motion, params, &LiftMotionTest_arrays, 1U);
+    LiftMotion_place(&motion, 0, &state);
+    LiftMotion_step(&motion, &run);
+    if (LiftMotionTest_direction[0] != 1) return -1.0f;
+
+    uint32_t steps = 1;
+    float accel = LiftMotionTest_accel[0];
+    while ((LiftMotionTest_direction[0] != 0) && (steps < LIFT_MOTION_TEST_SERVICE))
+    {
+        LiftMotion_step(&motion, &run);
+        steps++;
+
+        const float v = LiftMotionTest_velocity[0];
+        const float a = LiftMotionTest_accel[0];
+        const float jerk = (a - accel) / params->dt;
+        const bool levelled = (v == 0.0f) && (a == 0.0f);
+        if ((v > params->max_speed + slack) || (v < -slack) ||
+            (a > params->max_accel + slack) || (a < -params->max_accel - slack) ||
+            (!levelled && ((jerk > params->max_jerk + 0.01f) || (jerk < -params->max_jerk - 0.01f))) ||
+            (LiftMotionTest_position[0] > target + params->level_tolerance) || (LiftMotionTest_door[0] != 0.0f))
+        {
+            return -1.0f;
+        }
+        accel = a;
+    }
+
+    const bool arrived = (LiftMotionTest_position[0] == target) && (LiftMotionTest_plant[0].state.floor == floor) &&
+                         ((LiftMotionTest_in[0] & CONDSEL_MASK_SAME) != 0);
+    return arrived ? (float)steps * params->dt : -1.0f;
+}
+
+/**
+ * @brief Serves random calls of a bank with the batch engine and compares the order with the step plant.
+ */
+static bool LiftMotionTest_service(const LiftMotionParams_t* params, uint32_t* steps)
+{
+    static uint8_t pc[LIFT_MOTION_TEST_CARS];
+    static uint16_t out[LIFT_MOTION_TEST_CARS];
+    static uint16_t order[LIFT_MOTION_TEST_CARS][LIFT_MOTION_TEST_ORDER];
+    static uint8_t served[LIFT_MOTION_TEST_CARS];
+    static LiftState_t initial[LIFT_MOTION_TEST_CARS];
+    static SeqNetBatch_t batch;
+    const SeqNet_Program* program = SeqNetProgram_get();
+    LiftMotion_t motion;
+    uint32_t seed = 0xD00B5U;
+    bool ok = true;
+
+    LiftMotion_init(&motion, params, &LiftMotionTest_arrays, LIFT_MOTION_TEST_CARS);
+    for (uint32_t i = 0; i < LIFT_MOTION_TEST_CARS; ++i)
+    {
+        initial[i] = (LiftState_t){ .floor = (uint16_t)(LiftRandom_next32(&seed) % params->floors),
+                                    .is_door_open = false, .is_moving = false, .calls = LIFT_CALLS_NONE };
+        for (uint16_t f = 0; f < params->floors; ++f)
+        {
+            LiftCalls_assign(&initial[i].calls, f, (LiftRandom_next32(&seed) & 3U) == 0);
+        }
+        LiftMotion_place(&motion, i, &initial[i]);
+        pc[i] = 0;
+        served[i] = 0;
+    }
+    SeqNetBatch_init(&batch, program, pc, LiftMotionTest_in, out, LIFT_MOTION_TEST_CARS);
+
+    // Continuous plant: record the floor of every served call
+    uint32_t pending = LIFT_MOTION_TEST_CARS;
+    uint32_t step = 0;
+    for (; (step < LIFT_MOTION_TEST_SERVICE) && (pending != 0); ++step)
+    {
+        SeqNetBatch_step(&batch);
+        pending = 0;
+        for (uint32_t i = 0; i < LIFT_MOTION_TEST_CARS; ++i)
+        {
+            const LiftInputs_t* plant = &LiftMotionTest_plant[i];
+            if (((out[i] >> BIT_REQ_RESET) & 1U) && (LiftMotionTest_direction[i] == 0) && plant->in.call_pending_same &&
+                (served[i] < LIFT_MOTION_TEST_ORDER))
+            {
+                order[i][served[i]++] = plant->state.floor;
+            }
+
+            // The door is closed whenever the car runs
+            ok = ok && ((LiftMotionTest_direction[i] == 0) || (LiftMotionTest_door[i] == 0.0f));
+            pending += (LiftCalls_count(&plant->state.calls) != 0);
+        }
+        LiftMotion_step(&motion, out);
+    }
+    *steps = step;
+    ok = ok && (pending == 0);
+
+    // Step plant: the same controller serves the calls in the same order
+    for (uint32_t i = 0; ok && (i < LIFT_MOTION_TEST_CARS); ++i)
+    {
+        SeqNet_Ctx ctx;
+        LiftInputs_t plant;
+        uint32_t count = 0;
+
+        SeqNet_ctxInit(&ctx, program);
+        LiftInputs_init(&plant, &initial[i]);
+        for (uint32_t n = 0; (n < LIFT_MOTION_TEST_SERVICE) && (LiftCalls_count(&plant.state.calls) != 0); ++n)
+        {
+            const SeqNet_Out o = SeqNet_ctxStep(&ctx, &plant.in);
+            if (o.req_reset && plant.in.call_pending_same)
+            {
+                ok = ok && (count < served[i]) && (order[i][count] == plant.state.floor);
+                count++;
+            }
+            LiftInputs_apply(&plant, &o);
+        }
+        ok = ok && (count == served[i]);
+    }
+    return ok;
+}
+
+/**
+ * @brief Cross-checks the integration kernels, the trip limits and the service order of the continuous-time plant.
+ */
+void LiftMotionAllCases_test(void)
+{
+    printf("[TEST] Running LiftMotion_step() cases...\n");
+
+    LiftMotionParams_t params;
+    LiftMotionParams_default(&params, LIFT_MOTION_TEST_FLOORS);
+    size_t passed = 0;
+    bool ok;
+
+    ok = LiftMotionTest_kernels(&params);
+    printf("  - %-40s ... %s\n", "kernels integrate bit-identically", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // One floor, a few floors, the whole building: limits hold, the car levels at the call
+    const uint16_t trips[] = { 1U, (uint16_t)((LIFT_MOTION_TEST_FLOORS > 3U) ? 3U : 1U), (uint16_t)(LIFT_MOTION_TEST_FLOORS - 1U) };
+    float times[3];
+    ok = true;
+    for (size_t t = 0; t < 3U; ++t)
+    {
+        times[t] = LiftMotionTest_trip(&params, trips[t]);
+        const float bound = (float)trips[t] * params.floor_height / params.max_speed + 6.0f;
+        ok = ok && (times[t] > 0.0f) && (times[t] < bound);
+    }
+    printf("  - %-40s ... %s (%.2f s / %.2f s / %.2f s)\n", "trips within speed, accel and jerk", ok ? "OK" : "FAIL",
+           (double)times[0], (double)times[1], (double)times[2]);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    uint32_t steps = 0;
+    ok = LiftMotionTest_service(&params, &steps);
+    printf("  - %-40s ... %s (%u cars, %.1f s)\n", "bank serves calls in step plant order", ok ? "OK" : "FAIL",
+           LIFT_MOTION_TEST_CARS, (double)((float)steps * params.dt));
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/3 motion cases passed.\n", passed);
+}
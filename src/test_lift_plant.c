@@ -0,0 +1,144 @@
+/**
+ * @file test_lift_plant.c
+ * @brief Unit tests of the lift plant and its call bitset.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "lift_plant.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+#define LIFT_PLANT_TEST_STATES      (100000U)  // Random states compared with the reference scan
+#define LIFT_PLANT_TEST_UPDATES     (200000U)  // Random tracker updates compared with a full rebuild
+
+/**
+ * @brief Reference condition inputs: scans the calls floor by floor.
+ */
+static void LiftPlantTest_convert(const LiftState_t* state, CondSel_In* out)
+{
+    out->door_closed = !state->is_door_open;
+    out->door_open = state->is_door_open;
+    out->call_pending_below = false;
+    out->call_pending_same  = false;
+    out->call_pending_above = false;
+
+    for (uint16_t i = 0; i < LIFT_MAX_FLOORS; ++i)
+    {
+        if (!LiftCalls_get(&state->calls, i)) continue;
+        if (i < state->floor)
+            out->call_pending_below = true;
+        else if (i == state->floor)
+            out->call_pending_same = true;
+        else
+            out->call_pending_above = true;
+    }
+}
+
+/**
+ * @brief Compares the bitset condition inputs with a floor by floor scan on random states.
+ */
+void LiftPlantAllCases_test(void)
+{
+    printf("[TEST] Running LiftStateArray_convert() and LiftInputs_*() cases...\n");
+
+    LiftState_t state;
+    CondSel_In actual, expected;
+    uint32_t seed = 0x5EEDU;
+    uint32_t matched = 0;
+    size_t passed = 0;
+    bool ok;
+
+    // Sparse random calls (at most 3 floors), floors up to one past the top
+    for (uint32_t i = 0; i < LIFT_PLANT_TEST_STATES; ++i)
+    {
+        memset(&state, 0, sizeof(state));
+        LiftRandom_next32(&seed);
+        state.floor = (uint16_t)((seed >> 8) % (LIFT_MAX_FLOORS + 1U));
+        state.is_door_open = (seed & 1U) != 0;
+        for (uint32_t c = 0; c < ((seed >> 4) & 3U); ++c)
+        {
+            LiftRandom_next32(&seed);
+            LiftCalls_set(&state.calls, (uint16_t)((seed >> 8) % LIFT_MAX_FLOORS));
+        }
+
+        LiftStateArray_convert(&state, &actual);
+        LiftPlantTest_convert(&state, &expected);
+        matched += (CondSel_pack(&actual) == CondSel_pack(&expected));
+    }
+    ok = (matched == LIFT_PLANT_TEST_STATES);
+    printf("  - %-40s ... %s (%u/%u states, %u floors)\n", "bitset inputs equal floor scan", ok ? "OK" : "FAIL",
+           matched, LIFT_PLANT_TEST_STATES, (unsigned)LIFT_MAX_FLOORS);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // Count, format and the reset of the plant on the top floor
+    char text[LIFT_CALLS_TEXT_SIZE];
+    const uint16_t top = (uint16_t)(LIFT_MAX_FLOORS - 1U);
+    const SeqNet_Out reset = { .req_reset = true, .req_door_state = true };
+    memset(&state, 0, sizeof(state));
+    LiftCalls_set(&state.calls, 0);
+    LiftCalls_set(&state.calls, top);
+    LiftCalls_format(&state.calls, text);
+    ok = (LiftCalls_count(&state.calls) == ((top == 0) ? 1U : 2U)) && (strlen(text) == 3U * LIFT_MAX_FLOORS - 2U) &&
+         (text[0] == '1') && (text[strlen(text) - 1U] == '1');
+    state.floor = top;
+    LiftPlant_apply(&state, &reset);
+    ok = ok && !LiftCalls_get(&state.calls, top) && (LiftCalls_count(&state.calls) == ((top == 0) ? 0U : 1U));
+    printf("  - %-40s ... %s\n", "count, format and reset", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // Random hook sequences, the car also leaves the floor range in both directions
+    LiftInputs_t inputs;
+    memset(&state, 0, sizeof(state));
+    LiftInputs_init(&inputs, &state);
+    matched = 0;
+    for (uint32_t i = 0; i < LIFT_PLANT_TEST_UPDATES; ++i)
+    {
+        LiftRandom_next32(&seed);
+        const uint32_t r = seed >> 8;
+        switch (r & 7U)
+        {
+            case 0: case 1: LiftInputs_callSet(&inputs, (uint16_t)((r >> 3) % LIFT_MAX_FLOORS)); break;
+            case 2:         LiftInputs_callReset(&inputs); break;
+            case 3: case 4: LiftInputs_floorUp(&inputs); break;
+            case 5: case 6: LiftInputs_floorDown(&inputs); break;
+            default:        LiftInputs_door(&inputs, ((r >> 3) & 1U) != 0); break;
+        }
+        if ((inputs.state.floor > LIFT_MAX_FLOORS + 2U) && (inputs.state.floor < 0xFFF0U))
+        {
+            inputs.state.floor = 0;  // Back into the building, through the init path
+            LiftInputs_init(&inputs, &inputs.state);
+        }
+
+        LiftStateArray_convert(&inputs.state, &expected);
+        matched += (CondSel_pack(&inputs.in) == CondSel_pack(&expected));
+    }
+    ok = (matched == LIFT_PLANT_TEST_UPDATES);
+    printf("  - %-40s ... %s (%u/%u updates)\n", "tracked inputs equal rebuild", ok ? "OK" : "FAIL",
+           matched, LIFT_PLANT_TEST_UPDATES);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // The bitset leaves padding in LiftState_t: equality compares the fields, not the bytes
+    LiftState_t a, b;
+    memset(&a, 0xA5, sizeof(a));
+    memset(&b, 0x5A, sizeof(b));
+    a.floor = b.floor = top;
+    a.is_door_open = b.is_door_open = true;
+    a.is_moving = b.is_moving = false;
+    memset(&a.calls, 0, sizeof(a.calls));
+    memset(&b.calls, 0, sizeof(b.calls));
+    LiftCalls_set(&a.calls, 0);
+    LiftCalls_set(&b.calls, 0);
+    ok = LiftState_equal(&a, &b);
+    b.calls.words[0] ^= 1U;
+    ok = ok && !LiftState_equal(&a, &b);
+    printf("  - %-40s ... %s (%u padding bytes)\n", "state equality ignores padding", ok ? "OK" : "FAIL",
+           (unsigned)(sizeof(LiftState_t) - sizeof(LiftCalls_t) - sizeof(uint16_t) - 2U * sizeof(bool)));
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/4 plant cases passed.\n", passed);
+}
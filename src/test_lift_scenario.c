@@ -0,0 +1,383 @@
+/**
+ * @file test_lift_scenario.c
+ * @brief Unit tests of the scenario files and the streaming runner.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "lift_scenario.h"
+#include "lift_plant.h"
+#include "test_lift.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+#define LIFT_SCENARIO_TEST_GENERATED  (1U << 18)  // Scenarios of the streaming case
+#define LIFT_SCENARIO_TEST_TEXT       (1U << 14)  // Of them also written as text
+#define LIFT_SCENARIO_TEST_BATCH      (256U)      // Scenarios per batch of the runner
+#define LIFT_SCENARIO_TEST_THREADS    (4U)        // Workers of the runner
+#define LIFT_SCENARIO_TEST_FAILED     (123457U)   // Scenario with a wrong end state in the streaming case
+
+static LiftScenario_t LiftScenarioTest_batch[LIFT_SCENARIO_TEST_BATCH];
+static LiftScenarioReader_t LiftScenarioTest_reader;
+static LiftScenario_t LiftScenarioTest_scenario;
+static LiftScenario_t LiftScenarioTest_read;
+
+/// Compiled-in scenario suite (@see LiftTestAll_run)
+static const LiftTestCase_t* const LiftScenarioTest_cases[] = {
+    &test_case_already_open, &test_case_open_door_same_floor, &test_case_move_down, &test_case_move_up,
+    &test_case_multiple_calls, &test_case_idle, &test_case_reopen_during_close, &test_case_bottom_to_top,
+    &test_case_middle_stop, &test_case_up_two_floors, &test_case_down_two_floors, &test_case_all_calls
+};
+
+#define LIFT_SCENARIO_TEST_CASES (sizeof(LiftScenarioTest_cases) / sizeof(LiftScenarioTest_cases[0]))
+
+/**
+ * @brief Converts a compiled-in test case into a scenario without injections.
+ */
+static void LiftScenarioTest_convert(const LiftTestCase_t* test, LiftScenario_t* scenario)
+{
+    memset(scenario, 0, sizeof(LiftScenario_t));
+    scenario->initial_state = test->initial_state;
+    scenario->end_state = test->end_state;
+    scenario->steps = test->steps;
+    scenario->PC_preset = test->PC_preset;
+}
+
+/**
+ * @brief Compares every stored field of two scenarios.
+ */
+static bool LiftScenarioTest_equal(const LiftScenario_t* a, const LiftScenario_t* b)
+{
+    bool equal = LiftState_equal(&a->initial_state, &b->initial_state) && LiftState_equal(&a->end_state, &b->end_state) &&
+                 (a->steps == b->steps) && (a->PC_preset == b->PC_preset) && (a->injection_count == b->injection_count);
+    for (uint32_t i = 0; equal && (i < a->injection_count); ++i)
+    {
+        equal = (a->injections[i].tick == b->injections[i].tick) && (a->injections[i].floor == b->injections[i].floor);
+    }
+    return equal;
+}
+
+/**
+ * @brief Opens a scratch file holding @p text.
+ */
+static FILE* LiftScenarioTest_file(const void* data, size_t size)
+{
+    FILE* file = tmpfile();
+    if (file == NULL) return NULL;
+    if (fwrite(data, 1, size, file) != size)
+    {
+        fclose(file);
+        return NULL;
+    }
+    rewind(file);
+    return file;
+}
+
+/**
+ * @brief The compiled-in suite survives both formats and passes from the files.
+ */
+static bool LiftScenarioTest_suite(void)
+{
+    bool ok = true;
+
+    for (int format = LIFT_SCENARIO_TEXT; ok && (format <= LIFT_SCENARIO_BINARY); ++format)
+    {
+        FILE* file = tmpfile();
+        LiftScenarioWriter_t writer;
+        ok = (file != NULL) && (LiftScenarioWriter_begin(&writer, file, (LiftScenarioFormat_t)format) == LIFT_SCENARIO_OK);
+        for (size_t i = 0; ok && (i < LIFT_SCENARIO_TEST_CASES); ++i)
+        {
+            LiftScenarioTest_convert(LiftScenarioTest_cases[i], &LiftScenarioTest_scenario);
+            ok = (LiftScenarioWriter_add(&writer, &LiftScenarioTest_scenario) == LIFT_SCENARIO_OK);
+        }
+        ok = ok && (LiftScenarioWriter_end(&writer) == LIFT_SCENARIO_OK);
+
+        // Read back field by field
+        if (file != NULL) rewind(file);
+        ok = ok && (LiftScenarioReader_begin(&LiftScenarioTest_reader, file) == LIFT_SCENARIO_OK) &&
+             (LiftScenarioTest_reader.format == (LiftScenarioFormat_t)format);
+        for (size_t i = 0; ok && (i < LIFT_SCENARIO_TEST_CASES); ++i)
+        {
+            LiftScenarioTest_convert(LiftScenarioTest_cases[i], &LiftScenarioTest_scenario);
+            ok = (LiftScenarioReader_next(&LiftScenarioTest_reader, &LiftScenarioTest_read) == LIFT_SCENARIO_OK) &&
+                 LiftScenarioTest_equal(&LiftScenarioTest_scenario, &LiftScenarioTest_read);
+        }
+        ok = ok && (LiftScenarioReader_next(&LiftScenarioTest_reader, &LiftScenarioTest_read) == LIFT_SCENARIO_END);
+
+        // Run from the file
+        LiftScenarioReport_t report;
+        if (file != NULL) rewind(file);
+        ok = ok && (LiftScenarioReader_begin(&LiftScenarioTest_reader, file) == LIFT_SCENARIO_OK) &&
+             LiftScenario_stream(&LiftScenarioTest_reader, SeqNetProgram_get(), LiftScenarioTest_batch, 5, 2, &report) &&
+             (report.count == LIFT_SCENARIO_TEST_CASES) && (report.first_failed == UINT64_MAX);
+
+        if (file != NULL) fclose(file);
+    }
+    return ok;
+}
+
+/**
+ * @brief Calls injected at their ticks change the outcome of an idle lift.
+ */
+static bool LiftScenarioTest_injections(void)
+{
+    static const char text[] =
+        "# Idle lift on the ground floor called to floor 3, then to floor 1 on the way back\n"
+        "0 60 | 0 open idle - | 1 open idle - | 2:3 30:1   # both calls served\n"
+        "\n"
+        "0 60 | 0 open idle - | 0 open idle -              # no call, no trip\n"
+        "0 60 | 0 open idle - | 0 open idle - | 70:3       # the call arrives after the end\n";
+
+    FILE* file = LiftScenarioTest_file(text, sizeof(text) - 1U);
+    LiftScenarioResult_t result;
+    bool ok = (file != NULL) && (LiftScenarioReader_begin(&LiftScenarioTest_reader, file) == LIFT_SCENARIO_OK);
+
+    ok = ok && (LiftScenarioReader_next(&LiftScenarioTest_reader, &LiftScenarioTest_scenario) == LIFT_SCENARIO_OK) &&
+         (LiftScenarioTest_scenario.injection_count == 2) && (LiftScenarioTest_reader.line == 2) &&
+         LiftScenario_run(&LiftScenarioTest_scenario, SeqNetProgram_get(), &result);
+
+    // Without the injections the same scenario stays on the ground floor
+    LiftScenarioTest_scenario.injection_count = 0;
+    ok = ok && !LiftScenario_run(&LiftScenarioTest_scenario, SeqNetProgram_get(), &result) && (result.end_state.floor == 0);
+
+    for (uint32_t i = 0; ok && (i < 2); ++i)
+    {
+        ok = (LiftScenarioReader_next(&LiftScenarioTest_reader, &LiftScenarioTest_scenario) == LIFT_SCENARIO_OK) &&
+             LiftScenario_run(&LiftScenarioTest_scenario, SeqNetProgram_get(), &result);
+    }
+    ok = ok && (LiftScenarioTest_reader.line == 5) &&
+         (LiftScenarioReader_next(&LiftScenarioTest_reader, &LiftScenarioTest_scenario) == LIFT_SCENARIO_END);
+
+    if (file != NULL) fclose(file);
+    return ok;
+}
+
+/**
+ * @brief Generates a random scenario, its end state is simulated.
+ */
+static void LiftScenarioTest_generate(uint32_t* seed, LiftScenario_t* scenario)
+{
+    const uint32_t floors = (LIFT_MAX_FLOORS < 16U) ? LIFT_MAX_FLOORS : 16U;
+    LiftScenarioResult_t result;
+
+    memset(scenario, 0, sizeof(LiftScenario_t));
+    scenario->initial_state.floor = (uint16_t)(LiftRandom_next32(seed) % floors);
+    scenario->initial_state.is_door_open = (LiftRandom_next32(seed) & 1U) != 0;
+    const uint32_t calls = LiftRandom_next32(seed);
+    for (uint16_t f = 0; f < floors; ++f)
+    {
+        LiftCalls_assign(&scenario->initial_state.calls, f, ((calls >> f) & 1U) != 0);
+    }
+    scenario->steps = 1U + LiftRandom_next32(seed) % LIFT_TEST_MAX_STEPS;
+    scenario->PC_preset = (uint8_t)((LiftRandom_next32(seed) & 1U) ? 3U : 0U);
+
+    // Every second scenario gets injections, ordered by tick
+    const uint32_t injections = (LiftRandom_next32(seed) & 1U) ? 1U + LiftRandom_next32(seed) % 4U : 0U;
+    uint32_t tick = 0;
+    for (uint32_t i = 0; i < injections; ++i)
+    {
+        tick += LiftRandom_next32(seed) % 32U;
+        scenario->injections[i].tick = tick;
+        scenario->injections[i].floor = (uint16_t)(LiftRandom_next32(seed) % floors);
+    }
+    scenario->injection_count = (uint16_t)injections;
+
+    LiftScenario_run(scenario, SeqNetProgram_get(), &result);
+    scenario->end_state = result.end_state;
+}
+
+/**
+ * @brief Streams a large generated file through the parallel runner in a small batch.
+ */
+static bool LiftScenarioTest_stream(LiftScenarioReport_t* report, uint32_t* bytes)
+{
+    FILE* binary = tmpfile();
+    FILE* text = tmpfile();
+    LiftScenarioWriter_t binary_writer;
+    LiftScenarioWriter_t text_writer;
+    uint32_t seed = 0xC0FFEEU;
+    uint32_t matched = 0;
+
+    bool ok = (binary != NULL) && (text != NULL) &&
+              (LiftScenarioWriter_begin(&binary_writer, binary, LIFT_SCENARIO_BINARY) == LIFT_SCENARIO_OK) &&
+              (LiftScenarioWriter_begin(&text_writer, text, LIFT_SCENARIO_TEXT) == LIFT_SCENARIO_OK);
+    for (uint32_t i = 0; ok && (i < LIFT_SCENARIO_TEST_GENERATED); ++i)
+    {
+        LiftScenarioTest_generate(&seed, &LiftScenarioTest_scenario);
+
+        // Without injections the runner must agree with the test case executor
+        if ((LiftScenarioTest_scenario.injection_count == 0) && (i < LIFT_SCENARIO_TEST_TEXT))
+        {
+            LiftTestCase_t test;
+            LiftTestResult_t result;
+            memset(&test, 0, sizeof(test));
+            test.initial_state = LiftScenarioTest_scenario.initial_state;
+            test.end_state = LiftScenarioTest_scenario.end_state;
+            test.steps = (uint8_t)LiftScenarioTest_scenario.steps;
+            test.PC_preset = LiftScenarioTest_scenario.PC_preset;
+            ok = LiftTestCase_exec(&test, SeqNetProgram_get(), &result);
+            matched += ok;
+        }
+
+        if (i == LIFT_SCENARIO_TEST_FAILED)
+        {
+            LiftScenarioTest_scenario.end_state.is_door_open = !LiftScenarioTest_scenario.end_state.is_door_open;
+        }
+        ok = ok && (LiftScenarioWriter_add(&binary_writer, &LiftScenarioTest_scenario) == LIFT_SCENARIO_OK);
+        if (i < LIFT_SCENARIO_TEST_TEXT)
+        {
+            ok = ok && (LiftScenarioWriter_add(&text_writer, &LiftScenarioTest_scenario) == LIFT_SCENARIO_OK);
+        }
+    }
+    ok = ok && (matched > 0) && (LiftScenarioWriter_end(&binary_writer) == LIFT_SCENARIO_OK) &&
+         (LiftScenarioWriter_end(&text_writer) == LIFT_SCENARIO_OK);
+    *bytes = (binary != NULL) ? (uint32_t)ftell(binary) : 0;
+
+    // Binary: every scenario but the corrupted one passes
+    if (binary != NULL) rewind(binary);
+    ok = ok && (LiftScenarioReader_begin(&LiftScenarioTest_reader, binary) == LIFT_SCENARIO_OK) &&
+         !LiftScenario_stream(&LiftScenarioTest_reader, SeqNetProgram_get(), LiftScenarioTest_batch,
+                              LIFT_SCENARIO_TEST_BATCH, LIFT_SCENARIO_TEST_THREADS, report) &&
+         (report->status == LIFT_SCENARIO_END) && (report->count == LIFT_SCENARIO_TEST_GENERATED) &&
+         (report->passed == LIFT_SCENARIO_TEST_GENERATED - 1U) && (report->first_failed == LIFT_SCENARIO_TEST_FAILED);
+
+    // Text prefix: the same scenarios, on one thread
+    LiftScenarioReport_t text_report;
+    if (text != NULL) rewind(text);
+    ok = ok && (LiftScenarioReader_begin(&LiftScenarioTest_reader, text) == LIFT_SCENARIO_OK) &&
+         LiftScenario_stream(&LiftScenarioTest_reader, SeqNetProgram_get(), LiftScenarioTest_batch,
+                             LIFT_SCENARIO_TEST_BATCH, 1, &text_report) &&
+         (text_report.count == LIFT_SCENARIO_TEST_TEXT);
+
+    if (binary != NULL) fclose(binary);
+    if (text != NULL) fclose(text);
+    return ok;
+}
+
+/**
+ * @brief Reads a malformed file and expects the given status at the given line.
+ */
+static bool LiftScenarioTest_reject(const void* data, size_t size, LiftScenarioStatus_t expected, uint32_t line)
+{
+    FILE* file = LiftScenarioTest_file(data, size);
+    if (file == NULL) return false;
+
+    LiftScenarioStatus_t status = LiftScenarioReader_begin(&LiftScenarioTest_reader, file);
+    while (status == LIFT_SCENARIO_OK)
+    {
+        status = LiftScenarioReader_next(&LiftScenarioTest_reader, &LiftScenarioTest_read);
+    }
+    fclose(file);
+
+    const bool ok = (status == expected) && ((line == 0) || (LiftScenarioTest_reader.line == line));
+    if (!ok)
+    {
+        printf("    > %s at line %u, expected %s at line %u\n", LiftScenarioStatus_name(status),
+               LiftScenarioTest_reader.line, LiftScenarioStatus_name(expected), line);
+    }
+    return ok;
+}
+
+/**
+ * @brief Malformed text and binary files are rejected with their reason.
+ */
+static bool LiftScenarioTest_errors(void)
+{
+    static const struct {
+        const char* text;
+        LiftScenarioStatus_t status;
+        uint32_t line;
+    } cases[] = {
+        { "0 10 | 0 closed idle - | 0 ajar idle -\n",                         LIFT_SCENARIO_SYNTAX,    1 },
+        { "# header\n0 10 | 0 closed idle - 0 closed idle -\n",                LIFT_SCENARIO_SYNTAX,    2 },
+        { "0 10 | 0 closed idle 1,,2 | 0 closed idle -\n",                    LIFT_SCENARIO_SYNTAX,    1 },
+        { "0 10 | 0 closed idle - | 0 closed idle - | 5:1 3:2\n",             LIFT_SCENARIO_SYNTAX,    1 },
+        { "0 10 | 0 closed idle - | 0 closed idle - | 5\n",                   LIFT_SCENARIO_SYNTAX,    1 },
+        { "255 10 | 0 closed idle - | 0 closed idle -\n",                     LIFT_SCENARIO_SYNTAX,    1 },
+        { "0 10 | 0 closed idle - | 0 closed idle - extra\n",                 LIFT_SCENARIO_SYNTAX,    1 },
+        { "0 10 | 0 closed idle - | 0 closed idle -\n0 10 | 65535 open idle - | 0 open idle -\n",
+                                                                               LIFT_SCENARIO_BAD_FLOOR, 2 },
+        { "0 10 | 0 closed idle - | 0 closed idle - | 1:65535\n",             LIFT_SCENARIO_BAD_FLOOR, 1 }
+    };
+
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        ok &= LiftScenarioTest_reject(cases[i].text, strlen(cases[i].text), cases[i].status, cases[i].line);
+    }
+
+    // Too many injections
+    static char text[LIFT_SCENARIO_LINE_SIZE];
+    size_t length = (size_t)sprintf(text, "0 10 | 0 closed idle - | 0 closed idle - |");
+    for (uint32_t i = 0; i <= LIFT_SCENARIO_MAX_INJECTIONS; ++i)
+    {
+        length += (size_t)sprintf(&text[length], " %u:0", i);
+    }
+    text[length++] = '\n';
+    ok &= LiftScenarioTest_reject(text, length, LIFT_SCENARIO_TOO_MANY, 1);
+
+    // Line longer than the buffer
+    memset(text, ' ', sizeof(text));
+    ok &= LiftScenarioTest_reject(text, sizeof(text), LIFT_SCENARIO_SYNTAX, 1);
+
+    // Binary: wrong magic, wrong version, truncated record, call above the floors
+    static const uint8_t bad_magic[] = { 'L', 'S', 'C', 'X', 1, 0, 1, 0 };
+    static const uint8_t bad_version[] = { 'L', 'S', 'C', 'N', 2, 0, 1, 0 };
+    static const uint8_t truncated[] = { 'L', 'S', 'C', 'N', 1, 0, 1, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    ok &= LiftScenarioTest_reject(bad_magic, sizeof(bad_magic), LIFT_SCENARIO_BAD_MAGIC, 0);
+    ok &= LiftScenarioTest_reject(bad_version, sizeof(bad_version), LIFT_SCENARIO_BAD_VERSION, 0);
+    ok &= LiftScenarioTest_reject(truncated, sizeof(truncated), LIFT_SCENARIO_TRUNCATED, 0);
+
+    // Written with one call byte more than this build has, the call of the extra byte does not fit
+    const uint16_t call_bytes = (uint16_t)(LIFT_SCENARIO_CALL_BYTES + 1U);
+    uint8_t* bytes = (uint8_t*)text;
+    memset(bytes, 0, sizeof(text));
+    memcpy(bytes, "LSCN", 4);
+    bytes[4] = 1;
+    bytes[6] = (uint8_t)call_bytes;
+    bytes[7] = (uint8_t)(call_bytes >> 8);
+    bytes[LIFT_SCENARIO_HEADER_SIZE] = 10;
+    bytes[LIFT_SCENARIO_HEADER_SIZE + 12U + call_bytes - 1U] = 0x80;
+    ok &= LiftScenarioTest_reject(bytes, LIFT_SCENARIO_HEADER_SIZE + 12U + 2U * call_bytes, LIFT_SCENARIO_BAD_FLOOR, 0);
+
+    return ok;
+}
+
+/**
+ * @brief Writes, reads and streams scenario files.
+ */
+void LiftScenarioAllCases_test(void)
+{
+    printf("[TEST] Running LiftScenario cases...\n");
+
+    size_t passed = 0;
+    bool ok;
+
+    ok = LiftScenarioTest_suite();
+    printf("  - %-40s ... %s (%u cases)\n", "suite round trip, text and binary", ok ? "OK" : "FAIL",
+           (unsigned)LIFT_SCENARIO_TEST_CASES);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    ok = LiftScenarioTest_injections();
+    printf("  - %-40s ... %s\n", "timed call injections", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    LiftScenarioReport_t report;
+    uint32_t bytes = 0;
+    ok = LiftScenarioTest_stream(&report, &bytes);
+    printf("  - %-40s ... %s (%llu/%llu passed, %u bytes, batch %u)\n", "streamed generated file", ok ? "OK" : "FAIL",
+           (unsigned long long)report.passed, (unsigned long long)report.count, bytes, (unsigned)LIFT_SCENARIO_TEST_BATCH);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    ok = LiftScenarioTest_errors();
+    printf("  - %-40s ... %s\n", "malformed files are rejected", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/4 scenario cases passed.\n", passed);
+}
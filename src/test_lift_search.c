@@ -0,0 +1,232 @@
+/**
+ * @file test_lift_search.c
+ * @brief Unit tests of the genetic microprogram search.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "lift_search.h"
+#include "lift_check.h"
+#include "lift_plant.h"
+#include "test_lift.h"
+#include "lift_assert.h"
+
+#define LIFT_SEARCH_TEST_POPULATION   (32U)       // Candidates kept per generation
+#define LIFT_SEARCH_TEST_OFFSPRING    (96U)       // Children per generation
+#define LIFT_SEARCH_TEST_GENERATIONS  (24U)       // Generations of the search case
+#define LIFT_SEARCH_TEST_THREADS      (4U)        // Workers of the parallel search
+#define LIFT_SEARCH_TEST_LENGTH       (20U)       // Words the mutations may use
+#define LIFT_SEARCH_TEST_CAPACITY     (1U << 16)  // Visited set of the model check, power of two
+#define LIFT_SEARCH_TEST_FLOORS       (6U)        // Floors of the model check and the traffic
+/// Service bound of the random traffic, a sweep of the fuzzed building (at most 32 floors) fits in
+#define LIFT_SEARCH_TEST_BOUND        (64U * ((LIFT_MAX_FLOORS < 32U) ? LIFT_MAX_FLOORS : 32U))
+
+static LiftSearchCandidate_t LiftSearchTest_pool[LIFT_SEARCH_TEST_POPULATION + LIFT_SEARCH_TEST_OFFSPRING];
+static SeqNetTable_t LiftSearchTest_tables[LIFT_SEARCH_TEST_THREADS];
+static LiftSearch_t LiftSearchTest_search;
+static LiftSearchReport_t LiftSearchTest_reports[LIFT_SEARCH_TEST_GENERATIONS];
+static SeqNet_Program LiftSearchTest_program;
+
+static uint64_t LiftSearchTest_keys[LIFT_SEARCH_TEST_CAPACITY];
+static uint32_t LiftSearchTest_parents[LIFT_SEARCH_TEST_CAPACITY];
+static uint32_t LiftSearchTest_current[LIFT_SEARCH_TEST_CAPACITY];
+static uint32_t LiftSearchTest_next[LIFT_SEARCH_TEST_CAPACITY];
+
+static const LiftCheckWorkspace_t LiftSearchTest_workspace = {
+    .keys = LiftSearchTest_keys,
+    .parents = LiftSearchTest_parents,
+    .current = LiftSearchTest_current,
+    .next = LiftSearchTest_next,
+    .capacity = LIFT_SEARCH_TEST_CAPACITY
+};
+
+static const LiftSearchWorkspace_t LiftSearchTest_memory = {
+    .pool = LiftSearchTest_pool,
+    .tables = LiftSearchTest_tables
+};
+
+/// Start PCs of the random traffic: reset and the door closing state of the suite
+static const uint8_t LiftSearchTest_presets[] = { 0, 3 };
+
+/// Scenario suite of the search (@see LiftTestAll_run)
+static LiftTestCase_t LiftSearchTest_cases[12];
+
+/**
+ * @brief Copies the named scenarios into LiftSearchTest_cases.
+ */
+static void LiftSearchTest_suite(void)
+{
+    const LiftTestCase_t* const cases[] = {
+        &test_case_already_open, &test_case_open_door_same_floor, &test_case_move_down, &test_case_move_up,
+        &test_case_multiple_calls, &test_case_idle, &test_case_reopen_during_close, &test_case_bottom_to_top,
+        &test_case_middle_stop, &test_case_up_two_floors, &test_case_down_two_floors, &test_case_all_calls
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        LiftSearchTest_cases[i] = *cases[i];
+    }
+}
+
+/**
+ * @brief Parameters shared by the cases, on the given number of threads.
+ */
+static LiftSearchConfig_t LiftSearchTest_config(uint32_t threads)
+{
+    LiftSearchConfig_t config = {
+        .cases = LiftSearchTest_cases,
+        .case_count = sizeof(LiftSearchTest_cases) / sizeof(LiftSearchTest_cases[0]),
+        .traffic = {
+            .floors = LIFT_SEARCH_TEST_FLOORS,
+            .steps = 2U * LIFT_SEARCH_TEST_BOUND,
+            .service_bound = LIFT_SEARCH_TEST_BOUND,
+            .injection_shift = 6,
+            .presets = LiftSearchTest_presets,
+            .preset_count = sizeof(LiftSearchTest_presets) / sizeof(LiftSearchTest_presets[0])
+        },
+        .traffic_count = 16,
+        .traffic_seed = 0x5EA4C4U,
+        .population = LIFT_SEARCH_TEST_POPULATION,
+        .offspring = LIFT_SEARCH_TEST_OFFSPRING,
+        .length = LIFT_SEARCH_TEST_LENGTH,
+        .mutations = 3,
+        .threads = threads,
+        .seed = 0x9E3779B97F4A7C15ULL
+    };
+    return config;
+}
+
+/**
+ * @brief The default program is valid, faulty variants are rejected.
+ */
+static bool LiftSearchTest_evaluate(LiftSearchFitness_t* fitness)
+{
+    const LiftSearchConfig_t config = LiftSearchTest_config(1);
+    const SeqNet_Program* reference = SeqNetProgram_get();
+    LiftSearchFitness_t faulty;
+    bool ok = LiftSearch_evaluate(&config, reference, &LiftSearchTest_tables[0], fitness) &&
+              (fitness->steps > 0) && (fitness->door_cycles > 0) && (fitness->words > 0);
+
+    // Idle loop moving up with the door open: the first scenario fails
+    LiftSearchTest_program = *reference;
+    LiftSearchTest_program.words[1] |= (uint16_t)((1U << BIT_MOVE_UP) | (1U << BIT_DOOR_STATE));
+    SeqNetProgram_decode(&LiftSearchTest_program);
+    ok = ok && !LiftSearch_evaluate(&config, &LiftSearchTest_program, &LiftSearchTest_tables[0], &faulty) && !faulty.valid;
+
+    // Never resetting the calls: the suite ends in the wrong state
+    LiftSearchTest_program = *reference;
+    for (uint32_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        LiftSearchTest_program.words[pc] &= (uint16_t)~(1U << BIT_REQ_RESET);
+    }
+    SeqNetProgram_decode(&LiftSearchTest_program);
+    ok = ok && !LiftSearch_evaluate(&config, &LiftSearchTest_program, &LiftSearchTest_tables[0], &faulty);
+
+    return ok;
+}
+
+/**
+ * @brief Evolves the default program: every generation keeps a valid best that never gets
+ *        worse, and the final best passes the suite and the model check in fewer steps.
+ */
+static bool LiftSearchTest_evolve(const LiftSearchFitness_t* reference)
+{
+    const LiftSearchConfig_t config = LiftSearchTest_config(LIFT_SEARCH_TEST_THREADS);
+    LiftSearch_init(&LiftSearchTest_search, &config, &LiftSearchTest_memory, SeqNetProgram_get());
+
+    bool ok = (LiftSearchFitness_compare(&LiftSearch_best(&LiftSearchTest_search)->fitness, reference) <= 0);
+    LiftSearchFitness_t previous = LiftSearch_best(&LiftSearchTest_search)->fitness;
+    for (uint32_t g = 0; g < LIFT_SEARCH_TEST_GENERATIONS; ++g)
+    {
+        LiftSearchReport_t* report = &LiftSearchTest_reports[g];
+        LiftSearch_generation(&LiftSearchTest_search, report);
+        ok = ok && report->best.valid && (LiftSearchFitness_compare(&report->best, &previous) <= 0);
+        previous = report->best;
+
+        if ((g % 4U == 3U) || (g == 0))
+        {
+            printf("    > generation %2u: %3u steps, %2u door cycles, %2u words (%2u valid, %2u rejected, %2u duplicates, %2u accepted)\n",
+                   report->generation, report->best.steps, report->best.door_cycles, (unsigned)report->best.words,
+                   report->valid, report->rejected, report->duplicates, report->accepted);
+        }
+    }
+
+    // The best program still passes every case on its own and every reachable state holds
+    const LiftSearchCandidate_t* best = LiftSearch_best(&LiftSearchTest_search);
+    for (size_t i = 0; ok && (i < config.case_count); ++i)
+    {
+        LiftTestResult_t result;
+        ok = LiftTestCase_exec(&LiftSearchTest_cases[i], &best->program, &result);
+    }
+
+    LiftCheckConfig_t check = { .floors = LIFT_SEARCH_TEST_FLOORS, .arrivals = true, .service_bound = 256, .threads = 1 };
+    LiftCheckState_t initial;
+    LiftCheckResult_t result;
+    memset(&initial, 0, sizeof(initial));
+    LiftCheck_run(&best->program, &check, &initial, &LiftSearchTest_workspace, &result);
+    if (ok && (result.verdict != LIFT_CHECK_OK))
+    {
+        printf("    > Model check verdict %d\n", (int)result.verdict);
+    }
+
+    return ok && (result.verdict == LIFT_CHECK_OK) && (best->fitness.steps < reference->steps);
+}
+
+/**
+ * @brief The search on one thread replays the reports and the best program of the parallel run.
+ */
+static bool LiftSearchTest_threads(void)
+{
+    const uint32_t id = LiftSearch_best(&LiftSearchTest_search)->program.id;
+    const LiftSearchConfig_t config = LiftSearchTest_config(1);
+    LiftSearch_init(&LiftSearchTest_search, &config, &LiftSearchTest_memory, SeqNetProgram_get());
+
+    bool ok = true;
+    for (uint32_t g = 0; g < LIFT_SEARCH_TEST_GENERATIONS; ++g)
+    {
+        LiftSearchReport_t report;
+        LiftSearch_generation(&LiftSearchTest_search, &report);
+        const LiftSearchReport_t* expected = &LiftSearchTest_reports[g];
+        ok = ok && (LiftSearchFitness_compare(&report.best, &expected->best) == 0) &&
+             (report.valid == expected->valid) && (report.rejected == expected->rejected) &&
+             (report.duplicates == expected->duplicates) && (report.accepted == expected->accepted);
+    }
+    return ok && (LiftSearch_best(&LiftSearchTest_search)->program.id == id);
+}
+
+/**
+ * @brief Evaluates candidates and evolves the default program.
+ */
+void LiftSearchAllCases_test(void)
+{
+    printf("[TEST] Running LiftSearch cases...\n");
+
+    size_t passed = 0;
+    bool ok;
+
+    LiftSearchTest_suite();
+
+    LiftSearchFitness_t reference;
+    ok = LiftSearchTest_evaluate(&reference);
+    printf("  - %-40s ... %s (%u steps, %u door cycles)\n", "default valid, faulty variants rejected",
+           ok ? "OK" : "FAIL", reference.steps, reference.door_cycles);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    ok = LiftSearchTest_evolve(&reference);
+    const LiftSearchFitness_t* best = &LiftSearch_best(&LiftSearchTest_search)->fitness;
+    printf("  - %-40s ... %s (%u -> %u steps, %u -> %u words)\n", "evolved program serves sooner",
+           ok ? "OK" : "FAIL", reference.steps, best->steps, (unsigned)reference.words, (unsigned)best->words);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    ok = LiftSearchTest_threads();
+    printf("  - %-40s ... %s (%u vs 1 threads)\n", "search is independent of thread count",
+           ok ? "OK" : "FAIL", (unsigned)LIFT_SEARCH_TEST_THREADS);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/3 search cases passed.\n", passed);
+}
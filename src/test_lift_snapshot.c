@@ -0,0 +1,131 @@
+/**
+ * @file test_lift_snapshot.c
+ * @brief Unit tests of the emulator snapshots.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "lift_snapshot.h"
+#include "test_lift.h"
+#include "lift_assert.h"
+
+#define LIFT_SNAPSHOT_TEST_PREFIX   (20U)   // Steps simulated before the snapshot
+#define LIFT_SNAPSHOT_TEST_SUFFIX   (60U)   // Steps simulated after the snapshot
+
+/**
+ * @brief Simulates a controller context and its plant for some steps.
+ */
+static void LiftSnapshotTest_run(SeqNet_Ctx* ctx, LiftState_t* state, uint32_t steps)
+{
+    CondSel_In cond_in;
+    for (uint32_t i = 0; i < steps; ++i)
+    {
+        LiftStateArray_convert(state, &cond_in);
+        const SeqNet_Out out = SeqNet_ctxStep(ctx, &cond_in);
+        LiftPlant_apply(state, &out);
+    }
+}
+
+/**
+ * @brief Simulates the global controller and its plant for some steps.
+ */
+static void LiftSnapshotTest_runGlobal(LiftState_t* state, uint32_t steps)
+{
+    CondSel_In cond_in;
+    for (uint32_t i = 0; i < steps; ++i)
+    {
+        LiftStateArray_convert(state, &cond_in);
+        const SeqNet_Out out = SeqNet_step(&cond_in);
+        LiftPlant_apply(state, &out);
+    }
+}
+
+/**
+ * @brief Compares two plant states.
+ */
+static bool LiftSnapshotTest_equal(const LiftState_t* a, const LiftState_t* b)
+{
+    return (a->floor == b->floor) && (a->is_door_open == b->is_door_open) && (a->is_moving == b->is_moving) &&
+           LiftCalls_equal(&a->calls, &b->calls);
+}
+
+/**
+ * @brief Checks that restored and forked snapshots continue exactly like an uninterrupted run.
+ */
+void LiftSnapshotAllCases_test(void)
+{
+    printf("[TEST] Running LiftSnapshot_restore() cases...\n");
+
+    const SeqNet_Program* program = SeqNetProgram_get();
+    const LiftTestCase_t* test = &test_case_multiple_calls;
+    LiftSnapshot_t snapshot;
+    SeqNet_Ctx ctx, restored_ctx;
+    LiftState_t state, restored_state;
+    size_t passed = 0;
+    bool ok;
+
+    // Snapshot mid-run, restore into a fresh context, continue
+    SeqNet_ctxInit(&ctx, program);
+    ctx.pc = test->PC_preset;
+    state = test->initial_state;
+    LiftSnapshotTest_run(&ctx, &state, LIFT_SNAPSHOT_TEST_PREFIX);
+    LiftSnapshot_take(&snapshot, &ctx, &state);
+    LiftSnapshotTest_run(&ctx, &state, LIFT_SNAPSHOT_TEST_SUFFIX);
+
+    SeqNet_ctxInit(&restored_ctx, program);
+    memset(&restored_state, 0, sizeof(restored_state));
+    ok = (sizeof(LiftSnapshot_t) == 8U + sizeof(LiftCalls_t)) && LiftSnapshot_restore(&snapshot, &restored_ctx, &restored_state);
+    LiftSnapshotTest_run(&restored_ctx, &restored_state, LIFT_SNAPSHOT_TEST_SUFFIX);
+    ok = ok && (restored_ctx.pc == ctx.pc) && LiftSnapshotTest_equal(&restored_state, &state);
+    printf("  - %-40s ... %s\n", "restore continues the run", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // Same through the global controller
+    SeqNet_init();
+    ok = LiftSnapshot_restoreGlobal(&snapshot, &restored_state);
+    LiftSnapshotTest_runGlobal(&restored_state, LIFT_SNAPSHOT_TEST_SUFFIX);
+    ok = ok && (SeqNetPC_get() == ctx.pc) && LiftSnapshotTest_equal(&restored_state, &state);
+    printf("  - %-40s ... %s\n", "global restore continues the run", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // Fork one copy per floor, inject a different call into each, compare with replays from scratch
+    SeqNet_Ctx forks[LIFT_MAX_FLOORS];
+    LiftState_t fork_states[LIFT_MAX_FLOORS];
+    ok = (LiftSnapshot_fork(&snapshot, program, forks, fork_states, LIFT_MAX_FLOORS) == LIFT_MAX_FLOORS);
+    for (uint16_t floor = 0; ok && (floor < LIFT_MAX_FLOORS); ++floor)
+    {
+        LiftCalls_set(&fork_states[floor].calls, floor);
+        LiftSnapshotTest_run(&forks[floor], &fork_states[floor], LIFT_SNAPSHOT_TEST_SUFFIX);
+
+        SeqNet_ctxInit(&ctx, program);
+        ctx.pc = test->PC_preset;
+        state = test->initial_state;
+        LiftSnapshotTest_run(&ctx, &state, LIFT_SNAPSHOT_TEST_PREFIX);
+        LiftCalls_set(&state.calls, floor);
+        LiftSnapshotTest_run(&ctx, &state, LIFT_SNAPSHOT_TEST_SUFFIX);
+        ok = (forks[floor].pc == ctx.pc) && LiftSnapshotTest_equal(&fork_states[floor], &state);
+    }
+    printf("  - %-40s ... %s\n", "forks equal replays", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // A snapshot of another program is rejected
+    static SeqNet_Program other;
+    memcpy(other.words, program->words, sizeof(other.words));
+    other.words[0] ^= 1U;
+    SeqNetProgram_decode(&other);
+    SeqNet_ctxInit(&restored_ctx, &other);
+    restored_ctx.pc = 7U;
+    ok = !LiftSnapshot_restore(&snapshot, &restored_ctx, &restored_state) && (restored_ctx.pc == 7U) &&
+         (LiftSnapshot_fork(&snapshot, &other, forks, fork_states, LIFT_MAX_FLOORS) == 0U);
+    printf("  - %-40s ... %s\n", "other program is rejected", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    SeqNet_init();
+    printf("[TEST] %zu/4 snapshot cases passed.\n", passed);
+}
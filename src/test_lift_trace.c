@@ -0,0 +1,150 @@
+/**
+ * @file test_lift_trace.c
+ * @brief Unit tests of the binary trace recorder.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "lift_trace.h"
+#include "test_lift.h"
+#include "lift_assert.h"
+
+#define LIFT_TRACE_TEST_CAPACITY    (16U)        // Small ring, forces many flushes
+#define LIFT_TRACE_TEST_TEXT_SIZE   ((1U << 17) + 256U * LIFT_CALLS_TEXT_SIZE)   // Text log buffer size
+
+static char LiftTraceTest_expected[LIFT_TRACE_TEST_TEXT_SIZE];
+static char LiftTraceTest_decoded[LIFT_TRACE_TEST_TEXT_SIZE];
+
+/// Traced cases
+static const LiftTestCase_t* const LiftTraceTest_cases[] = {
+    &test_case_already_open, &test_case_move_down, &test_case_move_up, &test_case_multiple_calls,
+    &test_case_reopen_during_close, &test_case_all_calls, &test_case_down_two_floors
+};
+
+#define LIFT_TRACE_TEST_COUNT (sizeof(LiftTraceTest_cases) / sizeof(LiftTraceTest_cases[0]))
+
+#if LIFT_MAX_FLOORS > LIFT_TRACE_RECORD_FLOORS
+/// Call above the record floors: one call record in the keyframe, one when it is served
+static const LiftTestCase_t LiftTraceTest_tower = {
+    .initial_state = { .floor = LIFT_TRACE_RECORD_FLOORS - 1U, .is_door_open = true, .is_moving = false,
+                       .calls = LIFT_CALLS_INIT(LIFT_CALL(0) | LIFT_CALL(LIFT_TRACE_RECORD_FLOORS)) },
+    .steps = 60
+};
+#define LIFT_TRACE_TEST_CALL_RECORDS    (2U)
+#else
+#define LIFT_TRACE_TEST_CALL_RECORDS    (0U)
+#endif
+
+/**
+ * @brief Appends the text step log of a case, in the format of LiftTestCase_run().
+ */
+static size_t LiftTraceTest_log(char* text, size_t used, const LiftTestCase_t* test, const SeqNet_Program* program)
+{
+    LiftState_t actual = test->initial_state;
+    char calls_text[LIFT_CALLS_TEXT_SIZE];
+    CondSel_In cond_in;
+    SeqNet_Ctx ctx;
+
+    SeqNet_ctxInit(&ctx, program);
+    ctx.pc = test->PC_preset;
+
+    used += (size_t)snprintf(text + used, LIFT_TRACE_TEST_TEXT_SIZE - used,
+        "INT: Floor: %d, Door Open: %s, Moving: %s, Calls: [%s], PC preset: %d\n",
+            actual.floor,
+            actual.is_door_open ? "Y" : "N",
+            actual.is_moving ? "Y" : "N",
+            LiftCalls_format(&actual.calls, calls_text),
+            test->PC_preset);
+
+    for (uint8_t step = 0; step < test->steps; ++step)
+    {
+        const uint8_t pc_pre = ctx.pc;
+        LiftStateArray_convert(&actual, &cond_in);
+        const SeqNet_Out seq_out = SeqNet_ctxStep(&ctx, &cond_in);
+
+        used += (size_t)snprintf(text + used, LIFT_TRACE_TEST_TEXT_SIZE - used,
+            "Step %02d: Floor: %d, Door Open: %s, Moving: %s, prePC: %02d, postPC: %02d, Reset: %d, Calls: [%s], Up: %d, Down: %d, DReq: %d\n",
+                step,
+                actual.floor,
+                actual.is_door_open ? "Y" : "N",
+                actual.is_moving ? "Y" : "N",
+                pc_pre,
+                ctx.pc,
+                seq_out.req_reset ? 1 : 0,
+                LiftCalls_format(&actual.calls, calls_text),
+                seq_out.req_move_up ? 1 : 0,
+                seq_out.req_move_down ? 1 : 0,
+                seq_out.req_door_state == DOOR_REQ_OPEN ? 1 : 0);
+
+        LiftPlant_apply(&actual, &seq_out);
+    }
+    return used;
+}
+
+/**
+ * @brief Records the lift test cases, decodes the trace and compares it with the text step log.
+ */
+void LiftTraceAllCases_test(void)
+{
+    printf("[TEST] Running LiftTrace_decode() cases...\n");
+
+    const SeqNet_Program* program = SeqNetProgram_get();
+    static LiftTraceRecord_t records[LIFT_TRACE_TEST_CAPACITY];
+    LiftTrace_t trace;
+    LiftTestResult_t result;
+    size_t passed = 0;
+    bool ok;
+
+    // Recorded to a file through a small ring, decoded back to text
+    FILE* file = tmpfile();
+    FILE* text = tmpfile();
+    ok = (file != NULL) && (text != NULL);
+
+    size_t expected_size = 0;
+    uint64_t steps = 0;
+    if (ok)
+    {
+        LiftTrace_init(&trace, records, LIFT_TRACE_TEST_CAPACITY, file);
+        for (size_t i = 0; i < LIFT_TRACE_TEST_COUNT; ++i)
+        {
+            LiftTestCase_execTraced(LiftTraceTest_cases[i], program, &result, &trace);
+            expected_size = LiftTraceTest_log(LiftTraceTest_expected, expected_size, LiftTraceTest_cases[i], program);
+            steps += LiftTraceTest_cases[i]->steps;
+        }
+#if LIFT_MAX_FLOORS > LIFT_TRACE_RECORD_FLOORS
+        LiftTestCase_execTraced(&LiftTraceTest_tower, program, &result, &trace);
+        expected_size = LiftTraceTest_log(LiftTraceTest_expected, expected_size, &LiftTraceTest_tower, program);
+        steps += LiftTraceTest_tower.steps + 1U;
+#endif
+        ok = LiftTrace_flush(&trace) && (trace.written == steps + LIFT_TRACE_TEST_COUNT + LIFT_TRACE_TEST_CALL_RECORDS);
+
+        rewind(file);
+        ok = ok && LiftTrace_decode(file, text);
+        rewind(text);
+        const size_t decoded_size = fread(LiftTraceTest_decoded, 1, sizeof(LiftTraceTest_decoded), text);
+        ok = ok && (decoded_size == expected_size) &&
+             (memcmp(LiftTraceTest_decoded, LiftTraceTest_expected, expected_size) == 0);
+    }
+    if (file != NULL) fclose(file);
+    if (text != NULL) fclose(text);
+
+    printf("  - %-40s ... %s (%llu records, %zu bytes of text)\n", "decoded trace equals step log",
+           ok ? "OK" : "FAIL", (unsigned long long)steps + LIFT_TRACE_TEST_COUNT, expected_size);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // Without a sink the ring keeps the latest records
+    LiftTrace_init(&trace, records, LIFT_TRACE_TEST_CAPACITY, NULL);
+    LiftTestCase_execTraced(&test_case_all_calls, program, &result, &trace);
+    const LiftTraceRecord_t* last = &records[(trace.written - 1U) % LIFT_TRACE_TEST_CAPACITY];
+    ok = (trace.written == test_case_all_calls.steps + 1U) &&
+         (LiftTrace_pending(&trace) == LIFT_TRACE_TEST_CAPACITY) &&
+         (last->kind == LIFT_TRACE_KIND_STEP) && (last->b == result.end_pc);
+    printf("  - %-40s ... %s\n", "flight recorder keeps latest records", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/2 trace cases passed.\n", passed);
+}
@@ -0,0 +1,135 @@
+/**
+ * @file test_lift_traffic.c
+ * @brief Unit tests of the radix heap and the traffic simulator.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "lift_radix.h"
+#include "lift_traffic.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+#define LIFT_TRAFFIC_TEST_HEAP_OPS      (200000U)       // Random heap operations
+#define LIFT_TRAFFIC_TEST_HEAP_SIZE     (64U)           // Heap capacity of the heap test
+#define LIFT_TRAFFIC_TEST_PASSENGERS    (4096U)         // Passenger records
+#define LIFT_TRAFFIC_TEST_DAY           (86400U)        // Ticks of a simulated day (one tick per second)
+#define LIFT_TRAFFIC_TEST_YEAR          (365ULL * LIFT_TRAFFIC_TEST_DAY)
+#define LIFT_TRAFFIC_TEST_FLOORS        ((LIFT_MAX_FLOORS < 6U) ? LIFT_MAX_FLOORS : 6U)  // One car serves this building unsaturated
+
+static LiftRadixNode_t LiftTrafficTest_events[LIFT_MAX_FLOORS];
+static LiftTrafficPassenger_t LiftTrafficTest_passengers[LIFT_TRAFFIC_TEST_PASSENGERS];
+static uint32_t LiftTrafficTest_lists[2U * LIFT_MAX_FLOORS];
+
+static const LiftTrafficWorkspace_t LiftTrafficTest_workspace = {
+    .events = LiftTrafficTest_events, .event_capacity = LIFT_MAX_FLOORS,
+    .passengers = LiftTrafficTest_passengers, .passenger_capacity = LIFT_TRAFFIC_TEST_PASSENGERS,
+    .lists = LiftTrafficTest_lists
+};
+
+/// Profile names
+static const char* const LiftTrafficTest_names[] = { "uniform", "up-peak", "down-peak", "inter-floor" };
+
+/**
+ * @brief Random interleaved pushes and pops against a linear-scan reference.
+ */
+static bool LiftTrafficTest_heap(void)
+{
+    static LiftRadixNode_t nodes[LIFT_TRAFFIC_TEST_HEAP_SIZE];
+    uint64_t reference[LIFT_TRAFFIC_TEST_HEAP_SIZE];
+    uint32_t pending = 0;
+    uint64_t last = 0;
+    uint64_t seed = 0x8AD1CEULL;
+    LiftRadixHeap_t heap;
+
+    LiftRadix_init(&heap, nodes, LIFT_TRAFFIC_TEST_HEAP_SIZE);
+    for (uint32_t i = 0; i < LIFT_TRAFFIC_TEST_HEAP_OPS; ++i)
+    {
+        LiftRandom_next64(&seed);
+        const bool push = (pending == 0) || ((pending < LIFT_TRAFFIC_TEST_HEAP_SIZE) && ((seed >> 63) != 0));
+        if (push)
+        {
+            // Offsets of every magnitude, including equal keys
+            const uint64_t key = last + ((seed >> 8) & ((1ULL << ((seed >> 2) & 47U)) - 1U));
+            if (!LiftRadix_push(&heap, key, (uint32_t)key)) return false;
+            reference[pending++] = key;
+            continue;
+        }
+
+        uint32_t min = 0;
+        for (uint32_t j = 1; j < pending; ++j)
+        {
+            if (reference[j] < reference[min]) min = j;
+        }
+        uint64_t key;
+        uint32_t value;
+        if (!LiftRadix_pop(&heap, &key, &value) || (key != reference[min]) || (value != (uint32_t)key)) return false;
+        reference[min] = reference[--pending];
+        last = key;
+    }
+    return (heap.count == pending) && !((pending == LIFT_TRAFFIC_TEST_HEAP_SIZE) && LiftRadix_push(&heap, last, 0));
+}
+
+/**
+ * @brief Checks the radix heap and the traffic simulation against its tick-by-tick reference.
+ */
+void LiftTrafficAllCases_test(void)
+{
+    printf("[TEST] Running LiftTraffic_run() cases...\n");
+
+    const SeqNet_Program* program = SeqNetProgram_get();
+    LiftTrafficReport_t report, reference;
+    size_t passed = 0;
+    bool ok;
+
+    ok = LiftTrafficTest_heap();
+    printf("  - %-40s ... %s\n", "radix heap pops in key order", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    // A day of every profile: the event-driven run equals the tick-by-tick one, passengers are conserved
+    LiftTrafficConfig_t config = {
+        .profile = LIFT_TRAFFIC_UNIFORM, .floors = LIFT_TRAFFIC_TEST_FLOORS, .arrivals_per_hour = 120.0,
+        .ticks_per_hour = 3600U, .duration = LIFT_TRAFFIC_TEST_DAY, .seed = 0x7A11C0DEULL, .tick_by_tick = false
+    };
+    for (uint32_t profile = LIFT_TRAFFIC_UNIFORM; profile <= LIFT_TRAFFIC_INTER_FLOOR; ++profile)
+    {
+        config.profile = (LiftTrafficProfile_t)profile;
+        config.tick_by_tick = true;
+        LiftTraffic_run(program, &config, &LiftTrafficTest_workspace, &reference);
+        config.tick_by_tick = false;
+        LiftTraffic_run(program, &config, &LiftTrafficTest_workspace, &report);
+
+        ok = (report.arrived == reference.arrived) && (report.delivered == reference.delivered) &&
+             (report.wait_sum == reference.wait_sum) && (report.journey_sum == reference.journey_sum) &&
+             (report.journey_max == reference.journey_max) && (report.ticks == reference.ticks) &&
+             (report.steps < reference.steps) && (report.dropped == 0) &&
+             (report.delivered <= report.boarded) && (report.boarded <= report.arrived) &&
+             (report.arrived - report.delivered < 16U) && (report.mean_wait < report.mean_journey) &&
+             (report.throughput_per_hour > 0.9 * config.arrivals_per_hour) &&
+             (report.throughput_per_hour < 1.1 * config.arrivals_per_hour);
+        printf("  - %-40s ... %s (%llu passengers, wait %.1f / p95 %llu, journey %.1f, %.0f/h, %llu steps)\n",
+               LiftTrafficTest_names[profile], ok ? "OK" : "FAIL", (unsigned long long)report.delivered,
+               report.mean_wait, (unsigned long long)LiftTraffic_waitPercentile(&report, 95U), report.mean_journey,
+               report.throughput_per_hour, (unsigned long long)report.steps);
+        LIFT_ASSERT(ok);
+        passed += ok;
+    }
+
+    // A year of uniform traffic
+    config.profile = LIFT_TRAFFIC_UNIFORM;
+    config.duration = LIFT_TRAFFIC_TEST_YEAR;
+    LiftTraffic_run(program, &config, &LiftTrafficTest_workspace, &report);
+    ok = (report.ticks == LIFT_TRAFFIC_TEST_YEAR) && (report.dropped == 0) &&
+         (report.throughput_per_hour > 0.95 * config.arrivals_per_hour) &&
+         (report.throughput_per_hour < 1.05 * config.arrivals_per_hour);
+    printf("  - %-40s ... %s (%llu passengers, wait %.1f, journey %.1f, %llu steps)\n", "a year of uniform traffic",
+           ok ? "OK" : "FAIL", (unsigned long long)report.delivered, report.mean_wait, report.mean_journey,
+           (unsigned long long)report.steps);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/6 traffic cases passed.\n", passed);
+}
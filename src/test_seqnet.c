@@ -23,6 +23,172 @@ typedef struct {
     SeqNet_Out expected;
 } SeqNetTestCase_t;
 
+/**
+ * @brief Cross-checks the fused SeqNet_ctxStep()/SeqNet_ctxStepRaw() against
+ *        CondSel_calc() + SeqNet_ctxLoop() for every selector, inversion and input combination.
+ */
+static void SeqNetStepCases_test(void)
+{
+    printf("[TEST] Running SeqNet_ctxStep() cross-check...\n");
+
+    SeqNet_Program program;
+    memset(&program, 0, sizeof(program));
+
+    // One instruction per selector and inversion, each jumping to a distinct address
+    for (uint8_t i = 0; i < 16; ++i)
+    {
+        program.words[i] = (uint16_t)(((i & 0x1) << BIT_COND_INV) |
+                                      ((i >> 1) << BIT_COND_SEL) |
+                                      ((i & 0x1) << BIT_MOVE_UP) |
+                                      (0x80 + i));
+    }
+    SeqNetProgram_decode(&program);
+
+    size_t checked = 0;
+    size_t passed = 0;
+
+    for (uint8_t pc = 0; pc < 16; ++pc)
+    {
+        for (uint8_t bits = 0; bits < 32; ++bits)
+        {
+            const CondSel_In in = {
+                .call_pending_below = (bits >> 0) & 0x1,
+                .call_pending_same  = (bits >> 1) & 0x1,
+                .call_pending_above = (bits >> 2) & 0x1,
+                .door_closed        = (bits >> 3) & 0x1,
+                .door_open          = (bits >> 4) & 0x1
+            };
+
+            SeqNet_Ctx ref, fused, raw;
+            SeqNet_ctxInit(&ref, &program);
+            SeqNet_ctxInit(&fused, &program);
+            SeqNet_ctxInit(&raw, &program);
+            ref.pc = fused.pc = raw.pc = pc;
+
+            const SeqNet_Out* instr = &program.decoded[pc];
+            SeqNet_Out ref_out = SeqNet_ctxLoop(&ref, CondSel_calc(instr->cond_inv, instr->cond_sel, in));
+            SeqNet_Out fused_out = SeqNet_ctxStep(&fused, &in);
+            uint16_t raw_out = SeqNet_ctxStepRaw(&raw, &in);
+
+            bool ok = (fused.pc == ref.pc) && (raw.pc == ref.pc) &&
+                      (memcmp(&fused_out, &ref_out, sizeof(SeqNet_Out)) == 0) &&
+                      (raw_out == program.words[pc]);
+
+            if (!ok) {
+                printf("    > PC: 0x%02X, inputs: 0x%02X, expected PC: 0x%02X, got: 0x%02X/0x%02X\n",
+                       pc, bits, ref.pc, fused.pc, raw.pc);
+            }
+
+            LIFT_ASSERT(ok);
+            passed += ok;
+            ++checked;
+        }
+    }
+
+    printf("[TEST] %zu/%zu combinations matched.\n", passed, checked);
+}
+
+/**
+ * @brief Checks that SeqNet_ctxRunUntil() stops at plant events a partial watch mask leaves out.
+ */
+static void SeqNetRunUntilCases_test(void)
+{
+    printf("[TEST] Running SeqNet_ctxRunUntil() cases...\n");
+
+    // PC 0: goto 1, PC 1: reset the call and goto 2, PC 2: idle loop (selector 7 inverted)
+    SeqNet_Program program;
+    memset(&program, 0, sizeof(program));
+    program.words[0] = (uint16_t)((1U << BIT_COND_INV) | (7U << BIT_COND_SEL) | 1U);
+    program.words[1] = (uint16_t)((1U << BIT_COND_INV) | (7U << BIT_COND_SEL) | (1U << BIT_REQ_RESET) | 2U);
+    program.words[2] = (uint16_t)((1U << BIT_COND_INV) | (7U << BIT_COND_SEL) | 2U);
+    SeqNetProgram_decode(&program);
+
+    const CondSel_In in = { .call_pending_same = true, .door_closed = true };
+    const uint16_t watches[] = { SEQNET_WATCH_ALL, SEQNET_WATCH_MOVE | SEQNET_WATCH_DOOR, SEQNET_WATCH_MOVE, 0 };
+    size_t passed = 0;
+
+    for (size_t i = 0; i < sizeof(watches) / sizeof(watches[0]); ++i)
+    {
+        SeqNet_Ctx ctx;
+        SeqNet_Out out;
+        SeqNet_ctxInit(&ctx, &program);
+
+        // The reset ends a macro-step whatever is watched: it is never overrun by the idle loop
+        uint32_t steps = 0;
+        do
+        {
+            steps += SeqNet_ctxRunUntil(&ctx, &in, watches[i], 10, &out);
+        } while (!out.req_reset && (steps < 10U));
+        bool ok = (steps == 2U) && (ctx.pc == 2U);
+        const uint32_t idle = SeqNet_ctxRunUntil(&ctx, &in, watches[i], 10, &out);
+        ok = ok && (idle == 10U) && !out.req_reset && (ctx.pc == 2U);
+
+        char name[48];
+        snprintf(name, sizeof(name), "reset stops the run, watch 0x%04X", (unsigned)watches[i]);
+        printf("  - %-40s ... %s (%u steps)\n", name, ok ? "OK" : "FAIL", (unsigned)steps);
+        LIFT_ASSERT(ok);
+        passed += ok;
+    }
+
+    printf("[TEST] %zu/%zu macro-step cases passed.\n", passed, sizeof(watches) / sizeof(watches[0]));
+}
+
+#if SEQNET_PROFILE_ENABLED
+/**
+ * @brief Checks the profile counters of stepping and of fast-forwarding a wait loop.
+ */
+static void SeqNetProfileCases_test(void)
+{
+    printf("[TEST] Running SeqNet_ctxProfile() cases...\n");
+
+    // PC 0: wait while the door is not closed, PC 1: jump back to 0 (selector 7 inverted)
+    SeqNet_Program program;
+    memset(&program, 0, sizeof(program));
+    program.words[0] = (uint16_t)((1U << BIT_COND_INV) | (4U << BIT_COND_SEL) | 0U);
+    program.words[1] = (uint16_t)((1U << BIT_COND_INV) | (7U << BIT_COND_SEL) | 0U);
+    SeqNetProgram_decode(&program);
+
+    const CondSel_In open = { .door_open = true };
+    const CondSel_In closed = { .door_closed = true };
+    static SeqNet_Profile stepped, skipped;
+    SeqNetProfile_reset(&stepped);
+    SeqNetProfile_reset(&skipped);
+
+    // 1001 steps with the door open: PC 0 spins
+    SeqNet_Ctx ctx;
+    SeqNet_ctxInit(&ctx, &program);
+    SeqNet_ctxProfile(&ctx, &stepped);
+    for (uint32_t i = 0; i < 1001U; ++i)
+    {
+        SeqNet_ctxStep(&ctx, &open);
+    }
+    SeqNet_ctxStep(&ctx, &closed);  // PC 0 -> 1
+    SeqNet_ctxStep(&ctx, &closed);  // PC 1 -> 0
+
+    bool ok = (stepped.hits[0] == 1002U) && (stepped.taken[0] == 1001U) &&
+              (stepped.hits[1] == 1U) && (stepped.taken[1] == 1U) &&
+              (stepped.selector[4] == 1002U) && (stepped.selector[7] == 1U);
+    printf("  - %-40s ... %s\n", "step counters", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    size_t passed = ok;
+
+    // The same wait skipped with a fast-forward counts the same steps
+    SeqNet_Park park;
+    SeqNet_ctxInit(&ctx, &program);
+    SeqNet_ctxProfile(&ctx, &skipped);
+    ok = SeqNet_ctxPark(&ctx, &open, &park);
+    SeqNet_ctxFastForward(&ctx, &park, 1001U);
+    SeqNet_ctxStep(&ctx, &closed);
+    SeqNet_ctxStep(&ctx, &closed);
+    ok = ok && (memcmp(&stepped, &skipped, sizeof(SeqNet_Profile)) == 0);
+    printf("  - %-40s ... %s\n", "fast-forward counters", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/2 profile cases passed.\n", passed);
+}
+#endif // SEQNET_PROFILE_ENABLED
+
 /**
  * @brief Runs all SeqNet test cases, starting from simple to complex instructions.
  */
@@ -145,16 +311,28 @@ void SeqNetAllCases_test(void)
         // Initialize PC and memory
         SeqNetPC_set(t->initial_pc);
         uint16_t* mem = SeqNetProgramMemory_get();
-        memset(mem, 0, 256 * sizeof(uint16_t));
+        memset(mem, 0, SEQNET_PROGMEM_SIZE * sizeof(uint16_t));
         mem[t->initial_pc] = t->instr;
 
         // Execute one instruction
         SeqNet_Out out = SeqNet_loop(t->condition_active);
         uint8_t new_pc = SeqNetPC_get();
 
+        // Execute the same instruction on an independent context
+        SeqNet_Program program;
+        memset(&program, 0, sizeof(program));
+        program.words[t->initial_pc] = t->instr;
+        SeqNetProgram_decode(&program);
+        SeqNet_Ctx ctx;
+        SeqNet_ctxInit(&ctx, &program);
+        ctx.pc = t->initial_pc;
+        SeqNet_Out ctx_out = SeqNet_ctxLoop(&ctx, t->condition_active);
+
         // Check result
         bool ok = (new_pc == t->expected_pc) &&
-                  (memcmp(&out, &t->expected, sizeof(SeqNet_Out)) == 0);
+                  (memcmp(&out, &t->expected, sizeof(SeqNet_Out)) == 0) &&
+                  (ctx.pc == t->expected_pc) &&
+                  (memcmp(&ctx_out, &t->expected, sizeof(SeqNet_Out)) == 0);
 
         printf("  - %-40s ... %s\n", t->name, ok ? "OK" : "FAIL");
 
@@ -167,4 +345,10 @@ void SeqNetAllCases_test(void)
     }
 
     printf("[TEST] %zu/%zu tests passed.\n", passed, num_tests);
+
+    SeqNetStepCases_test();
+    SeqNetRunUntilCases_test();
+#if SEQNET_PROFILE_ENABLED
+    SeqNetProfileCases_test();
+#endif
 }
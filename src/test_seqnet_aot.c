@@ -0,0 +1,181 @@
+/**
+ * @file test_seqnet_aot.c
+ * @brief Verification of the generated engine against the SeqNet interpreter.
+ *
+ * Only compiled into builds that link the generated engine (`make aot`).
+ */
+
+#include "test_seqnet_aot.h"
+
+#if SEQNET_AOT_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "seqnet_aot.h"
+#include "scenario_loader.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+/// Number of instructions executed by each multi-step run
+#define AOT_TEST_RUN_STEPS (1000U)
+
+/**
+ * @brief Plant of the multi-step check: records the outputs and feeds pseudo-random inputs.
+ */
+typedef struct {
+    uint32_t seed;                            ///< xorshift state
+    uint32_t count;                           ///< Number of recorded steps
+    CondSel_Mask inputs[AOT_TEST_RUN_STEPS];  ///< Inputs of every step
+    SeqNet_Out outputs[AOT_TEST_RUN_STEPS];   ///< Outputs of every step
+} AotTestPlant_t;
+
+/**
+ * @brief Converts a packed mask back to the CondSel_In structure.
+ */
+static CondSel_In AotTestMask_unpack(CondSel_Mask mask)
+{
+    const CondSel_In in = {
+        .call_pending_below = (mask & CONDSEL_MASK_BELOW) != 0,
+        .call_pending_same  = (mask & CONDSEL_MASK_SAME) != 0,
+        .call_pending_above = (mask & CONDSEL_MASK_ABOVE) != 0,
+        .door_closed        = (mask & CONDSEL_MASK_CLOSED) != 0,
+        .door_open          = (mask & CONDSEL_MASK_OPEN) != 0
+    };
+    return in;
+}
+
+/**
+ * @brief Plant callback: records the step and draws the inputs of the next one.
+ */
+static void AotTestPlant_apply(void* user, const SeqNet_Out* out, CondSel_In* in)
+{
+    AotTestPlant_t* plant = (AotTestPlant_t*)user;
+
+    plant->outputs[plant->count++] = *out;
+
+    const uint32_t x = LiftRandom_next32(&plant->seed);
+
+    if (plant->count < AOT_TEST_RUN_STEPS)
+    {
+        plant->inputs[plant->count] = (CondSel_Mask)(x & CONDSEL_MASK_ALL);
+        *in = AotTestMask_unpack(plant->inputs[plant->count]);
+    }
+}
+
+/**
+ * @brief Verifies the generated engine of the default program against the interpreter.
+ */
+void SeqNetAotAllCases_test(void)
+{
+    printf("[TEST] Running generated engine cross-check...\n");
+
+    ScenarioDefaultProgram_load();
+    const SeqNet_Program* program = SeqNetProgram_get();
+
+    size_t checked = 0;
+    size_t passed = 0;
+
+    // Single-step engines: every PC with every input combination
+    for (uint16_t pc = 0; pc < SEQNET_PROGMEM_SIZE; ++pc)
+    {
+        for (uint8_t mask = 0; mask < CONDSEL_MASK_COUNT; ++mask)
+        {
+            const CondSel_In in = AotTestMask_unpack(mask);
+            SeqNet_Ctx ref, aot;
+
+            SeqNet_ctxInit(&ref, program);
+            SeqNet_ctxInit(&aot, program);
+            ref.pc = aot.pc = (uint8_t)pc;
+            SeqNet_Out ref_out = SeqNet_ctxStep(&ref, &in);
+            SeqNet_Out aot_out = SeqNetAot_ctxStep(&aot, &in);
+            bool ok = (ref.pc == aot.pc) && (memcmp(&ref_out, &aot_out, sizeof(SeqNet_Out)) == 0);
+
+            const bool condition_active = (mask & 0x1) != 0;
+            ref.pc = aot.pc = (uint8_t)pc;
+            ref_out = SeqNet_ctxLoop(&ref, condition_active);
+            aot_out = SeqNetAot_ctxLoop(&aot, condition_active);
+            ok = ok && (ref.pc == aot.pc) && (memcmp(&ref_out, &aot_out, sizeof(SeqNet_Out)) == 0);
+
+            if (!ok)
+            {
+                printf("    > PC %u, inputs 0x%02X: expected PC %u, got %u\n", pc, mask, ref.pc, aot.pc);
+            }
+            LIFT_ASSERT(ok);
+            passed += ok;
+            ++checked;
+        }
+    }
+
+    // Multi-step engine: replay the recorded inputs on the interpreter
+    static AotTestPlant_t plant;
+    for (uint8_t start = 0; start < 16; ++start)
+    {
+        memset(&plant, 0, sizeof(plant));
+        plant.seed = 0xACE1U + start;
+        plant.inputs[0] = (CondSel_Mask)(start & CONDSEL_MASK_ALL);
+
+        SeqNet_Ctx aot;
+        SeqNet_ctxInit(&aot, program);
+        aot.pc = start;
+        CondSel_In in = AotTestMask_unpack(plant.inputs[0]);
+        SeqNetAot_ctxRun(&aot, &in, AOT_TEST_RUN_STEPS, AotTestPlant_apply, &plant);
+
+        SeqNet_Ctx ref;
+        SeqNet_ctxInit(&ref, program);
+        ref.pc = start;
+        bool ok = (plant.count == AOT_TEST_RUN_STEPS);
+        for (uint32_t step = 0; ok && (step < AOT_TEST_RUN_STEPS); ++step)
+        {
+            const CondSel_In step_in = AotTestMask_unpack(plant.inputs[step]);
+            const SeqNet_Out ref_out = SeqNet_ctxStep(&ref, &step_in);
+            ok = (memcmp(&ref_out, &plant.outputs[step], sizeof(SeqNet_Out)) == 0);
+        }
+        ok = ok && (ref.pc == aot.pc);
+
+        if (!ok)
+        {
+            printf("    > Multi-step run from PC %u diverged\n", start);
+        }
+        LIFT_ASSERT(ok);
+        passed += ok;
+        ++checked;
+    }
+
+    // PC 255, past the program memory: the trap word halts every engine there
+    const SeqNet_Out trap = SeqNetInstruction_convert(SEQNET_TRAP_WORD);
+    {
+        memset(&plant, 0, sizeof(plant));
+        SeqNet_Ctx aot;
+        SeqNet_ctxInit(&aot, program);
+        aot.pc = SEQNET_PROGMEM_SIZE;
+        CondSel_In in = AotTestMask_unpack(CONDSEL_MASK_ALL);
+        const SeqNet_Out step_out = SeqNetAot_ctxStep(&aot, &in);
+        bool ok = (aot.pc == SEQNET_PROGMEM_SIZE) && (memcmp(&step_out, &trap, sizeof(SeqNet_Out)) == 0);
+        const SeqNet_Out loop_out = SeqNetAot_ctxLoop(&aot, true);
+        ok = ok && (aot.pc == SEQNET_PROGMEM_SIZE) && (memcmp(&loop_out, &trap, sizeof(SeqNet_Out)) == 0);
+        SeqNetAot_ctxRun(&aot, &in, 8, AotTestPlant_apply, &plant);
+        ok = ok && (aot.pc == SEQNET_PROGMEM_SIZE) && (plant.count == 8U) &&
+             (memcmp(&plant.outputs[7], &trap, sizeof(SeqNet_Out)) == 0);
+
+        // The interpreter it is checked against traps the same way
+        SeqNet_Ctx ref;
+        SeqNet_ctxInit(&ref, program);
+        ref.pc = SEQNET_PROGMEM_SIZE;
+        const SeqNet_Out ref_out = SeqNet_ctxStep(&ref, &in);
+        ok = ok && (ref.pc == SEQNET_PROGMEM_SIZE) && (memcmp(&ref_out, &trap, sizeof(SeqNet_Out)) == 0);
+
+        if (!ok)
+        {
+            printf("    > PC %u does not trap\n", SEQNET_PROGMEM_SIZE);
+        }
+        LIFT_ASSERT(ok);
+        passed += ok;
+        ++checked;
+    }
+
+    printf("[TEST] %zu/%zu checks matched.\n", passed, checked);
+}
+
+#endif // SEQNET_AOT_ENABLED
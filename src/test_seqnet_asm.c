@@ -0,0 +1,252 @@
+/**
+ * @file test_seqnet_asm.c
+ * @brief Unit tests of the microprogram assembler, disassembler and optimizer.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "seqnet_asm.h"
+#include "scenario_loader.h"
+#include "lift_check.h"
+#include "lift_plant.h"
+#include "test_lift.h"
+#include "lift_assert.h"
+
+#define SEQNET_ASM_TEST_TEXT_SIZE   (1U << 16)  // Listing buffer
+#define SEQNET_ASM_TEST_CAPACITY    (1U << 16)  // Visited set of the model check, power of two
+#define SEQNET_ASM_TEST_FLOORS      (6U)        // Floors of the model check
+
+static char SeqNetAsmTest_text[SEQNET_ASM_TEST_TEXT_SIZE];
+static SeqNetAsmProgram_t SeqNetAsmTest_source;
+static SeqNetAsmProgram_t SeqNetAsmTest_listed;
+static SeqNetAsmProgram_t SeqNetAsmTest_optimized;
+static SeqNet_Program SeqNetAsmTest_program;
+static SeqNet_Profile SeqNetAsmTest_profile;
+
+static uint64_t SeqNetAsmTest_keys[SEQNET_ASM_TEST_CAPACITY];
+static uint32_t SeqNetAsmTest_parents[SEQNET_ASM_TEST_CAPACITY];
+static uint32_t SeqNetAsmTest_current[SEQNET_ASM_TEST_CAPACITY];
+static uint32_t SeqNetAsmTest_next[SEQNET_ASM_TEST_CAPACITY];
+
+static const LiftCheckWorkspace_t SeqNetAsmTest_workspace = {
+    .keys = SeqNetAsmTest_keys,
+    .parents = SeqNetAsmTest_parents,
+    .current = SeqNetAsmTest_current,
+    .next = SeqNetAsmTest_next,
+    .capacity = SEQNET_ASM_TEST_CAPACITY
+};
+
+/// Scenario suite of the optimizer (@see LiftTestAll_run)
+static const LiftTestCase_t* const SeqNetAsmTest_cases[] = {
+    &test_case_already_open, &test_case_open_door_same_floor, &test_case_move_down, &test_case_move_up,
+    &test_case_multiple_calls, &test_case_idle, &test_case_reopen_during_close, &test_case_bottom_to_top,
+    &test_case_middle_stop, &test_case_up_two_floors, &test_case_down_two_floors, &test_case_all_calls
+};
+
+#define SEQNET_ASM_TEST_CASES (sizeof(SeqNetAsmTest_cases) / sizeof(SeqNetAsmTest_cases[0]))
+
+/**
+ * @brief Lists a program into SeqNetAsmTest_text and assembles the listing again.
+ */
+static bool SeqNetAsmTest_relist(const SeqNetAsmProgram_t* program, SeqNetAsmProgram_t* listed)
+{
+    FILE* file = tmpfile();
+    if (file == NULL) return false;
+
+    bool ok = SeqNetAsm_disassemble(program, file);
+    rewind(file);
+    const size_t length = fread(SeqNetAsmTest_text, 1, sizeof(SeqNetAsmTest_text) - 1U, file);
+    fclose(file);
+    SeqNetAsmTest_text[length] = '\0';
+
+    uint32_t line;
+    ok = ok && (length < sizeof(SeqNetAsmTest_text) - 1U) &&
+         (SeqNetAsm_assemble(SeqNetAsmTest_text, listed, &line) == SEQNET_ASM_OK) &&
+         (listed->count == program->count) &&
+         (memcmp(listed->words, program->words, sizeof(program->words)) == 0);
+    if (!ok)
+    {
+        printf("    > Listing does not assemble back (line %u)\n", line);
+    }
+    return ok;
+}
+
+/**
+ * @brief The default source assembles into the loaded program and survives a listing.
+ */
+static bool SeqNetAsmTest_default(void)
+{
+    uint32_t line;
+    ScenarioDefaultProgram_load();
+    bool ok = (SeqNetAsm_assemble(ScenarioDefaultProgram_source(), &SeqNetAsmTest_source, &line) == SEQNET_ASM_OK) &&
+              (memcmp(SeqNetAsmTest_source.words, SeqNetProgram_get()->words, sizeof(SeqNetAsmTest_source.words)) == 0) &&
+              SeqNetAsmTest_relist(&SeqNetAsmTest_source, &SeqNetAsmTest_listed);
+
+    // Labels and comments survive, the unlabelled words stay unlabelled
+    for (uint16_t pc = 0; ok && (pc < SeqNetAsmTest_source.count); ++pc)
+    {
+        ok = (strcmp(SeqNetAsmTest_source.symbols[pc], SeqNetAsmTest_listed.symbols[pc]) == 0) &&
+             (strcmp(SeqNetAsmTest_source.comments[pc], SeqNetAsmTest_listed.comments[pc]) == 0) &&
+             (SeqNetAsmTest_source.comments[pc][0] != '\0');
+    }
+    return ok;
+}
+
+/**
+ * @brief Every word with a jump inside the program memory lists and assembles back.
+ */
+static bool SeqNetAsmTest_everyWord(uint32_t* words)
+{
+    uint16_t block[SEQNET_PROGMEM_SIZE];
+    uint16_t count = 0;
+    bool ok = true;
+    *words = 0;
+
+    for (uint32_t word = 0; ok && (word <= 0xFFFFU); ++word)
+    {
+        if (((word >> BIT_JUMP_ADDR) & MASK_JUMP_ADDR) < SEQNET_PROGMEM_SIZE)
+        {
+            block[count++] = (uint16_t)word;
+            ++(*words);
+        }
+        if ((count == SEQNET_PROGMEM_SIZE) || ((word == 0xFFFFU) && (count != 0)))
+        {
+            SeqNetAsmProgram_init(&SeqNetAsmTest_source, block, count);
+            ok = SeqNetAsmTest_relist(&SeqNetAsmTest_source, &SeqNetAsmTest_listed);
+            count = 0;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Malformed sources are rejected with the right status and line.
+ */
+static bool SeqNetAsmTest_errors(void)
+{
+    static const struct {
+        const char* source;
+        SeqNetAsmStatus_t status;
+        uint32_t line;
+    } cases[] = {
+        { "a: open goto b\n",                                   SEQNET_ASM_UNKNOWN_LABEL,   1 },
+        { "a: open\n; comment\na: close goto a\n",              SEQNET_ASM_DUPLICATE_LABEL, 3 },
+        { "a:\nb: open goto a\n",                               SEQNET_ASM_DUPLICATE_LABEL, 2 },
+        { "open\nopen goto 255\n",                              SEQNET_ASM_BAD_TARGET,      2 },
+        { "open close\n",                                       SEQNET_ASM_SYNTAX,          1 },
+        { "open goto 0 if pend_nowhere\n",                      SEQNET_ASM_SYNTAX,          1 },
+        { "open up up\n",                                       SEQNET_ASM_SYNTAX,          1 },
+        { "goto: open\n",                                       SEQNET_ASM_SYNTAX,          1 },
+        { "open\nend:\n",                                       SEQNET_ASM_SYNTAX,          2 },
+        { "a_label_much_longer_than_the_limit: open\n",         SEQNET_ASM_TOO_LONG,        1 },
+    };
+
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        uint32_t line;
+        const SeqNetAsmStatus_t status = SeqNetAsm_assemble(cases[i].source, &SeqNetAsmTest_source, &line);
+        if ((status != cases[i].status) || (line != cases[i].line))
+        {
+            printf("    > Case %zu: %s at line %u\n", i, SeqNetAsmStatus_name(status), line);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Optimizes the default program: the suite still passes, the model check still
+ *        holds and the trips take fewer micro-steps.
+ */
+static bool SeqNetAsmTest_optimize(SeqNetAsmReport_t* report, uint32_t* before, uint32_t* after)
+{
+    uint32_t line;
+    bool ok = (SeqNetAsm_assemble(ScenarioDefaultProgram_source(), &SeqNetAsmTest_source, &line) == SEQNET_ASM_OK);
+
+    // Profile of the suite and the preset PCs, which stay entry points
+    const SeqNet_Program* reference = SeqNetProgram_get();
+    uint8_t entries[SEQNET_ASM_TEST_CASES];
+    uint32_t served[SEQNET_ASM_TEST_CASES];
+    uint32_t optimized[SEQNET_ASM_TEST_CASES];
+    for (size_t i = 0; i < SEQNET_ASM_TEST_CASES; ++i)
+    {
+        entries[i] = SeqNetAsmTest_cases[i]->PC_preset;
+    }
+    SeqNetProfile_reset(&SeqNetAsmTest_profile);
+    *before = SeqNetAsm_measure(reference, SeqNetAsmTest_cases, NULL, SEQNET_ASM_TEST_CASES, &SeqNetAsmTest_profile, served);
+
+    ok = ok && (SeqNetAsm_optimize(&SeqNetAsmTest_source, entries, SEQNET_ASM_TEST_CASES, &SeqNetAsmTest_profile,
+                                   &SeqNetAsmTest_optimized, report) == SEQNET_ASM_OK) &&
+         SeqNetAsmTest_relist(&SeqNetAsmTest_optimized, &SeqNetAsmTest_listed);
+    memcpy(SeqNetAsmTest_program.words, SeqNetAsmTest_optimized.words, sizeof(SeqNetAsmTest_program.words));
+    SeqNetProgram_decode(&SeqNetAsmTest_program);
+
+    // Every case passes within its own step budget, and serves sooner or as soon
+    for (size_t i = 0; ok && (i < SEQNET_ASM_TEST_CASES); ++i)
+    {
+        entries[i] = report->map[entries[i]];
+        ok = (entries[i] != SEQNET_ASM_PC_NONE);
+    }
+    *after = ok ? SeqNetAsm_measure(&SeqNetAsmTest_program, SeqNetAsmTest_cases, entries, SEQNET_ASM_TEST_CASES,
+                                    NULL, optimized) : 0;
+    for (size_t i = 0; ok && (i < SEQNET_ASM_TEST_CASES); ++i)
+    {
+        LiftTestCase_t test = *SeqNetAsmTest_cases[i];
+        LiftTestResult_t result;
+        test.PC_preset = entries[i];
+        ok = LiftTestCase_exec(&test, &SeqNetAsmTest_program, &result) && (optimized[i] <= served[i]);
+    }
+
+    // Same safety and service guarantees as the source for every reachable state
+    LiftCheckConfig_t config = { .floors = SEQNET_ASM_TEST_FLOORS, .arrivals = true, .service_bound = 256, .threads = 1 };
+    LiftCheckState_t initial;
+    LiftCheckResult_t result;
+    memset(&initial, 0, sizeof(initial));
+    LiftCheck_run(&SeqNetAsmTest_program, &config, &initial, &SeqNetAsmTest_workspace, &result);
+    if (ok && (result.verdict != LIFT_CHECK_OK))
+    {
+        printf("    > Model check verdict %d\n", (int)result.verdict);
+    }
+    return ok && (result.verdict == LIFT_CHECK_OK) && (*after < *before) && (report->words_after < report->words_before);
+}
+
+/**
+ * @brief Assembles, lists and optimizes microprograms.
+ */
+void SeqNetAsmAllCases_test(void)
+{
+    printf("[TEST] Running SeqNetAsm cases...\n");
+
+    size_t passed = 0;
+    bool ok;
+
+    ok = SeqNetAsmTest_default();
+    printf("  - %-40s ... %s\n", "default source assembles and relists", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    uint32_t words = 0;
+    ok = SeqNetAsmTest_everyWord(&words);
+    printf("  - %-40s ... %s (%u words)\n", "every word relists exactly", ok ? "OK" : "FAIL", words);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    ok = SeqNetAsmTest_errors();
+    printf("  - %-40s ... %s\n", "malformed sources are rejected", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    SeqNetAsmReport_t report;
+    uint32_t before = 0, after = 0;
+    ok = SeqNetAsmTest_optimize(&report, &before, &after);
+    printf("  - %-40s ... %s (%u -> %u words, %.2f -> %.2f steps per trip)\n", "optimized default program checks",
+           ok ? "OK" : "FAIL", (unsigned)report.words_before, (unsigned)report.words_after,
+           (double)before / (double)SEQNET_ASM_TEST_CASES, (double)after / (double)SEQNET_ASM_TEST_CASES);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/4 assembler cases passed.\n", passed);
+}
@@ -0,0 +1,141 @@
+/**
+ * @file test_seqnet_batch.c
+ * @brief Cross-check of the batch stepping kernels against the single-context step.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_batch.h"
+#include "seqnet_internal.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+/// Number of cars in the test batch (not a multiple of 8 to exercise the scalar tail)
+#define BATCH_TEST_CARS  (203U)
+
+/// Number of steps executed per kernel
+#define BATCH_TEST_STEPS (64U)
+
+/**
+ * @brief Runs all kernels over a random program and random inputs, comparing with SeqNet_ctxStepRaw().
+ */
+void SeqNetBatchAllCases_test(void)
+{
+    printf("[TEST] Running SeqNetBatch_step() kernel cross-check...\n");
+
+    static SeqNet_Program program;
+    static SeqNetBatch_t batch;
+    static uint8_t pc[BATCH_TEST_CARS];
+    static CondSel_Mask in[BATCH_TEST_CARS];
+    static uint16_t out[BATCH_TEST_CARS];
+    static SeqNet_Ctx ref[BATCH_TEST_CARS];
+
+    uint32_t seed = 0x5EED1234U;
+
+    // Random program: any selector, inversion, outputs and jump target, the trap row included
+    for (uint16_t i = 0; i < SEQNET_PROGMEM_SIZE; ++i)
+    {
+        program.words[i] = (uint16_t)LiftRandom_next32(&seed);
+    }
+    SeqNetProgram_decode(&program);
+
+    const SeqNetBatchKernel_t kernels[] = {
+        SEQNET_BATCH_KERNEL_SCALAR,
+        SEQNET_BATCH_KERNEL_SSE41,
+        SEQNET_BATCH_KERNEL_AVX2
+    };
+
+    size_t passed = 0;
+    size_t num_tests = 0;
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k)
+    {
+        SeqNetBatch_init(&batch, &program, pc, in, out, BATCH_TEST_CARS);
+        SeqNetBatchKernel_t selected = SeqNetBatch_select(&batch, kernels[k]);
+
+        for (uint32_t car = 0; car < BATCH_TEST_CARS; ++car)
+        {
+            SeqNet_ctxInit(&ref[car], &program);
+            ref[car].pc = (uint8_t)(LiftRandom_next32(&seed) % SEQNET_PC_COUNT);
+            pc[car] = ref[car].pc;
+        }
+
+        bool ok = true;
+        for (uint32_t step = 0; step < BATCH_TEST_STEPS; ++step)
+        {
+            for (uint32_t car = 0; car < BATCH_TEST_CARS; ++car)
+            {
+                in[car] = (CondSel_Mask)(LiftRandom_next32(&seed) & CONDSEL_MASK_ALL);
+            }
+
+            SeqNetBatch_step(&batch);
+
+            for (uint32_t car = 0; car < BATCH_TEST_CARS; ++car)
+            {
+                const CondSel_In cond_in = {
+                    .call_pending_below = (in[car] & CONDSEL_MASK_BELOW) != 0,
+                    .call_pending_same  = (in[car] & CONDSEL_MASK_SAME) != 0,
+                    .call_pending_above = (in[car] & CONDSEL_MASK_ABOVE) != 0,
+                    .door_closed        = (in[car] & CONDSEL_MASK_CLOSED) != 0,
+                    .door_open          = (in[car] & CONDSEL_MASK_OPEN) != 0
+                };
+                const uint16_t expected = SeqNet_ctxStepRaw(&ref[car], &cond_in);
+
+                if ((out[car] != expected) || (pc[car] != ref[car].pc))
+                {
+                    if (ok)
+                    {
+                        printf("    > step %u, car %u: expected PC 0x%02X out 0x%04X, got PC 0x%02X out 0x%04X\n",
+                               (unsigned)step, (unsigned)car, ref[car].pc, expected, pc[car], out[car]);
+                    }
+                    ok = false;
+                }
+            }
+        }
+
+        printf("  - %-40s ... %s\n", SeqNetBatchKernel_name(selected), ok ? "OK" : "FAIL");
+        LIFT_ASSERT(ok);
+        passed += ok;
+        ++num_tests;
+    }
+
+    // Jump to 255, past the program memory: every kernel halts on the trap row, like the interpreter
+    memset(&program, 0, sizeof(program));
+    program.words[0] = (uint16_t)((1U << BIT_COND_INV) | (7U << BIT_COND_SEL) | (1U << BIT_MOVE_UP) | 0xFFU);
+    SeqNetProgram_decode(&program);
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k)
+    {
+        SeqNetBatch_init(&batch, &program, pc, in, out, BATCH_TEST_CARS);
+        SeqNetBatchKernel_t selected = SeqNetBatch_select(&batch, kernels[k]);
+        memset(pc, 0, sizeof(pc));
+        memset(in, CONDSEL_MASK_ALL, sizeof(in));
+        SeqNet_Ctx trapped;
+        SeqNet_ctxInit(&trapped, &program);
+        const CondSel_In all = {
+            .call_pending_below = true, .call_pending_same = true, .call_pending_above = true,
+            .door_closed = true, .door_open = true
+        };
+
+        bool ok = true;
+        for (uint32_t step = 0; step < 3U; ++step)
+        {
+            SeqNetBatch_step(&batch);
+            const uint16_t expected = (step == 0) ? program.words[0] : (uint16_t)SEQNET_TRAP_WORD;
+            ok = ok && (SeqNet_ctxStepRaw(&trapped, &all) == expected) && (trapped.pc == 0xFFU);
+            for (uint32_t car = 0; car < BATCH_TEST_CARS; ++car)
+            {
+                ok = ok && (pc[car] == 0xFFU) && (out[car] == expected);
+            }
+        }
+
+        char name[48];
+        snprintf(name, sizeof(name), "%s, jump to 255 traps", SeqNetBatchKernel_name(selected));
+        printf("  - %-40s ... %s\n", name, ok ? "OK" : "FAIL");
+        LIFT_ASSERT(ok);
+        passed += ok;
+        ++num_tests;
+    }
+
+    printf("[TEST] %zu/%zu kernels passed.\n", passed, num_tests);
+}
@@ -0,0 +1,246 @@
+/**
+ * @file test_seqnet_image.c
+ * @brief Unit tests of the binary program images.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "seqnet_image.h"
+#include "scenario_loader.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+#define SEQNET_IMAGE_TEST_FILE      "seqnet_image_test.bin"   // Scratch file, removed by the test
+#define SEQNET_IMAGE_TEST_PROGRAMS  (4096U)     // Images of the container case
+#define SEQNET_IMAGE_TEST_WORDS     (16U)       // Words of the default program
+#define SEQNET_IMAGE_TEST_SMALL     (8U)        // Images of the corruption case
+#define SEQNET_IMAGE_TEST_BUFFER    (4096U)     // Memory copy of the small container
+
+static uint8_t SeqNetImageTest_directory[SEQNET_IMAGE_TEST_PROGRAMS * SEQNET_IMAGE_ENTRY_SIZE];
+static uint16_t SeqNetImageTest_words[SEQNET_IMAGE_TEST_PROGRAMS][SEQNET_IMAGE_TEST_WORDS];
+static uint8_t SeqNetImageTest_buffer[SEQNET_IMAGE_TEST_BUFFER];
+
+/// Labels of the default program
+static const char* const SeqNetImageTest_symbols[SEQNET_IMAGE_TEST_WORDS] = {
+    "idle", NULL, "dispatch", "close", "wait_closed", NULL, NULL, "up",
+    "wait_up", NULL, "down", "wait_down", NULL, "open", "wait_open", "served"
+};
+
+/// Comments of the default program
+static const char* const SeqNetImageTest_comments[SEQNET_IMAGE_TEST_WORDS] = {
+    "Any pending call: dispatch it", "Idle loop", "Call on the same floor: open the door",
+    "Close the door", "Wait until the door is closed", "Call below: move down", "No call above: idle",
+    "Move up", "Wait until a called floor is reached", "Stop", "Move down",
+    "Wait until a called floor is reached", "Stop", "Open the door", "Wait until the door is open",
+    "Reset the served call"
+};
+
+/**
+ * @brief Writes the first @p count programs of SeqNetImageTest_words into a file.
+ */
+static SeqNetImageStatus_t SeqNetImageTest_write(FILE* file, uint32_t count, bool sections)
+{
+    SeqNetImageWriter_t writer;
+    SeqNetImageStatus_t status = SeqNetImageWriter_begin(&writer, file, SeqNetImageTest_directory, count);
+    for (uint32_t i = 0; (i < count) && (status == SEQNET_IMAGE_OK); ++i)
+    {
+        status = SeqNetImageWriter_add(&writer, SeqNetImageTest_words[i], SEQNET_IMAGE_TEST_WORDS,
+                                       sections ? SeqNetImageTest_symbols : NULL,
+                                       sections ? SeqNetImageTest_comments : NULL);
+    }
+    return (status == SEQNET_IMAGE_OK) ? SeqNetImageWriter_end(&writer) : status;
+}
+
+/**
+ * @brief Writes the default program with its sections, maps it back and installs it.
+ */
+static bool SeqNetImageTest_roundTrip(void)
+{
+    ScenarioDefaultProgram_load();
+    const SeqNet_Program* reference = SeqNetProgram_get();
+    memcpy(SeqNetImageTest_words[0], reference->words, sizeof(SeqNetImageTest_words[0]));
+
+    FILE* out = fopen(SEQNET_IMAGE_TEST_FILE, "wb");
+    if (out == NULL) return false;
+    bool ok = (SeqNetImageTest_write(out, 1U, true) == SEQNET_IMAGE_OK);
+    ok = (fclose(out) == 0) && ok;
+
+    SeqNetImageFile_t file;
+    SeqNetImage_t image;
+    SeqNet_Program program;
+    ok = ok && (SeqNetImageFile_open(&file, SEQNET_IMAGE_TEST_FILE) == SEQNET_IMAGE_OK);
+    if (ok)
+    {
+        ok = (file.count == 1U) && (SeqNetImage_get(&file, 0, &image) == SEQNET_IMAGE_OK) &&
+             (image.word_count == SEQNET_IMAGE_TEST_WORDS) && (image.id == reference->id) &&
+             (SeqNetImage_load(&file, 0, &program) == SEQNET_IMAGE_OK) &&
+             (memcmp(program.words, reference->words, sizeof(program.words)) == 0) &&
+             (memcmp(program.decoded, reference->decoded, sizeof(program.decoded)) == 0);
+
+        for (uint8_t pc = 0; ok && (pc < SEQNET_IMAGE_TEST_WORDS); ++pc)
+        {
+            const char* symbol = SeqNetImage_text(image.symbols, image.symbols_size, pc);
+            const char* comment = SeqNetImage_text(image.comments, image.comments_size, pc);
+            ok = ((SeqNetImageTest_symbols[pc] == NULL) ? (symbol == NULL)
+                                                        : ((symbol != NULL) && (strcmp(symbol, SeqNetImageTest_symbols[pc]) == 0))) &&
+                 (comment != NULL) && (strcmp(comment, SeqNetImageTest_comments[pc]) == 0);
+        }
+        ok = ok && (SeqNetImage_text(image.symbols, image.symbols_size, SEQNET_IMAGE_TEST_WORDS) == NULL);
+
+        // Installing the image must leave the same program in the memory
+        SeqNetProgramMemory_get()[0] ^= 1U;
+        ok = ok && (SeqNetImage_install(&file, 0) == SEQNET_IMAGE_OK) &&
+             (memcmp(SeqNetProgram_get()->decoded, reference->decoded, sizeof(reference->decoded)) == 0) &&
+             (SeqNetImage_get(&file, 1U, &image) == SEQNET_IMAGE_NO_IMAGE);
+        SeqNetImageFile_close(&file);
+    }
+    remove(SEQNET_IMAGE_TEST_FILE);
+    ScenarioDefaultProgram_load();
+    return ok;
+}
+
+/**
+ * @brief Fills SeqNetImageTest_words with mutants of the default program.
+ */
+static void SeqNetImageTest_mutate(uint32_t count)
+{
+    uint32_t seed = 0x5EC0DE5U;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        memcpy(SeqNetImageTest_words[i], SeqNetProgram_get()->words, sizeof(SeqNetImageTest_words[i]));
+
+        // Retarget a jump and change a condition, the program stays inside the image
+        uint16_t* word = &SeqNetImageTest_words[i][LiftRandom_next32(&seed) % SEQNET_IMAGE_TEST_WORDS];
+        *word = (uint16_t)((*word & ~(MASK_JUMP_ADDR << BIT_JUMP_ADDR)) |
+                           ((LiftRandom_next32(&seed) % SEQNET_IMAGE_TEST_WORDS) << BIT_JUMP_ADDR));
+        word = &SeqNetImageTest_words[i][LiftRandom_next32(&seed) % SEQNET_IMAGE_TEST_WORDS];
+        *word ^= (uint16_t)(LiftRandom_next32(&seed) & 0xFF00U);
+    }
+}
+
+/**
+ * @brief Writes thousands of programs into one container and loads every one of them.
+ */
+static bool SeqNetImageTest_container(size_t* file_size)
+{
+    SeqNetImageTest_mutate(SEQNET_IMAGE_TEST_PROGRAMS);
+
+    FILE* out = fopen(SEQNET_IMAGE_TEST_FILE, "wb");
+    if (out == NULL) return false;
+    bool ok = (SeqNetImageTest_write(out, SEQNET_IMAGE_TEST_PROGRAMS, false) == SEQNET_IMAGE_OK);
+    ok = (fclose(out) == 0) && ok;
+
+    SeqNetImageFile_t file;
+    ok = ok && (SeqNetImageFile_open(&file, SEQNET_IMAGE_TEST_FILE) == SEQNET_IMAGE_OK);
+    if (ok)
+    {
+        *file_size = file.size;
+        ok = (file.count == SEQNET_IMAGE_TEST_PROGRAMS);
+        for (uint32_t i = 0; ok && (i < SEQNET_IMAGE_TEST_PROGRAMS); ++i)
+        {
+            SeqNet_Program program, expected;
+            memset(expected.words, 0, sizeof(expected.words));
+            memcpy(expected.words, SeqNetImageTest_words[i], sizeof(SeqNetImageTest_words[i]));
+            SeqNetProgram_decode(&expected);
+
+            ok = (SeqNetImage_load(&file, i, &program) == SEQNET_IMAGE_OK) &&
+                 (program.id == expected.id) &&
+                 (memcmp(program.words, expected.words, sizeof(expected.words)) == 0);
+        }
+        SeqNetImageFile_close(&file);
+    }
+    remove(SEQNET_IMAGE_TEST_FILE);
+    return ok;
+}
+
+/**
+ * @brief Damages a small container in memory, every damage must be reported.
+ */
+static bool SeqNetImageTest_corruption(void)
+{
+    FILE* out = tmpfile();
+    if (out == NULL) return false;
+    bool ok = (SeqNetImageTest_write(out, SEQNET_IMAGE_TEST_SMALL, false) == SEQNET_IMAGE_OK);
+    rewind(out);
+    const size_t size = fread(SeqNetImageTest_buffer, 1, sizeof(SeqNetImageTest_buffer), out);
+    fclose(out);
+    ok = ok && (size > SEQNET_IMAGE_HEADER_SIZE) && (size < sizeof(SeqNetImageTest_buffer));
+
+    SeqNetImageFile_t file;
+    SeqNetImage_t image;
+    SeqNet_Program program;
+    ok = ok && (SeqNetImageFile_openMemory(&file, SeqNetImageTest_buffer, size) == SEQNET_IMAGE_OK);
+
+    // A damaged image is only reported when it is loaded, the others stay usable
+    const size_t image_byte = size - 3U;
+    SeqNetImageTest_buffer[image_byte] ^= 0x10U;
+    ok = ok && (SeqNetImageFile_openMemory(&file, SeqNetImageTest_buffer, size) == SEQNET_IMAGE_OK) &&
+         (SeqNetImage_load(&file, SEQNET_IMAGE_TEST_SMALL - 1U, &program) == SEQNET_IMAGE_BAD_CHECKSUM) &&
+         (SeqNetImage_load(&file, 0, &program) == SEQNET_IMAGE_OK) &&
+         (SeqNetImage_get(&file, SEQNET_IMAGE_TEST_SMALL, &image) == SEQNET_IMAGE_NO_IMAGE);
+    SeqNetImageTest_buffer[image_byte] ^= 0x10U;
+
+    // Header and directory
+    SeqNetImageTest_buffer[SEQNET_IMAGE_HEADER_SIZE + 5U] ^= 0x01U;
+    ok = ok && (SeqNetImageFile_openMemory(&file, SeqNetImageTest_buffer, size) == SEQNET_IMAGE_BAD_CHECKSUM);
+    SeqNetImageTest_buffer[SEQNET_IMAGE_HEADER_SIZE + 5U] ^= 0x01U;
+    SeqNetImageTest_buffer[0] ^= 0xFFU;
+    ok = ok && (SeqNetImageFile_openMemory(&file, SeqNetImageTest_buffer, size) == SEQNET_IMAGE_BAD_MAGIC);
+    SeqNetImageTest_buffer[0] ^= 0xFFU;
+    SeqNetImageTest_buffer[4] ^= 0x02U;
+    ok = ok && (SeqNetImageFile_openMemory(&file, SeqNetImageTest_buffer, size) == SEQNET_IMAGE_BAD_VERSION);
+    SeqNetImageTest_buffer[4] ^= 0x02U;
+
+    // Truncated inside the header, the directory and the last image
+    ok = ok && (SeqNetImageFile_openMemory(&file, SeqNetImageTest_buffer, SEQNET_IMAGE_HEADER_SIZE - 1U) == SEQNET_IMAGE_TRUNCATED) &&
+         (SeqNetImageFile_openMemory(&file, SeqNetImageTest_buffer, SEQNET_IMAGE_HEADER_SIZE + 8U) == SEQNET_IMAGE_TRUNCATED) &&
+         (SeqNetImageFile_openMemory(&file, SeqNetImageTest_buffer, size - 1U) == SEQNET_IMAGE_OK) &&
+         (SeqNetImage_get(&file, SEQNET_IMAGE_TEST_SMALL - 1U, &image) == SEQNET_IMAGE_TRUNCATED);
+
+    // The writer rejects what the loader could not run and a full directory
+    out = tmpfile();
+    if (out == NULL) return false;
+    SeqNetImageWriter_t writer;
+    uint16_t words[SEQNET_IMAGE_TEST_WORDS];
+    memcpy(words, SeqNetImageTest_words[0], sizeof(words));
+    words[3] |= (uint16_t)(MASK_JUMP_ADDR << BIT_JUMP_ADDR);
+    ok = ok && (SeqNetImageWriter_begin(&writer, out, SeqNetImageTest_directory, 1U) == SEQNET_IMAGE_OK) &&
+         (SeqNetImageWriter_add(&writer, words, SEQNET_IMAGE_TEST_WORDS, NULL, NULL) == SEQNET_IMAGE_BAD_PROGRAM) &&
+         (SeqNetImageWriter_add(&writer, SeqNetImageTest_words[0], SEQNET_IMAGE_TEST_WORDS, NULL, NULL) == SEQNET_IMAGE_OK) &&
+         (SeqNetImageWriter_add(&writer, SeqNetImageTest_words[0], SEQNET_IMAGE_TEST_WORDS, NULL, NULL) == SEQNET_IMAGE_FULL) &&
+         (SeqNetImageWriter_end(&writer) == SEQNET_IMAGE_OK);
+    fclose(out);
+    return ok;
+}
+
+/**
+ * @brief Round-trips program images through mapped files and checks the corruption detection.
+ */
+void SeqNetImageAllCases_test(void)
+{
+    printf("[TEST] Running SeqNetImage cases...\n");
+
+    size_t passed = 0;
+    bool ok;
+
+    ok = SeqNetImageTest_roundTrip();
+    printf("  - %-40s ... %s\n", "default program with sections round-trips", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    size_t file_size = 0;
+    ok = SeqNetImageTest_container(&file_size);
+    printf("  - %-40s ... %s (%u images, %zu bytes)\n", "container of mutants loads every image", ok ? "OK" : "FAIL",
+           SEQNET_IMAGE_TEST_PROGRAMS, file_size);
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    ok = SeqNetImageTest_corruption();
+    printf("  - %-40s ... %s\n", "corruption and truncation are detected", ok ? "OK" : "FAIL");
+    LIFT_ASSERT(ok);
+    passed += ok;
+
+    printf("[TEST] %zu/3 image cases passed.\n", passed);
+}
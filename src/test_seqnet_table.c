@@ -0,0 +1,133 @@
+/**
+ * @file test_seqnet_table.c
+ * @brief Unit tests of the precomputed transition table.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "seqnet_table.h"
+#include "lift_random.h"
+#include "lift_assert.h"
+
+/**
+ * @brief Unpacks a condition input mask.
+ */
+static CondSel_In SeqNetTableTest_unpack(const CondSel_Mask mask)
+{
+    const CondSel_In in = {
+        .call_pending_below = (mask & CONDSEL_MASK_BELOW) != 0,
+        .call_pending_same  = (mask & CONDSEL_MASK_SAME) != 0,
+        .call_pending_above = (mask & CONDSEL_MASK_ABOVE) != 0,
+        .door_closed        = (mask & CONDSEL_MASK_CLOSED) != 0,
+        .door_open          = (mask & CONDSEL_MASK_OPEN) != 0
+    };
+    return in;
+}
+
+/**
+ * @brief Verifies the table-driven step against the interpreter for every PC and input mask.
+ */
+void SeqNetTableAllCases_test(void)
+{
+    printf("[TEST] Running SeqNetTable_step() cross-check...\n");
+
+    static SeqNet_Program program;
+    static SeqNetTable_t table;
+
+    // One instruction per selector and inversion, the rest random-ish (jumps to the trap row included)
+    uint32_t seed = 0xC0FFEEU;
+    for (uint16_t i = 0; i < SEQNET_PROGMEM_SIZE; ++i)
+    {
+        LiftRandom_next32(&seed);
+        program.words[i] = (uint16_t)(((i & 0xF) << BIT_COND_SEL) | ((seed >> 8) & 0x0F00) | ((seed >> 16) % SEQNET_PC_COUNT));
+    }
+    SeqNetProgram_decode(&program);
+    SeqNetTable_build(&table, &program);
+
+    size_t checked = 0;
+    size_t passed = 0;
+
+    for (uint16_t pc = 0; pc < SEQNET_PC_COUNT; ++pc)
+    {
+        for (uint8_t mask = 0; mask < CONDSEL_MASK_COUNT; ++mask)
+        {
+            const CondSel_In in = SeqNetTableTest_unpack(mask);
+
+            SeqNet_Ctx ref;
+            SeqNet_ctxInit(&ref, &program);
+            ref.pc = (uint8_t)pc;
+            const uint16_t ref_out = SeqNet_ctxStepRaw(&ref, &in);
+
+            uint8_t table_pc = (uint8_t)pc;
+            const uint16_t table_out = SeqNetTable_step(&table, &table_pc, mask);
+
+            bool ok = (table_pc == ref.pc) && (table_out == ref_out);
+            if (!ok)
+            {
+                printf("    > PC %u, inputs 0x%02X: expected PC %u, got %u\n", pc, mask, ref.pc, table_pc);
+            }
+            LIFT_ASSERT(ok);
+            passed += ok;
+            ++checked;
+        }
+    }
+
+    // Dependencies follow the selector: any pending, one signal, or nothing
+    const CondSel_Mask expected_deps[8] = {
+        CONDSEL_MASK_PENDING, CONDSEL_MASK_BELOW, CONDSEL_MASK_SAME, CONDSEL_MASK_ABOVE,
+        CONDSEL_MASK_CLOSED, CONDSEL_MASK_OPEN, 0, 0
+    };
+    for (uint8_t pc = 0; pc < 16; ++pc)
+    {
+        const SeqNet_Out* instr = &program.decoded[pc];
+        const uint8_t fall_through = (uint8_t)(pc + 1);
+        const CondSel_Mask expected = (instr->jump_addr == fall_through) ? 0 : expected_deps[instr->cond_sel];
+
+        bool ok = (SeqNetTable_dependency(&table, pc) == expected);
+        if (!ok)
+        {
+            printf("    > PC %u: dependency 0x%02X, expected 0x%02X\n", pc, SeqNetTable_dependency(&table, pc), expected);
+        }
+        LIFT_ASSERT(ok);
+        passed += ok;
+        ++checked;
+    }
+
+    // A jump to 255, past the program memory, halts on the trap row, in the table and in the interpreter
+    program.words[0] = (uint16_t)((1U << BIT_COND_INV) | (7U << BIT_COND_SEL) | (1U << BIT_DOOR_STATE) | 0xFFU);
+    SeqNetProgram_decode(&program);
+    SeqNetTable_build(&table, &program);
+    {
+        static SeqNet_Profile profile;
+        SeqNetProfile_reset(&profile);
+        SeqNet_Ctx ref;
+        SeqNet_ctxInit(&ref, &program);
+        SeqNet_ctxProfile(&ref, &profile);
+
+        const CondSel_In none = SeqNetTableTest_unpack(0);
+        uint8_t table_pc = 0;
+        bool ok = (SeqNetTable_step(&table, &table_pc, 0) == program.words[0]) && (table_pc == 0xFFU);
+        ok = ok && (SeqNet_ctxStepRaw(&ref, &none) == program.words[0]) && (ref.pc == 0xFFU);
+        for (uint8_t mask = 0; mask < CONDSEL_MASK_COUNT; ++mask)
+        {
+            const CondSel_In in = SeqNetTableTest_unpack(mask);
+            ok = ok && (SeqNetTable_step(&table, &table_pc, mask) == SEQNET_TRAP_WORD) && (table_pc == 0xFFU);
+            ok = ok && (SeqNet_ctxStepRaw(&ref, &in) == SEQNET_TRAP_WORD) && (ref.pc == 0xFFU);
+        }
+        ok = ok && (SeqNetTable_dependency(&table, 0xFFU) == 0);
+#if SEQNET_PROFILE_ENABLED
+        ok = ok && (profile.hits[0xFF] == CONDSEL_MASK_COUNT) && (profile.taken[0xFF] == CONDSEL_MASK_COUNT);
+#endif
+        if (!ok)
+        {
+            printf("    > PC 255 does not trap\n");
+        }
+        LIFT_ASSERT(ok);
+        passed += ok;
+        ++checked;
+    }
+
+    printf("[TEST] %zu/%zu checks matched.\n", passed, checked);
+}
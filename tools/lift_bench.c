@@ -0,0 +1,379 @@
+/**
+ * @file lift_bench.c
+ * @brief Microbenchmarks of the controller hot path.
+ *
+ * Usage: lift_bench [results.json]
+ * Every benchmark is repeated LIFT_BENCH_REPEATS times; the mean, standard deviation
+ * and minimum of the time per operation are printed and written as JSON, tagged with
+ * the git hash, so results can be compared across commits.
+ */
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 199309L  // clock_gettime()
+#endif
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "version.h"
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "condsel.h"
+#include "lift_plant.h"
+#include "lift_group.h"
+#include "lift_motion.h"
+#include "lift_random.h"
+#include "scenario_loader.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define LIFT_BENCH_REPEATS              (10U)        // Measured runs per benchmark
+#define LIFT_BENCH_ITERATIONS           (4000000U)   // Operations per run
+#define LIFT_BENCH_CALL_PERIOD          (64U)        // Steps between injected calls in the plant benchmarks
+#define LIFT_BENCH_GROUP_CARS           (16U)        // Cars of the dispatch benchmark (LIFT_MAX_FLOORS floors, 128 in the bench build)
+#define LIFT_BENCH_MOTION_CARS          (4096U)      // Cars of the motion integration benchmark
+
+/// Keeps the results of the measured loops alive
+static volatile uint64_t LiftBench_sink;
+
+/**
+ * @brief Benchmark body: executes @p iterations operations, returns a checksum.
+ */
+typedef uint64_t (*LiftBench_Fn)(uint32_t iterations);
+
+/**
+ * @brief Benchmark entry and its statistics.
+ */
+typedef struct
+{
+    const char* name;
+    LiftBench_Fn fn;
+    double mean_ns;     ///< Mean time per operation
+    double stddev_ns;   ///< Standard deviation of the time per operation
+    double min_ns;      ///< Best run
+} LiftBench_t;
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ */
+static uint64_t LiftBench_now(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// === Benchmarks ===
+
+static uint64_t LiftBench_seqNetLoop(uint32_t iterations)
+{
+    uint64_t sum = 0;
+    SeqNet_init();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        sum += SeqNet_loop((i & 3U) == 0).jump_addr;
+    }
+    return sum;
+}
+
+static uint64_t LiftBench_instructionConvert(uint32_t iterations)
+{
+    const uint16_t* words = SeqNetProgram_get()->words;
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        sum += SeqNetInstruction_convert(words[i & 15U]).jump_addr;
+    }
+    return sum;
+}
+
+static uint64_t LiftBench_outConvert(uint32_t iterations)
+{
+    const SeqNet_Out* decoded = SeqNetProgram_get()->decoded;
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        sum += SeqNetOut_convert(&decoded[i & 15U]);
+    }
+    return sum;
+}
+
+static uint64_t LiftBench_condSelCalc(uint32_t iterations)
+{
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        const CondSel_In in = {
+            .call_pending_below = (i >> 4) & 1U,
+            .call_pending_same  = (i >> 5) & 1U,
+            .call_pending_above = (i >> 6) & 1U,
+            .door_closed        = !((i >> 7) & 1U),
+            .door_open          = (i >> 7) & 1U
+        };
+        sum += CondSel_calc((i >> 3) & 1U, (uint8_t)(i & 7U), in);
+    }
+    return sum;
+}
+
+static uint64_t LiftBench_condSelCalcMask(uint32_t iterations)
+{
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        sum += CondSel_calcMask((i >> 3) & 1U, (uint8_t)(i & 7U), (CondSel_Mask)((i >> 4) & CONDSEL_MASK_ALL));
+    }
+    return sum;
+}
+
+static uint64_t LiftBench_stateConvert(uint32_t iterations)
+{
+    LiftState_t state;
+    CondSel_In in;
+    uint64_t sum = 0;
+
+    memset(&state, 0, sizeof(state));
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        const uint16_t call = (uint16_t)((i >> 3) % LIFT_MAX_FLOORS);
+        state.floor = (uint16_t)(i % LIFT_MAX_FLOORS);
+        LiftCalls_assign(&state.calls, call, !LiftCalls_get(&state.calls, call));
+        LiftStateArray_convert(&state, &in);
+        sum += CondSel_pack(&in);
+    }
+    return sum;
+}
+
+/**
+ * @brief Full step as in LiftTestCase_run() without printing: convert, step, plant.
+ */
+static uint64_t LiftBench_fullStep(uint32_t iterations)
+{
+    LiftState_t state;
+    CondSel_In in;
+    uint64_t sum = 0;
+
+    memset(&state, 0, sizeof(state));
+    SeqNet_init();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        if ((i % LIFT_BENCH_CALL_PERIOD) == 0)
+        {
+            LiftCalls_set(&state.calls, (uint16_t)((i / LIFT_BENCH_CALL_PERIOD) % LIFT_MAX_FLOORS));
+        }
+        LiftStateArray_convert(&state, &in);
+        const SeqNet_Out out = SeqNet_step(&in);
+        LiftPlant_apply(&state, &out);
+        sum += state.floor;
+    }
+    return sum;
+}
+
+/**
+ * @brief Full step with incrementally maintained inputs: step, plant hooks.
+ */
+static uint64_t LiftBench_trackedStep(uint32_t iterations)
+{
+    LiftState_t initial;
+    LiftInputs_t plant;
+    uint64_t sum = 0;
+
+    memset(&initial, 0, sizeof(initial));
+    LiftInputs_init(&plant, &initial);
+    SeqNet_init();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        if ((i % LIFT_BENCH_CALL_PERIOD) == 0)
+        {
+            LiftInputs_callSet(&plant, (uint16_t)((i / LIFT_BENCH_CALL_PERIOD) % LIFT_MAX_FLOORS));
+        }
+        const SeqNet_Out out = SeqNet_step(&plant.in);
+        LiftInputs_apply(&plant, &out);
+        sum += plant.state.floor;
+    }
+    return sum;
+}
+
+/**
+ * @brief Hall call dispatch in a running bank: one operation is a hall call on a random
+ *        floor followed by a group step.
+ *
+ * The step drives every controller and re-rates the pending calls of the cars whose view
+ * changed, reassigning calls to cheaper cars, so the time is an upper bound of the
+ * dispatch latency under the pending-call load the bank builds up.
+ */
+static uint64_t LiftBench_groupDispatch(uint32_t iterations)
+{
+    static const LiftGroupWeights_t weights = { .distance = 4, .reversal = 16, .load = 8 };
+    static LiftGroup_t group;
+    LiftState_t initial[LIFT_BENCH_GROUP_CARS];
+    uint32_t seed = 0x9A11CA11U;
+    uint64_t sum = 0;
+
+    // Cars spread over the building
+    memset(initial, 0, sizeof(initial));
+    for (uint8_t i = 0; i < LIFT_BENCH_GROUP_CARS; ++i)
+    {
+        initial[i].floor = (uint16_t)((i * LIFT_MAX_FLOORS) / LIFT_BENCH_GROUP_CARS);
+    }
+    LiftGroup_init(&group, SeqNetProgram_get(), LIFT_BENCH_GROUP_CARS, initial, LiftGroupCost_default, &weights);
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        sum += LiftGroup_hallCall(&group, (uint16_t)(LiftRandom_next32(&seed) % LIFT_MAX_FLOORS));
+        LiftGroup_step(&group);
+        sum += group.pending_count;
+    }
+    return sum;
+}
+
+/**
+ * @brief Motion integration of a bank of running cars: one operation is one car step.
+ */
+static uint64_t LiftBench_motionIntegrate(uint32_t iterations)
+{
+    static float position[LIFT_BENCH_MOTION_CARS], velocity[LIFT_BENCH_MOTION_CARS], accel[LIFT_BENCH_MOTION_CARS];
+    static float target[LIFT_BENCH_MOTION_CARS], door[LIFT_BENCH_MOTION_CARS], door_rate[LIFT_BENCH_MOTION_CARS];
+    static float dwell[LIFT_BENCH_MOTION_CARS];
+    static int8_t direction[LIFT_BENCH_MOTION_CARS];
+    static LiftInputs_t plant[LIFT_BENCH_MOTION_CARS];
+    static CondSel_Mask in[LIFT_BENCH_MOTION_CARS];
+    const LiftMotionArrays_t arrays = {
+        .position = position, .velocity = velocity, .accel = accel, .target = target, .door = door,
+        .door_rate = door_rate, .dwell = dwell, .direction = direction, .plant = plant, .in = in
+    };
+    LiftMotionParams_t params;
+    LiftMotion_t motion;
+
+    LiftMotionParams_default(&params, (LIFT_MAX_FLOORS < 2U) ? 2U : (uint16_t)LIFT_MAX_FLOORS);
+    LiftMotion_init(&motion, &params, &arrays, LIFT_BENCH_MOTION_CARS);
+    for (uint32_t i = 0; i < LIFT_BENCH_MOTION_CARS; ++i)
+    {
+        target[i] = (float)(i % params.floors) * params.floor_height;
+    }
+    for (uint32_t i = 0; i < iterations; i += LIFT_BENCH_MOTION_CARS)
+    {
+        LiftMotion_integrate(&motion);
+    }
+    return (uint64_t)position[LIFT_BENCH_MOTION_CARS - 1U];
+}
+
+/// All benchmarks in report order
+static LiftBench_t LiftBench_all[] = {
+    { "SeqNet_loop",               LiftBench_seqNetLoop,         0, 0, 0 },
+    { "SeqNetInstruction_convert", LiftBench_instructionConvert, 0, 0, 0 },
+    { "SeqNetOut_convert",         LiftBench_outConvert,         0, 0, 0 },
+    { "CondSel_calc",              LiftBench_condSelCalc,        0, 0, 0 },
+    { "CondSel_calcMask",          LiftBench_condSelCalcMask,    0, 0, 0 },
+    { "LiftStateArray_convert",    LiftBench_stateConvert,       0, 0, 0 },
+    { "full_step",                 LiftBench_fullStep,           0, 0, 0 },
+    { "tracked_step",              LiftBench_trackedStep,        0, 0, 0 },
+    { "group_dispatch_16",         LiftBench_groupDispatch,      0, 0, 0 },
+    { "motion_integrate_4096",     LiftBench_motionIntegrate,    0, 0, 0 },
+};
+
+#define LIFT_BENCH_COUNT (sizeof(LiftBench_all) / sizeof(LiftBench_all[0]))
+
+/**
+ * @brief Runs one benchmark: one warm-up run, then the measured repeats.
+ */
+static void LiftBench_measure(LiftBench_t* bench)
+{
+    double samples[LIFT_BENCH_REPEATS];
+    double sum = 0.0;
+
+    LiftBench_sink += bench->fn(LIFT_BENCH_ITERATIONS / 4U);
+
+    for (uint32_t r = 0; r < LIFT_BENCH_REPEATS; ++r)
+    {
+        const uint64_t start = LiftBench_now();
+        LiftBench_sink += bench->fn(LIFT_BENCH_ITERATIONS);
+        const uint64_t elapsed = LiftBench_now() - start;
+
+        samples[r] = (double)elapsed / (double)LIFT_BENCH_ITERATIONS;
+        sum += samples[r];
+    }
+
+    bench->mean_ns = sum / LIFT_BENCH_REPEATS;
+    bench->min_ns = samples[0];
+    double variance = 0.0;
+    for (uint32_t r = 0; r < LIFT_BENCH_REPEATS; ++r)
+    {
+        const double d = samples[r] - bench->mean_ns;
+        variance += d * d;
+        if (samples[r] < bench->min_ns) bench->min_ns = samples[r];
+    }
+    bench->stddev_ns = sqrt(variance / (LIFT_BENCH_REPEATS - 1U));
+}
+
+/**
+ * @brief Writes the results as JSON.
+ */
+static bool LiftBench_writeJson(const char* path)
+{
+    FILE* file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"version\": \"%s\",\n", Version_get());
+    fprintf(file, "  \"git_hash\": \"%s\",\n", VersionGitHash_get());
+    fprintf(file, "  \"repeats\": %u,\n", (unsigned)LIFT_BENCH_REPEATS);
+    fprintf(file, "  \"iterations\": %u,\n", (unsigned)LIFT_BENCH_ITERATIONS);
+    fprintf(file, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < LIFT_BENCH_COUNT; ++i)
+    {
+        const LiftBench_t* bench = &LiftBench_all[i];
+        fprintf(file, "    { \"name\": \"%s\", \"ns_per_step\": %.3f, \"stddev_ns\": %.3f, \"min_ns\": %.3f, "
+                      "\"steps_per_sec\": %.0f }%s\n",
+                bench->name, bench->mean_ns, bench->stddev_ns, bench->min_ns,
+                1e9 / bench->mean_ns, (i + 1U < LIFT_BENCH_COUNT) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    return fclose(file) == 0;
+}
+
+/**
+ * @brief Runs every benchmark, prints the table and writes the JSON results.
+ *
+ * @return int Returns 0 on success, 1 if the results cannot be written.
+ */
+int main(int argc, char** argv)
+{
+    const char* path = (argc > 1) ? argv[1] : "build/bench.json";
+
+    ScenarioDefaultProgram_load();
+
+    printf("Lift emulator benchmarks (%s, %s), %u x %u operations\n",
+           Version_get(), VersionGitHash_get(), (unsigned)LIFT_BENCH_REPEATS, (unsigned)LIFT_BENCH_ITERATIONS);
+    printf("%-28s %10s %10s %10s %14s\n", "benchmark", "ns/step", "stddev", "min", "steps/sec");
+
+    for (size_t i = 0; i < LIFT_BENCH_COUNT; ++i)
+    {
+        LiftBench_t* bench = &LiftBench_all[i];
+        LiftBench_measure(bench);
+        printf("%-28s %10.3f %10.3f %10.3f %14.0f\n",
+               bench->name, bench->mean_ns, bench->stddev_ns, bench->min_ns, 1e9 / bench->mean_ns);
+    }
+
+    if (!LiftBench_writeJson(path))
+    {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 1;
+    }
+    printf("Results written to %s\n", path);
+    return 0;
+}
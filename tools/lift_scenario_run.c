@@ -0,0 +1,104 @@
+/**
+ * @file lift_scenario_run.c
+ * @brief Command line runner of scenario files.
+ *
+ * Usage: lift_scenario_run <scenarios> [<image.bin> <index>]
+ * Streams a text or binary scenario file (@see lift_scenario.h) through the default
+ * program, or through an image of a program image file, and prints the report.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "seqnet_image.h"
+#include "scenario_loader.h"
+#include "lift_scenario.h"
+
+/// Scenarios read and run per batch
+#define LIFT_SCENARIO_RUN_BATCH    (1024U)
+/// Worker threads of the runner
+#define LIFT_SCENARIO_RUN_THREADS  (4U)
+
+/**
+ * @brief Runs a scenario file and prints the report to the standard output.
+ *
+ * @return int Returns 0 if every scenario passed, 1 on a failing scenario or an error.
+ */
+int main(int argc, char** argv)
+{
+    static LiftScenarioReader_t reader;
+    static LiftScenario_t batch[LIFT_SCENARIO_RUN_BATCH];
+    static SeqNet_Program program;
+
+    if ((argc != 2) && (argc != 4))
+    {
+        fprintf(stderr, "Usage: %s <scenarios> [<image.bin> <index>]\n", argv[0]);
+        return 1;
+    }
+
+    // Program under test: the default one or an image of a file
+    if (argc == 4)
+    {
+        SeqNetImageFile_t images;
+        SeqNetImageStatus_t status = SeqNetImageFile_open(&images, argv[2]);
+        if (status == SEQNET_IMAGE_OK)
+        {
+            status = SeqNetImage_load(&images, (uint32_t)strtoul(argv[3], NULL, 10), &program);
+            SeqNetImageFile_close(&images);
+        }
+        if (status != SEQNET_IMAGE_OK)
+        {
+            fprintf(stderr, "Cannot load image %s of %s: %s\n", argv[3], argv[2], SeqNetImageStatus_name(status));
+            return 1;
+        }
+    }
+    else
+    {
+        ScenarioDefaultProgram_load();
+        program = *SeqNetProgram_get();
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    LiftScenarioReport_t report;
+    LiftScenarioStatus_t status = LiftScenarioReader_begin(&reader, file);
+    bool ok = false;
+    if (status == LIFT_SCENARIO_OK)
+    {
+        ok = LiftScenario_stream(&reader, &program, batch, LIFT_SCENARIO_RUN_BATCH, LIFT_SCENARIO_RUN_THREADS, &report);
+        status = report.status;
+    }
+    fclose(file);
+
+    if (status != LIFT_SCENARIO_END)
+    {
+        fprintf(stderr, "Malformed scenario file %s: %s", argv[1], LiftScenarioStatus_name(status));
+        if (reader.format == LIFT_SCENARIO_TEXT)
+        {
+            fprintf(stderr, " (line %u)", (unsigned)reader.line);
+        }
+        else
+        {
+            fprintf(stderr, " (record #%llu)", (unsigned long long)reader.index);
+        }
+        fprintf(stderr, "\n");
+        return 1;
+    }
+
+    printf("Program:     %s (id 0x%08X)\n", (argc == 4) ? argv[2] : "default", (unsigned)program.id);
+    printf("Format:      %s\n", (reader.format == LIFT_SCENARIO_TEXT) ? "text" : "binary");
+    printf("Scenarios:   %llu\n", (unsigned long long)report.count);
+    printf("Passed:      %llu\n", (unsigned long long)report.passed);
+    printf("Failed:      %llu\n", (unsigned long long)(report.count - report.passed));
+    if (report.first_failed != UINT64_MAX)
+    {
+        printf("First fail:  #%llu\n", (unsigned long long)report.first_failed);
+    }
+    return ok ? 0 : 1;
+}
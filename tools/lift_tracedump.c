@@ -0,0 +1,41 @@
+/**
+ * @file lift_tracedump.c
+ * @brief Command line decoder of binary step traces.
+ *
+ * Usage: lift_tracedump <trace.bin>
+ * Prints the trace in the text format of the lift test step log (@see LiftTrace_decode).
+ */
+
+#include <stdio.h>
+#include "lift_trace.h"
+
+/**
+ * @brief Decodes a trace file to the standard output.
+ *
+ * @return int Returns 0 on success, 1 on error.
+ */
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s <trace.bin>\n", argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[1], "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    const bool ok = LiftTrace_decode(file, stdout);
+    fclose(file);
+
+    if (!ok)
+    {
+        fprintf(stderr, "Malformed trace %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
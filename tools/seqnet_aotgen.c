@@ -0,0 +1,48 @@
+/**
+ * @file seqnet_aotgen.c
+ * @brief Command line front-end of the ahead-of-time compiler.
+ *
+ * Usage: seqnet_aotgen <output.c>
+ * Compiles the default program (@see ScenarioDefaultProgram_load) into a specialized engine.
+ */
+
+#include <stdio.h>
+#include "seqnet.h"
+#include "seqnet_internal.h"
+#include "seqnet_aot.h"
+#include "scenario_loader.h"
+
+/**
+ * @brief Generates the specialized engine of the default program.
+ *
+ * @return int Returns 0 on success, 1 on error.
+ */
+int main(int argc, char** argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "Usage: %s <output.c>\n", argv[0]);
+        return 1;
+    }
+
+    ScenarioDefaultProgram_load();
+
+    FILE* file = fopen(argv[1], "w");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    bool ok = SeqNetAot_generate(file, SeqNetProgram_get(), "default");
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok)
+    {
+        fprintf(stderr, "Failed to write %s\n", argv[1]);
+        return 1;
+    }
+
+    printf("Generated %s\n", argv[1]);
+    return 0;
+}